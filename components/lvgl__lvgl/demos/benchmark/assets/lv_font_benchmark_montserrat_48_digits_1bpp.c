@@ -0,0 +1,259 @@
+#include "../../../lvgl.h"
+
+#if LV_USE_DEMO_BENCHMARK
+
+/*******************************************************************************
+ * Size: 48 px
+ * Bpp: 1
+ * Opts: the glyphs of "0123456789:" of lv_font_montserrat_48.c with the 4 bpp pixels >= 8 set, no kerning
+ ******************************************************************************/
+
+#ifndef LV_FONT_BENCHMARK_MONTSERRAT_48_DIGITS_1BPP
+#define LV_FONT_BENCHMARK_MONTSERRAT_48_DIGITS_1BPP 1
+#endif
+
+#if LV_FONT_BENCHMARK_MONTSERRAT_48_DIGITS_1BPP
+
+/*-----------------
+ *    BITMAPS
+ *----------------*/
+
+/*Store the image of the glyphs*/
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
+    /* U+0030 "0" */
+    0x0, 0x3f, 0xc0, 0x0, 0xf, 0xff, 0x0, 0x3,
+    0xff, 0xfc, 0x0, 0x7f, 0xff, 0xe0, 0xf, 0xf0,
+    0xff, 0x1, 0xfc, 0x3, 0xf8, 0x1f, 0x80, 0x1f,
+    0x83, 0xf0, 0x0, 0xfc, 0x3e, 0x0, 0x7, 0xc7,
+    0xc0, 0x0, 0x3e, 0x7c, 0x0, 0x3, 0xe7, 0xc0,
+    0x0, 0x3e, 0x7c, 0x0, 0x3, 0xe7, 0x80, 0x0,
+    0x1e, 0xf8, 0x0, 0x1, 0xff, 0x80, 0x0, 0x1f,
+    0xf8, 0x0, 0x1, 0xff, 0x80, 0x0, 0x1f, 0xf8,
+    0x0, 0x1, 0xff, 0x80, 0x0, 0x1f, 0x78, 0x0,
+    0x1, 0xe7, 0xc0, 0x0, 0x3e, 0x7c, 0x0, 0x3,
+    0xe7, 0xc0, 0x0, 0x3e, 0x7c, 0x0, 0x3, 0xe3,
+    0xe0, 0x0, 0x7c, 0x3f, 0x0, 0xf, 0xc1, 0xf8,
+    0x1, 0xf8, 0x1f, 0xc0, 0x3f, 0x80, 0xff, 0xf,
+    0xf0, 0x7, 0xff, 0xfe, 0x0, 0x3f, 0xff, 0xc0,
+    0x0, 0xff, 0xf0, 0x0, 0x3, 0xfc, 0x0,
+
+    /* U+0031 "1" */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf,
+    0x80, 0x7c, 0x3, 0xe0, 0x1f, 0x0, 0xf8, 0x7,
+    0xc0, 0x3e, 0x1, 0xf0, 0xf, 0x80, 0x7c, 0x3,
+    0xe0, 0x1f, 0x0, 0xf8, 0x7, 0xc0, 0x3e, 0x1,
+    0xf0, 0xf, 0x80, 0x7c, 0x3, 0xe0, 0x1f, 0x0,
+    0xf8, 0x7, 0xc0, 0x3e, 0x1, 0xf0, 0xf, 0x80,
+    0x7c, 0x3, 0xe0, 0x1f, 0x0, 0xf8, 0x7, 0xc0,
+
+    /* U+0032 "2" */
+    0x0, 0x7f, 0x80, 0x0, 0xff, 0xfc, 0x0, 0xff,
+    0xff, 0x80, 0xff, 0xff, 0xf0, 0x7f, 0xc1, 0xfe,
+    0x1f, 0x80, 0x1f, 0xc3, 0x80, 0x1, 0xf0, 0x40,
+    0x0, 0x7c, 0x0, 0x0, 0xf, 0x0, 0x0, 0x3,
+    0xc0, 0x0, 0x0, 0xf0, 0x0, 0x0, 0x7c, 0x0,
+    0x0, 0x1f, 0x0, 0x0, 0x7, 0xc0, 0x0, 0x3,
+    0xe0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xfc, 0x0,
+    0x0, 0x7e, 0x0, 0x0, 0x3f, 0x0, 0x0, 0x1f,
+    0x80, 0x0, 0xf, 0xc0, 0x0, 0x7, 0xe0, 0x0,
+    0x3, 0xf0, 0x0, 0x1, 0xf8, 0x0, 0x0, 0xfc,
+    0x0, 0x0, 0x7e, 0x0, 0x0, 0x3f, 0x0, 0x0,
+    0x1f, 0x80, 0x0, 0xf, 0xc0, 0x0, 0x7, 0xe0,
+    0x0, 0x3, 0xff, 0xff, 0xfc, 0xff, 0xff, 0xff,
+    0x3f, 0xff, 0xff, 0xcf, 0xff, 0xff, 0xf0,
+
+    /* U+0033 "3" */
+    0x3f, 0xff, 0xff, 0xf, 0xff, 0xff, 0xc3, 0xff,
+    0xff, 0xf0, 0xff, 0xff, 0xfc, 0x0, 0x0, 0x7e,
+    0x0, 0x0, 0x1f, 0x0, 0x0, 0xf, 0x80, 0x0,
+    0x7, 0xe0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0xf8,
+    0x0, 0x0, 0x7c, 0x0, 0x0, 0x3e, 0x0, 0x0,
+    0x1f, 0x0, 0x0, 0xf, 0xc0, 0x0, 0x3, 0xf8,
+    0x0, 0x1, 0xff, 0xc0, 0x0, 0x7f, 0xfc, 0x0,
+    0xf, 0xff, 0x80, 0x0, 0xf, 0xf0, 0x0, 0x0,
+    0xfc, 0x0, 0x0, 0x1f, 0x80, 0x0, 0x3, 0xe0,
+    0x0, 0x0, 0xf8, 0x0, 0x0, 0x3e, 0x0, 0x0,
+    0xf, 0x80, 0x0, 0x3, 0xe2, 0x0, 0x0, 0xf8,
+    0xc0, 0x0, 0x7e, 0x7c, 0x0, 0x3f, 0x3f, 0xf0,
+    0x7f, 0x87, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xe0,
+    0x7, 0xff, 0xf0, 0x0, 0x3f, 0xe0, 0x0,
+
+    /* U+0034 "4" */
+    0x0, 0x0, 0x3e, 0x0, 0x0, 0x0, 0xf8, 0x0,
+    0x0, 0x3, 0xe0, 0x0, 0x0, 0xf, 0xc0, 0x0,
+    0x0, 0x1f, 0x0, 0x0, 0x0, 0x7c, 0x0, 0x0,
+    0x1, 0xf0, 0x0, 0x0, 0x7, 0xe0, 0x0, 0x0,
+    0xf, 0x80, 0x0, 0x0, 0x3e, 0x0, 0x0, 0x0,
+    0xf8, 0x0, 0x0, 0x3, 0xf0, 0x0, 0x0, 0x7,
+    0xc0, 0x0, 0x0, 0x1f, 0x0, 0x0, 0x0, 0x7c,
+    0x3, 0xc0, 0x1, 0xf8, 0x7, 0x80, 0x7, 0xe0,
+    0xf, 0x0, 0xf, 0x80, 0x1e, 0x0, 0x3e, 0x0,
+    0x3c, 0x0, 0xf8, 0x0, 0x78, 0x3, 0xf0, 0x0,
+    0xf0, 0x7, 0xc0, 0x1, 0xe0, 0x1f, 0xff, 0xff,
+    0xff, 0xbf, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff,
+    0xfe, 0xff, 0xff, 0xff, 0xfc, 0x0, 0x0, 0x7c,
+    0x0, 0x0, 0x0, 0xf8, 0x0, 0x0, 0x1, 0xf0,
+    0x0, 0x0, 0x3, 0xe0, 0x0, 0x0, 0x7, 0xc0,
+    0x0, 0x0, 0xf, 0x80, 0x0, 0x0, 0x1f, 0x0,
+    0x0, 0x0, 0x3e, 0x0,
+
+    /* U+0035 "5" */
+    0x7, 0xff, 0xff, 0x1, 0xff, 0xff, 0xc0, 0x7f,
+    0xff, 0xf0, 0x1f, 0xff, 0xfc, 0x7, 0x80, 0x0,
+    0x3, 0xe0, 0x0, 0x0, 0xf8, 0x0, 0x0, 0x3e,
+    0x0, 0x0, 0xf, 0x80, 0x0, 0x3, 0xe0, 0x0,
+    0x0, 0xf0, 0x0, 0x0, 0x3c, 0x0, 0x0, 0xf,
+    0x0, 0x0, 0x3, 0xff, 0xe0, 0x0, 0xff, 0xff,
+    0x0, 0x7f, 0xff, 0xf0, 0x1f, 0xff, 0xfe, 0x0,
+    0x0, 0x7f, 0xc0, 0x0, 0x3, 0xf8, 0x0, 0x0,
+    0x3e, 0x0, 0x0, 0xf, 0x80, 0x0, 0x1, 0xf0,
+    0x0, 0x0, 0x7c, 0x0, 0x0, 0x1f, 0x0, 0x0,
+    0x7, 0xc0, 0x0, 0x1, 0xf1, 0x0, 0x0, 0xf8,
+    0xe0, 0x0, 0x3e, 0x3e, 0x0, 0x3f, 0x9f, 0xf8,
+    0x7f, 0xc3, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xf0,
+    0x7, 0xff, 0xf0, 0x0, 0x1f, 0xf0, 0x0,
+
+    /* U+0036 "6" */
+    0x0, 0xf, 0xf8, 0x0, 0xf, 0xff, 0xe0, 0x7,
+    0xff, 0xfc, 0x1, 0xff, 0xff, 0x80, 0x7f, 0x80,
+    0xe0, 0x1f, 0xc0, 0x0, 0x7, 0xe0, 0x0, 0x0,
+    0xf8, 0x0, 0x0, 0x3e, 0x0, 0x0, 0x7, 0xc0,
+    0x0, 0x1, 0xf0, 0x0, 0x0, 0x3e, 0x0, 0x0,
+    0x7, 0xc0, 0x0, 0x0, 0xf0, 0x3f, 0xc0, 0x3e,
+    0x3f, 0xfe, 0x7, 0xcf, 0xff, 0xf0, 0xfb, 0xff,
+    0xff, 0x1f, 0xfc, 0xf, 0xf3, 0xfe, 0x0, 0x7e,
+    0x7f, 0x80, 0x7, 0xef, 0xe0, 0x0, 0x7c, 0xfc,
+    0x0, 0xf, 0x9f, 0x0, 0x0, 0xf3, 0xe0, 0x0,
+    0x1e, 0x7c, 0x0, 0x3, 0xc7, 0xc0, 0x0, 0xf8,
+    0xf8, 0x0, 0x1f, 0xf, 0x80, 0x7, 0xc1, 0xf8,
+    0x1, 0xf8, 0x1f, 0xc0, 0xfe, 0x1, 0xff, 0xff,
+    0x80, 0x1f, 0xff, 0xe0, 0x0, 0xff, 0xf8, 0x0,
+    0x7, 0xf8, 0x0,
+
+    /* U+0037 "7" */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x0, 0xf,
+    0xbe, 0x0, 0x3, 0xef, 0x80, 0x1, 0xf3, 0xe0,
+    0x0, 0x7c, 0xf8, 0x0, 0x3e, 0x3e, 0x0, 0xf,
+    0x80, 0x0, 0x3, 0xe0, 0x0, 0x1, 0xf0, 0x0,
+    0x0, 0x7c, 0x0, 0x0, 0x3e, 0x0, 0x0, 0xf,
+    0x80, 0x0, 0x7, 0xc0, 0x0, 0x1, 0xf0, 0x0,
+    0x0, 0xfc, 0x0, 0x0, 0x3e, 0x0, 0x0, 0xf,
+    0x80, 0x0, 0x7, 0xc0, 0x0, 0x1, 0xf0, 0x0,
+    0x0, 0xf8, 0x0, 0x0, 0x3e, 0x0, 0x0, 0x1f,
+    0x0, 0x0, 0x7, 0xc0, 0x0, 0x3, 0xf0, 0x0,
+    0x0, 0xf8, 0x0, 0x0, 0x3e, 0x0, 0x0, 0x1f,
+    0x0, 0x0, 0x7, 0xc0, 0x0, 0x3, 0xe0, 0x0,
+    0x0, 0xf8, 0x0, 0x0, 0x7c, 0x0, 0x0,
+
+    /* U+0038 "8" */
+    0x0, 0x7f, 0xc0, 0x0, 0x7f, 0xff, 0x0, 0x3f,
+    0xff, 0xf0, 0xf, 0xff, 0xff, 0x81, 0xfc, 0x7,
+    0xf0, 0x7e, 0x0, 0x3f, 0xf, 0x80, 0x3, 0xe3,
+    0xe0, 0x0, 0x3c, 0x7c, 0x0, 0x7, 0xcf, 0x80,
+    0x0, 0xf8, 0xf0, 0x0, 0x1e, 0x1f, 0x0, 0x7,
+    0xc3, 0xf0, 0x1, 0xf8, 0x3f, 0x80, 0xfe, 0x3,
+    0xff, 0xff, 0x80, 0x3f, 0xff, 0xc0, 0xf, 0xff,
+    0xfc, 0x3, 0xff, 0xff, 0xe0, 0xfe, 0x0, 0xfe,
+    0x3f, 0x0, 0x7, 0xe7, 0xc0, 0x0, 0x7d, 0xf0,
+    0x0, 0xf, 0xbe, 0x0, 0x0, 0xff, 0xc0, 0x0,
+    0x1f, 0xf8, 0x0, 0x3, 0xff, 0x0, 0x0, 0x7f,
+    0xf0, 0x0, 0x1f, 0x3e, 0x0, 0x3, 0xe7, 0xe0,
+    0x1, 0xfc, 0x7f, 0x0, 0xff, 0x7, 0xff, 0xff,
+    0xc0, 0x7f, 0xff, 0xf0, 0x3, 0xff, 0xf8, 0x0,
+    0xf, 0xf8, 0x0,
+
+    /* U+0039 "9" */
+    0x0, 0xff, 0x0, 0x0, 0x7f, 0xfc, 0x0, 0x3f,
+    0xff, 0xe0, 0xf, 0xff, 0xfe, 0x3, 0xf8, 0xf,
+    0xe0, 0x7c, 0x0, 0x7c, 0x1f, 0x0, 0x7, 0xc3,
+    0xe0, 0x0, 0x7c, 0xf8, 0x0, 0xf, 0x9f, 0x0,
+    0x1, 0xf3, 0xe0, 0x0, 0x3f, 0x7c, 0x0, 0x7,
+    0xe7, 0xc0, 0x0, 0xfc, 0xf8, 0x0, 0x3f, 0x9f,
+    0x80, 0xf, 0xf1, 0xfc, 0x7, 0xfe, 0x1f, 0xff,
+    0xff, 0xc1, 0xff, 0xfe, 0xf8, 0x1f, 0xff, 0x1f,
+    0x0, 0x7f, 0x83, 0xe0, 0x0, 0x0, 0x7c, 0x0,
+    0x0, 0xf, 0x80, 0x0, 0x1, 0xf0, 0x0, 0x0,
+    0x7c, 0x0, 0x0, 0xf, 0x80, 0x0, 0x3, 0xf0,
+    0x0, 0x0, 0xfc, 0x0, 0x0, 0x3f, 0x0, 0x0,
+    0xf, 0xe0, 0x3c, 0xf, 0xf8, 0x7, 0xff, 0xfe,
+    0x1, 0xff, 0xff, 0x0, 0x1f, 0xff, 0xc0, 0x0,
+    0x7f, 0xc0, 0x0,
+
+    /* U+003A ":" */
+    0x38, 0xfb, 0xf7, 0xff, 0xcf, 0x84, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x87, 0xdf, 0xbf, 0xfe, 0x7c, 0x70
+};
+
+
+/*---------------------
+ *  GLYPH DESCRIPTION
+ *--------------------*/
+
+static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
+    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
+    {.bitmap_index = 0, .adv_w = 512, .box_w = 28, .box_h = 34, .ofs_x = 2, .ofs_y = 0},
+    {.bitmap_index = 119, .adv_w = 284, .box_w = 13, .box_h = 34, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 175, .adv_w = 441, .box_w = 26, .box_h = 34, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 286, .adv_w = 439, .box_w = 26, .box_h = 34, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 397, .adv_w = 514, .box_w = 31, .box_h = 34, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 529, .adv_w = 441, .box_w = 26, .box_h = 34, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 640, .adv_w = 474, .box_w = 27, .box_h = 34, .ofs_x = 2, .ofs_y = 0},
+    {.bitmap_index = 755, .adv_w = 459, .box_w = 26, .box_h = 34, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 866, .adv_w = 495, .box_w = 27, .box_h = 34, .ofs_x = 2, .ofs_y = 0},
+    {.bitmap_index = 981, .adv_w = 474, .box_w = 27, .box_h = 34, .ofs_x = 1, .ofs_y = 0},
+    {.bitmap_index = 1096, .adv_w = 174, .box_w = 7, .box_h = 26, .ofs_x = 2, .ofs_y = 0}
+};
+
+/*---------------------
+ *  CHARACTER MAPPING
+ *--------------------*/
+
+
+/*Collect the unicode lists and glyph_id offsets*/
+static const lv_font_fmt_txt_cmap_t cmaps[] = {
+    {
+        .range_start = 48, .range_length = 11, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    }
+};
+
+
+/*--------------------
+ *  ALL CUSTOM DATA
+ *--------------------*/
+
+/*Store all the custom data of the font*/
+static lv_font_fmt_txt_dsc_t font_dsc = {
+    .glyph_bitmap = glyph_bitmap,
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = NULL,
+    .kern_scale = 0,
+    .cmap_num = 1,
+    .bpp = 1,
+    .kern_classes = 0,
+    .bitmap_format = 0
+};
+
+
+/*-----------------
+ *  PUBLIC FONT
+ *----------------*/
+
+/*Initialize a public general font descriptor*/
+lv_font_t lv_font_benchmark_montserrat_48_digits_1bpp = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph's data*/
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph's bitmap*/
+    .line_height = 52,          /*The maximum line height required by the font*/
+    .base_line = 9,             /*Baseline measured from the bottom of the line*/
+#if !(LVGL_VERSION_MAJOR == 6 && LVGL_VERSION_MINOR == 0)
+    .subpx = LV_FONT_SUBPX_NONE,
+#endif
+    .dsc = &font_dsc           /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */
+};
+
+#endif /*#if LV_FONT_BENCHMARK_MONTSERRAT_48_DIGITS_1BPP*/
+
+#endif
@@ -75,24 +75,27 @@ static uint32_t disp_ori_timer_period;
 static uint32_t anim_ori_timer_period;
 
 #if LV_DEMO_BENCHMARK_RGB565A8 && LV_COLOR_DEPTH == 16
-    LV_IMG_DECLARE(img_benchmark_cogwheel_rgb565a8);
+    LV_IMG_DECLARE(img_benchmark_cogwheel_rgb565a8)
 #else
-    LV_IMG_DECLARE(img_benchmark_cogwheel_argb);
+    LV_IMG_DECLARE(img_benchmark_cogwheel_argb)
 #endif
-LV_IMG_DECLARE(img_benchmark_cogwheel_rgb);
-LV_IMG_DECLARE(img_benchmark_cogwheel_chroma_keyed);
-LV_IMG_DECLARE(img_benchmark_cogwheel_indexed16);
-LV_IMG_DECLARE(img_benchmark_cogwheel_alpha16);
+LV_IMG_DECLARE(img_benchmark_cogwheel_rgb)
+LV_IMG_DECLARE(img_benchmark_cogwheel_chroma_keyed)
+LV_IMG_DECLARE(img_benchmark_cogwheel_indexed16)
+LV_IMG_DECLARE(img_benchmark_cogwheel_alpha16)
 
-LV_FONT_DECLARE(lv_font_benchmark_montserrat_12_compr_az);
-LV_FONT_DECLARE(lv_font_benchmark_montserrat_16_compr_az);
-LV_FONT_DECLARE(lv_font_benchmark_montserrat_28_compr_az);
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_12_compr_az)
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_16_compr_az)
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_28_compr_az)
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_48_digits_1bpp)
+LV_FONT_DECLARE(lv_font_benchmark_montserrat_48_digits_4bpp)
 
 static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px);
 static void next_scene_timer_cb(lv_timer_t * timer);
 static void rect_create(lv_style_t * style);
 static void img_create(lv_style_t * style, const void * src, bool rotate, bool zoom, bool aa);
 static void txt_create(lv_style_t * style);
+static void clock_create(lv_style_t * style);
 static void line_create(lv_style_t * style);
 static void arc_create(lv_style_t * style);
 static void fall_anim(lv_obj_t * obj);
@@ -463,6 +466,25 @@ static void txt_large_compr_cb(void)
 }
 
 
+static void txt_clock_1bpp_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, &lv_font_benchmark_montserrat_48_digits_1bpp);
+    lv_style_set_text_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    clock_create(&style_common);
+
+}
+
+static void txt_clock_4bpp_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, &lv_font_benchmark_montserrat_48_digits_4bpp);
+    lv_style_set_text_opa(&style_common, opa_mode ? LV_OPA_50 : LV_OPA_COVER);
+    clock_create(&style_common);
+
+}
+
+
 static void line_cb(void)
 {
     lv_style_reset(&style_common);
@@ -615,6 +637,9 @@ static scene_dsc_t scenes[] = {
     {.name = "Text medium compressed",       .weight = 5, .create_cb = txt_medium_compr_cb},
     {.name = "Text large compressed",        .weight = 10, .create_cb = txt_large_compr_cb},
 
+    {.name = "Text clock digits 1 bpp",      .weight = 10, .create_cb = txt_clock_1bpp_cb},
+    {.name = "Text clock digits 4 bpp",      .weight = 10, .create_cb = txt_clock_4bpp_cb},
+
     {.name = "Line",                         .weight = 10, .create_cb = line_cb},
 
     {.name = "Arc think",                    .weight = 10, .create_cb = arc_think_cb},
@@ -637,6 +662,7 @@ static lv_obj_t * title;
 static lv_obj_t * subtitle;
 static uint32_t rnd_act;
 static lv_timer_t * next_scene_timer;
+static lv_timer_t * report_timer;
 
 static const uint32_t rnd_map[] = {
     0xbd13204f, 0x67d8167f, 0x20211c99, 0xb0a7cc05,
@@ -716,6 +742,10 @@ void lv_demo_benchmark_close(void)
     if(next_scene_timer) lv_timer_del(next_scene_timer);
     next_scene_timer = NULL;
 
+    /*The report of a scene started by `lv_demo_benchmark_run_scene()` would write the deleted labels*/
+    if(report_timer) lv_timer_del(report_timer);
+    report_timer = NULL;
+
     lv_anim_del(NULL, NULL);
 
     lv_style_reset(&style_common);
@@ -728,7 +758,7 @@ void lv_demo_benchmark_run_scene(int_fast16_t scene_no)
 {
     benchmark_init();
 
-    if(((scene_no >> 1) >= dimof(scenes))) {
+    if(scene_no < 0 || (size_t)(scene_no >> 1) >= dimof(scenes)) {
         /* invalid scene number */
         return ;
     }
@@ -745,8 +775,9 @@ void lv_demo_benchmark_run_scene(int_fast16_t scene_no)
         rnd_reset();
         scenes[scene_act].create_cb();
 
-        lv_timer_t * t = lv_timer_create(report_cb, SCENE_TIME, NULL);
-        lv_timer_set_repeat_count(t, 1);
+        if(report_timer) lv_timer_del(report_timer);
+        report_timer = lv_timer_create(report_cb, SCENE_TIME, NULL);
+        lv_timer_set_repeat_count(report_timer, 1);
     }
 }
 
@@ -959,6 +990,9 @@ static void generate_report(void)
 
 static void report_cb(lv_timer_t * timer)
 {
+    LV_UNUSED(timer);
+    report_timer = NULL;
+
     if(NULL != benchmark_finished_cb) {
         (*benchmark_finished_cb)();
     }
@@ -1104,6 +1138,21 @@ static void txt_create(lv_style_t * style)
     }
 }
 
+/*Large digits, like the face of a clock*/
+static void clock_create(lv_style_t * style)
+{
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+        lv_obj_t * obj = lv_label_create(scene_bg);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_obj_set_style_text_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+
+        lv_label_set_text_fmt(obj, "%02"LV_PRId32":%02"LV_PRId32, rnd_next(0, 23), rnd_next(0, 59));
+
+        fall_anim(obj);
+    }
+}
 
 static void line_create(lv_style_t * style)
 {
@@ -66,10 +66,33 @@
     #define LV_MEM_CUSTOM_REALLOC realloc
 #endif     /*LV_MEM_CUSTOM*/
 
+/*1: use a custom allocator for large caches (e.g. glyph cache) which can live in slower, external RAM;
+ *0: allocate them with `lv_mem_alloc()` and `lv_mem_free()` too*/
+#define LV_MEM_EXT_CUSTOM 0
+#if LV_MEM_EXT_CUSTOM
+    #define LV_MEM_EXT_CUSTOM_INCLUDE <stdlib.h>   /*Header for the external memory functions*/
+    #define LV_MEM_EXT_CUSTOM_ALLOC   malloc
+    #define LV_MEM_EXT_CUSTOM_FREE    free
+#endif     /*LV_MEM_EXT_CUSTOM*/
+
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
  *You will see an error log message if there wasn't enough buffers. */
 #define LV_MEM_BUF_MAX_NUM 16
 
+/*Size of the arena in bytes `lv_mem_buf_get()` takes the intermediate buffers from (per drawing thread).
+ *The buffers are stacked in it and it's emptied after every refresh so drawing doesn't call the heap.
+ *Requests which don't fit cause an error and an assert. 0: use `LV_MEM_BUF_MAX_NUM` buffers from the heap*/
+#define LV_MEM_BUF_ARENA_SIZE 0
+
+/*1: allocate the arenas with a custom allocator (e.g. from fast internal RAM when `malloc()` can return
+ *external RAM); 0: allocate them with `lv_mem_alloc()` and `lv_mem_free()`*/
+#define LV_MEM_BUF_ARENA_CUSTOM 0
+#if LV_MEM_BUF_ARENA_CUSTOM
+    #define LV_MEM_BUF_ARENA_CUSTOM_INCLUDE <stdlib.h>   /*Header for the arena's memory functions*/
+    #define LV_MEM_BUF_ARENA_CUSTOM_ALLOC   malloc
+    #define LV_MEM_BUF_ARENA_CUSTOM_FREE    free
+#endif     /*LV_MEM_BUF_ARENA_CUSTOM*/
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
@@ -113,8 +136,15 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *A buffered shadow has shadow size^2 RAM cost*/
     #define LV_SHADOW_CACHE_SIZE 0
+    #if LV_SHADOW_CACHE_SIZE
+        /*Size of all the buffered shadows in bytes, by default 4 shadows of the max. size
+         *(with Kconfig set as the number of shadows, LV_SHADOW_CACHE_CNT).
+         *The least recently used ones are dropped to make room.
+         *Allocated with the `LV_MEM_EXT_CUSTOM` allocator. 0: blur the shadows on every draw*/
+        #define LV_SHADOW_CACHE_MEM_SIZE (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 4)
+    #endif
 
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
@@ -145,6 +175,18 @@
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Limit of the RAM used by the opened images in bytes. The least recently used ones are closed to make room.
+     *0: limit only the number of images*/
+    #define LV_IMG_CACHE_MEM_SIZE 0
+#endif
+
+/*Size of the text cache in bytes.
+ *The software renderer draws the text of a label into an 8 bit opacity map once
+ *and blends this map with a single fill while the text, font and layout of the label don't change.
+ *A text needs width x height bytes. Texts larger than the cache are drawn letter by letter.
+ *0: to disable caching*/
+#define LV_TEXT_CACHE_SIZE 0
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -152,6 +194,8 @@
 
 /*Default gradient buffer size.
  *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
+ *The maps are found by their stops, direction, size and dithering mode and the least recently used ones are dropped.
+ *With ordered dithering the dithered rows are cached too (8 times the size of the map).
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
@@ -172,6 +216,35 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Number of threads rendering with the software renderer.
+ *The areas to redraw are cut into horizontal bands and the bands are drawn in parallel
+ *by the thread calling `lv_timer_handler()` and LV_DRAW_SW_THREAD_CNT - 1 worker threads.
+ *Requires LV_MEM_CUSTOM 1 with a thread safe `malloc` and the draw event callbacks of the application
+ *have to be thread safe too.
+ *1: render on the calling thread only*/
+#define LV_DRAW_SW_THREAD_CNT 1
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*1: use FreeRTOS tasks; 0: use pthreads*/
+    #define LV_DRAW_SW_THREAD_FREERTOS 0
+
+    /*Stack size of the worker threads in bytes*/
+    #define LV_DRAW_SW_THREAD_STACK_SIZE (16 * 1024)
+
+    /*Priority of the worker tasks. Only used with FreeRTOS.*/
+    #define LV_DRAW_SW_THREAD_PRIO 5
+
+    /*Areas lower than this many rows per thread are drawn by the calling thread only*/
+    #define LV_DRAW_SW_THREAD_MIN_HEIGHT 16
+
+    /*Storage class specifier of thread-local variables*/
+    #define LV_DRAW_SW_THREAD_LOCAL __thread
+#endif
+
+/*Blend with vectorized kernels chosen by the CPU's features in `lv_init()` instead of the C loops.
+ *Built-in: SSE2 and AVX2 on x86 with GCC or Clang, PIE on the ESP32-S3 (fill only).
+ *Other kernels can be set by `lv_draw_sw_blend_set_kernels()`*/
+#define LV_DRAW_SW_BLEND_SIMD 1
+
 /*-------------
  * GPU
  *-----------*/
@@ -306,6 +379,25 @@
 
 #define LV_USE_USER_DATA 1
 
+/*Number of style property lookups to cache per object.
+ *The resolved values are kept for the object's current state and are invalidated when a style changes.
+ *Needs around 12 bytes per entry on 32 bit systems for every object which has styles.
+ *Must be a power of 2 (max 256). 0: to disable caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 0
+
+/*Maximal size of the recorded draw calls of an object in bytes.
+ *Objects which weren't changed since they were drawn replay their recorded draw calls
+ *instead of sending the draw events and building the draw descriptors again.
+ *Objects with larger recordings or masks (e.g. clip corner) are always drawn with the draw events.
+ *0: to disable recording*/
+#define LV_OBJ_DRAW_LIST_SIZE 0
+
+/*Maximal total size of the kept layers of the objects in bytes.
+ *The objects enabled with `lv_obj_set_layer_cache()` keep their rendered layer (e.g. for opa_layered or transform)
+ *between the frames and only blend or transform it until one of their descendants is invalidated.
+ *0: to disable keeping the layers*/
+#define LV_OBJ_LAYER_CACHE_SIZE 0
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #define LV_ENABLE_GC 0
@@ -408,6 +500,12 @@
 
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of decompressed glyph bitmaps in bytes. Allocated with the `LV_MEM_EXT_CUSTOM` allocator.
+     *Glyphs drawn again and again (e.g. digits of a clock) don't need to be decompressed while they are cached.
+     *0: no cache, decompress the glyphs every time*/
+    #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+#endif
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -608,6 +706,25 @@
 
 /*File system interfaces for common APIs */
 
+/*Number of blocks of `LV_FS_..._CACHE_SIZE` bytes shared by the open files of each driver with a cache.
+ *The least recently used block is replaced. Blocks read in order replace themselves first.
+ *0: cache one block per open file*/
+#define LV_FS_CACHE_BLOCK_CNT 0
+#if LV_FS_CACHE_BLOCK_CNT
+    /*1: read the next block on a worker thread when a file is read sequentially*/
+    #define LV_FS_CACHE_PREFETCH 0
+    #if LV_FS_CACHE_PREFETCH
+        /*1: use a FreeRTOS task; 0: use a pthread*/
+        #define LV_FS_CACHE_PREFETCH_FREERTOS 0
+
+        /*Stack size of the prefetch thread in bytes*/
+        #define LV_FS_CACHE_PREFETCH_STACK_SIZE (4 * 1024)
+
+        /*Priority of the prefetch task. Only used with FreeRTOS.*/
+        #define LV_FS_CACHE_PREFETCH_PRIO 4
+    #endif
+#endif
+
 /*API for fopen, fread, etc*/
 #define LV_USE_FS_STDIO 0
 #if LV_USE_FS_STDIO
@@ -624,6 +741,13 @@
     #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
 #endif
 
+/*API for mmap (POSIX) or esp_partition_mmap (ESP32). The files can be read in place with `lv_fs_get_ptr()`*/
+#define LV_USE_FS_MMAP 0
+#if LV_USE_FS_MMAP
+    #define LV_FS_MMAP_LETTER '\0'     /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+    #define LV_FS_MMAP_PATH ""          /*The working directory (POSIX) or the label of the data partition (ESP32)*/
+#endif
+
 /*API for CreateFile, ReadFile, etc*/
 #define LV_USE_FS_WIN32 0
 #if LV_USE_FS_WIN32
@@ -684,6 +808,10 @@
 #if LV_USE_TINY_TTF
     /*Load TTF data from files*/
     #define LV_TINY_TTF_FILE_SUPPORT 0
+
+    /*Number of glyph metrics (glyph index, box and advance) and kerning pairs cached per font. 0: don't cache*/
+    #define LV_TINY_TTF_GLYPH_CACHE_CNT 256
+    #define LV_TINY_TTF_KERN_CACHE_CNT 512
 #endif
 
 /*Rlottie library*/
@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+
+'''
+Converts a font of lv_font_conv's binary format (`--format bin`) to the mappable font format
+loaded by `lv_font_load()` (see `mmap_font_header_t` in src/font/lv_font_loader.c).
+
+The binary format is bit packed so it has to be parsed when loaded. The converted font has
+the layout of `lv_font_fmt_txt_dsc_t` with every table aligned to 4 bytes, so it's used
+in place from a mapped file (e.g. the `LV_USE_FS_MMAP` driver) or read with a single read.
+
+Layout (little endian):
+  header {"LVFM", uint16 version, uint16 glyph_dsc_size, uint32 file_size, int16 line_height,
+          int16 base_line, int8 underline_position, int8 underline_thickness, uint8 subpx,
+          uint8 bpp, uint8 bitmap_format, uint8 kern_type, uint16 kern_scale, uint16 cmap_num,
+          uint16 reserved, uint32 glyph_cnt, uint32 glyph_dsc_ofs, uint32 bitmap_ofs,
+          uint32 bitmap_size, uint32 cmap_ofs, uint32 kern_ofs},
+  the glyph descriptors, the character maps, the kerning and the bitmaps
+  (the offsets are from the start of the file)
+
+Usage:
+  font_bin_to_mmap.py <input.bin> <output> [--large]
+
+The glyph descriptors are written as the 8 byte bit fields of `lv_font_fmt_txt_glyph_dsc_t`
+if the values fit, else as with `LV_FONT_FMT_TXT_LARGE`. Use `--large` to always write the latter.
+The loader converts them if they don't match the configuration.
+'''
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"LVFM"
+VERSION = 1
+ALIGN = 4
+
+HEADER_FMT = "<4sHHIhhbbBBBBHHHIIIIII"
+CMAP_FMT = "<IHHIIHBB"
+KERN_PAIR_FMT = "<IIIB3x"
+KERN_CLASSES_FMT = "<IIIIBB2x"
+
+CMAP_FORMAT0_FULL = 0
+CMAP_SPARSE_FULL = 1
+CMAP_FORMAT0_TINY = 2
+CMAP_SPARSE_TINY = 3
+
+if sys.version_info < (3,6,0):
+  print("Python >=3.6 is required", file=sys.stderr)
+  exit(1)
+
+parser = argparse.ArgumentParser(description="Convert an LVGL binary font to the mappable font format")
+parser.add_argument("input", help="the font in lv_font_conv's binary format")
+parser.add_argument("out", help="the mappable font to write")
+parser.add_argument("--large", action="store_true",
+                    help="write the glyph descriptors as with LV_FONT_FMT_TXT_LARGE")
+args = parser.parse_args()
+
+with open(args.input, "rb") as f:
+  src = f.read()
+
+def fail(msg):
+  print(msg, file=sys.stderr)
+  exit(1)
+
+def read_label(start, label):
+  length, name = struct.unpack_from("<I4s", src, start)
+  if name != label.encode():
+    fail("Error reading '%s' label" % label)
+  return length
+
+class BitReader:
+  '''Reads the bits MSB first like `read_bits()` of the loader'''
+  def __init__(self, pos):
+    self.bit = pos * 8
+
+  def read(self, n):
+    v = 0
+    for _ in range(n):
+      byte = src[self.bit // 8] if self.bit // 8 < len(src) else 0
+      v = (v << 1) | ((byte >> (7 - self.bit % 8)) & 1)
+      self.bit += 1
+    return v
+
+  def read_signed(self, n):
+    v = self.read(n)
+    if n and v & (1 << (n - 1)):
+      v -= 1 << n
+    return v
+
+# head
+head_length = read_label(0, "head")
+(_, tables_count, _, ascent, descent, _, _, _, _, _, default_advance_width, kerning_scale,
+ index_to_loc_format, glyph_id_format, advance_width_format, bpp, xy_bits, wh_bits, advance_width_bits,
+ compression_id, subpixels_mode, _, underline_position, underline_thickness) = \
+  struct.unpack_from("<IHHHhHhHhhHHBBBBBBBBBBhH", src, 8)
+
+# cmap
+cmaps_start = head_length
+cmaps_length = read_label(cmaps_start, "cmap")
+cmap_cnt, = struct.unpack_from("<I", src, cmaps_start + 8)
+cmaps = []
+for i in range(cmap_cnt):
+  data_offset, range_start, range_length, glyph_id_start, entries, fmt = \
+    struct.unpack_from("<IIHHHB3x", src, cmaps_start + 12 + i * 16)
+  pos = cmaps_start + data_offset
+  unicode_list = None
+  ids = None
+  if fmt == CMAP_FORMAT0_FULL:
+    ids = src[pos:pos + entries] + b"\0" * max(0, range_length - entries)
+    list_length = range_length
+  elif fmt == CMAP_FORMAT0_TINY:
+    list_length = 0
+  elif fmt in (CMAP_SPARSE_FULL, CMAP_SPARSE_TINY):
+    unicode_list = src[pos:pos + entries * 2]
+    if fmt == CMAP_SPARSE_FULL:
+      ids = src[pos + entries * 2:pos + entries * 4]
+    list_length = entries
+  else:
+    fail("Unknown cmaps format type %d" % fmt)
+  cmaps.append((range_start, range_length, glyph_id_start, unicode_list, ids, list_length, fmt))
+
+# loca
+loca_start = cmaps_start + cmaps_length
+loca_length = read_label(loca_start, "loca")
+loca_count, = struct.unpack_from("<I", src, loca_start + 8)
+if index_to_loc_format == 0:
+  glyph_offset = list(struct.unpack_from("<%dH" % loca_count, src, loca_start + 12))
+elif index_to_loc_format == 1:
+  glyph_offset = list(struct.unpack_from("<%dI" % loca_count, src, loca_start + 12))
+else:
+  fail("Unknown index_to_loc_format: %d" % index_to_loc_format)
+
+# glyf: the bitmaps are aligned to bytes as in `load_glyph()` of the loader
+glyf_start = loca_start + loca_length
+glyf_length = read_label(glyf_start, "glyf")
+nbits = advance_width_bits + 2 * xy_bits + 2 * wh_bits
+glyphs = []
+bitmaps = b""
+for i in range(loca_count):
+  it = BitReader(glyf_start + glyph_offset[i])
+  adv_w = it.read(advance_width_bits) if advance_width_bits else default_advance_width
+  if advance_width_format == 0:
+    adv_w *= 16
+  ofs_x = it.read_signed(xy_bits)
+  ofs_y = it.read_signed(xy_bits)
+  box_w = it.read(wh_bits)
+  box_h = it.read(wh_bits)
+  if i == 0:
+    adv_w = box_w = box_h = ofs_x = ofs_y = 0
+
+  glyphs.append((len(bitmaps), adv_w, box_w, box_h, ofs_x, ofs_y))
+  if box_w * box_h == 0:
+    continue
+
+  next_offset = glyph_offset[i + 1] if i < loca_count - 1 else glyf_length
+  bmp_size = next_offset - glyph_offset[i] - nbits // 8
+  if nbits % 8 == 0:
+    pos = glyf_start + glyph_offset[i] + nbits // 8
+    bitmaps += src[pos:pos + bmp_size]
+  else:
+    bitmaps += bytes(it.read(8) for _ in range(bmp_size - 1))
+    bitmaps += bytes([(it.read(8 - nbits % 8) << (nbits % 8)) & 0xFF])
+
+# kern
+kern = None
+if tables_count >= 4:
+  kern_start = glyf_start + glyf_length
+  read_label(kern_start, "kern")
+  kern_format, = struct.unpack_from("<B", src, kern_start + 8)
+  pos = kern_start + 12
+  if kern_format == 0:
+    pair_cnt, = struct.unpack_from("<I", src, pos)
+    ids_size = pair_cnt * 2 * (1 if glyph_id_format == 0 else 2)
+    kern = ("pair", pair_cnt, src[pos + 4:pos + 4 + ids_size], src[pos + 4 + ids_size:pos + 4 + ids_size + pair_cnt])
+  elif kern_format == 3:
+    mapping_length, rows, cols = struct.unpack_from("<HBB", src, pos)
+    pos += 4
+    left = src[pos:pos + mapping_length]
+    right = src[pos + mapping_length:pos + 2 * mapping_length]
+    values = src[pos + 2 * mapping_length:pos + 2 * mapping_length + rows * cols]
+    kern = ("classes", mapping_length, rows, cols, left, right, values)
+  else:
+    fail("Unknown kern_format_type: %d" % kern_format)
+
+def int8(v):
+  '''Truncate like the assignment to the `int8_t` fields of `lv_font_t`'''
+  return (v & 0xFF) - 256 if v & 0x80 else v & 0xFF
+
+# Write the tables
+def fits_small(g):
+  bitmap_index, adv_w, box_w, box_h, ofs_x, ofs_y = g
+  return bitmap_index < (1 << 20) and adv_w < (1 << 12) and box_w < 256 and box_h < 256 and \
+         -128 <= ofs_x < 128 and -128 <= ofs_y < 128
+
+large = args.large or not all(fits_small(g) for g in glyphs)
+
+out = bytearray(struct.calcsize(HEADER_FMT))
+
+def add(data, align=ALIGN):
+  '''Append a table and return its offset'''
+  out.extend(b"\0" * (-len(out) % align))
+  ofs = len(out)
+  out.extend(data)
+  return ofs
+
+glyph_dsc = bytearray()
+for bitmap_index, adv_w, box_w, box_h, ofs_x, ofs_y in glyphs:
+  if large:
+    glyph_dsc += struct.pack("<IIHHhh", bitmap_index, adv_w, box_w, box_h, ofs_x, ofs_y)
+  else:
+    glyph_dsc += struct.pack("<IBBbb", bitmap_index | (adv_w << 20), box_w, box_h, ofs_x, ofs_y)
+glyph_dsc_ofs = add(glyph_dsc)
+
+cmap_tables = []
+for range_start, range_length, glyph_id_start, unicode_list, ids, list_length, fmt in cmaps:
+  unicode_list_ofs = add(unicode_list) if unicode_list is not None else 0
+  ids_ofs = add(ids) if ids is not None else 0
+  cmap_tables.append(struct.pack(CMAP_FMT, range_start, range_length, glyph_id_start,
+                                 unicode_list_ofs, ids_ofs, list_length, fmt, 0))
+cmap_ofs = add(b"".join(cmap_tables))
+
+kern_type = 0
+kern_ofs = 0
+if kern and kern[0] == "pair":
+  _, pair_cnt, ids, values = kern
+  ids_ofs = add(ids)
+  values_ofs = add(values)
+  kern_ofs = add(struct.pack(KERN_PAIR_FMT, pair_cnt, ids_ofs, values_ofs, glyph_id_format))
+  kern_type = 1
+elif kern:
+  _, mapping_length, rows, cols, left, right, values = kern
+  values_ofs = add(values)
+  left_ofs = add(left)
+  right_ofs = add(right)
+  kern_ofs = add(struct.pack(KERN_CLASSES_FMT, values_ofs, left_ofs, right_ofs, mapping_length, rows, cols))
+  kern_type = 2
+
+bitmap_ofs = add(bitmaps)
+out.extend(b"\0" * (-len(out) % ALIGN))
+
+struct.pack_into(HEADER_FMT, out, 0, MAGIC, VERSION, 16 if large else 8, len(out),
+                 ascent - descent, -descent, int8(underline_position), int8(underline_thickness), subpixels_mode,
+                 bpp, compression_id, kern_type, kerning_scale if kern else 0, len(cmaps), 0,
+                 len(glyphs), glyph_dsc_ofs, bitmap_ofs, len(bitmaps), cmap_ofs, kern_ofs)
+
+with open(args.out, "wb") as f:
+  f.write(out)
+
+print("%d glyphs, %d bytes (%s glyph descriptors)" % (len(glyphs), len(out), "large" if large else "small"))
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+
+'''
+Packs the files of a directory into an image for the data partition read by the
+`LV_USE_FS_MMAP` driver on ESP32 (see src/extra/libs/fsdrv/lv_fs_mmap.c).
+
+Layout (little endian):
+  "LVMM" magic, uint32 file count,
+  file count * {char name[56]; uint32 offset; uint32 size}, sorted by name,
+  the data of the files, each aligned to 4 bytes (offsets are from the start of the image)
+
+Usage:
+  fs_mmap_pack.py <directory> <output.bin> [--size <partition size>]
+
+Flash the image with e.g. `esptool.py write_flash <partition offset> <output.bin>`
+or `parttool.py write_partition --partition-name <label> --input <output.bin>`.
+'''
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"LVMM"
+NAME_LEN = 56
+ALIGN = 4
+
+if sys.version_info < (3,6,0):
+  print("Python >=3.6 is required", file=sys.stderr)
+  exit(1)
+
+parser = argparse.ArgumentParser(description="Pack files for the LVGL mmap file system driver")
+parser.add_argument("dir", help="the directory to pack (it will be the root of the drive)")
+parser.add_argument("out", help="the image to write")
+parser.add_argument("--size", type=lambda x: int(x, 0), default=0,
+                    help="the size of the partition to check that the image fits")
+args = parser.parse_args()
+
+names = []
+for root, dirs, files in os.walk(args.dir):
+  for f in files:
+    names.append(os.path.relpath(os.path.join(root, f), args.dir).replace(os.sep, "/"))
+names.sort()
+
+for n in names:
+  if len(n.encode()) >= NAME_LEN:
+    print("The path is too long (max. %d characters): %s" % (NAME_LEN - 1, n), file=sys.stderr)
+    exit(1)
+
+def align(x):
+  return (x + ALIGN - 1) // ALIGN * ALIGN
+
+header = MAGIC + struct.pack("<I", len(names))
+ofs = align(len(header) + len(names) * (NAME_LEN + 8))
+table = b""
+data = b""
+for n in names:
+  with open(os.path.join(args.dir, n), "rb") as f:
+    content = f.read()
+  data += b"\0" * (align(ofs + len(data)) - ofs - len(data))
+  table += struct.pack("<%dsII" % NAME_LEN, n.encode(), ofs + len(data), len(content))
+  data += content
+
+image = header + table
+image += b"\0" * (ofs - len(image)) + data
+
+if args.size and len(image) > args.size:
+  print("The image (%d bytes) doesn't fit into the partition (%d bytes)" % (len(image), args.size), file=sys.stderr)
+  exit(1)
+
+with open(args.out, "wb") as f:
+  f.write(image)
+
+print("%d files, %d bytes" % (len(names), len(image)))
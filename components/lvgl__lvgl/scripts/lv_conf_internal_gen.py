@@ -168,6 +168,12 @@ LV_EXPORT_CONST_INT(LV_DPI_DEF);
     #define LV_LOG_TRACE_ANIM       0
 #endif  /*LV_USE_LOG*/
 
+#if LV_DRAW_SW_THREAD_CNT <= 1
+    #ifndef LV_DRAW_SW_THREAD_LOCAL
+        #define LV_DRAW_SW_THREAD_LOCAL
+    #endif
+#endif  /*LV_DRAW_SW_THREAD_CNT*/
+
 
 /*If running without lv_conf.h add typedefs with default value*/
 #ifdef LV_CONF_SKIP
@@ -14,10 +14,12 @@
 #include "lv_theme.h"
 #include "../misc/lv_assert.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw.h"
 #include "../misc/lv_anim.h"
 #include "../misc/lv_timer.h"
 #include "../misc/lv_async.h"
 #include "../misc/lv_fs.h"
+#include "../misc/lv_fs_cache.h"
 #include "../misc/lv_gc.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
@@ -107,6 +109,7 @@ void lv_init(void)
 
     /*Initialize the misc modules*/
     lv_mem_init();
+    lv_mem_buf_init();
 
     _lv_timer_core_init();
 
@@ -118,6 +121,10 @@ void lv_init(void)
 
     lv_draw_init();
 
+#if LV_DRAW_SW_BLEND_SIMD
+    lv_draw_sw_blend_simd_init();
+#endif
+
 #if LV_USE_GPU_STM32_DMA2D
     /*Initialize DMA2D GPU*/
     lv_draw_stm32_dma2d_init();
@@ -196,6 +203,21 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+#if LV_USE_FONT_COMPRESSED
+    /*The cached bitmaps might be allocated outside of LVGL's heap*/
+    lv_font_fmt_txt_bitmap_cache_clear();
+#endif
+    lv_draw_sw_text_cache_clear();
+    lv_draw_sw_shadow_cache_clear();
+    lv_gradient_free_cache();
+    lv_draw_sw_thread_deinit();
+    _lv_fs_cache_deinit();
+    lv_mem_buf_deinit();
+    _lv_font_clean_up_fmt_txt();
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_cleanup();
+#endif
+
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -461,6 +483,14 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
 
+#if LV_OBJ_DRAW_LIST_SIZE
+    _lv_obj_draw_list_free(obj);
+#endif
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+    _lv_obj_layer_cache_free(obj);
+#endif
+
     /*Delete from the group*/
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
@@ -534,7 +564,7 @@ static void lv_obj_draw(lv_event_t * e)
         lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
         lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
         lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
+        lv_area_copy(&coords, _lv_obj_get_draw_coords(obj));
         coords.x1 -= w;
         coords.x2 += w;
         coords.y1 -= h;
@@ -564,7 +594,7 @@ static void lv_obj_draw(lv_event_t * e)
 #if LV_DRAW_COMPLEX
         if(clip_corner) {
             lv_draw_mask_radius_param_t * mp = lv_mem_buf_get(sizeof(lv_draw_mask_radius_param_t));
-            lv_draw_mask_radius_init(mp, &obj->coords, draw_dsc.radius, false);
+            lv_draw_mask_radius_init(mp, _lv_obj_get_draw_coords(obj), draw_dsc.radius, false);
             /*Add the mask and use `obj+8` as custom id. Don't use `obj` directly because it might be used by the user*/
             lv_draw_mask_add(mp, obj + 8);
 
@@ -608,7 +638,7 @@ static void lv_obj_draw(lv_event_t * e)
             lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
             lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
             lv_area_t coords;
-            lv_area_copy(&coords, &obj->coords);
+            lv_area_copy(&coords, _lv_obj_get_draw_coords(obj));
             coords.x1 -= w;
             coords.x2 += w;
             coords.y1 -= h;
@@ -162,6 +162,9 @@ typedef struct {
 
     lv_coord_t ext_click_pad;           /**< Extra click padding in all direction*/
     lv_coord_t ext_draw_size;           /**< EXTend the size in every direction for drawing.*/
+#if LV_OBJ_LAYER_CACHE_SIZE
+    struct _lv_obj_layer_cache_t * layer_cache; /**< The kept layer of the object, see `lv_obj_set_layer_cache()`*/
+#endif
 
     lv_scrollbar_mode_t scrollbar_mode : 2; /**< How to display scrollbars*/
     lv_scroll_snap_t scroll_snap_x : 2;     /**< Where to align the snappable children horizontally*/
@@ -176,6 +179,12 @@ typedef struct _lv_obj_t {
     struct _lv_obj_t * parent;
     _lv_obj_spec_attr_t * spec_attr;
     _lv_obj_style_t * styles;
+#if LV_OBJ_STYLE_CACHE_SIZE
+    struct _lv_obj_style_cache_t * style_cache;
+#endif
+#if LV_OBJ_DRAW_LIST_SIZE
+    struct _lv_obj_draw_list_t * draw_list;
+#endif
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
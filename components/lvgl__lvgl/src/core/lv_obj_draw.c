@@ -10,6 +10,9 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "lv_indev.h"
+#include "lv_refr.h"
+#include "../draw/sw/lv_draw_sw_thread.h"
+#include "../draw/sw/lv_draw_sw.h"
 
 /*********************
  *      DEFINES
@@ -19,14 +22,67 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_OBJ_DRAW_LIST_SIZE
+struct _lv_obj_draw_list_t {
+    lv_draw_list_t list;
+    uint32_t post_ofs;          /*Offset of the calls of the post draw events in `list`*/
+    uint32_t style_version;     /*`draw_list_style_version()` when it was recorded*/
+    uint32_t inv_frame;         /*The frame in which the object was invalidated last*/
+    lv_area_t coords;           /*The coordinates of the object when it was recorded*/
+    lv_point_t scroll;          /*The scroll position of the object when it was recorded*/
+    lv_state_t state;           /*The state of the object when it was recorded*/
+    uint16_t ref_cnt;           /*Number of threads using the list*/
+    uint8_t recorded : 1;       /*`list` is up to date unless `stale` is set*/
+    uint8_t stale : 1;          /*Invalidated while in use, reset it when released*/
+    uint8_t failed : 1;         /*Couldn't be recorded, draw it with events until invalidated*/
+};
+#endif
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+struct _lv_obj_layer_cache_t {
+    lv_img_dsc_t img;           /*The rendered layer to blend or transform. `img.data` is the buffer.*/
+    lv_area_t area;             /*The area of the layer: the object's coordinates with its extra draw size*/
+    uint32_t inv_frame;         /*The frame in which the object or a descendant was invalidated last*/
+    uint16_t ref_cnt;           /*Number of threads using the layer*/
+    uint8_t rendered : 1;       /*`img` is up to date unless `stale` is set*/
+    uint8_t stale : 1;          /*Invalidated while in use, reset it when released*/
+};
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_OBJ_DRAW_LIST_SIZE
+static bool draw_list_record(lv_obj_t * obj, struct _lv_obj_draw_list_t * dl);
+static bool draw_list_is_up_to_date(const lv_obj_t * obj, const struct _lv_obj_draw_list_t * dl);
+static uint32_t draw_list_style_version(const lv_obj_t * obj);
+static void draw_list_reset(struct _lv_obj_draw_list_t * dl);
+#endif
+#if LV_OBJ_LAYER_CACHE_SIZE
+static bool layer_cache_render(lv_obj_t * obj, struct _lv_obj_layer_cache_t * lc, lv_draw_ctx_t * draw_ctx,
+                               const lv_area_t * area);
+static void layer_cache_reset(struct _lv_obj_layer_cache_t * lc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DRAW_SW_THREAD_CNT > 1
+static LV_DRAW_SW_THREAD_LOCAL const lv_obj_t * draw_coords_obj;
+static LV_DRAW_SW_THREAD_LOCAL lv_area_t draw_coords;
+#endif
+
+#if LV_OBJ_DRAW_LIST_SIZE
+static bool draw_list_en = true;
+static uint32_t draw_list_frame;
+#endif
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+static const lv_obj_t * layer_cache_keep_obj;
+static uint32_t layer_cache_frame;
+static uint32_t layer_cache_cnt;    /*Number of objects with layer cache*/
+static uint32_t layer_cache_used;   /*Total size of the rendered layers in bytes*/
+#endif
 
 /**********************
  *      MACROS
@@ -393,6 +449,392 @@ lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+#if LV_DRAW_SW_THREAD_CNT > 1
+void _lv_obj_set_draw_coords(const lv_obj_t * obj, const lv_area_t * area)
+{
+    draw_coords_obj = area ? obj : NULL;
+    if(area) draw_coords = *area;
+}
+
+const lv_area_t * _lv_obj_get_draw_coords(const lv_obj_t * obj)
+{
+    return obj == draw_coords_obj ? &draw_coords : &obj->coords;
+}
+#endif
+
+#if LV_OBJ_DRAW_LIST_SIZE
+void lv_obj_enable_draw_list(bool en)
+{
+    draw_list_en = en;
+}
+
+struct _lv_obj_draw_list_t * _lv_obj_draw_list_acquire(lv_obj_t * obj)
+{
+    if(!draw_list_en) return NULL;
+
+    /*The bands of the screen might be drawn in parallel*/
+    lv_draw_sw_thread_lock();
+
+    struct _lv_obj_draw_list_t * dl = obj->draw_list;
+    if(dl == NULL) {
+        /*Drawn the first time. Record it if it's drawn again without changes.*/
+        dl = lv_mem_alloc(sizeof(struct _lv_obj_draw_list_t));
+        if(dl) {
+            lv_memset_00(dl, sizeof(struct _lv_obj_draw_list_t));
+            dl->inv_frame = draw_list_frame;
+            obj->draw_list = dl;
+        }
+        lv_draw_sw_thread_unlock();
+        return NULL;
+    }
+
+    if(dl->recorded && (dl->stale || !draw_list_is_up_to_date(obj, dl))) {
+        if(dl->ref_cnt) {
+            lv_draw_sw_thread_unlock();
+            return NULL;
+        }
+        draw_list_reset(dl);
+        dl->inv_frame = draw_list_frame;
+    }
+
+    if(!dl->recorded) {
+        /*Don't record objects which change in every frame (e.g. animations)*/
+        if(dl->failed || dl->inv_frame == draw_list_frame) {
+            lv_draw_sw_thread_unlock();
+            return NULL;
+        }
+
+        if(!draw_list_record(obj, dl)) {
+            lv_draw_sw_thread_unlock();
+            return NULL;
+        }
+    }
+
+    dl->ref_cnt++;
+    lv_draw_sw_thread_unlock();
+    return dl;
+}
+
+void _lv_obj_draw_list_replay(const struct _lv_obj_draw_list_t * dl, lv_draw_ctx_t * draw_ctx, bool post)
+{
+    if(post) lv_draw_list_replay(draw_ctx, &dl->list, dl->post_ofs, dl->list.size);
+    else lv_draw_list_replay(draw_ctx, &dl->list, 0, dl->post_ofs);
+}
+
+void _lv_obj_draw_list_release(struct _lv_obj_draw_list_t * dl)
+{
+    lv_draw_sw_thread_lock();
+    dl->ref_cnt--;
+    if(dl->ref_cnt == 0 && dl->stale) draw_list_reset(dl);
+    lv_draw_sw_thread_unlock();
+}
+
+void _lv_obj_draw_list_invalidate(const lv_obj_t * obj)
+{
+    lv_draw_sw_thread_lock();
+    struct _lv_obj_draw_list_t * dl = obj->draw_list;
+    if(dl) {
+        if(dl->ref_cnt) dl->stale = 1;
+        else draw_list_reset(dl);
+        dl->inv_frame = draw_list_frame;
+    }
+    lv_draw_sw_thread_unlock();
+}
+
+void _lv_obj_draw_list_free(lv_obj_t * obj)
+{
+    if(obj->draw_list == NULL) return;
+
+    lv_draw_list_reset(&obj->draw_list->list);
+    lv_mem_free(obj->draw_list);
+    obj->draw_list = NULL;
+}
+
+void _lv_obj_draw_list_next_frame(void)
+{
+    draw_list_frame++;
+}
+#endif
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    if(!en) {
+        _lv_obj_layer_cache_free(obj);
+        return;
+    }
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr->layer_cache) return;
+
+    struct _lv_obj_layer_cache_t * lc = lv_mem_alloc(sizeof(struct _lv_obj_layer_cache_t));
+    LV_ASSERT_MALLOC(lc);
+    if(lc == NULL) return;
+
+    lv_memset_00(lc, sizeof(struct _lv_obj_layer_cache_t));
+    lc->inv_frame = layer_cache_frame;
+    obj->spec_attr->layer_cache = lc;
+    layer_cache_cnt++;
+}
+
+bool _lv_obj_layer_cache_draw(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_img_dsc_t * draw_dsc,
+                              const lv_point_t * pivot)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->layer_cache == NULL) return false;
+
+    /*The layer's buffer is kept as an image so it needs the software renderer's layers*/
+    if(draw_ctx->layer_init != lv_draw_sw_layer_create) return false;
+
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+
+    /*The bands of the screen might be drawn in parallel*/
+    lv_draw_sw_thread_lock();
+
+    struct _lv_obj_layer_cache_t * lc = obj->spec_attr->layer_cache;
+    if(lc->rendered && (lc->stale || !_lv_area_is_equal(&lc->area, &area))) {
+        if(lc->ref_cnt) {
+            lv_draw_sw_thread_unlock();
+            return false;
+        }
+        layer_cache_reset(lc);
+        lc->inv_frame = layer_cache_frame;
+    }
+
+    if(!lc->rendered) {
+        /*Don't keep the layers which change in every frame (e.g. a counter on it)*/
+        if(lc->inv_frame == layer_cache_frame || !layer_cache_render(obj, lc, draw_ctx, &area)) {
+            lv_draw_sw_thread_unlock();
+            return false;
+        }
+    }
+
+    lc->ref_cnt++;
+    lv_draw_sw_thread_unlock();
+
+    draw_dsc->pivot.x = obj->coords.x1 + pivot->x - lc->area.x1;
+    draw_dsc->pivot.y = obj->coords.y1 + pivot->y - lc->area.y1;
+    lv_draw_img(draw_ctx, draw_dsc, &lc->area, &lc->img);
+    lv_draw_wait_for_finish(draw_ctx);
+
+    lv_draw_sw_thread_lock();
+    lc->ref_cnt--;
+    if(lc->ref_cnt == 0 && lc->stale) layer_cache_reset(lc);
+    lv_draw_sw_thread_unlock();
+
+    return true;
+}
+
+void _lv_obj_layer_cache_invalidate(const lv_obj_t * obj)
+{
+    if(layer_cache_cnt == 0) return;
+
+    lv_draw_sw_thread_lock();
+    const lv_obj_t * o;
+    for(o = obj; o; o = o->parent) {
+        if(o->spec_attr == NULL || o->spec_attr->layer_cache == NULL) continue;
+        if(o == layer_cache_keep_obj) continue;
+
+        struct _lv_obj_layer_cache_t * lc = o->spec_attr->layer_cache;
+        if(lc->ref_cnt) lc->stale = 1;
+        else layer_cache_reset(lc);
+        lc->inv_frame = layer_cache_frame;
+    }
+    lv_draw_sw_thread_unlock();
+}
+
+void _lv_obj_layer_cache_keep(const lv_obj_t * obj)
+{
+    layer_cache_keep_obj = obj;
+}
+
+void _lv_obj_layer_cache_free(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->layer_cache == NULL) return;
+
+    layer_cache_reset(obj->spec_attr->layer_cache);
+    lv_mem_free(obj->spec_attr->layer_cache);
+    obj->spec_attr->layer_cache = NULL;
+    layer_cache_cnt--;
+}
+
+void _lv_obj_layer_cache_next_frame(void)
+{
+    layer_cache_frame++;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_OBJ_DRAW_LIST_SIZE
+/**
+ * Record the draw calls of the draw events of an object
+ * @param obj       pointer to an object
+ * @param dl        pointer to the reset draw list of the object
+ * @return          true: recorded; false: the object can't be recorded
+ */
+static bool draw_list_record(lv_obj_t * obj, struct _lv_obj_draw_list_t * dl)
+{
+    /*Protect the list from being reset by the draw events*/
+    dl->ref_cnt++;
+
+    lv_draw_list_recorder_t rec;
+    lv_draw_list_record_start(&rec, &dl->list, LV_OBJ_DRAW_LIST_SIZE);
+
+    /*Record the whole object, not only the currently redrawn area*/
+    lv_area_t clip_area;
+    lv_obj_get_coords(obj, &clip_area);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&clip_area, ext_draw_size, ext_draw_size);
+    rec.base_draw.clip_area = &clip_area;
+    rec.base_draw.buf_area = &clip_area;
+
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, &rec.base_draw);
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN, &rec.base_draw);
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, &rec.base_draw);
+
+    /*The masks added for the children (e.g. to clip the corners) can't be replayed*/
+    dl->post_ofs = dl->list.size;
+    bool res = lv_draw_list_record_check(&rec);
+
+    lv_event_send(obj, LV_EVENT_DRAW_POST_BEGIN, &rec.base_draw);
+    lv_event_send(obj, LV_EVENT_DRAW_POST, &rec.base_draw);
+    lv_event_send(obj, LV_EVENT_DRAW_POST_END, &rec.base_draw);
+
+    if(!lv_draw_list_record_end(&rec)) res = false;
+
+    dl->ref_cnt--;
+    if(!res) {
+        lv_draw_list_reset(&dl->list);
+        dl->failed = 1;
+        return false;
+    }
+
+    dl->recorded = 1;
+    dl->style_version = draw_list_style_version(obj);
+    dl->coords = obj->coords;
+    dl->scroll.x = lv_obj_get_scroll_x(obj);
+    dl->scroll.y = lv_obj_get_scroll_y(obj);
+    dl->state = obj->state;
+    return true;
+}
+
+/**
+ * Check if an object would be drawn the same way as its draw list was recorded.
+ * Changes in the object usually invalidate it, but moving or scrolling its parent doesn't.
+ * @param obj       pointer to an object
+ * @param dl        pointer to the recorded draw list of the object
+ * @return          true: the list can be replayed
+ */
+static bool draw_list_is_up_to_date(const lv_obj_t * obj, const struct _lv_obj_draw_list_t * dl)
+{
+    return dl->style_version == draw_list_style_version(obj) &&
+           dl->state == obj->state &&
+           _lv_area_is_equal(&dl->coords, &obj->coords) &&
+           dl->scroll.x == lv_obj_get_scroll_x(obj) &&
+           dl->scroll.y == lv_obj_get_scroll_y(obj);
+}
+
+/**
+ * Get the version of the styles an object can be drawn with: its own styles and, for the inherited properties, the
+ * styles of its parents. Modifying any other style doesn't change it.
+ * @param obj       pointer to an object
+ * @return          the highest `_lv_obj_get_style_version()` of the object and its parents
+ */
+static uint32_t draw_list_style_version(const lv_obj_t * obj)
+{
+    uint32_t version = 0;
+    while(obj) {
+        uint32_t v = _lv_obj_get_style_version(obj);
+        if(v > version) version = v;
+        obj = lv_obj_get_parent(obj);
+    }
+
+    return version;
+}
+
+static void draw_list_reset(struct _lv_obj_draw_list_t * dl)
+{
+    lv_draw_list_reset(&dl->list);
+    dl->recorded = 0;
+    dl->stale = 0;
+    dl->failed = 0;
+}
+#endif
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+/**
+ * Render an object with its children into a new layer and keep it
+ * @param obj       pointer to an object
+ * @param lc        pointer to the reset layer cache of the object
+ * @param draw_ctx  pointer to the draw context which draws the object
+ * @param area      the area of the layer
+ * @return          true: rendered; false: the layer can't be kept
+ */
+static bool layer_cache_render(lv_obj_t * obj, struct _lv_obj_layer_cache_t * lc, lv_draw_ctx_t * draw_ctx,
+                               const lv_area_t * area)
+{
+#if LV_DRAW_COMPLEX
+    /*The masks of the ancestors (e.g. clip corner) would be applied on the kept layer too*/
+    if(lv_draw_mask_is_any(area)) return false;
+#endif
+
+    lv_draw_layer_flags_t flags = LV_DRAW_LAYER_FLAG_HAS_ALPHA;
+    if(_lv_area_is_in(area, &obj->coords, 0)) {
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_COVER;
+        info.area = area;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_COVER) flags = LV_DRAW_LAYER_FLAG_NONE;
+    }
+    if(LV_COLOR_SCREEN_TRANSP == 0 && (flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA)) return false;
+
+    uint32_t px_size = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t size = lv_area_get_size(area) * px_size;
+    if(layer_cache_used + size > LV_OBJ_LAYER_CACHE_SIZE) return false;
+
+    /*Render the whole object, not only the currently redrawn area*/
+    lv_draw_layer_ctx_t * layer_ctx = lv_draw_layer_create(draw_ctx, area, flags);
+    if(layer_ctx == NULL) return false;
+
+    /*Protect the layer from being reset by the draw events*/
+    lc->ref_cnt++;
+    lv_obj_redraw(draw_ctx, obj);
+    lv_draw_wait_for_finish(draw_ctx);
+    lc->ref_cnt--;
+
+    /*Take the buffer from the layer before it's destroyed*/
+    lc->img.data = layer_ctx->buf;
+    layer_ctx->buf = NULL;
+    lv_draw_layer_destroy(draw_ctx, layer_ctx);
+
+    lc->img.header.always_zero = 0;
+    lc->img.header.w = lv_area_get_width(area);
+    lc->img.header.h = lv_area_get_height(area);
+    lc->img.header.cf = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    lc->img.data_size = size;
+    lc->area = *area;
+    lc->rendered = 1;
+    layer_cache_used += size;
+    return true;
+}
+
+static void layer_cache_reset(struct _lv_obj_layer_cache_t * lc)
+{
+    if(lc->rendered) {
+        /*The image decoder might have cached the layer by the address of `img`*/
+        lv_img_cache_invalidate_src(&lc->img);
+        lv_mem_free((void *)lc->img.data);
+        lc->img.data = NULL;
+        layer_cache_used -= lc->img.data_size;
+    }
+    lc->rendered = 0;
+    lc->stale = 0;
+}
+#endif
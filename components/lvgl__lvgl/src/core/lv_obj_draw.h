@@ -161,6 +161,130 @@ lv_coord_t _lv_obj_get_ext_draw_size(const struct _lv_obj_t * obj);
 
 lv_layer_type_t _lv_obj_get_layer_type(const struct _lv_obj_t * obj);
 
+#if LV_DRAW_SW_THREAD_CNT > 1
+/**
+ * Make the base object's draw events of `obj` use `area` instead of its coordinates on the calling thread.
+ * While the bands of the screen are drawn in parallel the widgets can't change their `coords` temporarily for that.
+ * @param obj       pointer to an object
+ * @param area      the area to draw the object's background to, or NULL to use its coordinates again
+ */
+void _lv_obj_set_draw_coords(const struct _lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Get the area to draw the background of an object to on the calling thread.
+ * @param obj       pointer to an object
+ * @return          the area set by `_lv_obj_set_draw_coords()` or the coordinates of the object
+ */
+const lv_area_t * _lv_obj_get_draw_coords(const struct _lv_obj_t * obj);
+#else
+#define _lv_obj_get_draw_coords(obj) (&(obj)->coords)
+#endif
+
+#if LV_OBJ_DRAW_LIST_SIZE
+struct _lv_obj_draw_list_t;
+
+/**
+ * Enable or disable replaying the recorded draw calls of the objects.
+ * The recorded calls are dropped when the objects are invalidated even if replaying is disabled,
+ * so it can be enabled again any time.
+ * @param en        true: replay the recorded calls (default); false: always draw the objects with the draw events
+ */
+void lv_obj_enable_draw_list(bool en);
+
+/**
+ * Get the recorded draw calls of an object to replay them instead of sending the draw events.
+ * The calls are recorded when the object is drawn in a frame in which it wasn't invalidated.
+ * @param obj       pointer to an object
+ * @return          the draw list of the object, or NULL if the object should be drawn with the draw events.
+ *                  Release it with `_lv_obj_draw_list_release()` after drawing the object.
+ */
+struct _lv_obj_draw_list_t * _lv_obj_draw_list_acquire(struct _lv_obj_t * obj);
+
+/**
+ * Replay the draw calls of an object recorded from its draw events
+ * @param dl        pointer to a draw list returned by `_lv_obj_draw_list_acquire()`
+ * @param draw_ctx  pointer to a draw context to draw with
+ * @param post      false: replay the calls of the `LV_EVENT_DRAW_MAIN...` events;
+ *                  true: replay the calls of the `LV_EVENT_DRAW_POST...` events
+ */
+void _lv_obj_draw_list_replay(const struct _lv_obj_draw_list_t * dl, lv_draw_ctx_t * draw_ctx, bool post);
+
+/**
+ * Release a draw list got by `_lv_obj_draw_list_acquire()`
+ * @param dl        pointer to a draw list
+ */
+void _lv_obj_draw_list_release(struct _lv_obj_draw_list_t * dl);
+
+/**
+ * Drop the recorded draw calls of an object because it will look differently
+ * @param obj       pointer to an object
+ */
+void _lv_obj_draw_list_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Free the draw list of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_draw_list_free(struct _lv_obj_t * obj);
+
+/**
+ * Count the rendered frames to know which objects were invalidated in the current frame.
+ * Called when a display finished rendering its invalidated areas.
+ */
+void _lv_obj_draw_list_next_frame(void);
+#endif
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+struct _lv_obj_layer_cache_t;
+
+/**
+ * Keep the rendered layer of an object (used for `opa_layered`, `blend_mode` and transformations) between the frames.
+ * Changing only these properties (e.g. in a fade or zoom animation) then blends or transforms the kept layer
+ * instead of rendering the object and its children again. The layer is rendered again when the object
+ * or one of its descendants is invalidated.
+ * The size of all the kept layers is limited by `LV_OBJ_LAYER_CACHE_SIZE`. Works only with the software renderer.
+ * @param obj       pointer to an object
+ * @param en        true: keep the layer of the object; false: render it in every frame and free the kept layer
+ */
+void lv_obj_set_layer_cache(struct _lv_obj_t * obj, bool en);
+
+/**
+ * Draw an object from its kept layer
+ * @param obj       pointer to an object with layer type other than `LV_LAYER_TYPE_NONE`
+ * @param draw_ctx  pointer to a draw context to draw with
+ * @param draw_dsc  the descriptor to blend or transform the layer with. Its pivot is set here.
+ * @param pivot     the pivot of the transformation relative to the object's coordinates
+ * @return          true: drawn; false: the object has no kept layer, draw it with a temporary layer
+ */
+bool _lv_obj_layer_cache_draw(struct _lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_img_dsc_t * draw_dsc,
+                              const lv_point_t * pivot);
+
+/**
+ * Drop the kept layers of an object and its ancestors because the object will look differently
+ * @param obj       pointer to an object
+ */
+void _lv_obj_layer_cache_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Keep the layer of an object while it's invalidated only because of a property applied on the layer
+ * (e.g. `transform_zoom`). The layers of its ancestors are still dropped.
+ * @param obj       pointer to an object, or NULL to drop the layer of every invalidated object again
+ */
+void _lv_obj_layer_cache_keep(const struct _lv_obj_t * obj);
+
+/**
+ * Free the kept layer of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_layer_cache_free(struct _lv_obj_t * obj);
+
+/**
+ * Count the rendered frames to know which objects were invalidated in the current frame.
+ * Called when a display finished rendering its invalidated areas.
+ */
+void _lv_obj_layer_cache_next_frame(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
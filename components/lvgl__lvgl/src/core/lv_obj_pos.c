@@ -838,6 +838,15 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_DRAW_LIST_SIZE
+    /*The object will look differently so record its draw calls again*/
+    _lv_obj_draw_list_invalidate(obj);
+#endif
+#if LV_OBJ_LAYER_CACHE_SIZE
+    /*The kept layers of the object and its ancestors have to be rendered again*/
+    _lv_obj_layer_cache_invalidate(obj);
+#endif
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -9,12 +9,19 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "../misc/lv_gc.h"
+#include "../draw/sw/lv_draw_sw_thread.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+#if (LV_OBJ_STYLE_CACHE_SIZE & (LV_OBJ_STYLE_CACHE_SIZE - 1)) != 0 || LV_OBJ_STYLE_CACHE_SIZE > 256
+#error "LV_OBJ_STYLE_CACHE_SIZE must be a power of 2 and not larger than 256"
+#endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +42,21 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+typedef struct {
+    lv_style_value_t value;     /*Valid only if `res == LV_STYLE_RES_FOUND`*/
+    uint16_t prop;              /*`LV_STYLE_PROP_INV` if the entry is empty*/
+    lv_state_t state;
+    uint8_t part;               /*The index of the part, i.e. `part >> 16`*/
+    lv_style_res_t res;
+} style_cache_entry_t;
+
+struct _lv_obj_style_cache_t {
+    uint32_t style_version;     /*`_lv_obj_get_style_version()` when the entries were added*/
+    style_cache_entry_t entries[LV_OBJ_STYLE_CACHE_SIZE];
+};
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +67,9 @@ typedef enum {
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop,
+                                      lv_style_value_t * v);
+static void style_cache_invalidate(lv_obj_t * obj);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -59,6 +84,9 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_OBJ_STYLE_CACHE_SIZE
+static bool style_cache_en = true;
+#endif
 
 /**********************
  *      MACROS
@@ -99,6 +127,7 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
     lv_memset_00(&obj->styles[i], sizeof(_lv_obj_style_t));
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
+    style_cache_invalidate(obj);
 
     lv_obj_refresh_style(obj, selector, LV_STYLE_PROP_ANY);
 }
@@ -145,6 +174,18 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         /*The style from the current `i` index is removed, so `i` points to the next style.
          *Therefore it doesn't needs to be incremented*/
     }
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*The properties aren't cached for objects without styles*/
+    if(obj->style_cnt == 0) {
+        lv_mem_free(obj->style_cache);
+        obj->style_cache = NULL;
+    }
+    else if(deleted) {
+        style_cache_invalidate(obj);
+    }
+#endif
+
     if(deleted && prop != LV_STYLE_PROP_INV) {
         lv_obj_refresh_style(obj, part, prop);
     }
@@ -168,9 +209,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
+    style_cache_invalidate(obj);
 
-    lv_obj_invalidate(obj);
+    if(!style_refr) return;
 
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
@@ -179,6 +220,15 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_LAYER_REFR);
 
+#if LV_OBJ_LAYER_CACHE_SIZE
+    /*The properties applied when the layer is blended don't change the kept layer of the object*/
+    bool is_layer_prop = part == LV_PART_MAIN && prop != LV_STYLE_PROP_ANY &&
+                         (is_layer_refr || prop == LV_STYLE_TRANSFORM_PIVOT_X || prop == LV_STYLE_TRANSFORM_PIVOT_Y);
+    if(is_layer_prop) _lv_obj_layer_cache_keep(obj);
+#endif
+
+    lv_obj_invalidate(obj);
+
     if(is_layout_refr) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -213,6 +263,10 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
             refresh_children_style(obj);
         }
     }
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+    if(is_layer_prop) _lv_obj_layer_cache_keep(NULL);
+#endif
 }
 
 void lv_obj_enable_style_refresh(bool en)
@@ -220,13 +274,20 @@ void lv_obj_enable_style_refresh(bool en)
     style_refr = en;
 }
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+void lv_obj_enable_style_cache(bool en)
+{
+    style_cache_en = en;
+}
+#endif
+
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
     lv_style_value_t value_act;
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
     while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
+        found = get_prop_cached(obj, part, prop, &value_act);
         if(found == LV_STYLE_RES_FOUND) break;
         if(!inheritable) break;
 
@@ -452,6 +513,18 @@ _lv_style_state_cmp_t _lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t sta
     return res;
 }
 
+uint32_t _lv_obj_get_style_version(const lv_obj_t * obj)
+{
+    uint32_t version = 0;
+    uint32_t i;
+    for(i = 0; i < obj->style_cnt; i++) {
+        uint32_t v = _lv_style_get_version(obj->styles[i].style);
+        if(v > version) version = v;
+    }
+
+    return version;
+}
+
 void lv_obj_fade_in(lv_obj_t * obj, uint32_t time, uint32_t delay)
 {
     lv_anim_t a;
@@ -567,6 +640,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
     lv_style_init(obj->styles[i].style);
     obj->styles[i].is_local = 1;
     obj->styles[i].selector = selector;
+    style_cache_invalidate(obj);
     return obj->styles[i].style;
 }
 
@@ -599,6 +673,7 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     lv_style_init(obj->styles[0].style);
     obj->styles[0].is_trans = 1;
     obj->styles[0].selector = selector;
+    style_cache_invalidate(obj);
     return &obj->styles[0];
 }
 
@@ -670,6 +745,80 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_sty
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+/**
+ * Get a property of an object's own styles like `get_prop_core` but remember the result
+ * for the object's current state.
+ * @param obj   pointer to an object
+ * @param part  the part whose property should be get
+ * @param prop  the property to get
+ * @param v     store the value here if it's found
+ * @return      the result of `get_prop_core`
+ */
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop,
+                                      lv_style_value_t * v)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*The values without the transitions are needed only while a transition is created*/
+    if(!style_cache_en || obj->skip_trans || obj->style_cnt == 0) return get_prop_core(obj, part, prop, v);
+
+    struct _lv_obj_style_cache_t * cache = obj->style_cache;
+    uint32_t style_version = _lv_obj_get_style_version(obj);
+
+    /*While drawing with multiple threads an object can be drawn by more threads at the same time,
+     *so only read the cache*/
+    bool read_only = lv_draw_sw_thread_is_active();
+    if(read_only && (cache == NULL || cache->style_version != style_version)) return get_prop_core(obj, part, prop, v);
+
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(struct _lv_obj_style_cache_t));
+        if(cache == NULL) return get_prop_core(obj, part, prop, v);
+        ((lv_obj_t *)obj)->style_cache = cache;
+        cache->style_version = style_version - 1;
+    }
+
+    /*One of the object's styles has changed since the entries were added.
+     *A modified style gets a higher version than any other style, so it raises the highest version.*/
+    if(cache->style_version != style_version) {
+        lv_memset_00(cache->entries, sizeof(cache->entries));
+        cache->style_version = style_version;
+    }
+
+    uint8_t part_idx = (uint8_t)(part >> 16);
+    uint32_t key = ((uint32_t)part_idx << 16) | prop;
+    style_cache_entry_t * e = &cache->entries[((key * 2654435761U) >> 24) & (LV_OBJ_STYLE_CACHE_SIZE - 1)];
+    if(e->prop == prop && e->part == part_idx && e->state == obj->state) {
+        if(e->res == LV_STYLE_RES_FOUND) *v = e->value;
+        return e->res;
+    }
+
+    lv_style_res_t res = get_prop_core(obj, part, prop, v);
+    if(read_only) return res;
+
+    e->prop = prop;
+    e->part = part_idx;
+    e->state = obj->state;
+    e->res = res;
+    if(res == LV_STYLE_RES_FOUND) e->value = *v;
+    return res;
+#else
+    return get_prop_core(obj, part, prop, v);
+#endif
+}
+
+/**
+ * Forget the cached style properties of an object. Called when the list of styles changes or the object's style
+ * is refreshed. Modified properties of the styles themselves are detected from the version of the object's styles.
+ * @param obj   pointer to an object
+ */
+static void style_cache_invalidate(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    if(obj->style_cache) lv_memset_00(obj->style_cache->entries, sizeof(obj->style_cache->entries));
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -27,6 +27,9 @@ extern "C" {
 /*Can't include lv_obj.h because it includes this header file*/
 struct _lv_obj_t;
 
+/*The style property lookups cached in an object. Defined in lv_obj_style.c*/
+struct _lv_obj_style_cache_t;
+
 typedef enum {
     _LV_STYLE_STATE_CMP_SAME,           /*The style properties in the 2 states are identical*/
     _LV_STYLE_STATE_CMP_DIFF_REDRAW,    /*The differences can be shown with a simple redraw*/
@@ -118,6 +121,15 @@ void lv_obj_refresh_style(struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_
  */
 void lv_obj_enable_style_refresh(bool en);
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+/**
+ * Enable or disable caching the style property lookups of the objects.
+ * The cached values are kept up to date even if caching is disabled, so it can be enabled again any time.
+ * @param en        true: use the cache (default); false: always look up the properties in the styles
+ */
+void lv_obj_enable_style_cache(bool en);
+#endif
+
 /**
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
@@ -180,6 +192,14 @@ void _lv_obj_style_create_transition(struct _lv_obj_t * obj, lv_part_t part, lv_
  */
 _lv_style_state_cmp_t _lv_obj_style_state_compare(struct _lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+/**
+ * Get the highest version of the styles added to an object, including its local and transition styles.
+ * It changes when any of these styles is modified (see `_lv_style_get_version()`), but not when other styles are.
+ * @param obj   pointer to an object
+ * @return      the version of the object's styles
+ */
+uint32_t _lv_obj_get_style_version(const struct _lv_obj_t * obj);
+
 /**
  * Fade in an an object and all its children.
  * @param obj       the object to fade in
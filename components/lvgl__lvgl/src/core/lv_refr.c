@@ -16,6 +16,7 @@
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../extra/others/snapshot/lv_snapshot.h"
 
@@ -48,6 +49,12 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+/*The most top objects of the screens which are not covered by others in the area being drawn*/
+typedef struct {
+    lv_obj_t * act_scr;
+    lv_obj_t * prev_scr;
+} top_objs_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -56,6 +63,7 @@ static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_area_part_objs(lv_draw_ctx_t * draw_ctx, void * user_data);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
@@ -74,7 +82,7 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
-static lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_DRAW_SW_THREAD_LOCAL lv_disp_t * disp_refr; /*Display being refreshed*/
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -141,12 +149,24 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     /*If the object is visible on the current clip area OR has overflow visible draw it.
      *With overflow visible drawing should happen to apply the masks which might affect children */
     bool should_draw = com_clip_res || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+#if LV_OBJ_DRAW_LIST_SIZE
+    /*Replay the recorded draw calls instead of sending the draw events if the object hasn't changed*/
+    struct _lv_obj_draw_list_t * draw_list = should_draw ? _lv_obj_draw_list_acquire(obj) : NULL;
+#endif
     if(should_draw) {
         draw_ctx->clip_area = &clip_coords_for_obj;
 
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+#if LV_OBJ_DRAW_LIST_SIZE
+        if(draw_list) {
+            _lv_obj_draw_list_replay(draw_list, draw_ctx, false);
+        }
+        else
+#endif
+        {
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+        }
 #if LV_USE_REFR_DEBUG
         lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
         lv_draw_rect_dsc_t draw_dsc;
@@ -188,9 +208,18 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         draw_ctx->clip_area = &clip_coords_for_obj;
 
         /*If all the children are redrawn make 'post draw' draw*/
-        lv_event_send(obj, LV_EVENT_DRAW_POST_BEGIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_POST, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_POST_END, draw_ctx);
+#if LV_OBJ_DRAW_LIST_SIZE
+        if(draw_list) {
+            _lv_obj_draw_list_replay(draw_list, draw_ctx, true);
+            _lv_obj_draw_list_release(draw_list);
+        }
+        else
+#endif
+        {
+            lv_event_send(obj, LV_EVENT_DRAW_POST_BEGIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_POST, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_POST_END, draw_ctx);
+        }
     }
 
     draw_ctx->clip_area = clip_area_ori;
@@ -354,11 +383,16 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     }
 
     lv_mem_buf_free_all();
+
+    /*With the arena the buffers of the circle cache and the font decompression are kept
+     *to not call the heap in every frame*/
+#if LV_MEM_BUF_ARENA_SIZE == 0
     _lv_font_clean_up_fmt_txt();
 
 #if LV_DRAW_COMPLEX
     _lv_draw_mask_cleanup();
 #endif
+#endif
 
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     lv_obj_t * perf_label = perf_monitor.perf_label;
@@ -622,6 +656,13 @@ static void refr_invalid_areas(void)
     }
 
     disp_refr->rendering_in_progress = false;
+
+#if LV_OBJ_DRAW_LIST_SIZE
+    _lv_obj_draw_list_next_frame();
+#endif
+#if LV_OBJ_LAYER_CACHE_SIZE
+    _lv_obj_layer_cache_next_frame();
+#endif
 }
 
 /**
@@ -725,15 +766,35 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 #endif
     }
 
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
+    top_objs_t top_objs;
 
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top_objs.act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top_objs.prev_scr = NULL;
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
+        top_objs.prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
     }
 
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_render(disp_refr->driver, draw_ctx, refr_area_part_objs, &top_objs);
+#else
+    refr_area_part_objs(draw_ctx, &top_objs);
+#endif
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the background and the objects of the display into the `clip_area` of a draw context
+ * @param draw_ctx pointer to a draw context
+ * @param user_data pointer to a `top_objs_t`
+ */
+static void refr_area_part_objs(lv_draw_ctx_t * draw_ctx, void * user_data)
+{
+    top_objs_t * top_objs = user_data;
+    lv_obj_t * top_act_scr = top_objs->act_scr;
+    lv_obj_t * top_prev_scr = top_objs->prev_scr;
+
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         lv_area_t a;
@@ -794,8 +855,6 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
-
-    draw_buf_flush(disp_refr);
 }
 
 /**
@@ -981,23 +1040,6 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         lv_res_t res = layer_get_area(draw_ctx, obj, layer_type, &layer_area_full);
         if(res != LV_RES_OK) return;
 
-        lv_draw_layer_flags_t flags = LV_DRAW_LAYER_FLAG_HAS_ALPHA;
-
-        if(_lv_area_is_in(&layer_area_full, &obj->coords, 0)) {
-            lv_cover_check_info_t info;
-            info.res = LV_COVER_RES_COVER;
-            info.area = &layer_area_full;
-            lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
-            if(info.res == LV_COVER_RES_COVER) flags &= ~LV_DRAW_LAYER_FLAG_HAS_ALPHA;
-        }
-
-        if(layer_type == LV_LAYER_TYPE_SIMPLE) flags |= LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE;
-
-        lv_draw_layer_ctx_t * layer_ctx = lv_draw_layer_create(draw_ctx, &layer_area_full, flags);
-        if(layer_ctx == NULL) {
-            LV_LOG_WARN("Couldn't create a new layer context");
-            return;
-        }
         lv_point_t pivot = {
             .x = lv_obj_get_style_transform_pivot_x(obj, 0),
             .y = lv_obj_get_style_transform_pivot_y(obj, 0)
@@ -1021,6 +1063,28 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
         draw_dsc.antialias = disp_refr->driver->antialiasing;
 
+#if LV_OBJ_LAYER_CACHE_SIZE
+        /*Only blend or transform the kept layer if neither the object nor its children changed*/
+        if(_lv_obj_layer_cache_draw(obj, draw_ctx, &draw_dsc, &pivot)) return;
+#endif
+
+        lv_draw_layer_flags_t flags = LV_DRAW_LAYER_FLAG_HAS_ALPHA;
+
+        if(_lv_area_is_in(&layer_area_full, &obj->coords, 0)) {
+            lv_cover_check_info_t info;
+            info.res = LV_COVER_RES_COVER;
+            info.area = &layer_area_full;
+            lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+            if(info.res == LV_COVER_RES_COVER) flags &= ~LV_DRAW_LAYER_FLAG_HAS_ALPHA;
+        }
+
+        if(layer_type == LV_LAYER_TYPE_SIMPLE) flags |= LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE;
+
+        lv_draw_layer_ctx_t * layer_ctx = lv_draw_layer_create(draw_ctx, &layer_area_full, flags);
+        if(layer_ctx == NULL) {
+            LV_LOG_WARN("Couldn't create a new layer context");
+            return;
+        }
         if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
             layer_ctx->area_act = layer_ctx->area_full;
             layer_ctx->area_act.y2 = layer_ctx->area_act.y1 + layer_ctx->max_row_with_no_alpha - 1;
@@ -1113,70 +1177,6 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
     area->x1 = drv->hor_res - tmp_coord - 1;
 }
 
-static void LV_ATTRIBUTE_FAST_MEM draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
-                                                     lv_color_t * orig_color_p, lv_color_t * rot_buf)
-{
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
-        }
-    }
-}
-
-/**
- * Helper function for draw_buf_rotate_90_sqr. Given a list of four numbers, rotate the entire list to the left.
- */
-static inline void draw_buf_rotate4(lv_color_t * a, lv_color_t * b, lv_color_t * c, lv_color_t * d)
-{
-    lv_color_t tmp;
-    tmp = *a;
-    *a = *b;
-    *b = *c;
-    *c = *d;
-    *d = tmp;
-}
-
-/**
- * Rotate a square image 90/270 degrees in place.
- * @note inspired by https://stackoverflow.com/a/43694906
- */
-static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color_p)
-{
-    for(lv_coord_t i = 0; i < w / 2; i++) {
-        for(lv_coord_t j = 0; j < (w + 1) / 2; j++) {
-            lv_coord_t inv_i = (w - 1) - i;
-            lv_coord_t inv_j = (w - 1) - j;
-            if(is_270) {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[inv_j * w + i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[j * w + inv_i]
-                );
-            }
-            else {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[j * w + inv_i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[inv_j * w + i]
-                );
-            }
-
-        }
-    }
-}
-
 /**
  * Rotate the draw_buf to the display's native orientation.
  */
@@ -1218,7 +1218,7 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             if((row == 0) && (area_h >= area_w)) {
                 /*Rotate the initial area as a square*/
                 height = area_w;
-                draw_buf_rotate_90_sqr(drv->rotated == LV_DISP_ROT_270, area_w, color_p);
+                lv_draw_sw_rotate_sqr(color_p, area_w, area_w, drv->rotated);
                 if(drv->rotated == LV_DISP_ROT_90) {
                     area->x1 = init_y_off;
                     area->x2 = init_y_off + area_w - 1;
@@ -1231,7 +1231,7 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             else {
                 /*Rotate other areas using a maximum buffer size*/
                 if(rot_buf == NULL) rot_buf = lv_mem_buf_get(LV_DISP_ROT_MAX_BUF);
-                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, rot_buf);
+                lv_draw_sw_rotate(color_p, rot_buf, area_w, height, area_w, height, drv->rotated);
 
                 if(drv->rotated == LV_DISP_ROT_90) {
                     area->x1 = init_y_off + row;
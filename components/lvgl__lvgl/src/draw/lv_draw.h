@@ -211,6 +211,7 @@ void lv_draw_wait_for_finish(lv_draw_ctx_t * draw_ctx);
 /**********************
  *   POST INCLUDES
  *********************/
+#include "lv_draw_list.h"
 
 #ifdef __cplusplus
 } /*extern "C"*/
@@ -3,6 +3,7 @@ CSRCS += lv_draw.c
 CSRCS += lv_draw_img.c
 CSRCS += lv_draw_label.c
 CSRCS += lv_draw_line.c
+CSRCS += lv_draw_list.c
 CSRCS += lv_draw_mask.c
 CSRCS += lv_draw_rect.c
 CSRCS += lv_draw_transform.c
@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
+#include "sw/lv_draw_sw_thread.h"
 
 /*********************
  *      DEFINES
@@ -30,6 +31,7 @@ static lv_res_t /* LV_ATTRIBUTE_FAST_MEM */ decode_and_draw(lv_draw_ctx_t * draw
                                                             const lv_area_t * coords, const void * src);
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
+static void draw_ref(_lv_img_cache_entry_t * cache);
 static void draw_cleanup(_lv_img_cache_entry_t * cache);
 
 /**********************
@@ -243,9 +245,15 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
 {
     if(draw_dsc->opa <= LV_OPA_MIN) return LV_RES_OK;
 
+    /*The cache entries are shared by the drawing threads. Only opening the image and reading its lines need the
+     *lock, the entry is referenced while the image is drawn so that the other threads don't close it.*/
+    lv_draw_sw_thread_lock();
     _lv_img_cache_entry_t * cdsc = _lv_img_cache_open(src, draw_dsc->recolor, draw_dsc->frame_id);
 
-    if(cdsc == NULL) return LV_RES_INV;
+    if(cdsc == NULL) {
+        lv_draw_sw_thread_unlock();
+        return LV_RES_INV;
+    }
 
     lv_img_cf_t cf;
     if(lv_img_cf_is_chroma_keyed(cdsc->dec_dsc.header.cf)) cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
@@ -262,14 +270,24 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         }
     }
 
-    if(cdsc->dec_dsc.error_msg != NULL) {
+    const uint8_t * img_data = cdsc->dec_dsc.img_data;
+    draw_ref(cdsc);
+
+    /*If the pixels are read right from the constant data of the image the cache entry is not needed while drawing*/
+    if(cdsc->dec_dsc.error_msg == NULL && img_data && lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE &&
+       img_data == ((const lv_img_dsc_t *)src)->data) {
+        draw_cleanup(cdsc);
+        cdsc = NULL;
+    }
+
+    if(cdsc && cdsc->dec_dsc.error_msg != NULL) {
         LV_LOG_WARN("Image draw error");
 
         show_error(draw_ctx, coords, cdsc->dec_dsc.error_msg);
     }
     /*The decoder could open the image and gave the entire uncompressed image.
      *Just draw it!*/
-    else if(cdsc->dec_dsc.img_data) {
+    else if(img_data) {
         lv_area_t map_area_rot;
         lv_area_copy(&map_area_rot, coords);
         if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
@@ -295,7 +313,7 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
 
         const lv_area_t * clip_area_ori = draw_ctx->clip_area;
         draw_ctx->clip_area = &clip_com;
-        lv_draw_img_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, cf);
+        lv_draw_img_decoded(draw_ctx, draw_dsc, coords, img_data, cf);
         draw_ctx->clip_area = clip_area_ori;
     }
     /*The whole uncompressed image is not available. Try to read it line-by-line*/
@@ -327,9 +345,12 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
             union_ok = _lv_area_intersect(&mask_line, clip_area_ori, &line);
             if(union_ok == false) continue;
 
+            /*The decoder's state is shared, but the line is read into the thread's own buffer*/
+            lv_draw_sw_thread_lock();
             read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
+            if(read_res != LV_RES_OK) lv_img_decoder_close(&cdsc->dec_dsc);
+            lv_draw_sw_thread_unlock();
             if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 lv_mem_buf_release(buf);
                 draw_cleanup(cdsc);
@@ -364,12 +385,36 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
     lv_draw_label(draw_ctx, &label_dsc, coords, msg, NULL);
 }
 
+/**
+ * Keep an opened image for drawing it. Called with the lock of the drawing threads held.
+ * The cached images are referenced and the lock is released. Without caching all the images are opened in the same
+ * entry, so the lock is kept until the image is drawn.
+ */
+static void draw_ref(_lv_img_cache_entry_t * cache)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    cache->ref_cnt++;
+    lv_draw_sw_thread_unlock();
+#else
+    LV_UNUSED(cache);
+#endif
+}
+
+/**
+ * Release an image kept by `draw_ref()`
+ */
 static void draw_cleanup(_lv_img_cache_entry_t * cache)
 {
+    /*Already released*/
+    if(cache == NULL) return;
+
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_draw_sw_thread_lock();
+    cache->ref_cnt--;
+    lv_draw_sw_thread_unlock();
+#else
     /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
     lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
+    lv_draw_sw_thread_unlock();
 #endif
 }
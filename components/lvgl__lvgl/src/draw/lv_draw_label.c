@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "sw/lv_draw_sw.h"
 
 /*********************
  *      DEFINES
@@ -101,6 +102,16 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, draw_ctx->clip_area);
     if(!clip_ok) return;
 
+#if LV_OBJ_DRAW_LIST_SIZE
+    /*Record the whole text instead of its letters*/
+    if(_lv_draw_list_record_label(draw_ctx, dsc, coords, txt)) return;
+#endif
+
+#if LV_TEXT_CACHE_SIZE
+    /*Draw the whole text at once if it's cached*/
+    if(lv_draw_sw_text_cache_draw(draw_ctx, dsc, coords, txt)) return;
+#endif
+
     lv_text_align_t align = dsc->align;
     lv_base_dir_t base_dir = dsc->bidi_dir;
 
@@ -0,0 +1,416 @@
+/**
+ * @file lv_draw_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_math.h"
+
+#if LV_OBJ_DRAW_LIST_SIZE
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Keep the pointers in the commands aligned*/
+#define CMD_ALIGN(size) (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define BUF_SIZE_MIN 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    CMD_RECT,
+    CMD_ARC,
+    CMD_IMG,
+    CMD_LABEL,
+    CMD_LETTER,
+    CMD_LINE,
+    CMD_POLYGON,
+} cmd_type_t;
+
+typedef struct {
+    uint32_t size;          /*Size of the command with its data*/
+    uint8_t type;           /*Element of `cmd_type_t`*/
+    lv_area_t clip_area;    /*The clip area when it was drawn*/
+} cmd_t;
+
+typedef struct {
+    cmd_t cmd;
+    lv_draw_rect_dsc_t dsc;
+    lv_area_t coords;
+} cmd_rect_t;
+
+typedef struct {
+    cmd_t cmd;
+    lv_draw_arc_dsc_t dsc;
+    lv_point_t center;
+    uint16_t radius;
+    uint16_t start_angle;
+    uint16_t end_angle;
+} cmd_arc_t;
+
+/*The path of file and symbol sources follows the command*/
+typedef struct {
+    cmd_t cmd;
+    lv_draw_img_dsc_t dsc;
+    lv_area_t coords;
+    const void * src;
+} cmd_img_t;
+
+/*The text follows the command*/
+typedef struct {
+    cmd_t cmd;
+    lv_draw_label_dsc_t dsc;
+    lv_area_t coords;
+} cmd_label_t;
+
+typedef struct {
+    cmd_t cmd;
+    lv_draw_label_dsc_t dsc;
+    lv_point_t pos;
+    uint32_t letter;
+} cmd_letter_t;
+
+typedef struct {
+    cmd_t cmd;
+    lv_draw_line_dsc_t dsc;
+    lv_point_t point1;
+    lv_point_t point2;
+} cmd_line_t;
+
+/*The points follow the command*/
+typedef struct {
+    cmd_t cmd;
+    lv_draw_rect_dsc_t dsc;
+    uint16_t point_cnt;
+} cmd_polygon_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * cmd_add(lv_draw_list_recorder_t * rec, cmd_type_t type, uint32_t size);
+static void record_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void record_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                       uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static lv_res_t record_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                           const void * src);
+static void record_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                          uint32_t letter);
+static void record_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                        const lv_point_t * point2);
+static void record_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                           uint16_t point_cnt);
+static void record_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                               const uint8_t * map_p, lv_img_cf_t color_format);
+static void record_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area, const void * src_buf,
+                             lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                             const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf);
+static void record_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_list_reset(lv_draw_list_t * list)
+{
+    if(list->buf) lv_mem_free(list->buf);
+    list->buf = NULL;
+    list->size = 0;
+    list->buf_size = 0;
+}
+
+void lv_draw_list_record_start(lv_draw_list_recorder_t * rec, lv_draw_list_t * list, uint32_t max_size)
+{
+    lv_memset_00(rec, sizeof(lv_draw_list_recorder_t));
+    rec->list = list;
+    rec->max_size = max_size;
+    rec->mask_cnt = lv_draw_mask_get_cnt();
+
+    /*Everything which can change the pixels directly stops the recording*/
+    lv_draw_ctx_t * draw_ctx = &rec->base_draw;
+    draw_ctx->draw_rect = record_rect;
+    draw_ctx->draw_arc = record_arc;
+    draw_ctx->draw_img = record_img;
+    draw_ctx->draw_img_decoded = record_img_decoded;
+    draw_ctx->draw_letter = record_letter;
+    draw_ctx->draw_line = record_line;
+    draw_ctx->draw_polygon = record_polygon;
+    draw_ctx->draw_transform = record_transform;
+    draw_ctx->draw_bg = record_bg;
+}
+
+bool lv_draw_list_record_check(lv_draw_list_recorder_t * rec)
+{
+    if(lv_draw_mask_get_cnt() != rec->mask_cnt) rec->failed = 1;
+    return !rec->failed;
+}
+
+bool lv_draw_list_record_end(lv_draw_list_recorder_t * rec)
+{
+    lv_draw_list_t * list = rec->list;
+    if(!lv_draw_list_record_check(rec)) {
+        lv_draw_list_reset(list);
+        return false;
+    }
+
+    if(list->size == 0) {
+        lv_draw_list_reset(list);
+    }
+    else if(list->size < list->buf_size) {
+        uint8_t * buf = lv_mem_realloc(list->buf, list->size);
+        if(buf) {
+            list->buf = buf;
+            list->buf_size = list->size;
+        }
+    }
+
+    return true;
+}
+
+void lv_draw_list_replay(lv_draw_ctx_t * draw_ctx, const lv_draw_list_t * list, uint32_t start, uint32_t end)
+{
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    draw_ctx->clip_area = &clip_area;
+
+    uint32_t ofs = start;
+    while(ofs < end) {
+        const cmd_t * cmd = (const cmd_t *)&list->buf[ofs];
+        ofs += cmd->size;
+        if(!_lv_area_intersect(&clip_area, &cmd->clip_area, clip_area_ori)) continue;
+
+        switch(cmd->type) {
+            case CMD_RECT: {
+                    const cmd_rect_t * c = (const cmd_rect_t *)cmd;
+                    lv_draw_rect(draw_ctx, &c->dsc, &c->coords);
+                    break;
+                }
+            case CMD_ARC: {
+                    const cmd_arc_t * c = (const cmd_arc_t *)cmd;
+                    lv_draw_arc(draw_ctx, &c->dsc, &c->center, c->radius, c->start_angle, c->end_angle);
+                    break;
+                }
+            case CMD_IMG: {
+                    const cmd_img_t * c = (const cmd_img_t *)cmd;
+                    lv_draw_img(draw_ctx, &c->dsc, &c->coords, c->src ? c->src : (const void *)(c + 1));
+                    break;
+                }
+            case CMD_LABEL: {
+                    const cmd_label_t * c = (const cmd_label_t *)cmd;
+                    lv_draw_label(draw_ctx, &c->dsc, &c->coords, (const char *)(c + 1), NULL);
+                    break;
+                }
+            case CMD_LETTER: {
+                    const cmd_letter_t * c = (const cmd_letter_t *)cmd;
+                    lv_draw_letter(draw_ctx, &c->dsc, &c->pos, c->letter);
+                    break;
+                }
+            case CMD_LINE: {
+                    const cmd_line_t * c = (const cmd_line_t *)cmd;
+                    lv_draw_line(draw_ctx, &c->dsc, &c->point1, &c->point2);
+                    break;
+                }
+            case CMD_POLYGON: {
+                    const cmd_polygon_t * c = (const cmd_polygon_t *)cmd;
+                    lv_draw_polygon(draw_ctx, &c->dsc, (const lv_point_t *)(c + 1), c->point_cnt);
+                    break;
+                }
+            default:
+                LV_LOG_WARN("unknown command: %d", cmd->type);
+                break;
+        }
+    }
+
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+bool _lv_draw_list_record_label(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                const lv_area_t * coords, const char * txt)
+{
+    if(draw_ctx->draw_letter != record_letter) return false;
+
+    size_t txt_size = strlen(txt) + 1;
+    cmd_label_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_LABEL, sizeof(cmd_label_t) + txt_size);
+    if(c) {
+        c->dsc = *dsc;
+        c->coords = *coords;
+        lv_memcpy(c + 1, txt, txt_size);
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a command to the end of the list
+ * @param rec       pointer to a recorder
+ * @param type      type of the command
+ * @param size      size of the command with its data
+ * @return          pointer to the command's data to fill, or NULL if it can't be recorded
+ */
+static void * cmd_add(lv_draw_list_recorder_t * rec, cmd_type_t type, uint32_t size)
+{
+    if(!lv_draw_list_record_check(rec)) return NULL;
+
+    lv_draw_list_t * list = rec->list;
+    size = CMD_ALIGN(size);
+    if(list->size + size > rec->max_size) {
+        rec->failed = 1;
+        return NULL;
+    }
+
+    if(list->size + size > list->buf_size) {
+        uint32_t buf_size = LV_MAX(list->buf_size * 2, BUF_SIZE_MIN);
+        buf_size = LV_MAX(buf_size, list->size + size);
+        buf_size = LV_MIN(buf_size, rec->max_size);
+        uint8_t * buf = lv_mem_realloc(list->buf, buf_size);
+        if(buf == NULL) {
+            rec->failed = 1;
+            return NULL;
+        }
+        list->buf = buf;
+        list->buf_size = buf_size;
+    }
+
+    cmd_t * cmd = (cmd_t *)&list->buf[list->size];
+    list->size += size;
+    cmd->size = size;
+    cmd->type = type;
+    cmd->clip_area = *rec->base_draw.clip_area;
+    return cmd;
+}
+
+static void record_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    cmd_rect_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_RECT, sizeof(cmd_rect_t));
+    if(c == NULL) return;
+
+    c->dsc = *dsc;
+    c->coords = *coords;
+}
+
+static void record_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                       uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    cmd_arc_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_ARC, sizeof(cmd_arc_t));
+    if(c == NULL) return;
+
+    c->dsc = *dsc;
+    c->center = *center;
+    c->radius = radius;
+    c->start_angle = start_angle;
+    c->end_angle = end_angle;
+}
+
+static lv_res_t record_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                           const void * src)
+{
+    /*The paths might be temporary so copy them. Variables are kept by the user anyway.*/
+    size_t src_size = 0;
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) src_size = strlen(src) + 1;
+
+    cmd_img_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_IMG, sizeof(cmd_img_t) + src_size);
+    if(c) {
+        c->dsc = *dsc;
+        c->coords = *coords;
+        if(src_size) {
+            c->src = NULL;
+            lv_memcpy(c + 1, src, src_size);
+        }
+        else {
+            c->src = src;
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+static void record_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                          uint32_t letter)
+{
+    cmd_letter_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_LETTER, sizeof(cmd_letter_t));
+    if(c == NULL) return;
+
+    c->dsc = *dsc;
+    c->pos = *pos_p;
+    c->letter = letter;
+}
+
+static void record_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                        const lv_point_t * point2)
+{
+    cmd_line_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_LINE, sizeof(cmd_line_t));
+    if(c == NULL) return;
+
+    c->dsc = *dsc;
+    c->point1 = *point1;
+    c->point2 = *point2;
+}
+
+static void record_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                           uint16_t point_cnt)
+{
+    size_t points_size = point_cnt * sizeof(lv_point_t);
+    cmd_polygon_t * c = cmd_add((lv_draw_list_recorder_t *)draw_ctx, CMD_POLYGON, sizeof(cmd_polygon_t) + points_size);
+    if(c == NULL) return;
+
+    c->dsc = *dsc;
+    c->point_cnt = point_cnt;
+    lv_memcpy(c + 1, points, points_size);
+}
+
+static void record_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                               const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+    LV_UNUSED(map_p);
+    LV_UNUSED(color_format);
+
+    /*The decoded image might be temporary*/
+    ((lv_draw_list_recorder_t *)draw_ctx)->failed = 1;
+}
+
+static void record_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area, const void * src_buf,
+                             lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                             const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    LV_UNUSED(dest_area);
+    LV_UNUSED(src_buf);
+    LV_UNUSED(src_w);
+    LV_UNUSED(src_h);
+    LV_UNUSED(src_stride);
+    LV_UNUSED(draw_dsc);
+    LV_UNUSED(cf);
+    LV_UNUSED(cbuf);
+    LV_UNUSED(abuf);
+
+    /*The result is needed right away*/
+    ((lv_draw_list_recorder_t *)draw_ctx)->failed = 1;
+}
+
+static void record_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+
+    /*Only used by the renderer for the screen's background*/
+    ((lv_draw_list_recorder_t *)draw_ctx)->failed = 1;
+}
+
+#endif /*LV_OBJ_DRAW_LIST_SIZE*/
@@ -0,0 +1,119 @@
+/**
+ * @file lv_draw_list.h
+ *
+ */
+
+#ifndef LV_DRAW_LIST_H
+#define LV_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+
+#if LV_OBJ_DRAW_LIST_SIZE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Draw calls stored in a compact buffer to be replayed later.
+ * Every call is stored with its descriptor, coordinates and clip area, and
+ * the texts and file names are copied, so nothing has to be looked up again on replay.
+ */
+typedef struct {
+    uint8_t * buf;
+    uint32_t size;          /**< Used bytes of `buf`*/
+    uint32_t buf_size;      /**< Allocated bytes of `buf`*/
+} lv_draw_list_t;
+
+/**
+ * A draw context which stores the draw calls in a draw list instead of drawing them.
+ */
+typedef struct {
+    lv_draw_ctx_t base_draw;
+    lv_draw_list_t * list;
+    uint32_t max_size;      /**< Stop recording if the list would be larger*/
+    uint8_t mask_cnt;       /**< Number of masks when the recording started*/
+    uint8_t failed : 1;     /**< The calls couldn't be recorded*/
+} lv_draw_list_recorder_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Free the buffer of a draw list. The list can be recorded again.
+ * @param list          pointer to a draw list
+ */
+void lv_draw_list_reset(lv_draw_list_t * list);
+
+/**
+ * Start recording the draw calls into a draw list.
+ * The draws made with `&rec->base_draw` will be appended to `list` until `lv_draw_list_record_end()`.
+ * Set `rec->base_draw.clip_area` to the area the calls should be recorded on.
+ * @param rec           pointer to a recorder to initialize, it can be on the stack
+ * @param list          pointer to a reset draw list
+ * @param max_size      maximal size of the list in bytes
+ */
+void lv_draw_list_record_start(lv_draw_list_recorder_t * rec, lv_draw_list_t * list, uint32_t max_size);
+
+/**
+ * Check if the draw calls made so far could be recorded.
+ * Recording fails if the list would be too large, memory allocation fails
+ * or masks are added and still applied when something is drawn or when this function is called
+ * (they affect the pixels of other objects too).
+ * @param rec           pointer to a recorder
+ * @return              true: the calls are recorded; false: recording failed
+ */
+bool lv_draw_list_record_check(lv_draw_list_recorder_t * rec);
+
+/**
+ * Finish recording the draw calls and shrink the list to its size.
+ * @param rec           pointer to a recorder
+ * @return              true: all the calls are recorded; false: recording failed and the list is reset
+ */
+bool lv_draw_list_record_end(lv_draw_list_recorder_t * rec);
+
+/**
+ * Draw the recorded calls of a draw list.
+ * The calls are drawn with their recorded clip area truncated to `draw_ctx->clip_area`.
+ * @param draw_ctx      pointer to a draw context to draw with
+ * @param list          pointer to a draw list
+ * @param start         offset of the first call to draw in bytes
+ * @param end           draw the calls up to this offset in bytes (`list->size` to draw all)
+ */
+void lv_draw_list_replay(lv_draw_ctx_t * draw_ctx, const lv_draw_list_t * list, uint32_t start, uint32_t end);
+
+/**
+ * Record a label if `draw_ctx` is a recording context.
+ * Called by `lv_draw_label()` to record the whole text instead of the letters.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           pointer to the label's draw descriptor
+ * @param coords        coordinates of the label
+ * @param txt           the text to draw
+ * @return              true: `draw_ctx` is a recording context and it handled the label
+ */
+bool _lv_draw_list_record_label(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                const lv_area_t * coords, const char * txt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_OBJ_DRAW_LIST_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LIST_H*/
@@ -12,6 +12,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "sw/lv_draw_sw_thread.h"
 
 /*********************
  *      DEFINES
@@ -19,10 +20,19 @@
 #define CIRCLE_CACHE_LIFE_MAX   1000
 #define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 
+#define SPAN_SEG_MAX        (LV_DRAW_MASK_SPAN_MAX * 2)
+#define SPAN_SPLIT_MIN      16  /*Split the partially covered spans at transparent or covered runs of this length*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*A part of a line with the same kind of mask result. It starts where the previous segment ends.*/
+typedef struct {
+    lv_coord_t end;
+    lv_draw_mask_res_t res;
+} span_seg_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -60,6 +70,16 @@ static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_
                                 lv_coord_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
+static uint32_t seg_add(span_seg_t * segs, uint32_t cnt, lv_coord_t end, lv_draw_mask_res_t res);
+static uint32_t seg_intersect(const span_seg_t * a, uint32_t a_cnt, const span_seg_t * b, uint32_t b_cnt,
+                              span_seg_t * res);
+static uint32_t radius_segs(lv_draw_mask_radius_param_t * p, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len,
+                            span_seg_t * segs);
+static uint32_t span_add(lv_draw_mask_span_t * spans, uint32_t cnt, lv_coord_t x, lv_coord_t len,
+                         lv_draw_mask_res_t res, lv_opa_t * mask_buf, lv_opa_t opa);
+static uint32_t span_split(lv_draw_mask_span_t * spans, uint32_t cnt, lv_coord_t x, lv_coord_t len,
+                           lv_opa_t * mask_buf, lv_opa_t opa);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -163,6 +183,74 @@ lv_draw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_apply_ids(lv_opa_t * mask_
     return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
+/**
+ * Apply the added masks on a line and split it to spans. Used internally by the library's drawing routines.
+ * Only the partially covered parts of the line are calculated per pixel, so the fully covered and transparent
+ * parts can be skipped or drawn without mask.
+ * @param mask_buf  store the opacity of the partially covered spans here. Has to be `len` byte long.
+ *                  The fully covered and transparent parts are not written.
+ * @param abs_x     absolute X coordinate where the line to calculate start
+ * @param abs_y     absolute Y coordinate where the line to calculate start
+ * @param len       length of the line to calculate (in pixel count)
+ * @param opa       the initial opacity of the line (like initializing the buffer for `lv_draw_mask_apply()`)
+ * @param spans     store the non-transparent spans here in increasing X order.
+ *                  Has to have room for `LV_DRAW_MASK_SPAN_MAX` spans.
+ * @return          the number of spans. 0 if the whole line is transparent.
+ */
+uint32_t LV_ATTRIBUTE_FAST_MEM lv_draw_mask_apply_spans(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                        lv_coord_t len, lv_opa_t opa, lv_draw_mask_span_t * spans)
+{
+    if(len <= 0) return 0;
+
+    span_seg_t segs_buf[2][SPAN_SEG_MAX];
+    span_seg_t mask_segs[SPAN_SEG_MAX];
+    span_seg_t * segs = segs_buf[0];
+    uint32_t seg_cnt = seg_add(segs, 0, len, LV_DRAW_MASK_RES_FULL_COVER);
+
+    /*Intersect the segments of the masks. The radius masks know where their edges are,
+     *the others are handled as if they changed the whole line.*/
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    while(m->param) {
+        _lv_draw_mask_common_dsc_t * dsc = m->param;
+        uint32_t mask_seg_cnt;
+        if(dsc->cb == (lv_draw_mask_xcb_t)lv_draw_mask_radius) {
+            mask_seg_cnt = radius_segs(m->param, abs_x, abs_y, len, mask_segs);
+        }
+        else {
+            mask_seg_cnt = seg_add(mask_segs, 0, len, LV_DRAW_MASK_RES_CHANGED);
+        }
+
+        span_seg_t * segs_new = segs == segs_buf[0] ? segs_buf[1] : segs_buf[0];
+        seg_cnt = seg_intersect(segs, seg_cnt, mask_segs, mask_seg_cnt, segs_new);
+        segs = segs_new;
+        m++;
+    }
+
+    /*Calculate the opacity only in the changed segments*/
+    uint32_t span_cnt = 0;
+    lv_coord_t x = 0;
+    uint32_t i;
+    for(i = 0; i < seg_cnt; i++) {
+        lv_coord_t seg_len = segs[i].end - x;
+        if(segs[i].res == LV_DRAW_MASK_RES_FULL_COVER) {
+            span_cnt = span_add(spans, span_cnt, x, seg_len, LV_DRAW_MASK_RES_FULL_COVER, mask_buf, opa);
+        }
+        else if(segs[i].res == LV_DRAW_MASK_RES_CHANGED) {
+            lv_memset(&mask_buf[x], opa, seg_len);
+            lv_draw_mask_res_t res = lv_draw_mask_apply(&mask_buf[x], abs_x + x, abs_y, seg_len);
+            if(res == LV_DRAW_MASK_RES_FULL_COVER) {
+                span_cnt = span_add(spans, span_cnt, x, seg_len, LV_DRAW_MASK_RES_FULL_COVER, mask_buf, opa);
+            }
+            else if(res == LV_DRAW_MASK_RES_CHANGED) {
+                span_cnt = span_split(spans, span_cnt, x, seg_len, mask_buf, opa);
+            }
+        }
+        x = segs[i].end;
+    }
+
+    return span_cnt;
+}
+
 /**
  * Remove a mask with a given ID
  * @param id the ID of the mask.  Returned by `lv_draw_mask_add`
@@ -219,7 +307,9 @@ void lv_draw_mask_free_param(void * p)
                 lv_mem_free(radius_p->circle);
             }
             else {
+                lv_draw_sw_thread_lock();
                 radius_p->circle->used_cnt--;
+                lv_draw_sw_thread_unlock();
             }
         }
     }
@@ -493,12 +583,16 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
 
     uint32_t i;
 
+    /*The circle cache is shared by the drawing threads*/
+    lv_draw_sw_thread_lock();
+
     /*Try to reuse a circle cache entry*/
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
         if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
             LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
             CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
             param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
+            lv_draw_sw_thread_unlock();
             return;
         }
     }
@@ -513,20 +607,31 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     }
 
     if(!entry) {
+        lv_draw_sw_thread_unlock();
         entry = lv_mem_alloc(sizeof(_lv_draw_mask_radius_circle_dsc_t));
         LV_ASSERT_MALLOC(entry);
         lv_memset_00(entry, sizeof(_lv_draw_mask_radius_circle_dsc_t));
         entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
+        circ_calc_aa4(entry, radius);
+        entry->radius = radius;
+        param->circle = entry;
+        return;
     }
 
-    param->circle = entry;
+    /*Reserve the entry but don't let the other threads find it until it's calculated without the lock*/
+    entry->used_cnt++;
+    entry->life = 0;
+    CIRCLE_CACHE_AGING(entry->life, radius);
+    entry->radius = 0;
+    lv_draw_sw_thread_unlock();
+
+    circ_calc_aa4(entry, radius);
+
+    lv_draw_sw_thread_lock();
+    entry->radius = radius;
+    lv_draw_sw_thread_unlock();
 
-    circ_calc_aa4(param->circle, radius);
+    param->circle = entry;
 }
 
 /**
@@ -1365,13 +1470,15 @@ static void circ_next(lv_point_t * c, lv_coord_t * tmp)
 static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius)
 {
     if(radius == 0) return;
-    c->radius = radius;
-
-    /*Allocate buffers*/
-    if(c->buf) lv_mem_free(c->buf);
 
-    c->buf = lv_mem_alloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
-    LV_ASSERT_MALLOC(c->buf);
+    /*Allocate buffers if the current one is too small*/
+    uint32_t buf_size = radius * 6 + 6;  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    if(c->buf == NULL || c->buf_size < buf_size) {
+        if(c->buf) lv_mem_free(c->buf);
+        c->buf = lv_mem_alloc(buf_size);
+        LV_ASSERT_MALLOC(c->buf);
+        c->buf_size = buf_size;
+    }
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
     c->x_start_on_y = (uint16_t *)(c->buf + 4 * radius + 4);
@@ -1527,5 +1634,172 @@ static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);// >> 8);
 }
 
+/**
+ * Append a segment ending at `end` (exclusive) to a segment list. It's merged with the previous one if they are the
+ * same kind. If there is no more room the last segment is extended and marked as changed.
+ */
+static uint32_t seg_add(span_seg_t * segs, uint32_t cnt, lv_coord_t end, lv_draw_mask_res_t res)
+{
+    if(cnt > 0) {
+        span_seg_t * last = &segs[cnt - 1];
+        if(end <= last->end) return cnt;
+        if(last->res == res) {
+            last->end = end;
+            return cnt;
+        }
+        /*Calculating more pixels is always correct*/
+        if(cnt == SPAN_SEG_MAX) {
+            last->res = LV_DRAW_MASK_RES_CHANGED;
+            last->end = end;
+            return cnt;
+        }
+    }
+    else if(end <= 0) {
+        return 0;
+    }
+
+    segs[cnt].end = end;
+    segs[cnt].res = res;
+    return cnt + 1;
+}
+
+static uint32_t seg_intersect(const span_seg_t * a, uint32_t a_cnt, const span_seg_t * b, uint32_t b_cnt,
+                              span_seg_t * res)
+{
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while(i < a_cnt && j < b_cnt) {
+        lv_coord_t end = LV_MIN(a[i].end, b[j].end);
+        lv_draw_mask_res_t r;
+        if(a[i].res == LV_DRAW_MASK_RES_TRANSP || b[j].res == LV_DRAW_MASK_RES_TRANSP) r = LV_DRAW_MASK_RES_TRANSP;
+        else if(a[i].res == LV_DRAW_MASK_RES_FULL_COVER && b[j].res == LV_DRAW_MASK_RES_FULL_COVER) {
+            r = LV_DRAW_MASK_RES_FULL_COVER;
+        }
+        else r = LV_DRAW_MASK_RES_CHANGED;
+
+        cnt = seg_add(res, cnt, end, r);
+        if(a[i].end == end) i++;
+        if(b[j].end == end) j++;
+    }
+
+    return cnt;
+}
+
+/**
+ * Get the segments of a line of a radius mask. Follows the calculations of `lv_draw_mask_radius()`:
+ * only the anti-aliased pixels of the corners are changed, the rest is fully covered or transparent.
+ */
+static uint32_t radius_segs(lv_draw_mask_radius_param_t * p, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len,
+                            span_seg_t * segs)
+{
+    lv_draw_mask_res_t in_res = p->cfg.outer ? LV_DRAW_MASK_RES_TRANSP : LV_DRAW_MASK_RES_FULL_COVER;
+    lv_draw_mask_res_t out_res = p->cfg.outer ? LV_DRAW_MASK_RES_FULL_COVER : LV_DRAW_MASK_RES_TRANSP;
+    const lv_area_t * rect = &p->cfg.rect;
+    int32_t radius = p->cfg.radius;
+
+    if(abs_y < rect->y1 || abs_y > rect->y2) return seg_add(segs, 0, len, out_res);
+
+    /*The coordinates are relative to the start of the line from here*/
+    int32_t k = rect->x1 - abs_x;
+    int32_t w = lv_area_get_width(rect);
+    uint32_t cnt = 0;
+
+    if(abs_y >= rect->y1 + radius && abs_y <= rect->y2 - radius) {
+        cnt = seg_add(segs, cnt, LV_CLAMP(0, k, len), out_res);
+        cnt = seg_add(segs, cnt, LV_CLAMP(0, k + w, len), in_res);
+        return seg_add(segs, cnt, len, out_res);
+    }
+
+    int32_t h = lv_area_get_height(rect);
+    int32_t y = abs_y - rect->y1;
+    lv_coord_t cir_y = y < radius ? radius - y - 1 : y - (h - radius);
+    lv_coord_t aa_len;
+    lv_coord_t x_start;
+    get_next_line(p->circle, cir_y, &aa_len, &x_start);
+    int32_t cir_x_right = k + w - radius + x_start;
+    int32_t cir_x_left = k + radius - x_start - 1;
+
+    /*[cir_x_left - aa_len + 1, cir_x_left] and [cir_x_right, cir_x_right + aa_len) are anti-aliased.
+     *They can overlap on small circles, then everything between them is calculated.*/
+    int32_t aa_start = LV_MIN(cir_x_left - aa_len + 1, cir_x_right);
+    int32_t aa_end = LV_MAX(cir_x_right + aa_len, cir_x_left + 1);
+    cnt = seg_add(segs, cnt, LV_CLAMP(0, aa_start, len), out_res);
+    if(cir_x_left + 1 < cir_x_right) {
+        cnt = seg_add(segs, cnt, LV_CLAMP(0, cir_x_left + 1, len), LV_DRAW_MASK_RES_CHANGED);
+        cnt = seg_add(segs, cnt, LV_CLAMP(0, cir_x_right, len), in_res);
+    }
+    cnt = seg_add(segs, cnt, LV_CLAMP(0, aa_end, len), LV_DRAW_MASK_RES_CHANGED);
+    return seg_add(segs, cnt, len, out_res);
+}
+
+/**
+ * Append a span. It's merged with the previous one if they are next to each other and the same kind.
+ * If there is no more room the rest of the line is stored in the mask buffer as part of the last span.
+ */
+static uint32_t span_add(lv_draw_mask_span_t * spans, uint32_t cnt, lv_coord_t x, lv_coord_t len,
+                         lv_draw_mask_res_t res, lv_opa_t * mask_buf, lv_opa_t opa)
+{
+    if(len <= 0) return cnt;
+
+    if(cnt > 0) {
+        lv_draw_mask_span_t * last = &spans[cnt - 1];
+        lv_coord_t last_end = last->x + last->len;
+        if(last_end == x && last->res == res) {
+            last->len += len;
+            return cnt;
+        }
+
+        if(cnt == LV_DRAW_MASK_SPAN_MAX) {
+            if(last->res == LV_DRAW_MASK_RES_FULL_COVER) {
+                lv_memset(&mask_buf[last->x], opa, last->len);
+                last->res = LV_DRAW_MASK_RES_CHANGED;
+            }
+            lv_memset_00(&mask_buf[last_end], x - last_end);
+            if(res == LV_DRAW_MASK_RES_FULL_COVER) lv_memset(&mask_buf[x], opa, len);
+            last->len = x + len - last->x;
+            return cnt;
+        }
+    }
+
+    spans[cnt].x = x;
+    spans[cnt].len = len;
+    spans[cnt].res = res;
+    return cnt + 1;
+}
+
+/**
+ * Add the changed part of a line as spans. The long enough transparent runs are left out,
+ * and the runs with the initial opacity are added as fully covered spans.
+ */
+static uint32_t span_split(lv_draw_mask_span_t * spans, uint32_t cnt, lv_coord_t x, lv_coord_t len,
+                           lv_opa_t * mask_buf, lv_opa_t opa)
+{
+    lv_coord_t end = x + len;
+    lv_coord_t changed_start = x;
+    lv_coord_t i = x;
+    while(i < end) {
+        lv_opa_t v = mask_buf[i];
+        if(v != LV_OPA_TRANSP && v != opa) {
+            i++;
+            continue;
+        }
+
+        lv_coord_t run_end = i + 1;
+        while(run_end < end && mask_buf[run_end] == v) run_end++;
+
+        if(run_end - i >= SPAN_SPLIT_MIN) {
+            cnt = span_add(spans, cnt, changed_start, i - changed_start, LV_DRAW_MASK_RES_CHANGED, mask_buf, opa);
+            if(v != LV_OPA_TRANSP) {
+                cnt = span_add(spans, cnt, i, run_end - i, LV_DRAW_MASK_RES_FULL_COVER, mask_buf, opa);
+            }
+            changed_start = run_end;
+        }
+        i = run_end;
+    }
+
+    return span_add(spans, cnt, changed_start, end - changed_start, LV_DRAW_MASK_RES_CHANGED, mask_buf, opa);
+}
+
 
 #endif /*LV_DRAW_COMPLEX*/
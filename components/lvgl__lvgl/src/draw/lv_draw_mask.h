@@ -95,6 +95,20 @@ typedef lv_draw_mask_res_t (*lv_draw_mask_xcb_t)(lv_opa_t * mask_buf, lv_coord_t
 
 typedef uint8_t lv_draw_mask_line_side_t;
 
+/** Max. number of spans `lv_draw_mask_apply_spans()` splits a line to*/
+#define LV_DRAW_MASK_SPAN_MAX   16
+
+/**
+ * A part of a line where the masks have the same kind of result.
+ * The fully transparent parts of a line have no spans.
+ */
+typedef struct {
+    lv_coord_t x;               /**< Start of the span relative to the start of the line*/
+    lv_coord_t len;             /**< Length of the span in pixels*/
+    lv_draw_mask_res_t res;     /**< `LV_DRAW_MASK_RES_FULL_COVER`: every pixel has the initial opacity of the line.
+                                 *   `LV_DRAW_MASK_RES_CHANGED`: the opacity of the pixels is in the mask buffer*/
+} lv_draw_mask_span_t;
+
 typedef struct {
     lv_draw_mask_xcb_t cb;
     lv_draw_mask_type_t type;
@@ -155,6 +169,7 @@ typedef struct {
 
 typedef struct  {
     uint8_t * buf;
+    uint32_t buf_size;          /*Size of `buf`, it's reused for smaller radii*/
     lv_opa_t * cir_opa;         /*Opacity of values on the circumference of an 1/4 circle*/
     uint16_t * x_start_on_y;        /*The x coordinate of the circle for each y value*/
     uint16_t * opa_start_on_y;      /*The index of `cir_opa` for each y value*/
@@ -261,6 +276,23 @@ lv_draw_mask_res_t /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_mask_apply_ids(lv_opa_t *
                                                                       lv_coord_t abs_y, lv_coord_t len,
                                                                       const int16_t * ids, int16_t ids_count);
 
+/**
+ * Apply the added masks on a line and split it to spans. Used internally by the library's drawing routines.
+ * Only the partially covered parts of the line are calculated per pixel, so the fully covered and transparent
+ * parts can be skipped or drawn without mask.
+ * @param mask_buf  store the opacity of the partially covered spans here. Has to be `len` byte long.
+ *                  The fully covered and transparent parts are not written.
+ * @param abs_x     absolute X coordinate where the line to calculate start
+ * @param abs_y     absolute Y coordinate where the line to calculate start
+ * @param len       length of the line to calculate (in pixel count)
+ * @param opa       the initial opacity of the line (like initializing the buffer for `lv_draw_mask_apply()`)
+ * @param spans     store the non-transparent spans here in increasing X order.
+ *                  Has to have room for `LV_DRAW_MASK_SPAN_MAX` spans.
+ * @return          the number of spans. 0 if the whole line is transparent.
+ */
+uint32_t /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_mask_apply_spans(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                              lv_coord_t len, lv_opa_t opa, lv_draw_mask_span_t * spans);
+
 //! @endcond
 
 /**
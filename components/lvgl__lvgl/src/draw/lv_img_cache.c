@@ -12,19 +12,13 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "sw/lv_draw_sw_thread.h"
 
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values*/
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+/*Minimal number of hash buckets*/
+#define LV_IMG_CACHE_BUCKET_MIN 8
 
 /**********************
  *      TYPEDEFS
@@ -35,6 +29,12 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t src_hash(const void * src, lv_color_t color, int32_t frame_id);
+    static _lv_img_cache_entry_t * find_entry(const void * src, lv_color_t color, int32_t frame_id, uint32_t hash);
+    static uint32_t entry_mem_size(const _lv_img_cache_entry_t * entry);
+    static void drop_entry(_lv_img_cache_entry_t * entry);
+    static bool drop_lru_entry(const _lv_img_cache_entry_t * keep);
+    static bool set_pinned(const void * src, bool en);
 #endif
 
 /**********************
@@ -42,6 +42,13 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t used_cnt;
+    static uint32_t bucket_cnt;
+    static uint32_t mem_size_limit = LV_IMG_CACHE_MEM_SIZE;
+    static uint32_t used_mem_size;
+    static uint32_t hit_cnt;
+    static uint32_t miss_cnt;
+    static uint32_t evict_cnt;
 #endif
 
 /**********************
@@ -55,7 +62,7 @@
 /**
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
- * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * The least recently used images are closed if the new image doesn't fit into the cache.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param color color The color of the image with `LV_IMG_CF_ALPHA_...`
  * @return pointer to the cache entry or NULL if can open the image
@@ -71,50 +78,28 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
         return NULL;
     }
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
+    /*The list is ordered from the most to the least recently used image*/
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_ll);
+    uint32_t hash = src_hash(src, color, frame_id);
+    cached_src = find_entry(src, color, frame_id, hash);
+    if(cached_src) {
+        _lv_ll_move_before(ll, cached_src, _lv_ll_get_head(ll));
+        hit_cnt++;
+        LV_LOG_TRACE("image source found in the cache");
+        return cached_src;
     }
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image source found in the cache");
-            break;
-        }
-    }
+    miss_cnt++;
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    /*Close an image before opening the new one to keep the peak memory usage low.
+     *If all the images are pinned the cache grows beyond `entry_cnt`*/
+    while(used_cnt >= entry_cnt && drop_lru_entry(NULL));
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
-    }
-
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
+    cached_src = _lv_ll_ins_head(ll);
+    LV_ASSERT_MALLOC(cached_src);
+    if(cached_src == NULL) return NULL;
+    lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
+    LV_LOG_INFO("image draw: cache miss");
 #else
     cached_src = &LV_GC_ROOT(_lv_img_cache_single);
 #endif
@@ -123,13 +108,15 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
+#if LV_IMG_CACHE_DEF_SIZE
+        _lv_ll_remove(ll, cached_src);
+        lv_mem_free(cached_src);
+#else
         lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
+#endif
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -137,6 +124,22 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_img_cache_entry_t ** buckets = LV_GC_ROOT(_lv_img_cache_buckets);
+    cached_src->hash = hash;
+    cached_src->hash_next = buckets[hash & (bucket_cnt - 1)];
+    buckets[hash & (bucket_cnt - 1)] = cached_src;
+
+    cached_src->mem_size = entry_mem_size(cached_src);
+    used_mem_size += cached_src->mem_size;
+    used_cnt++;
+
+    /*Close the least recently used images until the new one fits*/
+    if(mem_size_limit) {
+        while(used_mem_size > mem_size_limit && drop_lru_entry(cached_src));
+    }
+#endif
+
     return cached_src;
 }
 
@@ -144,6 +147,7 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * All the images are closed (the pinned ones too) and the statistics are reset.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_entry_cnt)
@@ -152,23 +156,59 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_UNUSED(new_entry_cnt);
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
-    if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
+    lv_draw_sw_thread_lock();
+    if(LV_GC_ROOT(_lv_img_cache_buckets) != NULL) {
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
-        lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        lv_mem_free(LV_GC_ROOT(_lv_img_cache_buckets));
     }
+    else {
+        _lv_ll_init(&LV_GC_ROOT(_lv_img_cache_ll), sizeof(_lv_img_cache_entry_t));
+    }
+
+    hit_cnt = 0;
+    miss_cnt = 0;
+    evict_cnt = 0;
+
+    /*At most one entry per bucket on average*/
+    uint32_t new_bucket_cnt = LV_IMG_CACHE_BUCKET_MIN;
+    while(new_bucket_cnt < new_entry_cnt) new_bucket_cnt <<= 1;
 
     /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
+    LV_GC_ROOT(_lv_img_cache_buckets) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t *) * new_bucket_cnt);
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_buckets));
+    if(LV_GC_ROOT(_lv_img_cache_buckets) == NULL) {
         entry_cnt = 0;
+        bucket_cnt = 0;
+        lv_draw_sw_thread_unlock();
         return;
     }
     entry_cnt = new_entry_cnt;
+    bucket_cnt = new_bucket_cnt;
 
     /*Clean the cache*/
-    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    lv_memset_00(LV_GC_ROOT(_lv_img_cache_buckets), bucket_cnt * sizeof(_lv_img_cache_entry_t *));
+    lv_draw_sw_thread_unlock();
+#endif
+}
+
+/**
+ * Limit the RAM used by the opened images in the cache.
+ * The least recently used images are closed until the opened ones fit.
+ * @param mem_size size in bytes, 0: limit only the number of images
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(mem_size);
+    LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    lv_draw_sw_thread_lock();
+    mem_size_limit = mem_size;
+    if(mem_size_limit) {
+        while(used_mem_size > mem_size_limit && drop_lru_entry(NULL));
+    }
+    lv_draw_sw_thread_unlock();
 #endif
 }
 
@@ -181,18 +221,83 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    if(LV_GC_ROOT(_lv_img_cache_buckets) == NULL) return;
 
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+    /*All the colors and frames of the image are cached under different hashes*/
+    lv_draw_sw_thread_lock();
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_ll);
+    _lv_img_cache_entry_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        _lv_img_cache_entry_t * next = _lv_ll_get_next(ll, entry);
+        if(src == NULL || lv_img_cache_match(src, entry->dec_dsc.src)) {
+            drop_entry(entry);
+        }
+        entry = next;
+    }
+    lv_draw_sw_thread_unlock();
+#endif
+}
 
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
+/**
+ * Keep an image opened in the cache even if it's not used for a long time. E.g. for icons shown all the time.
+ * If the image is not cached yet it's opened with the default recolor (black) and frame (0).
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: the cache is disabled or the image can't be opened
+ */
+lv_res_t lv_img_cache_pin(const void * src)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_draw_sw_thread_lock();
+    bool pinned = set_pinned(src, true);
+    if(!pinned) {
+        _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, lv_color_black(), 0);
+        if(entry) {
+            entry->pinned = 1;
+            pinned = true;
         }
     }
+    lv_draw_sw_thread_unlock();
+
+    return pinned ? LV_RES_OK : LV_RES_INV;
+#else
+    LV_UNUSED(src);
+    LV_LOG_WARN("Can't pin an image because the cache is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Let an image pinned with `lv_img_cache_pin()` be closed again when its place is needed.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ */
+void lv_img_cache_unpin(const void * src)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_draw_sw_thread_lock();
+    set_pinned(src, false);
+    lv_draw_sw_thread_unlock();
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+/**
+ * Get statistics about the image cache
+ * @param mon_p pointer to a `lv_img_cache_monitor_t` variable to store the result
+ */
+void lv_img_cache_monitor(lv_img_cache_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_img_cache_monitor_t));
+
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_draw_sw_thread_lock();
+    mon_p->hit_cnt = hit_cnt;
+    mon_p->miss_cnt = miss_cnt;
+    mon_p->evict_cnt = evict_cnt;
+    mon_p->entry_cnt = used_cnt;
+    mon_p->used_size = used_mem_size;
+    mon_p->total_size = mem_size_limit;
+    lv_draw_sw_thread_unlock();
 #endif
 }
 
@@ -212,4 +317,127 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Hash an image the same way as `lv_img_cache_match()` compares them:
+ * variables by their address and files by their path.
+ */
+static uint32_t src_hash(const void * src, lv_color_t color, int32_t frame_id)
+{
+    /*FNV-1a*/
+    uint32_t hash = 2166136261u;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        const uint8_t * path = src;
+        while(*path) {
+            hash = (hash ^ *path) * 16777619u;
+            path++;
+        }
+    }
+    else {
+        hash = (hash ^ (uint32_t)((lv_uintptr_t)src >> 2)) * 16777619u;
+    }
+
+    hash = (hash ^ (uint32_t)color.full) * 16777619u;
+    hash = (hash ^ (uint32_t)frame_id) * 16777619u;
+
+    /*Mix the high bits into the low ones used as the bucket index*/
+    return hash ^ (hash >> 16);
+}
+
+static _lv_img_cache_entry_t * find_entry(const void * src, lv_color_t color, int32_t frame_id, uint32_t hash)
+{
+    _lv_img_cache_entry_t * entry = LV_GC_ROOT(_lv_img_cache_buckets)[hash & (bucket_cnt - 1)];
+    while(entry) {
+        if(entry->hash == hash &&
+           color.full == entry->dec_dsc.color.full &&
+           frame_id == entry->dec_dsc.frame_id &&
+           lv_img_cache_match(src, entry->dec_dsc.src)) {
+            return entry;
+        }
+        entry = entry->hash_next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Estimate the RAM kept by an opened image
+ */
+static uint32_t entry_mem_size(const _lv_img_cache_entry_t * entry)
+{
+    const lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    uint32_t size = sizeof(_lv_img_cache_entry_t);
+    if(dsc->src_type == LV_IMG_SRC_FILE) size += strlen(dsc->src) + 1;
+
+    /*The image is read line by line or right from the constant data of the variable*/
+    if(dsc->img_data == NULL) return size;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return size;
+
+    uint32_t data_size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+
+    /*The decoders of the raw formats (e.g. PNG) give true color images with alpha*/
+    if(data_size == 0) data_size = (uint32_t)dsc->header.w * dsc->header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    return size + data_size;
+}
+
+/**
+ * Close an image and remove it from the cache
+ */
+static void drop_entry(_lv_img_cache_entry_t * entry)
+{
+    _lv_img_cache_entry_t ** next_p = &LV_GC_ROOT(_lv_img_cache_buckets)[entry->hash & (bucket_cnt - 1)];
+    while(*next_p != entry) next_p = &(*next_p)->hash_next;
+    *next_p = entry->hash_next;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+
+    used_mem_size -= entry->mem_size;
+    used_cnt--;
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+    lv_mem_free(entry);
+}
+
+/**
+ * Close the least recently used image which is neither pinned nor drawn by an other thread
+ * @param keep an entry not to close or NULL
+ * @return true: an image was closed; false: there is no image to close
+ */
+static bool drop_lru_entry(const _lv_img_cache_entry_t * keep)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_ll);
+    _lv_img_cache_entry_t * entry = _lv_ll_get_tail(ll);
+    while(entry && (entry->pinned || entry->ref_cnt || entry == keep)) {
+        entry = _lv_ll_get_prev(ll, entry);
+    }
+
+    if(entry == NULL) return false;
+
+    LV_LOG_INFO("image draw: close the least recently used image to make room");
+    drop_entry(entry);
+    evict_cnt++;
+    return true;
+}
+
+/**
+ * Pin or unpin all the cached colors and frames of an image
+ * @return true: the image was found in the cache
+ */
+static bool set_pinned(const void * src, bool en)
+{
+    if(LV_GC_ROOT(_lv_img_cache_buckets) == NULL) return false;
+
+    bool found = false;
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_cache_ll);
+    _lv_img_cache_entry_t * entry;
+    _LV_LL_READ(ll, entry) {
+        if(lv_img_cache_match(src, entry->dec_dsc.src)) {
+            entry->pinned = en ? 1 : 0;
+            found = true;
+        }
+    }
+
+    return found;
+}
 #endif
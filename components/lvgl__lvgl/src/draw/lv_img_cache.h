@@ -28,15 +28,25 @@ extern "C" {
  *
  * To avoid repeating this heavy load images can be cached.
  */
-typedef struct {
+typedef struct __lv_img_cache_entry_t {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    struct __lv_img_cache_entry_t * hash_next;  /**< Next entry in the same hash bucket*/
+    uint32_t hash;                              /**< Hash of the source, color and frame*/
+    uint32_t mem_size;                          /**< RAM used by the opened image in bytes*/
+    uint16_t ref_cnt;                           /**< Number of threads drawing the image, it's not closed meanwhile*/
+    uint8_t pinned : 1;                         /**< 1: never closed to make room for other images*/
 } _lv_img_cache_entry_t;
 
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;      /**< Number of images which had to be opened by a decoder*/
+    uint32_t evict_cnt;     /**< Number of images closed to make room for others*/
+    uint32_t entry_cnt;     /**< Number of opened images in the cache*/
+    uint32_t used_size;     /**< RAM used by the opened images in bytes*/
+    uint32_t total_size;    /**< Limit of `used_size` in bytes, 0: no limit*/
+} lv_img_cache_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -56,10 +66,18 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * All the images are closed (the pinned ones too) and the statistics are reset.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the RAM used by the opened images in the cache.
+ * The least recently used images are closed until the opened ones fit.
+ * @param mem_size size in bytes, 0: limit only the number of images
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -67,6 +85,26 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Keep an image opened in the cache even if it's not used for a long time. E.g. for icons shown all the time.
+ * If the image is not cached yet it's opened with the default recolor (black) and frame (0).
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: the cache is disabled or the image can't be opened
+ */
+lv_res_t lv_img_cache_pin(const void * src);
+
+/**
+ * Let an image pinned with `lv_img_cache_pin()` be closed again when its place is needed.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ */
+void lv_img_cache_unpin(const void * src);
+
+/**
+ * Get statistics about the image cache
+ * @param mon_p pointer to a `lv_img_cache_monitor_t` variable to store the result
+ */
+void lv_img_cache_monitor(lv_img_cache_monitor_t * mon_p);
+
 /**********************
  *      MACROS
  **********************/
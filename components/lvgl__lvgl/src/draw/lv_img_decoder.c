@@ -11,6 +11,7 @@
 #include "../draw/lv_draw_img.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_gc.h"
+#include "sw/lv_draw_sw_thread.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +25,8 @@
 
 typedef struct {
     lv_fs_file_t f;
+    const uint8_t * data;   /*The image data (after the header) in place if the file system can map the file*/
+    uint8_t * img_buf;      /*The image data read into the RAM if it can't be mapped*/
     lv_color_t * palette;
     lv_opa_t * opa;
 } lv_img_decoder_built_in_data_t;
@@ -94,12 +97,15 @@ lv_res_t lv_img_decoder_get_info(const void * src, lv_img_header_t * header)
 
     lv_res_t res = LV_RES_INV;
     lv_img_decoder_t * d;
+    /*The decoders might open files or use other shared resources while drawing with multiple threads*/
+    lv_draw_sw_thread_lock();
     _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), d) {
         if(d->info_cb) {
             res = d->info_cb(d, src, header);
             if(res == LV_RES_OK) break;
         }
     }
+    lv_draw_sw_thread_unlock();
 
     return res;
 }
@@ -351,6 +357,15 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         lv_memcpy_small(&user_data->f, &f, sizeof(f));
+
+        /*Use the data in place if possible (e.g. memory mapped files) instead of reading it*/
+        lv_img_cf_t cf = dsc->header.cf;
+        uint32_t data_size = cf == LV_IMG_CF_RGB565A8 ? (uint32_t)dsc->header.w * dsc->header.h * 3 :
+                             lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, cf);
+        const void * data;
+        if(data_size && lv_fs_get_ptr(&user_data->f, 4, data_size, &data) == LV_FS_RES_OK) { /*+4 to skip the header*/
+            user_data->data = data;
+        }
     }
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         /*The variables should have valid data*/
@@ -368,6 +383,11 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             dsc->img_data = ((lv_img_dsc_t *)dsc->src)->data;
             return LV_RES_OK;
         }
+        else if(((lv_img_decoder_built_in_data_t *)dsc->user_data)->data) {
+            /*The file is mapped, it can be used as a variable*/
+            dsc->img_data = ((lv_img_decoder_built_in_data_t *)dsc->user_data)->data;
+            return LV_RES_OK;
+        }
         else {
             /*If it's a file, read all to memory*/
             uint32_t len = dsc->header.w * dsc->header.h;
@@ -382,6 +402,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
                 lv_mem_free(fs_buf);
                 return LV_RES_INV;
             }
+            user_data->img_buf = fs_buf;
             dsc->img_data = fs_buf;
             return LV_RES_OK;
         }
@@ -396,7 +417,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_OK;
         }
         else {
-            /*If it's a file it need to be read line by line later*/
+            /*If it's a mapped file simply give its pointer else it need to be read line by line later*/
+            dsc->img_data = ((lv_img_decoder_built_in_data_t *)dsc->user_data)->data;
             return LV_RES_OK;
         }
     }
@@ -428,7 +450,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_INV;
         }
 
-        if(dsc->src_type == LV_IMG_SRC_FILE) {
+        if(dsc->src_type == LV_IMG_SRC_FILE && user_data->data == NULL) {
             /*Read the palette from file*/
             lv_fs_seek(&user_data->f, 4, LV_FS_SEEK_SET); /*Skip the header*/
             lv_color32_t cur_color;
@@ -441,7 +463,9 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         }
         else {
             /*The palette begins in the beginning of the image data. Just point to it.*/
-            lv_color32_t * palette_p = (lv_color32_t *)((lv_img_dsc_t *)dsc->src)->data;
+            const uint8_t * data = dsc->src_type == LV_IMG_SRC_FILE ? user_data->data :
+                                   ((lv_img_dsc_t *)dsc->src)->data;
+            const lv_color32_t * palette_p = (const lv_color32_t *)data;
 
             uint32_t i;
             for(i = 0; i < palette_size; i++) {
@@ -522,6 +546,7 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             lv_fs_close(&user_data->f);
         }
+        if(user_data->img_buf) lv_mem_free(user_data->img_buf);
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
 
@@ -619,16 +644,19 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     }
 
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
-
+    uint8_t * fs_buf = NULL;
     const uint8_t * data_tmp = NULL;
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
 
         data_tmp = img_dsc->data + ofs;
     }
+    else if(user_data->data) {
+        data_tmp = user_data->data + ofs;
+    }
     else {
+        fs_buf = lv_mem_buf_get(w);
+        if(fs_buf == NULL) return LV_RES_INV;
         lv_fs_seek(&user_data->f, ofs + 4, LV_FS_SEEK_SET); /*+4 to skip the header*/
         lv_fs_read(&user_data->f, fs_buf, w, NULL);
         data_tmp = fs_buf;
@@ -646,7 +674,7 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
             data_tmp++;
         }
     }
-    lv_mem_buf_release(fs_buf);
+    if(fs_buf) lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 }
 
@@ -688,14 +716,18 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
 
     lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
 
-    uint8_t * fs_buf = lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
+    uint8_t * fs_buf = NULL;
     const uint8_t * data_tmp = NULL;
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
         data_tmp                     = img_dsc->data + ofs;
     }
+    else if(user_data->data) {
+        data_tmp = user_data->data + ofs;
+    }
     else {
+        fs_buf = lv_mem_buf_get(w);
+        if(fs_buf == NULL) return LV_RES_INV;
         lv_fs_seek(&user_data->f, ofs + 4, LV_FS_SEEK_SET); /*+4 to skip the header*/
         lv_fs_read(&user_data->f, fs_buf, w, NULL);
         data_tmp = fs_buf;
@@ -725,6 +757,6 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
             data_tmp++;
         }
     }
-    lv_mem_buf_release(fs_buf);
+    if(fs_buf) lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 }
@@ -14,6 +14,9 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_simd.h"
+#include "lv_draw_sw_rotate.h"
+#include "lv_draw_sw_thread.h"
 #include "../lv_draw.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_color.h"
@@ -36,6 +39,22 @@ typedef struct {
     void (*blend)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
 } lv_draw_sw_ctx_t;
 
+/** Statistics of the text cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of texts drawn from the cache*/
+    uint32_t miss_cnt;      /**< Number of texts which had to be rendered*/
+    uint32_t used_size;     /**< Size of the cached texts in bytes*/
+    uint32_t total_size;    /**< Size of the cache in bytes (`LV_TEXT_CACHE_SIZE`)*/
+} lv_draw_sw_text_cache_monitor_t;
+
+/** Statistics of the shadow cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of shadow corners taken from the cache*/
+    uint32_t miss_cnt;      /**< Number of shadow corners which had to be blurred*/
+    uint32_t used_size;     /**< Size of the cached corners in bytes*/
+    uint32_t total_size;    /**< Size of the cache in bytes (`LV_SHADOW_CACHE_MEM_SIZE`)*/
+} lv_draw_sw_shadow_cache_monitor_t;
+
 typedef struct {
     lv_draw_layer_ctx_t base_draw;
 
@@ -58,9 +77,44 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+
+/**
+ * Get statistics about the shadow cache
+ * @param mon_p pointer to a `lv_draw_sw_shadow_cache_monitor_t` variable to store the result
+ */
+void lv_draw_sw_shadow_cache_monitor(lv_draw_sw_shadow_cache_monitor_t * mon_p);
+
+/**
+ * Drop all the cached shadow corners and reset the statistics.
+ */
+void lv_draw_sw_shadow_cache_clear(void);
+
 void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
                        uint32_t letter);
 
+/**
+ * Draw a text from its cached opacity map if possible. Render and cache the opacity map if it's not cached yet.
+ * @param draw_ctx pointer to a draw context
+ * @param dsc pointer to draw descriptor
+ * @param coords coordinates of the label
+ * @param txt `\0` terminated text to write
+ * @return true: the text is drawn; false: the text can't be cached, draw it letter by letter
+ */
+bool lv_draw_sw_text_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                                const char * txt);
+
+/**
+ * Get statistics about the text cache
+ * @param mon_p pointer to a `lv_draw_sw_text_cache_monitor_t` variable to store the result
+ */
+void lv_draw_sw_text_cache_monitor(lv_draw_sw_text_cache_monitor_t * mon_p);
+
+/**
+ * Drop all the cached texts and reset the statistics.
+ * Has to be called if a font is deleted as the texts are cached by the address of their font.
+ */
+void lv_draw_sw_text_cache_clear(void);
+
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_img_dsc_t * draw_dsc,
                                                         const lv_area_t * coords, const uint8_t * src_buf,
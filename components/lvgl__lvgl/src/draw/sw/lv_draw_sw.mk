@@ -1,13 +1,17 @@
 CSRCS += lv_draw_sw.c
 CSRCS += lv_draw_sw_arc.c
 CSRCS += lv_draw_sw_blend.c
+CSRCS += lv_draw_sw_blend_simd.c
 CSRCS += lv_draw_sw_dither.c
 CSRCS += lv_draw_sw_gradient.c
 CSRCS += lv_draw_sw_img.c
 CSRCS += lv_draw_sw_letter.c
 CSRCS += lv_draw_sw_line.c
 CSRCS += lv_draw_sw_polygon.c
+CSRCS += lv_draw_sw_text_cache.c
+CSRCS += lv_draw_sw_thread.c
 CSRCS += lv_draw_sw_rect.c
+CSRCS += lv_draw_sw_rotate.c
 CSRCS += lv_draw_sw_transform.c
 CSRCS += lv_draw_sw_layer.c
 
@@ -72,6 +72,7 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 /**********************
  *  STATIC VARIABLES
  **********************/
+static const lv_draw_sw_blend_kernels_t * kernels;
 
 /**********************
  *      MACROS
@@ -206,6 +207,71 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
     }
 }
 
+#if LV_DRAW_COMPLEX
+void lv_draw_sw_blend_spans(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc,
+                            const lv_draw_mask_span_t * spans, uint32_t span_cnt, lv_opa_t mask_opa)
+{
+    /*The opacity of the fully covered spans if they are blended without mask. It's known only if one of them is 100%*/
+    lv_opa_t cover_opa;
+    if(dsc->opa == LV_OPA_COVER) cover_opa = mask_opa;
+    else if(mask_opa == LV_OPA_COVER) cover_opa = dsc->opa;
+    else cover_opa = LV_OPA_TRANSP;
+
+    /*Without mask the opacity is used a little differently in some cases, so blend without mask only if
+     *it's the same pixel by pixel. Else the fully covered spans are blended with a uniform mask.*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    bool cover_no_mask = ((lv_draw_sw_ctx_t *)draw_ctx)->blend == lv_draw_sw_blend_basic &&
+                         disp->driver->set_px_cb == NULL && disp->driver->screen_transp == 0;
+    if(cover_no_mask && cover_opa != LV_OPA_COVER) {
+        cover_no_mask = cover_opa > LV_OPA_MIN && cover_opa < LV_OPA_MAX && disp->driver->antialiasing &&
+                        dsc->blend_mode == LV_BLEND_MODE_NORMAL;
+#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
+        /*The fill without mask rounds the opacity*/
+        if(dsc->src_buf == NULL) cover_no_mask = false;
+#endif
+    }
+
+    lv_area_t span_area;
+    span_area.y1 = dsc->blend_area->y1;
+    span_area.y2 = dsc->blend_area->y2;
+
+    lv_draw_sw_blend_dsc_t span_dsc = *dsc;
+    span_dsc.blend_area = &span_area;
+    span_dsc.mask_area = &span_area;
+
+    uint32_t i;
+    for(i = 0; i < span_cnt; i++) {
+        const lv_draw_mask_span_t * span = &spans[i];
+        span_area.x1 = dsc->blend_area->x1 + span->x;
+        span_area.x2 = span_area.x1 + span->len - 1;
+        if(dsc->src_buf) span_dsc.src_buf = dsc->src_buf + span->x;
+
+        if(span->res == LV_DRAW_MASK_RES_FULL_COVER && cover_no_mask) {
+            span_dsc.mask_buf = NULL;
+            span_dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+            span_dsc.opa = cover_opa;
+        }
+        else {
+            if(span->res == LV_DRAW_MASK_RES_FULL_COVER) lv_memset(&dsc->mask_buf[span->x], mask_opa, span->len);
+            span_dsc.mask_buf = &dsc->mask_buf[span->x];
+            span_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            span_dsc.opa = dsc->opa;
+        }
+
+        lv_draw_sw_blend(draw_ctx, &span_dsc);
+    }
+}
+#endif /*LV_DRAW_COMPLEX*/
+
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * new_kernels)
+{
+    kernels = new_kernels;
+}
+
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void)
+{
+    return kernels;
+}
 
 /**********************
  *   STATIC FUNCTIONS
@@ -257,6 +323,11 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
     /*No mask*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+            if(kernels && kernels->fill) {
+                kernels->fill(dest_buf, dest_stride, w, h, color);
+                return;
+            }
+
             for(y = 0; y < h; y++) {
                 lv_color_fill(dest_buf, color, w);
                 dest_buf += dest_stride;
@@ -264,6 +335,11 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
+            if(kernels && kernels->fill_opa) {
+                kernels->fill_opa(dest_buf, dest_stride, w, h, color, opa);
+                return;
+            }
+
             lv_color_t last_dest_color = lv_color_black();
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -293,6 +369,11 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
     }
     /*Masked*/
     else {
+        if(kernels && kernels->fill_mask) {
+            kernels->fill_mask(dest_buf, dest_stride, w, h, color, opa, mask, mask_stride);
+            return;
+        }
+
 #if LV_COLOR_DEPTH == 16
         uint32_t c32 = color.full + ((uint32_t)color.full << 16);
 #endif
@@ -409,10 +490,10 @@ static inline void set_px_argb(uint8_t * buf, lv_color_t color, lv_opa_t opa)
 static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t opa, lv_color_t (*blend_fp)(lv_color_t,
                                                                                                            lv_color_t, lv_opa_t))
 {
-    static lv_color_t last_dest_color;
-    static lv_color_t last_src_color;
-    static lv_color_t last_res_color;
-    static uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
+    static LV_DRAW_SW_THREAD_LOCAL lv_color_t last_dest_color;
+    static LV_DRAW_SW_THREAD_LOCAL lv_color_t last_src_color;
+    static LV_DRAW_SW_THREAD_LOCAL lv_color_t last_res_color;
+    static LV_DRAW_SW_THREAD_LOCAL uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
 
     lv_color_t bg_color;
 
@@ -665,6 +746,11 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
             }
         }
         else {
+            if(kernels && kernels->map_opa) {
+                kernels->map_opa(dest_buf, dest_stride, w, h, src_buf, src_stride, opa);
+                return;
+            }
+
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
                     dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
@@ -676,6 +762,11 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     }
     /*Masked*/
     else {
+        if(kernels && kernels->map_mask) {
+            kernels->map_mask(dest_buf, dest_stride, w, h, src_buf, src_stride, opa, mask, mask_stride);
+            return;
+        }
+
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             int32_t x_end4 = w - 4;
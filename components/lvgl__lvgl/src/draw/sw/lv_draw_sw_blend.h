@@ -40,6 +40,29 @@ typedef struct {
 
 struct _lv_draw_ctx_t;
 
+/**
+ * Faster (e.g. vectorized) versions of the blend loops of `lv_draw_sw_blend_basic()` with `LV_BLEND_MODE_NORMAL`.
+ * They work on `w` x `h` pixels and have to give the same result as the C implementation.
+ * The unused byte of 32 bit colors is expected to be 0xFF. NULL members fall back to the C implementation.
+ */
+typedef struct {
+    const char * name;
+    /** Fill with a color*/
+    void (*fill)(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, lv_color_t color);
+    /** Mix a color with opacity (`opa < LV_OPA_MAX`)*/
+    void (*fill_opa)(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, lv_color_t color,
+                     lv_opa_t opa);
+    /** Mix a color through a mask (e.g. the opacity map of a text) and with opacity*/
+    void (*fill_mask)(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, lv_color_t color,
+                      lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+    /** Mix an image with opacity (`opa < LV_OPA_MAX`)*/
+    void (*map_opa)(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, const lv_color_t * src_buf,
+                    lv_coord_t src_stride, lv_opa_t opa);
+    /** Copy an image through a mask (e.g. its alpha channel) and with opacity*/
+    void (*map_mask)(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, const lv_color_t * src_buf,
+                     lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+} lv_draw_sw_blend_kernels_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +82,33 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_sw_blend_dsc_t * dsc);
 
+#if LV_DRAW_COMPLEX
+/**
+ * Blend a line split to spans by `lv_draw_mask_apply_spans()`. The fully covered spans are blended without
+ * mask when it gives the same result, the partially covered spans through the mask and the gaps are skipped.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           pointer to an initialized blend descriptor. `blend_area` has to be 1 line high and
+ *                      `mask_buf` has to be the mask of `blend_area`. `mask_res` and `mask_area` are ignored.
+ * @param spans         the spans with X coordinates relative to `blend_area->x1`
+ * @param span_cnt      number of spans
+ * @param mask_opa      the opacity of the fully covered spans in the mask (the initial opacity of the line)
+ */
+void lv_draw_sw_blend_spans(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc,
+                            const lv_draw_mask_span_t * spans, uint32_t span_cnt, lv_opa_t mask_opa);
+#endif /*LV_DRAW_COMPLEX*/
+
+/**
+ * Set the blend kernels used by `lv_draw_sw_blend_basic()`.
+ * @param kernels       pointer to a static kernel set or NULL to use the C implementation only
+ */
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * kernels);
+
+/**
+ * Get the blend kernels used by `lv_draw_sw_blend_basic()`.
+ * @return              pointer to the kernel set or NULL if only the C implementation is used
+ */
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,450 @@
+/**
+ * @file lv_draw_sw_blend_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_simd.h"
+
+#if LV_DRAW_SW_BLEND_SIMD
+
+#include "../../misc/lv_color.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__) && \
+    (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+    #define SIMD_X86 1
+#else
+    #define SIMD_X86 0
+#endif
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3) && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+    #define SIMD_PIE 1
+#else
+    #define SIMD_PIE 0
+#endif
+
+#if SIMD_X86
+
+#if defined(__GNUC__) && !defined(__clang__)
+    /*The helpers are always inlined so the ABI of returning 32 byte vectors without AVX doesn't matter*/
+    #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#define SIMD_INLINE static inline __attribute__((always_inline))
+
+/*The kernels work on 8 pixels at once*/
+#define PX_CNT  8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint8_t v8u8_t __attribute__((vector_size(8)));
+typedef uint16_t v8u16_t __attribute__((vector_size(16)));
+typedef uint32_t v8u32_t __attribute__((vector_size(32)));
+
+#if LV_COLOR_DEPTH == 32
+typedef int32_t v8i32_t __attribute__((vector_size(32)));
+typedef uint8_t v32u8_t __attribute__((vector_size(32)));
+typedef uint16_t v32u16_t __attribute__((vector_size(64)));
+typedef v8u32_t vpx_t;
+#else
+typedef v8u16_t vpx_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+#define SPLAT(type, v) ((type){v, v, v, v, v, v, v, v})
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+SIMD_INLINE vpx_t load_px(const lv_color_t * p)
+{
+    vpx_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+SIMD_INLINE void store_px(lv_color_t * p, const vpx_t * v)
+{
+    memcpy(p, v, sizeof(*v));
+}
+
+SIMD_INLINE uint64_t load_mask(const lv_opa_t * p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+SIMD_INLINE v8u16_t unpack_mask(uint64_t m)
+{
+    v8u8_t v;
+    memcpy(&v, &m, sizeof(v));
+    return __builtin_convertvector(v, v8u16_t);
+}
+
+#if LV_COLOR_DEPTH == 16
+SIMD_INLINE v8u16_t swap_px(v8u16_t v)
+{
+#if LV_COLOR_16_SWAP
+    return (v << 8) | (v >> 8);
+#else
+    return v;
+#endif
+}
+
+#if LV_COLOR_MIX_ROUND_OFS != 0
+SIMD_INLINE v8u16_t udiv255(v8u16_t x)
+{
+    /*Equals to `LV_UDIV255` below 0xFFFF*/
+    return (x + 1 + (x >> 8)) >> 8;
+}
+#endif
+#endif
+
+/**
+ * Vectorized `lv_color_mix()`: mix `fg` and `bg` pixel by pixel with the ratios of `mix`.
+ * (The pixels are passed by pointer as GCC notes the ABI change of 32 byte vector arguments even if it's ignored.)
+ */
+SIMD_INLINE vpx_t mix_px(const vpx_t * fg, const vpx_t * bg, v8u16_t mix)
+{
+#if LV_COLOR_DEPTH == 32
+    /*Mix the 4 bytes of the pixels with the same ratio on 16 bit*/
+    v8u32_t mix32 = __builtin_convertvector(mix, v8u32_t) * 0x01010101;
+    v32u16_t m = __builtin_convertvector((v32u8_t)mix32, v32u16_t);
+    v32u16_t f = __builtin_convertvector((v32u8_t)*fg, v32u16_t);
+    v32u16_t b = __builtin_convertvector((v32u8_t)*bg, v32u16_t);
+    v32u16_t x = f * m + b * (255 - m) + LV_COLOR_MIX_ROUND_OFS;
+    x = (x + 1 + (x >> 8)) >> 8;
+    return (vpx_t)__builtin_convertvector(x, v32u8_t) | 0xFF000000;
+#elif LV_COLOR_MIX_ROUND_OFS == 0
+    /*The same packed RGB565 trick as `lv_color_mix()` on 32 bit lanes*/
+    v8u32_t m = (__builtin_convertvector(mix, v8u32_t) + 4) >> 3;
+    v8u32_t f = __builtin_convertvector(swap_px(*fg), v8u32_t);
+    v8u32_t b = __builtin_convertvector(swap_px(*bg), v8u32_t);
+    f = (f | (f << 16)) & 0x7E0F81F;
+    b = (b | (b << 16)) & 0x7E0F81F;
+    v8u32_t res = ((((f - b) * m) >> 5) + b) & 0x7E0F81F;
+    return swap_px(__builtin_convertvector((res >> 16) | res, v8u16_t));
+#else
+    v8u16_t f = swap_px(*fg);
+    v8u16_t b = swap_px(*bg);
+    v8u16_t mi = 255 - mix;
+    v8u16_t r = udiv255((f >> 11) * mix + (b >> 11) * mi + LV_COLOR_MIX_ROUND_OFS);
+    v8u16_t g = udiv255(((f >> 5) & 0x3F) * mix + ((b >> 5) & 0x3F) * mi + LV_COLOR_MIX_ROUND_OFS);
+    v8u16_t bl = udiv255((f & 0x1F) * mix + (b & 0x1F) * mi + LV_COLOR_MIX_ROUND_OFS);
+    return swap_px((r << 11) | (g << 5) | bl);
+#endif
+}
+
+/**
+ * Mix `fg` to `bg` with the ratios of `opa` but keep `bg` where `mask` is 0 and use `fg` where `opa` is 255
+ */
+SIMD_INLINE vpx_t mix_masked_px(const vpx_t * fg, const vpx_t * bg, v8u16_t mask, v8u16_t opa)
+{
+    vpx_t res = mix_px(fg, bg, opa);
+#if LV_COLOR_DEPTH == 32
+    /*Sign extend the results of the comparisons to 32 bit*/
+    vpx_t cover = (vpx_t)__builtin_convertvector(opa == 255, v8i32_t);
+    vpx_t transp = (vpx_t)__builtin_convertvector(mask == 0, v8i32_t);
+#else
+    vpx_t cover = (vpx_t)(opa == 255);
+    vpx_t transp = (vpx_t)(mask == 0);
+#endif
+    res = (res & ~cover) | (*fg & cover);
+    return (res & ~transp) | (*bg & transp);
+}
+
+/**
+ * Scale `opa` with the mask: `mask >= mask_max ? opa : (mask * opa) >> 8`
+ */
+SIMD_INLINE v8u16_t mask_opa(v8u16_t mask, lv_opa_t opa, uint16_t mask_max)
+{
+    v8u16_t o = SPLAT(v8u16_t, opa);
+    v8u16_t res = (mask * o) >> 8;
+    v8u16_t full = (v8u16_t)(mask >= SPLAT(v8u16_t, mask_max));
+    return (res & ~full) | (o & full);
+}
+
+SIMD_INLINE lv_opa_t mask_opa_px(lv_opa_t mask, lv_opa_t opa, uint16_t mask_max)
+{
+    return mask >= mask_max ? opa : (lv_opa_t)(((uint32_t)mask * opa) >> 8);
+}
+
+SIMD_INLINE void fill_body(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, lv_color_t color)
+{
+    vpx_t c = SPLAT(vpx_t, color.full);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x + PX_CNT <= w; x += PX_CNT) {
+            store_px(&dest_buf[x], &c);
+        }
+        for(; x < w; x++) {
+            dest_buf[x] = color;
+        }
+        dest_buf += dest_stride;
+    }
+}
+
+SIMD_INLINE void fill_opa_body(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, lv_color_t color,
+                               lv_opa_t opa)
+{
+    vpx_t c = SPLAT(vpx_t, color.full);
+    v8u16_t o = SPLAT(v8u16_t, opa);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x + PX_CNT <= w; x += PX_CNT) {
+            vpx_t d = load_px(&dest_buf[x]);
+            vpx_t res = mix_px(&c, &d, o);
+            store_px(&dest_buf[x], &res);
+        }
+        for(; x < w; x++) {
+            dest_buf[x] = lv_color_mix(color, dest_buf[x], opa);
+        }
+        dest_buf += dest_stride;
+    }
+}
+
+SIMD_INLINE void fill_mask_body(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,
+                                lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    /*Like `fill_normal()`: ignore `opa` if it's almost opaque and scale it with the mask otherwise*/
+    bool cover = opa >= LV_OPA_MAX;
+    vpx_t c = SPLAT(vpx_t, color.full);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x + PX_CNT <= w; x += PX_CNT) {
+            uint64_t bits = load_mask(&mask[x]);
+            if(bits == 0) continue;
+            if(cover && bits == UINT64_MAX) {
+                store_px(&dest_buf[x], &c);
+                continue;
+            }
+
+            v8u16_t m = unpack_mask(bits);
+            v8u16_t o = cover ? m : mask_opa(m, opa, LV_OPA_COVER);
+            vpx_t d = load_px(&dest_buf[x]);
+            vpx_t res = mix_masked_px(&c, &d, m, o);
+            store_px(&dest_buf[x], &res);
+        }
+        for(; x < w; x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            lv_opa_t o = cover ? mask[x] : mask_opa_px(mask[x], opa, LV_OPA_COVER);
+            dest_buf[x] = o == LV_OPA_COVER ? color : lv_color_mix(color, dest_buf[x], o);
+        }
+        dest_buf += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+SIMD_INLINE void map_opa_body(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,
+                              const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa)
+{
+    v8u16_t o = SPLAT(v8u16_t, opa);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x + PX_CNT <= w; x += PX_CNT) {
+            vpx_t src = load_px(&src_buf[x]);
+            vpx_t d = load_px(&dest_buf[x]);
+            vpx_t res = mix_px(&src, &d, o);
+            store_px(&dest_buf[x], &res);
+        }
+        for(; x < w; x++) {
+            dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
+        }
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+    }
+}
+
+SIMD_INLINE void map_mask_body(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,
+                               const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                               const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    /*Like `map_normal()`: ignore `opa` if it's almost opaque and scale it with the mask otherwise*/
+    bool cover = opa > LV_OPA_MAX;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x + PX_CNT <= w; x += PX_CNT) {
+            uint64_t bits = load_mask(&mask[x]);
+            if(bits == 0) continue;
+            if(cover && bits == UINT64_MAX) {
+                memcpy(&dest_buf[x], &src_buf[x], PX_CNT * sizeof(lv_color_t));
+                continue;
+            }
+
+            v8u16_t m = unpack_mask(bits);
+            v8u16_t o = cover ? m : mask_opa(m, opa, LV_OPA_MAX);
+            vpx_t src = load_px(&src_buf[x]);
+            vpx_t d = load_px(&dest_buf[x]);
+            vpx_t res = mix_masked_px(&src, &d, m, o);
+            store_px(&dest_buf[x], &res);
+        }
+        for(; x < w; x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            lv_opa_t o = cover ? mask[x] : mask_opa_px(mask[x], opa, LV_OPA_MAX);
+            dest_buf[x] = o == LV_OPA_COVER ? src_buf[x] : lv_color_mix(src_buf[x], dest_buf[x], o);
+        }
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+        mask += mask_stride;
+    }
+}
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_MIX_ROUND_OFS == 0
+    /*`fill_normal()` rounds `opa` differently than `lv_color_mix()` so leave it to the C implementation*/
+    #define FILL_OPA_KERNEL(isa, attr)
+    #define FILL_OPA_KERNEL_REF(isa) NULL
+#else
+    #define FILL_OPA_KERNEL(isa, attr)                                                                              \
+        static void attr fill_opa_##isa(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,       \
+                                        lv_color_t color, lv_opa_t opa)                                             \
+        {                                                                                                           \
+            fill_opa_body(dest_buf, dest_stride, w, h, color, opa);                                                 \
+        }
+    #define FILL_OPA_KERNEL_REF(isa) fill_opa_##isa
+#endif
+
+/*Compile the kernels for an instruction set*/
+#define KERNELS(isa, isa_name, attr)                                                                                \
+    static void attr fill_##isa(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,               \
+                                lv_color_t color)                                                                   \
+    {                                                                                                               \
+        fill_body(dest_buf, dest_stride, w, h, color);                                                              \
+    }                                                                                                               \
+    FILL_OPA_KERNEL(isa, attr)                                                                                      \
+    static void attr fill_mask_##isa(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,          \
+                                     lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride) \
+    {                                                                                                               \
+        fill_mask_body(dest_buf, dest_stride, w, h, color, opa, mask, mask_stride);                                 \
+    }                                                                                                               \
+    static void attr map_opa_##isa(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,            \
+                                   const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa)                 \
+    {                                                                                                               \
+        map_opa_body(dest_buf, dest_stride, w, h, src_buf, src_stride, opa);                                        \
+    }                                                                                                               \
+    static void attr map_mask_##isa(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h,           \
+                                    const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,                \
+                                    const lv_opa_t * mask, lv_coord_t mask_stride)                                  \
+    {                                                                                                               \
+        map_mask_body(dest_buf, dest_stride, w, h, src_buf, src_stride, opa, mask, mask_stride);                    \
+    }                                                                                                               \
+    static const lv_draw_sw_blend_kernels_t kernels_##isa = {                                                       \
+        .name = isa_name,                                                                                           \
+        .fill = fill_##isa,                                                                                         \
+        .fill_opa = FILL_OPA_KERNEL_REF(isa),                                                                       \
+        .fill_mask = fill_mask_##isa,                                                                               \
+        .map_opa = map_opa_##isa,                                                                                   \
+        .map_mask = map_mask_##isa,                                                                                 \
+    };
+
+KERNELS(sse2, "SSE2", /*Always enabled with __SSE2__*/)
+KERNELS(avx2, "AVX2", __attribute__((target("avx2"))))
+
+#endif /*SIMD_X86*/
+
+#if SIMD_PIE
+
+/*The size of the vector registers of the ESP32-S3's Processor Instruction Extensions in bytes*/
+#define PIE_BYTES   16
+
+#if LV_COLOR_DEPTH == 16
+    #define PIE_VLDBC   "ee.vldbc.16"
+#else
+    #define PIE_VLDBC   "ee.vldbc.32"
+#endif
+
+/*`ee.vst.128.ip` ignores the low 4 bits of the address so store from the first aligned pixel*/
+static void fill_pie(lv_color_t * dest_buf, lv_coord_t dest_stride, int32_t w, int32_t h, lv_color_t color)
+{
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        lv_color_t * d = dest_buf;
+        lv_color_t * d_end = dest_buf + w;
+        while(((uintptr_t)d & (PIE_BYTES - 1)) && d < d_end) *d++ = color;
+
+        int32_t cnt = (int32_t)((d_end - d) * sizeof(lv_color_t) / PIE_BYTES);
+        if(cnt > 0) {
+            /*Broadcast the color to q0 and store it in the same block as the compiler doesn't know q0*/
+            __asm__ volatile(
+                PIE_VLDBC " q0, %[color]\n"
+                "1:\n"
+                "ee.vst.128.ip q0, %[d], 16\n"
+                "addi %[cnt], %[cnt], -1\n"
+                "bnez %[cnt], 1b\n"
+                : [d] "+r"(d), [cnt] "+r"(cnt)
+                : [color] "r"(&color)
+                : "memory");
+        }
+
+        while(d < d_end) *d++ = color;
+        dest_buf += dest_stride;
+    }
+}
+
+/*TODO the mixing kernels, bit exact to `lv_color_mix()` with the 16 bit lanes of PIE.
+ *Until then the C loops are used for them.*/
+static const lv_draw_sw_blend_kernels_t kernels_pie = {
+    .name = "PIE",
+    .fill = fill_pie,
+};
+
+#endif /*SIMD_PIE*/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_blend_simd_init(void)
+{
+    const lv_draw_sw_blend_kernels_t * kernels = NULL;
+    int32_t simd;
+    for(simd = _LV_DRAW_SW_BLEND_SIMD_LAST - 1; simd > LV_DRAW_SW_BLEND_SIMD_NONE && kernels == NULL; simd--) {
+        kernels = lv_draw_sw_blend_simd_get_kernels((lv_draw_sw_blend_simd_t)simd);
+    }
+
+    lv_draw_sw_blend_set_kernels(kernels);
+}
+
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_simd_get_kernels(lv_draw_sw_blend_simd_t simd)
+{
+    switch(simd) {
+#if SIMD_X86
+        case LV_DRAW_SW_BLEND_SIMD_SSE2:
+            return &kernels_sse2;
+        case LV_DRAW_SW_BLEND_SIMD_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? &kernels_avx2 : NULL;
+#endif
+#if SIMD_PIE
+        case LV_DRAW_SW_BLEND_SIMD_PIE:
+            return &kernels_pie;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+#endif /*LV_DRAW_SW_BLEND_SIMD*/
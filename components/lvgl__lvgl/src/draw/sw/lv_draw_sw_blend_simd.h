@@ -0,0 +1,60 @@
+/**
+ * @file lv_draw_sw_blend_simd.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BLEND_SIMD_H
+#define LV_DRAW_SW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The built-in vectorized blend kernel sets*/
+typedef enum {
+    LV_DRAW_SW_BLEND_SIMD_NONE,     /**< The C implementation*/
+    LV_DRAW_SW_BLEND_SIMD_SSE2,
+    LV_DRAW_SW_BLEND_SIMD_AVX2,
+    LV_DRAW_SW_BLEND_SIMD_PIE,      /**< The vector instructions of the ESP32-S3*/
+    _LV_DRAW_SW_BLEND_SIMD_LAST,
+} lv_draw_sw_blend_simd_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Select the fastest built-in blend kernels the CPU supports with `lv_draw_sw_blend_set_kernels()`.
+ * Called by `lv_init()` if `LV_DRAW_SW_BLEND_SIMD` is enabled.
+ */
+void lv_draw_sw_blend_simd_init(void);
+
+/**
+ * Get a built-in blend kernel set.
+ * @param simd      the instruction set to use
+ * @return          pointer to the kernels or NULL if they are not built or the CPU doesn't support them
+ */
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_simd_get_kernels(lv_draw_sw_blend_simd_t simd);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_SIMD_H*/
@@ -21,11 +21,10 @@ void LV_ATTRIBUTE_FAST_MEM lv_dither_none(lv_grad_t * grad, lv_coord_t x, lv_coo
 {
     LV_UNUSED(x);
     LV_UNUSED(y);
-    if(grad == NULL || grad->filled) return;
+    if(grad == NULL) return;
     for(lv_coord_t i = 0; i < w; i++) {
         grad->map[i] = lv_color_hex(grad->hmap[i].full);
     }
-    grad->filled = 1;
 }
 
 static const uint8_t dither_ordered_threshold_matrix[8 * 8] = {
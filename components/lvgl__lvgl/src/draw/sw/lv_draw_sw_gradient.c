@@ -7,7 +7,9 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_gradient.h"
+#include "lv_draw_sw_thread.h"
 #include "../../misc/lv_gc.h"
+#include "../../misc/lv_lru.h"
 #include "../../misc/lv_types.h"
 
 /*********************
@@ -32,220 +34,227 @@
     #error "LV_GRAD_CACHE_DEF_SIZE is too small"
 #endif
 
+/*Size of a typical map in bytes, to size the hash table of the cache*/
+#define GRAD_CACHE_AVG_SIZE 512
+
+/*Size of the ordered dithering matrix*/
+#define DITHER_ORDERED_SIZE 8
+
 /**********************
- *  STATIC PROTOTYPES
+ *      TYPEDEFS
  **********************/
-static lv_grad_t * next_in_cache(lv_grad_t * item);
-
-typedef lv_res_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out);
-static size_t get_cache_item_size(lv_grad_t * c);
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
-static lv_res_t find_item(lv_grad_t * c, void * ctx);
-static void free_item(lv_grad_t * c);
-static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+/*Everything the computed maps depend on*/
+typedef struct {
+    lv_gradient_stop_t stops[LV_GRADIENT_MAX_STOPS];
+    lv_coord_t size;
+    uint8_t stops_count;
+    uint8_t dir;
+    uint8_t dither;
+} grad_key_t;
 
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void grad_key(grad_key_t * key, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+static lv_grad_t * grad_create(const lv_grad_dsc_t * g, const grad_key_t * key, size_t * item_size);
+static void grad_cache_add(const grad_key_t * key, lv_grad_t * grad, size_t item_size);
+static void grad_cache_free(void * v);
 
 /**********************
  *   STATIC VARIABLE
  **********************/
-static size_t    grad_cache_size = 0;
-static uint8_t * grad_cache_end = 0;
+static size_t grad_cache_size = LV_GRAD_CACHE_DEF_SIZE;
+static uint32_t grad_cache_hit_cnt;
+static uint32_t grad_cache_miss_cnt;
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
 
-static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
+/**
+ * Get the key of a gradient in the cache.
+ * Gradients with the same stops and direction share the maps even if the other side of their areas differs.
+ */
+static void grad_key(grad_key_t * key, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
-}
+    lv_memset_00(key, sizeof(grad_key_t));    /*Clear the padding and the unused stops too as they are part of the key*/
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        key->stops[i].color = g->stops[i].color;
+        key->stops[i].frac = g->stops[i].frac;
+    }
+    key->stops_count = g->stops_count;
+    key->dir = g->dir;
+    key->size = g->dir == LV_GRAD_DIR_HOR ? w : h;
 
-static size_t get_cache_item_size(lv_grad_t * c)
-{
-    size_t s = ALIGN(sizeof(*c)) + ALIGN(c->alloc_size * sizeof(lv_color_t));
 #if _DITHER_GRADIENT
-    s += ALIGN(c->size * sizeof(lv_color32_t));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-    s += ALIGN(c->w * sizeof(lv_scolor24_t));
+    key->dither = g->dither;
+#if LV_DITHER_ERROR_DIFFUSION == 0
+    /*Any dithering is ordered without error diffusion*/
+    if(key->dither == LV_DITHER_ERR_DIFF) key->dither = LV_DITHER_ORDERED;
 #endif
+#else
+    key->dither = LV_DITHER_NONE;
 #endif
-    return s;
 }
 
-static lv_grad_t * next_in_cache(lv_grad_t * item)
+/**
+ * Allocate and compute the maps of a gradient.
+ * The dithered rows which don't depend on the drawn area are computed here too.
+ * @param g         the gradient descriptor
+ * @param key       key of the gradient
+ * @param item_size store the allocated size here
+ * @return          the gradient or NULL if out of memory
+ */
+static lv_grad_t * grad_create(const lv_grad_dsc_t * g, const grad_key_t * key, size_t * item_size)
 {
-    if(grad_cache_size == 0) return NULL;
-
-    if(item == NULL)
-        return (lv_grad_t *)LV_GC_ROOT(_lv_grad_cache_mem);
+    lv_coord_t size = key->size;
+    size_t map_size = size * sizeof(lv_color_t);
+    if(key->dither == LV_DITHER_ORDERED) map_size *= DITHER_ORDERED_SIZE;
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+    else if(key->dither == LV_DITHER_ERR_DIFF) map_size = size * sizeof(lv_color32_t);
+#endif
 
-    size_t s = get_cache_item_size(item);
-    /*Compute the size for this cache item*/
-    if((uint8_t *)item + s >= grad_cache_end) return NULL;
-    else return (lv_grad_t *)((uint8_t *)item + s);
-}
+    *item_size = ALIGN(sizeof(lv_grad_t)) + map_size;
+    lv_grad_t * grad = lv_mem_alloc(*item_size);
+    LV_ASSERT_MALLOC(grad);
+    if(grad == NULL) return NULL;
 
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out)
-{
-    lv_grad_t * first = next_in_cache(NULL);
-    while(first != NULL && first->life) {
-        if((*func)(first, ctx) == LV_RES_OK) {
-            if(out != NULL) *out = first;
-            return LV_RES_OK;
-        }
-        first = next_in_cache(first);
-    }
-    return LV_RES_INV;
-}
+    lv_memset_00(grad, sizeof(lv_grad_t));
+    grad->size = size;
+    grad->dir = key->dir;
+    grad->dither = key->dither;
+    uint8_t * data = (uint8_t *)grad + ALIGN(sizeof(lv_grad_t));
+    lv_coord_t i;
 
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx)
-{
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life < *min_life) *min_life = c->life;
-    return LV_RES_INV;
-}
-
-static void free_item(lv_grad_t * c)
-{
-    size_t size = get_cache_item_size(c);
-    size_t next_items_size = (size_t)(grad_cache_end - (uint8_t *)c) - size;
-    grad_cache_end -= size;
-    if(next_items_size) {
-        uint8_t * old = (uint8_t *)c;
-        lv_memcpy(c, ((uint8_t *)c) + size, next_items_size);
-        /* Then need to fix all internal pointers too */
-        while((uint8_t *)c != grad_cache_end) {
-            c->map = (lv_color_t *)(((uint8_t *)c->map) - size);
 #if _DITHER_GRADIENT
-            c->hmap = (lv_color32_t *)(((uint8_t *)c->hmap) - size);
 #if LV_DITHER_ERROR_DIFFUSION == 1
-            c->error_acc = (lv_scolor24_t *)(((uint8_t *)c->error_acc) - size);
-#endif
-#endif
-            c = (lv_grad_t *)(((uint8_t *)c) + get_cache_item_size(c));
+    if(grad->dither == LV_DITHER_ERR_DIFF) {
+        /*Dithered while drawing as the rows depend on the previous ones*/
+        grad->hmap = (lv_color32_t *)data;
+        for(i = 0; i < size; i++) {
+            grad->hmap[i] = lv_gradient_calculate(g, size, i);
         }
-        lv_memset_00(old + next_items_size, size);
+        return grad;
     }
-}
+#endif
 
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
-{
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life == *min_life) {
-        /*Found, let's kill it*/
-        free_item(c);
-        return LV_RES_OK;
+    grad->hmap = lv_mem_buf_get(size * sizeof(lv_color32_t));
+    if(grad->hmap == NULL) {
+        lv_mem_free(grad);
+        return NULL;
     }
-    return LV_RES_INV;
-}
-
-static lv_res_t find_item(lv_grad_t * c, void * ctx)
-{
-    uint32_t * k = (uint32_t *)ctx;
-    if(c->key == *k) return LV_RES_OK;
-    return LV_RES_INV;
-}
-
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
-{
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    lv_coord_t map_size = LV_MAX(w, h); /* The map is being used horizontally (width) unless
-                                           no dithering is selected where it's used vertically */
 
-    size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(map_size * sizeof(lv_color_t));
-#if _DITHER_GRADIENT
-    req_size += ALIGN(size * sizeof(lv_color32_t));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-    req_size += ALIGN(w * sizeof(lv_scolor24_t));
-#endif
-#endif
+    for(i = 0; i < size; i++) {
+        grad->hmap[i] = lv_gradient_calculate(g, size, i);
+    }
 
-    size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
-    lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
-        item = (lv_grad_t *)grad_cache_end;
-        item->not_cached = 0;
+    grad->map = (lv_color_t *)data;
+    if(grad->dither == LV_DITHER_NONE) {
+        lv_dither_none(grad, 0, 0, size);
     }
     else {
-        /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
-            while(act_size + req_size > grad_cache_size) {
-                uint32_t oldest_life = UINT32_MAX;
-                iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
-                iterate_cache(&kill_oldest_item, &oldest_life, NULL);
-                act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
+        /*The ordered dithering repeats in every 8 rows of a horizontal gradient
+         *and in every 8 pixels of the rows of a vertical gradient*/
+        lv_grad_t row = *grad;
+        lv_coord_t row_cnt = grad->dir == LV_GRAD_DIR_HOR ? DITHER_ORDERED_SIZE : size;
+        for(i = 0; i < row_cnt; i++) {
+            if(grad->dir == LV_GRAD_DIR_HOR) {
+                row.map = grad->map + i * size;
+                lv_dither_ordered_hor(&row, 0, i, size);
+            }
+            else {
+                row.map = grad->map + i * DITHER_ORDERED_SIZE;
+                lv_dither_ordered_ver(&row, 0, i, DITHER_ORDERED_SIZE);
             }
-            item = (lv_grad_t *)grad_cache_end;
-            item->not_cached = 0;
-        }
-        else {
-            /*The cache is too small. Allocate the item manually and free it later.*/
-            item = lv_mem_alloc(req_size);
-            LV_ASSERT_MALLOC(item);
-            if(item == NULL) return NULL;
-            item->not_cached = 1;
         }
     }
 
-    item->key = compute_key(g, size, w);
-    item->life = 1;
-    item->filled = 0;
-    item->alloc_size = map_size;
-    item->size = size;
-    if(item->not_cached) {
-        uint8_t * p = (uint8_t *)item;
-        item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
+    lv_mem_buf_release(grad->hmap);
+    grad->hmap = NULL;
+#else
+    grad->map = (lv_color_t *)data;
+    for(i = 0; i < size; i++) {
+        grad->map[i] = lv_gradient_calculate(g, size, i);
     }
-    else {
-        item->map = (lv_color_t *)(grad_cache_end + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
 #endif
-#endif
-        grad_cache_end += req_size;
+
+    return grad;
+}
+
+/**
+ * Store a gradient in the cache. The least recently used gradients are dropped if there is not enough room.
+ * If it can't be cached it's marked as `not_cached`.
+ */
+static void grad_cache_add(const grad_key_t * key, lv_grad_t * grad, size_t item_size)
+{
+    grad->not_cached = 1;
+
+    lv_draw_sw_thread_lock();
+    if(item_size <= grad_cache_size) {
+        if(LV_GC_ROOT(_lv_grad_cache) == NULL) {
+            LV_GC_ROOT(_lv_grad_cache) = lv_lru_create(grad_cache_size, LV_MIN(GRAD_CACHE_AVG_SIZE, grad_cache_size),
+                                                       grad_cache_free, NULL);
+        }
+
+        if(LV_GC_ROOT(_lv_grad_cache) &&
+           lv_lru_set(LV_GC_ROOT(_lv_grad_cache), key, sizeof(grad_key_t), grad, item_size) == LV_LRU_OK) {
+            grad->not_cached = 0;
+        }
     }
-    return item;
+    lv_draw_sw_thread_unlock();
 }
 
+/**
+ * Called by the cache when a gradient is evicted.
+ * The other drawing threads might still use it, in this case it's freed by `lv_gradient_cleanup()`.
+ */
+static void grad_cache_free(void * v)
+{
+    lv_grad_t * grad = v;
+    if(grad->ref_cnt) grad->dropped = 1;
+    else lv_mem_free(grad);
+}
 
 /**********************
  *     FUNCTIONS
  **********************/
 void lv_gradient_free_cache(void)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    LV_GC_ROOT(_lv_grad_cache_mem) = grad_cache_end = NULL;
-    grad_cache_size = 0;
+    lv_draw_sw_thread_lock();
+    if(LV_GC_ROOT(_lv_grad_cache)) {
+        lv_lru_del(LV_GC_ROOT(_lv_grad_cache));
+        LV_GC_ROOT(_lv_grad_cache) = NULL;
+    }
+
+    grad_cache_hit_cnt = 0;
+    grad_cache_miss_cnt = 0;
+    lv_draw_sw_thread_unlock();
 }
 
 void lv_gradient_set_cache_size(size_t max_bytes)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    grad_cache_end = LV_GC_ROOT(_lv_grad_cache_mem) = lv_mem_alloc(max_bytes);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_grad_cache_mem));
-    lv_memset_00(LV_GC_ROOT(_lv_grad_cache_mem), max_bytes);
+    lv_draw_sw_thread_lock();
+    if(LV_GC_ROOT(_lv_grad_cache)) {
+        lv_lru_del(LV_GC_ROOT(_lv_grad_cache));
+        LV_GC_ROOT(_lv_grad_cache) = NULL;
+    }
+
     grad_cache_size = max_bytes;
+    lv_draw_sw_thread_unlock();
+}
+
+void lv_gradient_cache_monitor(lv_grad_cache_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_grad_cache_monitor_t));
+
+    lv_draw_sw_thread_lock();
+    mon_p->hit_cnt = grad_cache_hit_cnt;
+    mon_p->miss_cnt = grad_cache_miss_cnt;
+    mon_p->total_size = grad_cache_size;
+    lv_lru_t * cache = LV_GC_ROOT(_lv_grad_cache);
+    if(cache) mon_p->used_size = cache->total_memory - cache->free_memory;
+    lv_draw_sw_thread_unlock();
 }
 
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
@@ -253,44 +262,142 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 0: Check if the cache exist (else create it) */
-    static bool inited = false;
-    if(!inited) {
-        lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
-        inited = true;
+    grad_key_t key;
+    grad_key(&key, g, w, h);
+
+    /*The cache is shared by the drawing threads.
+     *The used items are referenced so that they are not freed if an other thread evicts them.*/
+    lv_draw_sw_thread_lock();
+    lv_grad_t * grad = NULL;
+    if(LV_GC_ROOT(_lv_grad_cache)) {
+        lv_lru_get(LV_GC_ROOT(_lv_grad_cache), &key, sizeof(grad_key_t), (void **)&grad);
     }
 
-    /* Step 1: Search cache for the given key */
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    uint32_t key = compute_key(g, size, w);
-    lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
-        item->life++; /* Don't forget to bump the counter */
-        return item;
+    if(grad) {
+        grad->ref_cnt++;
+        grad_cache_hit_cnt++;
     }
+    else {
+        grad_cache_miss_cnt++;
+    }
+    lv_draw_sw_thread_unlock();
 
-    /* Step 2: Need to allocate an item for it */
-    item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Faild to allcoate item for teh gradient");
-        return item;
+    if(grad) return grad;
+
+    /*Compute it without blocking the other threads*/
+    size_t item_size;
+    grad = grad_create(g, &key, &item_size);
+    if(grad == NULL) {
+        LV_LOG_WARN("Failed to allocate item for the gradient");
+        return NULL;
     }
 
-    /* Step 3: Fill it with the gradient, as expected */
+    grad->ref_cnt = 1;
+    grad_cache_add(&key, grad, item_size);
+
+    return grad;
+}
+
+void lv_gradient_cleanup(lv_grad_t * grad)
+{
+    if(grad->not_cached) {
+        lv_mem_free(grad);
+        return;
+    }
+
+    lv_draw_sw_thread_lock();
+    grad->ref_cnt--;
+    bool free_it = grad->dropped && grad->ref_cnt == 0;
+    lv_draw_sw_thread_unlock();
+
+    if(free_it) lv_mem_free(grad);
+}
+
+lv_res_t lv_gradient_rows_init(lv_grad_rows_t * rows, lv_grad_t * grad, const lv_area_t * coords, lv_coord_t x1,
+                               lv_coord_t x2)
+{
+    lv_memset_00(rows, sizeof(lv_grad_rows_t));
+    rows->grad = grad;
+    rows->x = x1;
+    rows->x_ofs = x1 - coords->x1;
+    rows->w = lv_area_get_width(coords);
+    rows->draw_w = x2 - x1 + 1;
+    rows->solid = grad->dir == LV_GRAD_DIR_VER && grad->dither == LV_DITHER_NONE;
+
 #if _DITHER_GRADIENT
-    for(lv_coord_t i = 0; i < item->size; i++) {
-        item->hmap[i] = lv_gradient_calculate(g, item->size, i);
+    if(grad->dir == LV_GRAD_DIR_VER && grad->dither == LV_DITHER_ORDERED) {
+        /*The pattern of the rows are repeated to the drawn width*/
+        rows->buf = lv_mem_buf_get(rows->draw_w * sizeof(lv_color_t));
+        if(rows->buf == NULL) return LV_RES_INV;
     }
 #if LV_DITHER_ERROR_DIFFUSION == 1
-    lv_memset_00(item->error_acc, w * sizeof(lv_scolor24_t));
+    else if(grad->dither == LV_DITHER_ERR_DIFF) {
+        /*Each draw diffuses the error from zero so the result doesn't depend on the earlier draws*/
+        lv_coord_t w = grad->dir == LV_GRAD_DIR_HOR ? grad->size : rows->w;
+        rows->diff = *grad;
+        rows->diff.w = w;
+        rows->diff.map = rows->buf = lv_mem_buf_get(w * sizeof(lv_color_t));
+        rows->diff.error_acc = lv_mem_buf_get(w * sizeof(lv_scolor24_t));
+        if(rows->buf == NULL || rows->diff.error_acc == NULL) {
+            lv_gradient_rows_deinit(rows);
+            return LV_RES_INV;
+        }
+        lv_memset_00(rows->diff.error_acc, w * sizeof(lv_scolor24_t));
+    }
 #endif
-#else
-    for(lv_coord_t i = 0; i < item->size; i++) {
-        item->map[i] = lv_gradient_calculate(g, item->size, i);
+#endif
+
+    return LV_RES_OK;
+}
+
+const lv_color_t * LV_ATTRIBUTE_FAST_MEM lv_gradient_rows_get(lv_grad_rows_t * rows, lv_coord_t y)
+{
+    lv_grad_t * grad = rows->grad;
+
+#if _DITHER_GRADIENT
+    if(grad->dither == LV_DITHER_ORDERED) {
+        if(grad->dir == LV_GRAD_DIR_HOR) return grad->map + (y & (DITHER_ORDERED_SIZE - 1)) * grad->size + rows->x_ofs;
+
+        /*Start the pattern of the row at the phase of the first X coordinate, then repeat it*/
+        const lv_color_t * pattern = grad->map + y * DITHER_ORDERED_SIZE;
+        lv_color_t * buf = rows->buf;
+        lv_coord_t filled = LV_MIN(DITHER_ORDERED_SIZE, rows->draw_w);
+        lv_coord_t j;
+        for(j = 0; j < filled; j++) {
+            buf[j] = pattern[(j + rows->x) & (DITHER_ORDERED_SIZE - 1)];
+        }
+        while(filled < rows->draw_w) {
+            lv_coord_t n = LV_MIN(filled, rows->draw_w - filled);
+            lv_memcpy(buf + filled, buf, n * sizeof(lv_color_t));
+            filled += n;
+        }
+        return buf;
     }
+#if LV_DITHER_ERROR_DIFFUSION == 1
+    if(grad->dither == LV_DITHER_ERR_DIFF) {
+        if(grad->dir == LV_GRAD_DIR_HOR) {
+            lv_dither_err_diff_hor(&rows->diff, rows->x, y, grad->size);
+            return rows->buf + rows->x_ofs;
+        }
+        else {
+            lv_dither_err_diff_ver(&rows->diff, rows->x, y, rows->w);
+            return rows->buf;
+        }
+    }
+#endif
 #endif
 
-    return item;
+    if(grad->dir == LV_GRAD_DIR_HOR) return grad->map + rows->x_ofs;
+    else return grad->map + y;
+}
+
+void lv_gradient_rows_deinit(lv_grad_rows_t * rows)
+{
+    if(rows->buf) lv_mem_buf_release(rows->buf);
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+    if(rows->diff.error_acc) lv_mem_buf_release(rows->diff.error_acc);
+#endif
+    rows->buf = NULL;
 }
 
 lv_grad_color_t LV_ATTRIBUTE_FAST_MEM lv_gradient_calculate(const lv_grad_dsc_t * dsc, lv_coord_t range,
@@ -337,10 +444,3 @@ lv_grad_color_t LV_ATTRIBUTE_FAST_MEM lv_gradient_calculate(const lv_grad_dsc_t
                                 LV_UDIV255(two.ch.blue * mix  + one.ch.blue * imix));
     return r;
 }
-
-void lv_gradient_cleanup(lv_grad_t * grad)
-{
-    if(grad->not_cached) {
-        lv_mem_free(grad);
-    }
-}
@@ -34,31 +34,51 @@ typedef lv_color32_t lv_grad_color_t;
 typedef lv_color_t lv_grad_color_t;
 #endif
 
-/** To avoid recomputing gradient for each draw operation,
- *  it's possible to cache the computation in this structure instance.
- *  Whenever possible, this structure is reused instead of recomputing the gradient map */
+/** To avoid recomputing gradient for each draw operation, the computed maps are cached by their stops, direction,
+ *  size and dithering mode. Whenever possible, this structure is reused instead of recomputing the gradient map */
 typedef struct _lv_gradient_cache_t {
-    uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
-                                   * If the key does not match, the cache item is not used */
-    uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
-                                   * less likely to be evicted from the cache */
-    uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
-    uint32_t        not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
-    lv_color_t   *  map;          /**< The computed gradient low bitdepth color map, points into the
-                                   * cache's buffer, no free needed */
-    lv_coord_t      alloc_size;   /**< The map allocated size in colors */
+    lv_color_t   *  map;          /**< The computed gradient low bitdepth color map.
+                                   * With ordered dithering 8 precomputed rows (horizontal gradient) or
+                                   * an 8 pixel pattern per row (vertical gradient). NULL with error diffusion. */
     lv_coord_t      size;         /**< The computed gradient color map size, in colors */
+    uint16_t        ref_cnt;      /**< Number of draws using the item. It's freed only when not used anymore */
+    uint8_t         dir : 3;      /**< Direction of the gradient (`lv_grad_dir_t`) */
+    uint8_t         dither : 3;   /**< Dithering mode (`lv_dither_mode_t`) */
+    uint8_t         not_cached : 1; /**< The cache was too small so this item is not managed by the cache*/
+    uint8_t         dropped : 1;  /**< Evicted from the cache while it was still used*/
 #if _DITHER_GRADIENT
-    lv_color32_t  * hmap;         /**< If dithering, we need to store the current, high bitdepth gradient
-                                   * map too, points to the cache's buffer, no free needed */
+    lv_color32_t  * hmap;         /**< With error diffusion, the high bitdepth gradient map dithered on each draw.
+                                   * Else it's only a temporary map while the item is created.*/
 #if LV_DITHER_ERROR_DIFFUSION == 1
     lv_scolor24_t * error_acc;    /**< Error diffusion dithering algorithm requires storing the last error
-                                   * drawn, points to the cache's buffer, no free needed  */
+                                   * drawn. Only in the per draw copies of `lv_grad_rows_t`.*/
     lv_coord_t      w;            /**< The error array width in pixels */
 #endif
 #endif
 } lv_grad_t;
 
+/** Get the rows of a gradient to draw an area. Dithered rows might be computed or patched for every row.*/
+typedef struct {
+    lv_grad_t  *    grad;         /**< The gradient to draw */
+    lv_color_t *    buf;          /**< Buffer for the rows computed while drawing, or NULL */
+    lv_coord_t      x;            /**< First drawn X coordinate */
+    lv_coord_t      x_ofs;        /**< Offset of `x` from the left side of the gradient's area */
+    lv_coord_t      w;            /**< Width of the gradient's area */
+    lv_coord_t      draw_w;       /**< Number of pixels drawn in a row */
+    bool            solid;        /**< The rows have a single color (vertical gradient without dithering) */
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+    lv_grad_t       diff;         /**< A copy of `grad` with the error diffusion state of this draw */
+#endif
+} lv_grad_rows_t;
+
+/** Statistics of the gradient cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of gradients taken from the cache*/
+    uint32_t miss_cnt;      /**< Number of gradients which had to be computed*/
+    uint32_t used_size;     /**< Size of the cached gradients in bytes*/
+    uint32_t total_size;    /**< Size of the cache in bytes (see `lv_gradient_set_cache_size()`)*/
+} lv_grad_cache_monitor_t;
+
 
 /**********************
  *      PROTOTYPES
@@ -73,23 +93,63 @@ lv_grad_color_t /* LV_ATTRIBUTE_FAST_MEM */ lv_gradient_calculate(const lv_grad_
                                                                   lv_coord_t frac);
 
 /**
- * Set the gradient cache size
- * @param max_bytes Max cahce size
+ * Set the gradient cache size. The cached gradients are dropped.
+ * @param max_bytes Max cache size, 0 to disable caching
  */
 void lv_gradient_set_cache_size(size_t max_bytes);
 
-/** Free the gradient cache */
+/** Free the gradient cache and reset its statistics */
 void lv_gradient_free_cache(void);
 
-/** Get a gradient cache from the given parameters */
+/**
+ * Get statistics about the gradient cache
+ * @param mon_p pointer to a `lv_grad_cache_monitor_t` variable to store the result
+ */
+void lv_gradient_cache_monitor(lv_grad_cache_monitor_t * mon_p);
+
+/**
+ * Get a gradient from the cache or compute it. It can be used by several drawing threads at the same time.
+ * @param gradient  the gradient descriptor
+ * @param w         width of the area to fill
+ * @param h         height of the area to fill
+ * @return          the gradient or NULL if there is no gradient or out of memory.
+ *                  Release it with `lv_gradient_cleanup()`.
+ */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, lv_coord_t w, lv_coord_t h);
 
 /**
- * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
+ * Clean up the gradient item after it was get with `lv_gradient_get`.
  * @param grad      pointer to a gradient
  */
 void lv_gradient_cleanup(lv_grad_t * grad);
 
+/**
+ * Prepare drawing the rows of a gradient
+ * @param rows      the rows to initialize
+ * @param grad      a gradient from `lv_gradient_get()`
+ * @param coords    the area filled by the gradient
+ * @param x1        first drawn X coordinate
+ * @param x2        last drawn X coordinate
+ * @return          LV_RES_OK: ready; LV_RES_INV: out of memory
+ */
+lv_res_t lv_gradient_rows_init(lv_grad_rows_t * rows, lv_grad_t * grad, const lv_area_t * coords, lv_coord_t x1,
+                               lv_coord_t x2);
+
+/**
+ * Get the colors of a row of the gradient, from the first drawn X coordinate.
+ * With error diffusion dithering a row continues the error of the previously get row.
+ * @param rows      the rows initialized with `lv_gradient_rows_init()`
+ * @param y         the row relative to the top of the gradient's area
+ * @return          the colors of the row, or a single color if `rows->solid` is set
+ */
+const lv_color_t * /* LV_ATTRIBUTE_FAST_MEM */ lv_gradient_rows_get(lv_grad_rows_t * rows, lv_coord_t y);
+
+/**
+ * Release the buffers of the rows
+ * @param rows      the rows initialized with `lv_gradient_rows_init()`
+ */
+void lv_gradient_rows_deinit(lv_grad_rows_t * rows);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
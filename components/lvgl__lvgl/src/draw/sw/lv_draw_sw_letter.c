@@ -13,6 +13,7 @@
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
+#include "../../font/lv_font_fmt_txt.h"
 #include "../../core/lv_refr.h"
 
 /*********************
@@ -27,8 +28,15 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static uint8_t * glyph_bitmap_copy(const lv_font_glyph_dsc_t * g, const uint8_t * map_p);
 static void /* LV_ATTRIBUTE_FAST_MEM */ draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                            const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
+static bool letter_blit_possible(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, uint32_t bpp,
+                                 const lv_area_t * letter_area);
+static void /* LV_ATTRIBUTE_FAST_MEM */ blit_row_1bpp(lv_color_t * dest_buf, const uint8_t * map_p, uint32_t bit_ofs,
+                                                      int32_t w, lv_color_t color);
+static void /* LV_ATTRIBUTE_FAST_MEM */ blit_row_4bpp(lv_color_t * dest_buf, const uint8_t * map_p, uint32_t bit_ofs,
+                                                      int32_t w, lv_color_t color);
 
 
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
@@ -133,14 +141,26 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     gpos.y = pos_p->y + (dsc->font->line_height - dsc->font->base_line) - g.box_h - g.ofs_y;
 
     /*If the letter is completely out of mask don't draw it*/
-    if(gpos.x + g.box_w < draw_ctx->clip_area->x1 ||
+    if(gpos.x + g.box_w <= draw_ctx->clip_area->x1 ||
        gpos.x > draw_ctx->clip_area->x2 ||
-       gpos.y + g.box_h < draw_ctx->clip_area->y1 ||
+       gpos.y + g.box_h <= draw_ctx->clip_area->y1 ||
        gpos.y > draw_ctx->clip_area->y2)  {
         return;
     }
 
+    /*Decompressed or rendered bitmaps are in buffers shared by the drawing threads which the next glyph can
+     *overwrite. While the bands are drawn in parallel copy them with the lock held and draw the copy,
+     *else keep them locked while they are drawn. Plain bitmaps are constant.*/
+    lv_draw_sw_thread_lock();
     const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+    bool plain_bitmap = g.resolved_font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt &&
+                        ((lv_font_fmt_txt_dsc_t *)g.resolved_font->dsc)->bitmap_format == LV_FONT_FMT_TXT_PLAIN;
+    uint8_t * map_copy = NULL;
+    if(map_p && !plain_bitmap && lv_draw_sw_thread_is_active()) map_copy = glyph_bitmap_copy(&g, map_p);
+    if(map_copy) map_p = map_copy;
+    bool locked = map_p && !plain_bitmap && map_copy == NULL;
+    if(!locked) lv_draw_sw_thread_unlock();
+
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
         return;
@@ -156,12 +176,37 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     else {
         draw_letter_normal(draw_ctx, dsc, &gpos, &g, map_p);
     }
+
+    if(map_copy) lv_mem_free(map_copy);
+    if(locked) lv_draw_sw_thread_unlock();
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Copy the bitmap of a glyph to draw it without holding the lock of the drawing threads
+ * @param g         the descriptor of the glyph
+ * @param map_p     the bitmap returned by the font
+ * @return          the copy to free with `lv_mem_free()` or NULL if it can't be copied
+ */
+static uint8_t * glyph_bitmap_copy(const lv_font_glyph_dsc_t * g, const uint8_t * map_p)
+{
+#if LV_USE_IMGFONT
+    /*The "bitmap" is an image source*/
+    if(g->bpp == LV_IMGFONT_BPP) return NULL;
+#endif
+
+    uint32_t bpp = g->bpp == 3 ? 4 : g->bpp;
+    uint32_t size = ((uint32_t)g->box_w * g->box_h * bpp + 7) >> 3;
+
+    /*Not a temporary buffer: the glyphs of large fonts (e.g. TTF) might not fit into the arena*/
+    uint8_t * copy = lv_mem_alloc(size);
+    if(copy) lv_memcpy(copy, map_p, size);
+    return copy;
+}
+
 static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p)
 {
@@ -218,9 +263,9 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static LV_DRAW_SW_THREAD_LOCAL lv_opa_t opa_table[256];
+    static LV_DRAW_SW_THREAD_LOCAL lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static LV_DRAW_SW_THREAD_LOCAL uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
@@ -246,6 +291,29 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
 
     /*Move on the map too*/
     uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
+
+    /*Write the common opaque letters without masks directly to the buffer*/
+    lv_area_t letter_area;
+    letter_area.x1 = pos->x + col_start;
+    letter_area.x2 = pos->x + col_end - 1;
+    letter_area.y1 = pos->y + row_start;
+    letter_area.y2 = pos->y + row_end - 1;
+    if(letter_blit_possible(draw_ctx, dsc, bpp, &letter_area)) {
+        if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+        lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+        lv_color_t * dest_buf = draw_ctx->buf;
+        dest_buf += dest_stride * (letter_area.y1 - draw_ctx->buf_area->y1) + (letter_area.x1 - draw_ctx->buf_area->x1);
+        int32_t w = col_end - col_start;
+        for(row = row_start; row < row_end; row++) {
+            if(bpp == 1) blit_row_1bpp(dest_buf, map_p, bit_ofs, w, dsc->color);
+            else blit_row_4bpp(dest_buf, map_p, bit_ofs, w, dsc->color);
+            bit_ofs += width_bit;
+            dest_buf += dest_stride;
+        }
+        return;
+    }
+
     map_p += bit_ofs >> 3;
 
     uint8_t letter_px;
@@ -351,6 +419,117 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     lv_mem_buf_release(mask_buf);
 }
 
+/**
+ * Tell whether a letter can be written directly to the buffer instead of blending its opacity mask.
+ * It gives the same result as `lv_draw_sw_blend_basic()` with an opaque, normal letter if there are no masks.
+ */
+static bool letter_blit_possible(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, uint32_t bpp,
+                                 const lv_area_t * letter_area)
+{
+    if(bpp != 1 && bpp != 4) return false;
+    if(dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+
+    /*E.g. a GPU can have its own blend function*/
+    if(((lv_draw_sw_ctx_t *)draw_ctx)->blend != lv_draw_sw_blend_basic) return false;
+
+    lv_disp_drv_t * drv = _lv_refr_get_disp_refreshing()->driver;
+    if(drv->set_px_cb || drv->screen_transp) return false;
+
+    /*The blend rounds the opacity without anti-aliasing*/
+    if(bpp != 1 && drv->antialiasing == 0) return false;
+
+#if LV_DRAW_COMPLEX
+    if(lv_draw_mask_is_any(letter_area)) return false;
+#else
+    LV_UNUSED(letter_area);
+#endif
+
+    return true;
+}
+
+/**
+ * Write the set pixels of a 1 bpp glyph row. Fully set bytes are collected to runs filled at once.
+ */
+static void LV_ATTRIBUTE_FAST_MEM blit_row_1bpp(lv_color_t * dest_buf, const uint8_t * map_p, uint32_t bit_ofs,
+                                                int32_t w, lv_color_t color)
+{
+    map_p += bit_ofs >> 3;
+    uint32_t shift = bit_ofs & 0x7;
+    int32_t run = 0;
+    int32_t x;
+    for(x = 0; x < w; x += 8) {
+        /*The next max. 8 pixels starting from the MSB*/
+        int32_t n = LV_MIN(8, w - x);
+        uint32_t used = (0xFF00 >> n) & 0xFF;
+        uint32_t bits = (uint32_t)map_p[0] << shift;
+        if(shift + n > 8) bits |= map_p[1] >> (8 - shift);
+        bits &= used;
+        map_p++;
+
+        if(bits == used) {
+            run += n;
+            continue;
+        }
+
+        if(run) {
+            lv_color_fill(&dest_buf[x - run], color, run);
+            run = 0;
+        }
+
+        int32_t i;
+        for(i = 0; bits; i++) {
+            if(bits & 0x80) dest_buf[x + i] = color;
+            bits = (bits << 1) & 0xFF;
+        }
+    }
+
+    if(run) lv_color_fill(&dest_buf[w - run], color, run);
+}
+
+static inline void LV_ATTRIBUTE_FAST_MEM blit_px_4bpp(lv_color_t * dest, uint32_t letter_px, lv_color_t color)
+{
+    if(letter_px == 0xF) *dest = color;
+    else if(letter_px) *dest = lv_color_mix(color, *dest, _lv_bpp4_opa_table[letter_px]);
+}
+
+/**
+ * Write or mix the pixels of a 4 bpp glyph row. Fully set bytes are collected to runs filled at once.
+ */
+static void LV_ATTRIBUTE_FAST_MEM blit_row_4bpp(lv_color_t * dest_buf, const uint8_t * map_p, uint32_t bit_ofs,
+                                                int32_t w, lv_color_t color)
+{
+    map_p += bit_ofs >> 3;
+    int32_t x = 0;
+    if(bit_ofs & 0x4) {
+        blit_px_4bpp(&dest_buf[0], map_p[0] & 0xF, color);
+        map_p++;
+        x++;
+    }
+
+    int32_t run = 0;
+    for(; x + 1 < w; x += 2) {
+        uint32_t letter_px2 = *map_p;
+        map_p++;
+        if(letter_px2 == 0xFF) {
+            run += 2;
+            continue;
+        }
+
+        if(run) {
+            lv_color_fill(&dest_buf[x - run], color, run);
+            run = 0;
+        }
+
+        if(letter_px2) {
+            blit_px_4bpp(&dest_buf[x], letter_px2 >> 4, color);
+            blit_px_4bpp(&dest_buf[x + 1], letter_px2 & 0xF, color);
+        }
+    }
+
+    if(run) lv_color_fill(&dest_buf[x - run], color, run);
+    if(x < w) blit_px_4bpp(&dest_buf[x], map_p[0] >> 4, color);
+}
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p)
@@ -11,6 +11,9 @@
 #include "../../misc/lv_txt_ap.h"
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_lru.h"
+#include "../../misc/lv_mem.h"
 #include "lv_draw_sw_dither.h"
 
 /*********************
@@ -20,16 +23,32 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    /*Used to size the hash table of the shadow cache*/
+    #define SHADOW_CACHE_AVG_SIZE   LV_MIN(1024, LV_SHADOW_CACHE_MEM_SIZE)
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+/*Everything that affects the blurred corner of a shadow*/
+typedef struct {
+    lv_coord_t sw;      /*Shadow width*/
+    lv_coord_t r;       /*Clamped radius*/
+    lv_coord_t w;       /*Size of the blurred rectangle, only as much as it reaches into the corner*/
+    lv_coord_t h;
+} shadow_key_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+#if LV_DRAW_COMPLEX
+static inline void grad_row_get(lv_grad_rows_t * rows, lv_draw_sw_blend_dsc_t * blend_dsc, lv_coord_t y);
+#endif
 static void draw_border(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
@@ -40,6 +59,11 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ draw_shadow(lv_draw_ctx_t * draw_ctx, co
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf,
                                                                lv_coord_t s, lv_coord_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE
+    static void shadow_cache_key(shadow_key_t * key, const lv_area_t * coords, lv_coord_t sw, lv_coord_t r);
+    static bool shadow_cache_get(const shadow_key_t * key, lv_opa_t * sh_buf, uint32_t size);
+    static void shadow_cache_add(const shadow_key_t * key, const lv_opa_t * sh_buf, uint32_t size);
+#endif
 #endif
 
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
@@ -52,10 +76,9 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    static uint32_t shadow_cache_hit_cnt;
+    static uint32_t shadow_cache_miss_cnt;
 #endif
 
 /**********************
@@ -92,6 +115,43 @@ void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, con
     draw_bg_img(draw_ctx, dsc, coords);
 }
 
+/**
+ * Get statistics about the shadow cache
+ * @param mon_p pointer to a `lv_draw_sw_shadow_cache_monitor_t` variable to store the result
+ */
+void lv_draw_sw_shadow_cache_monitor(lv_draw_sw_shadow_cache_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_draw_sw_shadow_cache_monitor_t));
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    lv_draw_sw_thread_lock();
+    mon_p->hit_cnt = shadow_cache_hit_cnt;
+    mon_p->miss_cnt = shadow_cache_miss_cnt;
+    mon_p->total_size = LV_SHADOW_CACHE_MEM_SIZE;
+    lv_lru_t * cache = LV_GC_ROOT(_lv_shadow_cache);
+    if(cache) mon_p->used_size = cache->total_memory - cache->free_memory;
+    lv_draw_sw_thread_unlock();
+#endif
+}
+
+/**
+ * Drop all the cached shadow corners and reset the statistics.
+ */
+void lv_draw_sw_shadow_cache_clear(void)
+{
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    lv_draw_sw_thread_lock();
+    if(LV_GC_ROOT(_lv_shadow_cache)) {
+        lv_lru_del(LV_GC_ROOT(_lv_shadow_cache));
+        LV_GC_ROOT(_lv_shadow_cache) = NULL;
+    }
+
+    shadow_cache_hit_cnt = 0;
+    shadow_cache_miss_cnt = 0;
+    lv_draw_sw_thread_unlock();
+#endif
+}
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -156,6 +216,8 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     }
 
     int32_t h;
+    lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+    uint32_t span_cnt;
 
     lv_area_t blend_area;
     blend_area.x1 = clipped_coords.x1;
@@ -167,55 +229,14 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     blend_dsc.opa = LV_OPA_COVER;
 
 
-    /*Get gradient if appropriate*/
-    lv_grad_t * grad = lv_gradient_get(&dsc->bg_grad, coords_bg_w, coords_bg_h);
-    if(grad && grad_dir == LV_GRAD_DIR_HOR) {
-        blend_dsc.src_buf = grad->map + clipped_coords.x1 - bg_coords.x1;
-    }
-
-#if _DITHER_GRADIENT
-    lv_dither_mode_t dither_mode = dsc->bg_grad.dither;
-    lv_dither_func_t dither_func = &lv_dither_none;
-    lv_coord_t grad_size = coords_bg_w;
-    if(grad_dir == LV_GRAD_DIR_VER && dither_mode != LV_DITHER_NONE) {
-        /* When dithering, we are still using a map that's changing from line to line*/
-        blend_dsc.src_buf = grad->map;
-    }
-
-    if(grad && dither_mode == LV_DITHER_NONE) {
-        grad->filled = 0; /*Should we force refilling it each draw call ?*/
-        if(grad_dir == LV_GRAD_DIR_VER)
-            grad_size = coords_bg_h;
+    /*Get gradient if appropriate.
+     *The cached gradients are shared by the drawing threads, the dithered rows are computed per draw if required.*/
+    lv_grad_t * grad = grad_dir != LV_GRAD_DIR_NONE ? lv_gradient_get(&dsc->bg_grad, coords_bg_w, coords_bg_h) : NULL;
+    lv_grad_rows_t grad_rows;
+    if(grad && lv_gradient_rows_init(&grad_rows, grad, &bg_coords, clipped_coords.x1, clipped_coords.x2) != LV_RES_OK) {
+        lv_gradient_cleanup(grad);
+        grad = NULL;
     }
-    else
-#if LV_DITHER_ERROR_DIFFUSION
-        if(dither_mode == LV_DITHER_ORDERED)
-#endif
-            switch(grad_dir) {
-                case LV_GRAD_DIR_HOR:
-                    dither_func = lv_dither_ordered_hor;
-                    break;
-                case LV_GRAD_DIR_VER:
-                    dither_func = lv_dither_ordered_ver;
-                    break;
-                default:
-                    dither_func = NULL;
-            }
-
-#if LV_DITHER_ERROR_DIFFUSION
-        else if(dither_mode == LV_DITHER_ERR_DIFF)
-            switch(grad_dir) {
-                case LV_GRAD_DIR_HOR:
-                    dither_func = lv_dither_err_diff_hor;
-                    break;
-                case LV_GRAD_DIR_VER:
-                    dither_func = lv_dither_err_diff_ver;
-                    break;
-                default:
-                    dither_func = NULL;
-            }
-#endif
-#endif
 
     /*There is another mask too. Draw line by line. */
     if(mask_any) {
@@ -225,15 +246,10 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
 
             /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
              * It saves calculating the final opa in lv_draw_sw_blend*/
-            lv_memset(mask_buf, opa, clipped_w);
-            blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, clipped_coords.x1, h, clipped_w);
-            if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            span_cnt = lv_draw_mask_apply_spans(mask_buf, clipped_coords.x1, h, clipped_w, opa, spans);
 
-#if _DITHER_GRADIENT
-            if(dither_func) dither_func(grad, blend_area.x1,  h - bg_coords.y1, grad_size);
-#endif
-            if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[h - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            if(grad) grad_row_get(&grad_rows, &blend_dsc, h - bg_coords.y1);
+            lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, opa);
         }
         goto bg_clean_up;
     }
@@ -247,30 +263,22 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
 
         /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
          * It saves calculating the final opa in lv_draw_sw_blend*/
-        lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, clipped_w);
-        if(blend_dsc.mask_res == LV_DRAW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        span_cnt = lv_draw_mask_apply_spans(mask_buf, blend_area.x1, top_y, clipped_w, opa, spans);
 
         if(top_y >= clipped_coords.y1) {
             blend_area.y1 = top_y;
             blend_area.y2 = top_y;
 
-#if _DITHER_GRADIENT
-            if(dither_func) dither_func(grad, blend_area.x1,  top_y - bg_coords.y1, grad_size);
-#endif
-            if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[top_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            if(grad) grad_row_get(&grad_rows, &blend_dsc, top_y - bg_coords.y1);
+            lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, opa);
         }
 
         if(bottom_y <= clipped_coords.y2) {
             blend_area.y1 = bottom_y;
             blend_area.y2 = bottom_y;
 
-#if _DITHER_GRADIENT
-            if(dither_func) dither_func(grad, blend_area.x1,  bottom_y - bg_coords.y1, grad_size);
-#endif
-            if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[bottom_y - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            if(grad) grad_row_get(&grad_rows, &blend_dsc, bottom_y - bg_coords.y1);
+            lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, opa);
         }
     }
 
@@ -298,18 +306,15 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
         for(h = bg_coords.y1 + rout; h <= h_end; h++) {
             /*If there is no other mask do not apply mask as in the center there is no radius to mask*/
             if(mask_any_center) {
-                lv_memset(mask_buf, opa, clipped_w);
-                blend_dsc.mask_res = lv_draw_mask_apply(mask_buf, clipped_coords.x1, h, clipped_w);
+                span_cnt = lv_draw_mask_apply_spans(mask_buf, clipped_coords.x1, h, clipped_w, opa, spans);
             }
 
             blend_area.y1 = h;
             blend_area.y2 = h;
 
-#if _DITHER_GRADIENT
-            if(dither_func) dither_func(grad, blend_area.x1,  h - bg_coords.y1, grad_size);
-#endif
-            if(grad_dir == LV_GRAD_DIR_VER) blend_dsc.color = grad->map[h - bg_coords.y1];
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            if(grad) grad_row_get(&grad_rows, &blend_dsc, h - bg_coords.y1);
+            if(mask_any_center) lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, opa);
+            else lv_draw_sw_blend(draw_ctx, &blend_dsc);
         }
     }
 
@@ -321,12 +326,28 @@ bg_clean_up:
         lv_draw_mask_free_param(&mask_rout_param);
     }
     if(grad) {
+        lv_gradient_rows_deinit(&grad_rows);
         lv_gradient_cleanup(grad);
     }
 
 #endif
 }
 
+#if LV_DRAW_COMPLEX
+/**
+ * Set the colors of a gradient's row in the blend descriptor
+ * @param rows      the rows of the gradient
+ * @param blend_dsc the blend descriptor
+ * @param y         the row relative to the top of the gradient's area
+ */
+static inline void grad_row_get(lv_grad_rows_t * rows, lv_draw_sw_blend_dsc_t * blend_dsc, lv_coord_t y)
+{
+    const lv_color_t * colors = lv_gradient_rows_get(rows, y);
+    if(rows->solid) blend_dsc->color = colors[0];
+    else blend_dsc->src_buf = colors;
+}
+#endif
+
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->bg_img_src == NULL) return;
@@ -486,22 +507,18 @@ static void LV_ATTRIBUTE_FAST_MEM draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+    /*A larger buffer is required for calculation*/
+    sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
+    if(corner_size <= LV_SHADOW_CACHE_SIZE) {
+        shadow_key_t key;
+        shadow_cache_key(&key, &core_area, dsc->shadow_width, r_sh);
+        if(!shadow_cache_get(&key, sh_buf, corner_size * corner_size)) {
+            shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
+            shadow_cache_add(&key, sh_buf, corner_size * corner_size);
+        }
     }
     else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
     }
 #else
     sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1109,6 +1126,78 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(lv_coord_t size, lv_coord_t
 
     lv_mem_buf_release(sh_ups_blur_buf);
 }
+
+#if LV_SHADOW_CACHE_SIZE
+/**
+ * Get the key of a shadow corner in the cache.
+ * The parameters are the same as `shadow_draw_corner_buf()`'s.
+ */
+static void shadow_cache_key(shadow_key_t * key, const lv_area_t * coords, lv_coord_t sw, lv_coord_t r)
+{
+    lv_memset_00(key, sizeof(shadow_key_t));    /*Clear the padding too as it's part of the key*/
+    key->sw = sw;
+    key->r = r;
+
+    /*In `shadow_draw_corner_buf()` the right and top edges of the rectangle are fixed in the corner.
+     *A wider or taller rectangle gives the same corner if its other corners are out of the buffer
+     *because the blur repeats the edge pixels.*/
+    lv_coord_t size = sw + r;
+    lv_coord_t x2 = sw / 2 + r - 1 - ((sw & 1) ? 0 : 1);
+    lv_coord_t y1 = sw / 2 + 1;
+    key->w = LV_MIN(lv_area_get_width(coords), x2 + r + 1);
+    key->h = LV_MIN(lv_area_get_height(coords), size + r - y1);
+}
+
+/**
+ * Copy a cached corner to `sh_buf`
+ * @return true: found in the cache; false: not cached
+ */
+static bool shadow_cache_get(const shadow_key_t * key, lv_opa_t * sh_buf, uint32_t size)
+{
+    /*The cache is shared by the drawing threads*/
+    lv_draw_sw_thread_lock();
+    lv_opa_t * cached = NULL;
+    if(LV_GC_ROOT(_lv_shadow_cache)) {
+        lv_lru_get(LV_GC_ROOT(_lv_shadow_cache), key, sizeof(shadow_key_t), (void **)&cached);
+    }
+
+    if(cached) {
+        lv_memcpy(sh_buf, cached, size);
+        shadow_cache_hit_cnt++;
+    }
+    else {
+        shadow_cache_miss_cnt++;
+    }
+    lv_draw_sw_thread_unlock();
+
+    return cached != NULL;
+}
+
+/**
+ * Store a copy of a calculated corner. The least recently used corners are dropped if there is not enough room.
+ */
+static void shadow_cache_add(const shadow_key_t * key, const lv_opa_t * sh_buf, uint32_t size)
+{
+    if(size > LV_SHADOW_CACHE_MEM_SIZE) return;
+
+    /*Large, long lived buffers, e.g. in external RAM*/
+    lv_opa_t * cached = lv_mem_ext_alloc(size);
+    if(cached == NULL) return;
+    lv_memcpy(cached, sh_buf, size);
+
+    lv_draw_sw_thread_lock();
+    if(LV_GC_ROOT(_lv_shadow_cache) == NULL) {
+        LV_GC_ROOT(_lv_shadow_cache) = lv_lru_create(LV_SHADOW_CACHE_MEM_SIZE, SHADOW_CACHE_AVG_SIZE, lv_mem_ext_free,
+                                                     NULL);
+    }
+
+    if(LV_GC_ROOT(_lv_shadow_cache) == NULL ||
+       lv_lru_set(LV_GC_ROOT(_lv_shadow_cache), key, sizeof(shadow_key_t), cached, size) != LV_LRU_OK) {
+        lv_mem_ext_free(cached);
+    }
+    lv_draw_sw_thread_unlock();
+}
+#endif /*LV_SHADOW_CACHE_SIZE*/
 #endif
 
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
@@ -1191,6 +1280,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
     int16_t mask_rin_id = lv_draw_mask_add(&mask_rin_param, NULL);
 
     int32_t h;
+    lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+    uint32_t span_cnt;
     lv_area_t blend_area;
     blend_dsc.blend_area = &blend_area;
     blend_dsc.mask_area = &blend_area;
@@ -1220,9 +1311,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
             blend_area.y1 = h;
             blend_area.y2 = h;
 
-            lv_memset_ff(blend_dsc.mask_buf, draw_area_w);
-            blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, draw_area.x1, h, draw_area_w);
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            span_cnt = lv_draw_mask_apply_spans(blend_dsc.mask_buf, draw_area.x1, h, draw_area_w, LV_OPA_COVER, spans);
+            lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
         }
 
         lv_draw_mask_free_param(&mask_rin_param);
@@ -1293,19 +1383,18 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
             lv_coord_t bottom_y = outer_area->y2 - h;
             if(top_y < draw_area.y1 && bottom_y > draw_area.y2) continue;   /*This line is clipped now*/
 
-            lv_memset_ff(blend_dsc.mask_buf, draw_area_w);
-            blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, top_y, draw_area_w);
+            span_cnt = lv_draw_mask_apply_spans(blend_dsc.mask_buf, blend_area.x1, top_y, draw_area_w, LV_OPA_COVER, spans);
 
             if(top_y >= draw_area.y1) {
                 blend_area.y1 = top_y;
                 blend_area.y2 = top_y;
-                lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
             }
 
             if(bottom_y <= draw_area.y2) {
                 blend_area.y1 = bottom_y;
                 blend_area.y2 = bottom_y;
-                lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
             }
         }
     }
@@ -1320,9 +1409,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset_ff(blend_dsc.mask_buf, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                    span_cnt = lv_draw_mask_apply_spans(blend_dsc.mask_buf, blend_area.x1, h, blend_w, LV_OPA_COVER, spans);
+                    lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
                 }
             }
 
@@ -1331,9 +1419,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset_ff(blend_dsc.mask_buf, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                    span_cnt = lv_draw_mask_apply_spans(blend_dsc.mask_buf, blend_area.x1, h, blend_w, LV_OPA_COVER, spans);
+                    lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
                 }
             }
         }
@@ -1349,9 +1436,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset_ff(blend_dsc.mask_buf, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                    span_cnt = lv_draw_mask_apply_spans(blend_dsc.mask_buf, blend_area.x1, h, blend_w, LV_OPA_COVER, spans);
+                    lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
                 }
             }
 
@@ -1360,9 +1446,8 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
                     blend_area.y1 = h;
                     blend_area.y2 = h;
 
-                    lv_memset_ff(blend_dsc.mask_buf, blend_w);
-                    blend_dsc.mask_res = lv_draw_mask_apply(blend_dsc.mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                    span_cnt = lv_draw_mask_apply_spans(blend_dsc.mask_buf, blend_area.x1, h, blend_w, LV_OPA_COVER, spans);
+                    lv_draw_sw_blend_spans(draw_ctx, &blend_dsc, spans, span_cnt, LV_OPA_COVER);
                 }
             }
         }
@@ -0,0 +1,308 @@
+/**
+ * @file lv_draw_sw_rotate.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_rotate.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_log.h"
+#include "../../misc/lv_mem.h"
+#include <string.h>
+
+#if defined(__SSE2__) && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+    #include <emmintrin.h>
+    #define ROTATE_SSE2 1
+#else
+    #define ROTATE_SSE2 0
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Pixels transposed at once*/
+#define TILE    8
+
+/*Blocks of this many pixels are transposed together so that the cache lines of the
+ *destination rows are completely written before they are evicted. Multiple of TILE.*/
+#define BLOCK   32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void transpose(const lv_color_t * src, int32_t src_step, lv_color_t * dest, int32_t dest_step,
+                      int32_t w, int32_t h);
+static void transpose_sqr(lv_color_t * buf, int32_t w, int32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_rotate(const lv_color_t * src, lv_color_t * dest, lv_coord_t src_w, lv_coord_t src_h,
+                       lv_coord_t src_stride, lv_coord_t dest_stride, lv_disp_rot_t rotation)
+{
+    int32_t y;
+    switch(rotation) {
+        case LV_DISP_ROT_NONE:
+            for(y = 0; y < src_h; y++) {
+                lv_memcpy(dest + y * dest_stride, src + y * src_stride, src_w * sizeof(lv_color_t));
+            }
+            break;
+        case LV_DISP_ROT_180:
+            for(y = 0; y < src_h; y++) {
+                const lv_color_t * s = src + y * src_stride;
+                lv_color_t * d = dest + (src_h - 1 - y) * dest_stride + src_w - 1;
+                int32_t x;
+                for(x = 0; x < src_w; x++) d[-x] = s[x];
+            }
+            break;
+        case LV_DISP_ROT_90:
+            /*The columns of `src` are the rows of `dest` from bottom to top*/
+            transpose(src, src_stride, dest + (src_w - 1) * dest_stride, -dest_stride, src_w, src_h);
+            break;
+        case LV_DISP_ROT_270:
+            /*The columns of `src` read from bottom to top are the rows of `dest`*/
+            transpose(src + (src_h - 1) * src_stride, -src_stride, dest, dest_stride, src_w, src_h);
+            break;
+    }
+}
+
+void lv_draw_sw_rotate_sqr(lv_color_t * buf, lv_coord_t w, lv_coord_t stride, lv_disp_rot_t rotation)
+{
+    if(rotation != LV_DISP_ROT_90 && rotation != LV_DISP_ROT_270) {
+        LV_LOG_WARN("only 90 and 270 degrees are supported");
+        return;
+    }
+
+    transpose_sqr(buf, w, stride);
+
+    int32_t y;
+    if(rotation == LV_DISP_ROT_90) {
+        /*Mirror vertically*/
+        for(y = 0; y < w / 2; y++) {
+            lv_color_t * a = buf + y * stride;
+            lv_color_t * b = buf + (w - 1 - y) * stride;
+            int32_t x;
+            for(x = 0; x < w; x++) {
+                lv_color_t tmp = a[x];
+                a[x] = b[x];
+                b[x] = tmp;
+            }
+        }
+    }
+    else {
+        /*Mirror horizontally*/
+        for(y = 0; y < w; y++) {
+            lv_color_t * a = buf + y * stride;
+            int32_t x;
+            for(x = 0; x < w / 2; x++) {
+                lv_color_t tmp = a[x];
+                a[x] = a[w - 1 - x];
+                a[w - 1 - x] = tmp;
+            }
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*
+ * transpose_tile(): transpose a tile of TILE x TILE pixels: row `i` of `dest` will be column `i` of `src`.
+ * `src_step` is the distance of the rows of the tile in pixels, negative to read the rows upwards.
+ * `dest_step` is the distance of the rows of the transposed tile, negative to write the rows upwards.
+ */
+#if ROTATE_SSE2 && LV_COLOR_DEPTH == 16
+
+#define LOAD(i)         _mm_loadu_si128((const __m128i *)(src + (i) * src_step))
+#define STORE(i, v)     _mm_storeu_si128((__m128i *)(dest + (i) * dest_step), v)
+
+static inline void transpose_tile(const lv_color_t * src, int32_t src_step, lv_color_t * dest, int32_t dest_step)
+{
+    __m128i a0 = LOAD(0), a1 = LOAD(1), a2 = LOAD(2), a3 = LOAD(3);
+    __m128i a4 = LOAD(4), a5 = LOAD(5), a6 = LOAD(6), a7 = LOAD(7);
+
+    /*Pairs of pixels, then quads of the same columns*/
+    __m128i b0 = _mm_unpacklo_epi16(a0, a1), b1 = _mm_unpackhi_epi16(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi16(a2, a3), b3 = _mm_unpackhi_epi16(a2, a3);
+    __m128i b4 = _mm_unpacklo_epi16(a4, a5), b5 = _mm_unpackhi_epi16(a4, a5);
+    __m128i b6 = _mm_unpacklo_epi16(a6, a7), b7 = _mm_unpackhi_epi16(a6, a7);
+
+    __m128i c0 = _mm_unpacklo_epi32(b0, b2), c1 = _mm_unpackhi_epi32(b0, b2);
+    __m128i c2 = _mm_unpacklo_epi32(b1, b3), c3 = _mm_unpackhi_epi32(b1, b3);
+    __m128i c4 = _mm_unpacklo_epi32(b4, b6), c5 = _mm_unpackhi_epi32(b4, b6);
+    __m128i c6 = _mm_unpacklo_epi32(b5, b7), c7 = _mm_unpackhi_epi32(b5, b7);
+
+    STORE(0, _mm_unpacklo_epi64(c0, c4));
+    STORE(1, _mm_unpackhi_epi64(c0, c4));
+    STORE(2, _mm_unpacklo_epi64(c1, c5));
+    STORE(3, _mm_unpackhi_epi64(c1, c5));
+    STORE(4, _mm_unpacklo_epi64(c2, c6));
+    STORE(5, _mm_unpackhi_epi64(c2, c6));
+    STORE(6, _mm_unpacklo_epi64(c3, c7));
+    STORE(7, _mm_unpackhi_epi64(c3, c7));
+}
+
+#elif ROTATE_SSE2 && LV_COLOR_DEPTH == 32
+
+#define LOAD(i)         _mm_loadu_si128((const __m128i *)(src + (i) * src_step))
+#define STORE(i, v)     _mm_storeu_si128((__m128i *)(dest + (i) * dest_step), v)
+
+static inline void transpose_4x4(const lv_color_t * src, int32_t src_step, lv_color_t * dest, int32_t dest_step)
+{
+    __m128i a0 = LOAD(0), a1 = LOAD(1), a2 = LOAD(2), a3 = LOAD(3);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a1), b1 = _mm_unpacklo_epi32(a2, a3);
+    __m128i b2 = _mm_unpackhi_epi32(a0, a1), b3 = _mm_unpackhi_epi32(a2, a3);
+
+    STORE(0, _mm_unpacklo_epi64(b0, b1));
+    STORE(1, _mm_unpackhi_epi64(b0, b1));
+    STORE(2, _mm_unpacklo_epi64(b2, b3));
+    STORE(3, _mm_unpackhi_epi64(b2, b3));
+}
+
+/*The 8x8 tile is transposed as four 4x4 tiles*/
+static inline void transpose_tile(const lv_color_t * src, int32_t src_step, lv_color_t * dest, int32_t dest_step)
+{
+    transpose_4x4(src, src_step, dest, dest_step);
+    transpose_4x4(src + 4, src_step, dest + 4 * dest_step, dest_step);
+    transpose_4x4(src + 4 * src_step, src_step, dest + 4, dest_step);
+    transpose_4x4(src + 4 * src_step + 4, src_step, dest + 4 * dest_step + 4, dest_step);
+}
+
+#else
+
+/*Scalar version for the other color depths and the CPUs without SSE2*/
+static inline void transpose_tile(const lv_color_t * src, int32_t src_step, lv_color_t * dest, int32_t dest_step)
+{
+    /*Read the rows of the tile once into registers and write the transposed rows one by one*/
+    lv_color_t px[TILE][TILE];
+    int32_t i;
+    for(i = 0; i < TILE; i++) memcpy(px[i], src + i * src_step, sizeof(px[i]));
+
+    for(i = 0; i < TILE; i++) {
+        lv_color_t * d = dest + i * dest_step;
+        d[0] = px[0][i];
+        d[1] = px[1][i];
+        d[2] = px[2][i];
+        d[3] = px[3][i];
+        d[4] = px[4][i];
+        d[5] = px[5][i];
+        d[6] = px[6][i];
+        d[7] = px[7][i];
+    }
+}
+
+#endif
+
+/**
+ * Transpose the pixels which don't fill a whole tile
+ */
+static void transpose_px(const lv_color_t * src, int32_t src_step, lv_color_t * dest, int32_t dest_step,
+                         int32_t w, int32_t h)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_color_t * d = dest + x * dest_step;
+        int32_t y;
+        for(y = 0; y < h; y++) d[y] = src[y * src_step + x];
+    }
+}
+
+/**
+ * Transpose an image: row `i` of `dest` will be column `i` of `src`.
+ * @param src           pointer to the first pixel of the image
+ * @param src_step      distance of the rows of the image in pixels, negative to read the rows upwards
+ * @param dest          pointer to the first pixel of the transposed image
+ * @param dest_step     distance of the rows of the transposed image, negative to write the rows upwards
+ * @param w             width of the image in pixels
+ * @param h             height of the image in pixels
+ */
+static void LV_ATTRIBUTE_FAST_MEM transpose(const lv_color_t * src, int32_t src_step,
+                                           lv_color_t * dest, int32_t dest_step, int32_t w, int32_t h)
+{
+    int32_t by;
+    for(by = 0; by < h; by += BLOCK) {
+        int32_t bh = LV_MIN(BLOCK, h - by);
+        int32_t tile_h = bh - bh % TILE;
+        int32_t bx;
+        for(bx = 0; bx < w; bx += BLOCK) {
+            int32_t bw = LV_MIN(BLOCK, w - bx);
+            int32_t tile_w = bw - bw % TILE;
+            const lv_color_t * s = src + by * src_step + bx;
+            lv_color_t * d = dest + bx * dest_step + by;
+
+            int32_t ty;
+            for(ty = 0; ty < tile_h; ty += TILE) {
+                int32_t tx;
+                for(tx = 0; tx < tile_w; tx += TILE) {
+                    transpose_tile(s + ty * src_step + tx, src_step, d + tx * dest_step + ty, dest_step);
+                }
+            }
+
+            /*The right and bottom edges of the block*/
+            if(tile_w < bw) transpose_px(s + tile_w, src_step, d + tile_w * dest_step, dest_step, bw - tile_w, bh);
+            if(tile_h < bh) transpose_px(s + tile_h * src_step, src_step, d + tile_h, dest_step, tile_w, bh - tile_h);
+        }
+    }
+}
+
+/**
+ * Transpose a square image in place
+ * @param buf           pointer to the image
+ * @param w             width and height of the image
+ * @param stride        distance of the rows in pixels
+ */
+static void LV_ATTRIBUTE_FAST_MEM transpose_sqr(lv_color_t * buf, int32_t w, int32_t stride)
+{
+    lv_color_t tmp[TILE * TILE];
+    int32_t tile_w = w - w % TILE;
+
+    /*Swap the transposed tiles above the diagonal with the ones below it*/
+    int32_t by;
+    for(by = 0; by < tile_w; by += BLOCK) {
+        int32_t by_end = LV_MIN(by + BLOCK, tile_w);
+        int32_t bx;
+        for(bx = by; bx < tile_w; bx += BLOCK) {
+            int32_t bx_end = LV_MIN(bx + BLOCK, tile_w);
+            int32_t ty;
+            for(ty = by; ty < by_end; ty += TILE) {
+                int32_t tx;
+                for(tx = bx == by ? ty : bx; tx < bx_end; tx += TILE) {
+                    lv_color_t * a = buf + ty * stride + tx;
+                    lv_color_t * b = buf + tx * stride + ty;
+                    transpose_tile(a, stride, tmp, TILE);
+                    if(a != b) transpose_tile(b, stride, a, stride);
+                    int32_t i;
+                    for(i = 0; i < TILE; i++) memcpy(b + i * stride, tmp + i * TILE, TILE * sizeof(lv_color_t));
+                }
+            }
+        }
+    }
+
+    /*The last columns with the last rows*/
+    int32_t y;
+    for(y = 0; y < w; y++) {
+        int32_t x;
+        for(x = LV_MAX(tile_w, y + 1); x < w; x++) {
+            lv_color_t c = buf[y * stride + x];
+            buf[y * stride + x] = buf[x * stride + y];
+            buf[x * stride + y] = c;
+        }
+    }
+}
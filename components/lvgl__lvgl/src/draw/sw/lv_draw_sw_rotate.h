@@ -0,0 +1,67 @@
+/**
+ * @file lv_draw_sw_rotate.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_ROTATE_H
+#define LV_DRAW_SW_ROTATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+#include "../../misc/lv_area.h"
+#include "../../hal/lv_hal_disp.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Rotate an image into an other buffer.
+ * The image is processed in tiles which fit into the cache and the tiles are transposed
+ * 8x8 pixels at once (with SSE2 if available).
+ * @param src           pointer to the image to rotate
+ * @param dest          pointer to the buffer of the rotated image.
+ *                      With 90 and 270 degrees it's `src_h` wide and `src_w` high.
+ * @param src_w         width of the image in pixels
+ * @param src_h         height of the image in pixels
+ * @param src_stride    distance of the rows of `src` in pixels
+ * @param dest_stride   distance of the rows of `dest` in pixels
+ * @param rotation      `LV_DISP_ROT_90`: counter-clockwise, `LV_DISP_ROT_180` or `LV_DISP_ROT_270`: clockwise.
+ *                      This is how the draw buffer is rotated to the native orientation of a display
+ *                      with `lv_disp_drv_t::rotated = rotation`.
+ */
+void lv_draw_sw_rotate(const lv_color_t * src, lv_color_t * dest, lv_coord_t src_w, lv_coord_t src_h,
+                       lv_coord_t src_stride, lv_coord_t dest_stride, lv_disp_rot_t rotation);
+
+/**
+ * Rotate a square image in place.
+ * @param buf           pointer to the image
+ * @param w             width and height of the image in pixels
+ * @param stride        distance of the rows of `buf` in pixels
+ * @param rotation      `LV_DISP_ROT_90` or `LV_DISP_ROT_270`, see `lv_draw_sw_rotate()`
+ */
+void lv_draw_sw_rotate_sqr(lv_color_t * buf, lv_coord_t w, lv_coord_t stride, lv_disp_rot_t rotation);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_ROTATE_H*/
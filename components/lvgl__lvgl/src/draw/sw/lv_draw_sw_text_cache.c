@@ -0,0 +1,361 @@
+/**
+ * @file lv_draw_sw_text_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+#include "../../core/lv_refr.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_lru.h"
+#include "../../misc/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_TEXT_CACHE_SIZE
+    /*Used to size the hash table of the cache*/
+    #define TEXT_CACHE_AVG_SIZE LV_MIN(4096, LV_TEXT_CACHE_SIZE)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_TEXT_CACHE_SIZE
+/*Everything that affects the opacity map of a text. It's followed by the text itself in the key.*/
+typedef struct {
+    const lv_font_t * font;
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t line_space;
+    lv_coord_t letter_space;
+    lv_coord_t ofs_x;
+    lv_coord_t ofs_y;
+    lv_base_dir_t bidi_dir;
+    lv_text_align_t align;
+    lv_text_flag_t flag;
+} text_key_t;
+
+/*Draw context to render a text into an opacity map instead of a color buffer*/
+typedef struct {
+    lv_draw_sw_ctx_t sw_ctx;
+    bool failed;
+} record_ctx_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_TEXT_CACHE_SIZE
+    static lv_opa_t * text_record(const lv_draw_label_dsc_t * dsc, const lv_area_t * coords, const char * txt);
+    static void record_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                              uint32_t letter);
+    static void record_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+    static void record_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                   const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format);
+    static void record_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+    static void text_free(void * surface);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_TEXT_CACHE_SIZE
+    static uint32_t text_cache_hit_cnt;
+    static uint32_t text_cache_miss_cnt;
+
+    /*Stored for the texts which can't be cached (e.g. they are drawn out of their area or the letters overlap)
+     *to not try recording them again and again*/
+    static lv_opa_t not_cacheable;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Draw a text from its cached opacity map if possible. Render and cache the opacity map if it's not cached yet.
+ * @param draw_ctx pointer to a draw context
+ * @param dsc pointer to draw descriptor
+ * @param coords coordinates of the label
+ * @param txt `\0` terminated text to write
+ * @return true: the text is drawn; false: the text can't be cached, draw it letter by letter
+ */
+bool lv_draw_sw_text_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                                const char * txt)
+{
+#if LV_TEXT_CACHE_SIZE
+    /*Only the software renderer's letters can be recorded. The opacity map can't hold different colors
+     *and the opacity needs to be applied on each letter to get the same result as without cache.*/
+    if(draw_ctx->draw_letter != lv_draw_sw_letter) return false;
+    if(dsc->opa < LV_OPA_MAX) return false;
+    if(dsc->flag & LV_TEXT_FLAG_RECOLOR) return false;
+    if(dsc->decor != LV_TEXT_DECOR_NONE) return false;
+    if(dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) return false;
+
+    lv_coord_t w = lv_area_get_width(coords);
+    lv_coord_t h = lv_area_get_height(coords);
+    if(w <= 0 || h <= 0 || (uint32_t)w * h > LV_TEXT_CACHE_SIZE) return false;
+
+    /*Without anti-aliasing the blending would round the values of the opacity map in place*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL || disp->driver->antialiasing == 0) return false;
+
+    /*The masks are applied on the letters one by one*/
+    if(lv_draw_mask_is_any(coords)) return false;
+
+    size_t txt_len = strlen(txt);
+    size_t key_size = sizeof(text_key_t) + txt_len;
+    uint8_t * key_buf = lv_mem_buf_get(key_size);
+    if(key_buf == NULL) return false;
+
+    /*The cache is shared by the drawing threads and a cached text can be dropped by an other thread,
+     *so keep it locked until the text is blended*/
+    lv_draw_sw_thread_lock();
+    if(LV_GC_ROOT(_lv_text_cache) == NULL) {
+        LV_GC_ROOT(_lv_text_cache) = lv_lru_create(LV_TEXT_CACHE_SIZE, TEXT_CACHE_AVG_SIZE, text_free, NULL);
+        if(LV_GC_ROOT(_lv_text_cache) == NULL) {
+            lv_draw_sw_thread_unlock();
+            lv_mem_buf_release(key_buf);
+            return false;
+        }
+    }
+
+    text_key_t key;
+    lv_memset_00(&key, sizeof(key));    /*Clear the padding too as it's part of the key*/
+    key.font = dsc->font;
+    key.w = w;
+    key.h = h;
+    key.line_space = dsc->line_space;
+    key.letter_space = dsc->letter_space;
+    key.ofs_x = dsc->ofs_x;
+    key.ofs_y = dsc->ofs_y;
+    key.bidi_dir = dsc->bidi_dir;
+    key.align = dsc->align;
+    key.flag = dsc->flag;
+    lv_memcpy(key_buf, &key, sizeof(key));
+    lv_memcpy(key_buf + sizeof(key), txt, txt_len);
+
+    lv_opa_t * surface = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_text_cache), key_buf, key_size, (void **)&surface);
+    if(surface == NULL) {
+        text_cache_miss_cnt++;
+        surface = text_record(dsc, coords, txt);
+        if(surface) {
+            size_t size = surface == &not_cacheable ? 1 : (size_t)w * h;
+            if(lv_lru_set(LV_GC_ROOT(_lv_text_cache), key_buf, key_size, surface, size) != LV_LRU_OK) {
+                text_free(surface);
+                surface = NULL;
+            }
+        }
+    }
+    else if(surface == &not_cacheable) {
+        text_cache_miss_cnt++;
+    }
+    else {
+        text_cache_hit_cnt++;
+    }
+
+    lv_mem_buf_release(key_buf);
+
+    if(surface == NULL || surface == &not_cacheable) {
+        lv_draw_sw_thread_unlock();
+        return false;
+    }
+
+    /*Fill the whole text with its color in one step*/
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = coords;
+    blend_dsc.mask_buf = surface;
+    blend_dsc.mask_area = coords;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = dsc->opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    lv_draw_sw_thread_unlock();
+
+    return true;
+#else
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+    LV_UNUSED(txt);
+    return false;
+#endif
+}
+
+/**
+ * Get statistics about the text cache
+ * @param mon_p pointer to a `lv_draw_sw_text_cache_monitor_t` variable to store the result
+ */
+void lv_draw_sw_text_cache_monitor(lv_draw_sw_text_cache_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_draw_sw_text_cache_monitor_t));
+
+#if LV_TEXT_CACHE_SIZE
+    mon_p->hit_cnt = text_cache_hit_cnt;
+    mon_p->miss_cnt = text_cache_miss_cnt;
+    mon_p->total_size = LV_TEXT_CACHE_SIZE;
+    lv_lru_t * cache = LV_GC_ROOT(_lv_text_cache);
+    if(cache) mon_p->used_size = cache->total_memory - cache->free_memory;
+#endif
+}
+
+/**
+ * Drop all the cached texts and reset the statistics.
+ * Has to be called if a font is deleted as the texts are cached by the address of their font.
+ */
+void lv_draw_sw_text_cache_clear(void)
+{
+#if LV_TEXT_CACHE_SIZE
+    if(LV_GC_ROOT(_lv_text_cache)) {
+        lv_lru_del(LV_GC_ROOT(_lv_text_cache));
+        LV_GC_ROOT(_lv_text_cache) = NULL;
+    }
+
+    text_cache_hit_cnt = 0;
+    text_cache_miss_cnt = 0;
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_TEXT_CACHE_SIZE
+
+/**
+ * Render a text into an opacity map of the size of `coords`
+ * @param dsc pointer to draw descriptor
+ * @param coords coordinates of the label
+ * @param txt `\0` terminated text to write
+ * @return the opacity map, `&not_cacheable` if the text can't be cached or NULL if out of memory
+ */
+static lv_opa_t * text_record(const lv_draw_label_dsc_t * dsc, const lv_area_t * coords, const char * txt)
+{
+    uint32_t size = lv_area_get_size(coords);
+    lv_opa_t * surface = lv_mem_ext_alloc(size);
+    if(surface == NULL) return NULL;
+    lv_memset_00(surface, size);
+
+    /*Draw without clipping to see if anything is drawn out of the label's area.*/
+    lv_area_t buf_area;
+    lv_area_copy(&buf_area, coords);
+    lv_area_t clip_area;
+    lv_area_set(&clip_area, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MAX, LV_COORD_MAX);
+
+    record_ctx_t rec;
+    lv_memset_00(&rec, sizeof(rec));
+    rec.sw_ctx.base_draw.buf = surface;
+    rec.sw_ctx.base_draw.buf_area = &buf_area;
+    rec.sw_ctx.base_draw.clip_area = &clip_area;
+    rec.sw_ctx.base_draw.draw_letter = record_letter;
+    rec.sw_ctx.base_draw.draw_rect = record_rect;
+    rec.sw_ctx.base_draw.draw_img_decoded = record_img_decoded;
+    rec.sw_ctx.blend = record_blend;
+
+    lv_draw_label_dsc_t rec_dsc = *dsc;
+    rec_dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+    lv_draw_label((lv_draw_ctx_t *)&rec, &rec_dsc, coords, txt, NULL);
+
+    if(rec.failed) {
+        lv_mem_ext_free(surface);
+        return &not_cacheable;
+    }
+
+    return surface;
+}
+
+static void record_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                          uint32_t letter)
+{
+    /*Not `lv_draw_sw_letter` itself to not try to use the cache while recording*/
+    lv_draw_sw_letter(draw_ctx, dsc, pos_p, letter);
+}
+
+static void record_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+
+    /*E.g. a placeholder of a missing glyph*/
+    ((record_ctx_t *)draw_ctx)->failed = true;
+}
+
+static void record_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                               const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+    LV_UNUSED(map_p);
+    LV_UNUSED(color_format);
+
+    /*E.g. a letter of an image font*/
+    ((record_ctx_t *)draw_ctx)->failed = true;
+}
+
+/**
+ * Write the opacity of a letter to the opacity map
+ */
+static void record_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    record_ctx_t * rec = (record_ctx_t *)draw_ctx;
+
+    /*Sub-pixel rendered letters have colors*/
+    if(dsc->src_buf) {
+        rec->failed = true;
+        return;
+    }
+
+    if(dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+
+    lv_area_t blend_area;
+    if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    if(!_lv_area_is_in(&blend_area, draw_ctx->buf_area, 0)) {
+        rec->failed = true;
+        return;
+    }
+
+    const lv_opa_t * mask = dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : dsc->mask_buf;
+    lv_coord_t mask_stride = mask ? lv_area_get_width(dsc->mask_area) : 0;
+    lv_coord_t buf_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_opa_t * buf = draw_ctx->buf;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = blend_area.y1; y <= blend_area.y2; y++) {
+        lv_opa_t * buf_px = &buf[(y - draw_ctx->buf_area->y1) * buf_stride + (blend_area.x1 - draw_ctx->buf_area->x1)];
+        const lv_opa_t * mask_px = NULL;
+        if(mask) mask_px = &mask[(y - dsc->mask_area->y1) * mask_stride + (blend_area.x1 - dsc->mask_area->x1)];
+
+        for(x = blend_area.x1; x <= blend_area.x2; x++, buf_px++) {
+            lv_opa_t opa = mask_px ? *mask_px++ : LV_OPA_COVER;
+            if(dsc->opa < LV_OPA_MAX) opa = (opa * dsc->opa) >> 8;
+            if(opa == LV_OPA_TRANSP) continue;
+
+            /*Overlapping letters would be blended on each other which can't be reproduced exactly in one step*/
+            if(*buf_px != LV_OPA_TRANSP) {
+                rec->failed = true;
+                return;
+            }
+
+            *buf_px = opa;
+        }
+    }
+}
+
+static void text_free(void * surface)
+{
+    if(surface != &not_cacheable) lv_mem_ext_free(surface);
+}
+
+#endif /*LV_TEXT_CACHE_SIZE*/
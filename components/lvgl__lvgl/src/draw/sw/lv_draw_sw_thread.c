@@ -0,0 +1,482 @@
+/**
+ * @file lv_draw_sw_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+
+#if LV_DRAW_SW_THREAD_CNT > 1
+
+#include "../../hal/lv_hal_disp.h"
+#include "../../core/lv_refr.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_log.h"
+
+#if LV_DRAW_SW_THREAD_FREERTOS
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/task.h"
+        #include "freertos/semphr.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "task.h"
+        #include "semphr.h"
+    #endif
+#else
+    #include <pthread.h>
+    #include <limits.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define WORKER_CNT  (LV_DRAW_SW_THREAD_CNT - 1)
+
+/*Cut the area to more bands than threads, so a thread finishing its band early can take an other one*/
+#define BANDS_PER_THREAD 2
+
+#if LV_DRAW_SW_THREAD_FREERTOS
+    #ifdef ESP_PLATFORM
+        #define TASK_STACK_DEPTH    LV_DRAW_SW_THREAD_STACK_SIZE    /*ESP-IDF counts the stack in bytes*/
+    #else
+        #define TASK_STACK_DEPTH    (LV_DRAW_SW_THREAD_STACK_SIZE / sizeof(StackType_t))
+    #endif
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_DRAW_SW_THREAD_FREERTOS
+typedef TaskHandle_t sync_thread_t;
+typedef SemaphoreHandle_t sync_sem_t;
+typedef SemaphoreHandle_t sync_mutex_t;
+#else
+typedef pthread_t sync_thread_t;
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t cnt;
+} sync_sem_t;
+typedef pthread_mutex_t sync_mutex_t;
+#endif
+
+typedef struct {
+    sync_thread_t thread;
+    sync_sem_t start;           /*Given when there are bands to draw or the worker has to exit*/
+    lv_disp_t disp;             /*Copy of the display so that e.g. a layer's `screen_transp` is local to the worker*/
+    lv_disp_drv_t drv;
+    lv_draw_ctx_t * draw_ctx;   /*The worker's copy of the display's draw context*/
+    uint32_t draw_ctx_size;
+    lv_area_t buf_area;
+    lv_area_t clip_area;
+} worker_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool workers_start(void);
+static void worker_run(worker_t * w);
+static void render_bands(lv_draw_ctx_t * draw_ctx, lv_area_t * clip_area);
+
+static bool sem_init(sync_sem_t * sem);
+static void sem_deinit(sync_sem_t * sem);
+static void sem_give(sync_sem_t * sem);
+static void sem_take(sync_sem_t * sem);
+static bool mutex_init(sync_mutex_t * mutex);
+static void mutex_deinit(sync_mutex_t * mutex);
+static void mutex_lock(sync_mutex_t * mutex);
+static void mutex_unlock(sync_mutex_t * mutex);
+static bool thread_create(worker_t * w);
+static void thread_join(worker_t * w);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static worker_t workers[WORKER_CNT];
+static uint32_t worker_cnt;     /*Number of the running worker threads*/
+static uint32_t thread_cnt = LV_DRAW_SW_THREAD_CNT;
+static sync_sem_t done_sem;     /*Given by the workers when there are no more bands to draw*/
+static sync_mutex_t shared_mutex;
+static bool active;
+static bool quit;
+
+/*The area being drawn*/
+static lv_draw_sw_thread_render_cb_t job_cb;
+static void * job_user_data;
+static lv_area_t job_area;
+static uint32_t job_band_cnt;
+static uint32_t job_next_band;
+
+static lv_draw_sw_thread_monitor_t monitor;
+
+static LV_DRAW_SW_THREAD_LOCAL uint32_t lock_depth;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_thread_render(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx,
+                              lv_draw_sw_thread_render_cb_t render_cb, void * user_data)
+{
+    uint32_t band_cnt = LV_MIN(thread_cnt * BANDS_PER_THREAD,
+                               (uint32_t)lv_area_get_height(draw_ctx->clip_area) / LV_DRAW_SW_THREAD_MIN_HEIGHT);
+
+    /*Only the software renderer is known to be able to draw from multiple threads*/
+    if(thread_cnt <= 1 || band_cnt <= 1 || drv->draw_ctx_init != lv_draw_sw_init_ctx || !workers_start()) {
+        monitor.serial_cnt++;
+        render_cb(draw_ctx, user_data);
+        return;
+    }
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    uint32_t used_worker_cnt = LV_MIN(LV_MIN(thread_cnt, band_cnt) - 1, worker_cnt);
+    uint32_t i;
+    for(i = 0; i < used_worker_cnt; i++) {
+        worker_t * w = &workers[i];
+        if(w->draw_ctx_size != drv->draw_ctx_size) {
+            lv_mem_free(w->draw_ctx);
+            w->draw_ctx = lv_mem_alloc(drv->draw_ctx_size);
+            w->draw_ctx_size = w->draw_ctx ? drv->draw_ctx_size : 0;
+            if(w->draw_ctx == NULL) {
+                LV_LOG_WARN("Couldn't allocate a draw context for a worker thread");
+                break;
+            }
+        }
+        lv_memcpy(w->draw_ctx, draw_ctx, drv->draw_ctx_size);
+        w->buf_area = *draw_ctx->buf_area;
+        w->draw_ctx->buf_area = &w->buf_area;
+        w->draw_ctx->clip_area = &w->clip_area;
+
+        w->drv = *drv;
+        w->drv.draw_ctx = w->draw_ctx;
+        w->disp = *disp;
+        w->disp.driver = &w->drv;
+    }
+    used_worker_cnt = i;
+
+    job_cb = render_cb;
+    job_user_data = user_data;
+    job_area = *draw_ctx->clip_area;
+    job_band_cnt = band_cnt;
+    job_next_band = 0;
+    active = true;
+
+    for(i = 0; i < used_worker_cnt; i++) {
+        sem_give(&workers[i].start);
+    }
+
+    /*Draw bands on this thread too, with the display's own draw context*/
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    draw_ctx->clip_area = &clip_area;
+    render_bands(draw_ctx, &clip_area);
+    draw_ctx->clip_area = clip_area_ori;
+
+    for(i = 0; i < used_worker_cnt; i++) {
+        sem_take(&done_sem);
+    }
+
+    active = false;
+    monitor.render_cnt++;
+    monitor.band_cnt += band_cnt;
+}
+
+void lv_draw_sw_thread_set_cnt(uint32_t cnt)
+{
+    thread_cnt = LV_CLAMP(1, cnt, LV_DRAW_SW_THREAD_CNT);
+}
+
+uint32_t lv_draw_sw_thread_get_cnt(void)
+{
+    return thread_cnt;
+}
+
+bool lv_draw_sw_thread_is_active(void)
+{
+    return active;
+}
+
+void lv_draw_sw_thread_lock(void)
+{
+    /*Only the calling thread draws when not active*/
+    if(!active) return;
+
+    if(lock_depth == 0) mutex_lock(&shared_mutex);
+    lock_depth++;
+}
+
+void lv_draw_sw_thread_unlock(void)
+{
+    if(!active) return;
+
+    lock_depth--;
+    if(lock_depth == 0) mutex_unlock(&shared_mutex);
+}
+
+void lv_draw_sw_thread_monitor(lv_draw_sw_thread_monitor_t * mon_p)
+{
+    *mon_p = monitor;
+}
+
+void lv_draw_sw_thread_deinit(void)
+{
+    if(worker_cnt == 0) return;
+
+    quit = true;
+    uint32_t i;
+    for(i = 0; i < worker_cnt; i++) {
+        sem_give(&workers[i].start);
+    }
+
+    for(i = 0; i < worker_cnt; i++) {
+        worker_t * w = &workers[i];
+        thread_join(w);
+        sem_deinit(&w->start);
+        lv_mem_free(w->draw_ctx);
+        lv_memset_00(w, sizeof(worker_t));
+    }
+
+    sem_deinit(&done_sem);
+    mutex_deinit(&shared_mutex);
+    worker_cnt = 0;
+    quit = false;
+    lv_memset_00(&monitor, sizeof(monitor));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool workers_start(void)
+{
+    if(worker_cnt > 0) return true;
+
+    if(!sem_init(&done_sem)) return false;
+    if(!mutex_init(&shared_mutex)) {
+        sem_deinit(&done_sem);
+        return false;
+    }
+
+    uint32_t i;
+    for(i = 0; i < WORKER_CNT; i++) {
+        worker_t * w = &workers[i];
+        if(!sem_init(&w->start)) break;
+        if(!thread_create(w)) {
+            sem_deinit(&w->start);
+            break;
+        }
+        worker_cnt++;
+    }
+
+    if(worker_cnt == 0) {
+        LV_LOG_WARN("Couldn't start the drawing threads, drawing on the calling thread only");
+        sem_deinit(&done_sem);
+        mutex_deinit(&shared_mutex);
+        thread_cnt = 1;
+        return false;
+    }
+
+    if(worker_cnt < WORKER_CNT) {
+        LV_LOG_WARN("Only %d drawing threads could be started", (int)worker_cnt + 1);
+    }
+
+    return true;
+}
+
+static void worker_run(worker_t * w)
+{
+    lv_mem_buf_init();
+
+    while(1) {
+        sem_take(&w->start);
+        if(quit) break;
+
+        _lv_refr_set_disp_refreshing(&w->disp);
+        render_bands(w->draw_ctx, &w->clip_area);
+#if LV_MEM_BUF_ARENA_SIZE
+        /*Empty the arena like the refreshing thread does after every frame*/
+        lv_mem_buf_free_all();
+#endif
+        sem_give(&done_sem);
+    }
+
+    /*Free the thread's own temporary buffers*/
+    lv_mem_buf_deinit();
+}
+
+/**
+ * Draw the next band of the job until all of them are drawn
+ * @param draw_ctx the draw context of the thread
+ * @param clip_area the area `draw_ctx->clip_area` points to
+ */
+static void render_bands(lv_draw_ctx_t * draw_ctx, lv_area_t * clip_area)
+{
+    lv_coord_t h = lv_area_get_height(&job_area);
+    while(1) {
+        lv_draw_sw_thread_lock();
+        uint32_t band = job_next_band;
+        job_next_band++;
+        lv_draw_sw_thread_unlock();
+        if(band >= job_band_cnt) break;
+
+        *clip_area = job_area;
+        clip_area->y1 = job_area.y1 + (lv_coord_t)((int32_t)h * band / job_band_cnt);
+        clip_area->y2 = job_area.y1 + (lv_coord_t)((int32_t)h * (band + 1) / job_band_cnt) - 1;
+        job_cb(draw_ctx, job_user_data);
+    }
+}
+
+#if LV_DRAW_SW_THREAD_FREERTOS
+
+static void worker_task(void * p)
+{
+    worker_run(p);
+
+    /*Tell `thread_join` that the task is done*/
+    xSemaphoreGive(done_sem);
+    vTaskDelete(NULL);
+}
+
+static bool sem_init(sync_sem_t * sem)
+{
+    *sem = xSemaphoreCreateCounting(LV_DRAW_SW_THREAD_CNT, 0);
+    return *sem != NULL;
+}
+
+static void sem_deinit(sync_sem_t * sem)
+{
+    vSemaphoreDelete(*sem);
+}
+
+static void sem_give(sync_sem_t * sem)
+{
+    xSemaphoreGive(*sem);
+}
+
+static void sem_take(sync_sem_t * sem)
+{
+    xSemaphoreTake(*sem, portMAX_DELAY);
+}
+
+static bool mutex_init(sync_mutex_t * mutex)
+{
+    *mutex = xSemaphoreCreateMutex();
+    return *mutex != NULL;
+}
+
+static void mutex_deinit(sync_mutex_t * mutex)
+{
+    vSemaphoreDelete(*mutex);
+}
+
+static void mutex_lock(sync_mutex_t * mutex)
+{
+    xSemaphoreTake(*mutex, portMAX_DELAY);
+}
+
+static void mutex_unlock(sync_mutex_t * mutex)
+{
+    xSemaphoreGive(*mutex);
+}
+
+static bool thread_create(worker_t * w)
+{
+    return xTaskCreate(worker_task, "lv_draw_sw", TASK_STACK_DEPTH, w, LV_DRAW_SW_THREAD_PRIO, &w->thread) == pdPASS;
+}
+
+static void thread_join(worker_t * w)
+{
+    LV_UNUSED(w);
+    xSemaphoreTake(done_sem, portMAX_DELAY);
+}
+
+#else
+
+static void * worker_thread(void * p)
+{
+    worker_run(p);
+    return NULL;
+}
+
+static bool sem_init(sync_sem_t * sem)
+{
+    sem->cnt = 0;
+    if(pthread_mutex_init(&sem->mutex, NULL) != 0) return false;
+    if(pthread_cond_init(&sem->cond, NULL) != 0) {
+        pthread_mutex_destroy(&sem->mutex);
+        return false;
+    }
+    return true;
+}
+
+static void sem_deinit(sync_sem_t * sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->mutex);
+}
+
+static void sem_give(sync_sem_t * sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    sem->cnt++;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+static void sem_take(sync_sem_t * sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    while(sem->cnt == 0) pthread_cond_wait(&sem->cond, &sem->mutex);
+    sem->cnt--;
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+static bool mutex_init(sync_mutex_t * mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0;
+}
+
+static void mutex_deinit(sync_mutex_t * mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+static void mutex_lock(sync_mutex_t * mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+static void mutex_unlock(sync_mutex_t * mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+static bool thread_create(worker_t * w)
+{
+    pthread_attr_t attr;
+    if(pthread_attr_init(&attr) != 0) return false;
+    size_t stack_size = LV_DRAW_SW_THREAD_STACK_SIZE;
+#ifdef PTHREAD_STACK_MIN
+    if(stack_size < (size_t)PTHREAD_STACK_MIN) stack_size = (size_t)PTHREAD_STACK_MIN;
+#endif
+    pthread_attr_setstacksize(&attr, stack_size);
+    bool ok = pthread_create(&w->thread, &attr, worker_thread, w) == 0;
+    pthread_attr_destroy(&attr);
+    return ok;
+}
+
+static void thread_join(worker_t * w)
+{
+    pthread_join(w->thread, NULL);
+}
+
+#endif /*LV_DRAW_SW_THREAD_FREERTOS*/
+
+#endif /*LV_DRAW_SW_THREAD_CNT > 1*/
@@ -0,0 +1,141 @@
+/**
+ * @file lv_draw_sw_thread.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_THREAD_H
+#define LV_DRAW_SW_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_DRAW_SW_THREAD_CNT > 1
+#if LV_MEM_CUSTOM == 0
+#error "LV_DRAW_SW_THREAD_CNT > 1 requires LV_MEM_CUSTOM 1 with a thread safe `malloc`"
+#endif
+#if LV_ENABLE_GC
+#error "LV_DRAW_SW_THREAD_CNT > 1 can't be used with LV_ENABLE_GC"
+#endif
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_disp_drv_t;
+struct _lv_draw_ctx_t;
+
+/**
+ * Draw into the buffer of a draw context. Called with a copy of the display's draw context
+ * whose `clip_area` is a band of the area to redraw.
+ */
+typedef void (*lv_draw_sw_thread_render_cb_t)(struct _lv_draw_ctx_t * draw_ctx, void * user_data);
+
+/** Statistics of the parallel rendering*/
+typedef struct {
+    uint32_t render_cnt;    /**< Number of areas drawn in parallel*/
+    uint32_t serial_cnt;    /**< Number of areas drawn by the calling thread only*/
+    uint32_t band_cnt;      /**< Number of bands drawn in parallel*/
+} lv_draw_sw_thread_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_DRAW_SW_THREAD_CNT > 1
+
+/**
+ * Cut the `clip_area` of `draw_ctx` into horizontal bands and call `render_cb` for each band in parallel.
+ * The calling thread draws a band too and returns when all the bands are drawn.
+ * The worker threads are started on the first call.
+ * @param drv the display driver whose draw context is used
+ * @param draw_ctx the draw context with the buffer and the area to draw
+ * @param render_cb called with a draw context per band
+ * @param user_data passed to `render_cb`
+ */
+void lv_draw_sw_thread_render(struct _lv_disp_drv_t * drv, struct _lv_draw_ctx_t * draw_ctx,
+                              lv_draw_sw_thread_render_cb_t render_cb, void * user_data);
+
+/**
+ * Set how many threads draw in parallel, including the calling thread.
+ * @param cnt 1..LV_DRAW_SW_THREAD_CNT
+ */
+void lv_draw_sw_thread_set_cnt(uint32_t cnt);
+
+/**
+ * Get how many threads draw in parallel.
+ * @return 1..LV_DRAW_SW_THREAD_CNT
+ */
+uint32_t lv_draw_sw_thread_get_cnt(void);
+
+/**
+ * Tell whether bands are being drawn in parallel right now.
+ * Caches which are written during drawing without locking have to be bypassed while it's true.
+ * @return true: parallel rendering is in progress
+ */
+bool lv_draw_sw_thread_is_active(void);
+
+/**
+ * Lock the data shared by the drawing threads (e.g. the image and glyph caches).
+ * It can be called again by the thread holding the lock. Does nothing if the worker threads are not started.
+ */
+void lv_draw_sw_thread_lock(void);
+
+/**
+ * Release the lock taken with `lv_draw_sw_thread_lock()`.
+ */
+void lv_draw_sw_thread_unlock(void);
+
+/**
+ * Get statistics about the parallel rendering
+ * @param mon_p pointer to a `lv_draw_sw_thread_monitor_t` variable to store the result
+ */
+void lv_draw_sw_thread_monitor(lv_draw_sw_thread_monitor_t * mon_p);
+
+/**
+ * Stop the worker threads and free their resources. They are started again when needed.
+ */
+void lv_draw_sw_thread_deinit(void);
+
+#else
+
+static inline bool lv_draw_sw_thread_is_active(void)
+{
+    return false;
+}
+
+static inline void lv_draw_sw_thread_lock(void)
+{
+}
+
+static inline void lv_draw_sw_thread_unlock(void)
+{
+}
+
+static inline void lv_draw_sw_thread_deinit(void)
+{
+}
+
+#endif /*LV_DRAW_SW_THREAD_CNT > 1*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_THREAD_H*/
@@ -15,15 +15,17 @@
 /*********************
  *      DEFINES
  *********************/
+#if defined(__GNUC__)
+    /*Inline the pixel functions into the loops of each color format to remove the format checks*/
+    #define TRANSFORM_INLINE static inline __attribute__((always_inline))
+#else
+    #define TRANSFORM_INLINE static inline
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 typedef struct {
-    int32_t x_in;
-    int32_t y_in;
-    int32_t x_out;
-    int32_t y_out;
     int32_t sinma;
     int32_t cosma;
     int32_t zoom;
@@ -31,39 +33,64 @@ typedef struct {
     int32_t pivot_x_256;
     int32_t pivot_y_256;
     lv_point_t pivot;
+    int32_t x_row_step;         /**< Change of the X accumulator on the next row*/
+    int32_t y_row_step;         /**< Change of the Y accumulator on the next row*/
+    uint8_t shift;              /**< The upscaled coordinates are `(acc >> shift) + pivot_256`*/
 } point_transform_dsc_t;
 
+/**
+ * A precomputed column of the image when it's zoomed without rotation
+ */
+typedef struct {
+    int32_t x;                  /**< X coordinate on the source image*/
+    int16_t fract;              /**< Weight of the horizontal neighbor*/
+    int16_t next;               /**< Direction of the horizontal neighbor: -1 or 1*/
+} zoom_col_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 /**
- * Transform a point with 1/256 precision (the output coordinates are upscaled by 256)
- * @param t         pointer to n initialized `point_transform_dsc_t` structure
+ * Initialize the row steps of a point transformation
+ * @param t         pointer to a `point_transform_dsc_t` with initialized angle, zoom and pivot
+ */
+static void transform_init(point_transform_dsc_t * t);
+
+/**
+ * Transform a point to accumulators which can be stepped to the next rows
+ * (`t->x_row_step` and `t->y_row_step`) and give the coordinates with 1/256 precision:
+ * `(x_acc >> t->shift) + t->pivot_x_256`
+ * @param t         pointer to an initialized `point_transform_dsc_t` structure
  * @param xin       X coordinate to rotate
  * @param yin       Y coordinate to rotate
- * @param xout      upscaled, transformed X
- * @param yout      upscaled, transformed Y
+ * @param x_acc     accumulator of the transformed X
+ * @param y_acc     accumulator of the transformed Y
  */
-static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
-                                     int32_t * yout);
+static void transform_point_acc(const point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * x_acc,
+                                int32_t * y_acc);
 
-static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+static void transform_row(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                          int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck, bool aa,
+                          const zoom_col_t * cols, int32_t col_start, int32_t col_end);
 
-static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+static void get_run(int32_t start, int32_t step, int32_t min, int32_t max, int32_t len,
+                    int32_t * run_start, int32_t * run_end);
 
-#if LV_COLOR_DEPTH == 16
-static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                           int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
-#endif
+static void no_aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                       int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf,
+                       lv_img_cf_t cf, lv_color_t ck);
+
+static void aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                    int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf,
+                    lv_img_cf_t cf, lv_color_t ck);
 
-static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
+static void inner_run(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, const zoom_col_t * cols,
+                      int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck,
+                      bool aa);
 
 /**********************
  *  STATIC VARIABLES
@@ -83,36 +110,54 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
 {
     LV_UNUSED(draw_ctx);
 
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8:
+#endif
+            break;
+        default:
+            return;
+    }
+
     point_transform_dsc_t tr_dsc;
     tr_dsc.angle = -draw_dsc->angle;
     tr_dsc.zoom = (256 * 256) / draw_dsc->zoom;
     tr_dsc.pivot = draw_dsc->pivot;
+    transform_init(&tr_dsc);
 
-    int32_t angle_low = tr_dsc.angle / 10;
-    int32_t angle_high = angle_low + 1;
-    int32_t angle_rem = tr_dsc.angle  - (angle_low * 10);
+    lv_color_t ck = _LV_COLOR_ZERO_INITIALIZER;
+    if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_disp_t * d = _lv_refr_get_disp_refreshing();
+        ck = d->driver->color_chroma_key;
+    }
 
-    int32_t s1 = lv_trigo_sin(angle_low);
-    int32_t s2 = lv_trigo_sin(angle_high);
+    bool aa = draw_dsc->antialias != 0;
+    lv_coord_t dest_w = lv_area_get_width(dest_area);
+    lv_coord_t dest_h = lv_area_get_height(dest_area);
 
-    int32_t c1 = lv_trigo_sin(angle_low + 90);
-    int32_t c2 = lv_trigo_sin(angle_high + 90);
+    /*Step the transformed start and end points of the rows instead of transforming them on every row*/
+    int32_t x1_acc, y1_acc, x2_acc, y2_acc;
+    transform_point_acc(&tr_dsc, dest_area->x1, dest_area->y1, &x1_acc, &y1_acc);
+    transform_point_acc(&tr_dsc, dest_area->x2, dest_area->y1, &x2_acc, &y2_acc);
 
-    tr_dsc.sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
-    tr_dsc.cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
-    tr_dsc.sinma = tr_dsc.sinma >> (LV_TRIGO_SHIFT - 10);
-    tr_dsc.cosma = tr_dsc.cosma >> (LV_TRIGO_SHIFT - 10);
-    tr_dsc.pivot_x_256 = tr_dsc.pivot.x * 256;
-    tr_dsc.pivot_y_256 = tr_dsc.pivot.y * 256;
+    /*Without rotation every row samples the same columns so compute them only once*/
+    zoom_col_t * cols = NULL;
+    int32_t col_start = 0;
+    int32_t col_end = 0;
 
-    lv_coord_t dest_w = lv_area_get_width(dest_area);
-    lv_coord_t dest_h = lv_area_get_height(dest_area);
     lv_coord_t y;
     for(y = 0; y < dest_h; y++) {
-        int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
-
-        transform_point_upscaled(&tr_dsc, dest_area->x1, dest_area->y1 + y, &xs1_ups, &ys1_ups);
-        transform_point_upscaled(&tr_dsc, dest_area->x2, dest_area->y1 + y, &xs2_ups, &ys2_ups);
+        int32_t xs1_ups = (x1_acc >> tr_dsc.shift) + tr_dsc.pivot_x_256;
+        int32_t ys1_ups = (y1_acc >> tr_dsc.shift) + tr_dsc.pivot_y_256;
+        int32_t xs2_ups = (x2_acc >> tr_dsc.shift) + tr_dsc.pivot_x_256;
+        int32_t ys2_ups = (y2_acc >> tr_dsc.shift) + tr_dsc.pivot_y_256;
+        x1_acc += tr_dsc.x_row_step;
+        y1_acc += tr_dsc.y_row_step;
+        x2_acc += tr_dsc.x_row_step;
+        y2_acc += tr_dsc.y_row_step;
 
         int32_t xs_diff = xs2_ups - xs1_ups;
         int32_t ys_diff = ys2_ups - ys1_ups;
@@ -125,183 +170,426 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
         int32_t xs_ups = xs1_ups + 0x80;
         int32_t ys_ups = ys1_ups + 0x80;
 
-        if(draw_dsc->antialias == 0) {
-            switch(cf) {
-                case LV_IMG_CF_TRUE_COLOR_ALPHA:
-                    argb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
-                    break;
-                case LV_IMG_CF_TRUE_COLOR:
-                case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
-                    rgb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf, cf);
-                    break;
-
-#if LV_COLOR_DEPTH == 16
-                case LV_IMG_CF_RGB565A8:
-                    rgb565a8_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
-                    break;
-#endif
-                default:
-                    break;
+        if(y == 0 && tr_dsc.angle == 0) {
+            int32_t margin = aa ? 1 : 0;
+            get_run(xs_ups, xs_step_256, margin, src_w - 1 - margin, dest_w, &col_start, &col_end);
+            if(col_start < col_end) cols = lv_mem_buf_get((col_end - col_start) * sizeof(zoom_col_t));
+            if(cols) {
+                int32_t x;
+                for(x = col_start; x < col_end; x++) {
+                    int32_t xs_col = xs_ups + ((xs_step_256 * x) >> 8);
+                    int32_t xs_fract = xs_col & 0xFF;
+                    zoom_col_t * col = &cols[x - col_start];
+                    col->x = xs_col >> 8;
+                    col->next = xs_fract < 0x80 ? -1 : 1;
+                    col->fract = (int16_t)(xs_fract < 0x80 ? (0x7F - xs_fract) * 2 : (xs_fract - 0x80) * 2);
+                }
             }
         }
-        else {
-            argb_and_rgb_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf, cf);
-        }
+
+        transform_row(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
+                      cbuf, abuf, cf, ck, aa, cols, col_start, col_end);
 
         cbuf += dest_w;
         abuf += dest_w;
     }
+
+    if(cols) lv_mem_buf_release(cols);
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+/**
+ * Transform a row. The pixels whose samples are surely on the image are transformed without
+ * bounds checks and only the pixels around the edges of the image are checked.
+ * If `cols` is not `NULL` the row is not rotated and the columns between `col_start` and `col_end`
+ * are precomputed (these are the inner columns).
+ */
+static void transform_row(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                          int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck, bool aa,
+                          const zoom_col_t * cols, int32_t col_start, int32_t col_end)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-    lv_disp_t * d = _lv_refr_get_disp_refreshing();
-    lv_color_t ck = d->driver->color_chroma_key;
+    /*With anti-aliasing the neighbors need to be on the image too*/
+    int32_t margin = aa ? 1 : 0;
+    int32_t in_start;
+    int32_t in_end;
+    int32_t y_start;
+    int32_t y_end;
+    if(cols) {
+        in_start = col_start;
+        in_end = col_end;
+    }
+    else {
+        get_run(xs_ups, xs_step, margin, src_w - 1 - margin, x_end, &in_start, &in_end);
+    }
+    get_run(ys_ups, ys_step, margin, src_h - 1 - margin, x_end, &y_start, &y_end);
+    in_start = LV_MAX(in_start, y_start);
+    in_end = LV_MIN(in_end, y_end);
+    if(in_start >= in_end || (cols && (in_start != col_start || in_end != col_end))) {
+        in_start = 0;
+        in_end = 0;
+    }
 
-    lv_memset_ff(abuf, x_end);
+    if(aa) {
+        aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, in_start, cbuf, abuf, cf, ck);
+        inner_run(src, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, cols, in_start, in_end, cbuf, abuf, cf, ck,
+                  true);
+        aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, in_end, x_end, cbuf, abuf, cf, ck);
+    }
+    else {
+        no_aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, in_start, cbuf, abuf, cf, ck);
+        inner_run(src, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, cols, in_start, in_end, cbuf, abuf, cf, ck,
+                  false);
+        no_aa_edge(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, in_end, x_end, cbuf, abuf, cf, ck);
+    }
+}
 
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+static int64_t div_floor(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    if((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-        }
-        else {
+static int64_t div_ceil(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    if((a % b != 0) && ((a < 0) == (b < 0))) q++;
+    return q;
+}
+
+/**
+ * Get the pixels of a row whose source coordinate is between `min` and `max`.
+ * The source coordinate of the `x`th pixel is `(start + ((step * x) >> 8)) >> 8`
+ * which changes monotonically so the pixels are next to each other.
+ * @param start         upscaled source coordinate of the first pixel
+ * @param step          step of the upscaled coordinate on every pixel, upscaled by 256
+ * @param min           the smallest source coordinate
+ * @param max           the largest source coordinate
+ * @param len           number of pixels in the row
+ * @param run_start     store the first pixel here
+ * @param run_end       store the pixel after the last pixel here (equals to `run_start` if there are no such pixels)
+ */
+static void get_run(int32_t start, int32_t step, int32_t min, int32_t max, int32_t len,
+                    int32_t * run_start, int32_t * run_end)
+{
+    *run_start = 0;
+    *run_end = 0;
+    if(min > max) return;
+
+    /*min <= coord <= max  <=>  k_min <= step * x <= k_max*/
+    int64_t k_min = ((int64_t)min * 256 - start) * 256;
+    int64_t k_max = ((int64_t)(max + 1) * 256 - start) * 256 - 1;
+    int64_t x_min;
+    int64_t x_max;
+    if(step == 0) {
+        if(k_min > 0 || k_max < 0) return;
+        x_min = 0;
+        x_max = len - 1;
+    }
+    else if(step > 0) {
+        x_min = div_ceil(k_min, step);
+        x_max = div_floor(k_max, step);
+    }
+    else {
+        x_min = div_ceil(k_max, step);
+        x_max = div_floor(k_min, step);
+    }
+
+    x_min = LV_MAX(x_min, 0);
+    x_max = LV_MIN(x_max, len - 1);
+    if(x_min > x_max) return;
+
+    *run_start = (int32_t)x_min;
+    *run_end = (int32_t)x_max + 1;
+}
+
+/**
+ * Get the direction of the neighbor and its weight
+ * @param ups       an upscaled coordinate
+ * @param fract     store the weight in range of 0x00..0xFF here
+ * @param next      store the direction (+/-1) here
+ */
+TRANSFORM_INLINE void get_neighbor(int32_t ups, int32_t * fract, int32_t * next)
+{
+    int32_t f = ups & 0xFF;
+    if(f < 0x80) {
+        *next = -1;
+        *fract = (0x7F - f) * 2;
+    }
+    else {
+        *next = 1;
+        *fract = (f - 0x80) * 2;
+    }
+}
+
+/**
+ * Get a pixel of the image without anti-aliasing. The coordinates should be on the image.
+ */
+TRANSFORM_INLINE void get_px(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                             int32_t xs_int, int32_t ys_int, lv_img_cf_t cf, lv_color_t ck,
+                             lv_color_t * cbuf, uint8_t * abuf)
+{
+    LV_UNUSED(src_h);
+    LV_UNUSED(ck);
+
+    if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE) + xs_int * LV_IMG_PX_SIZE_ALPHA_BYTE;
 
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            const uint8_t * src_tmp = src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x].full = src_tmp[0];
+        cbuf->full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
+        cbuf->full = src_tmp[0] + (src_tmp[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        cbuf->full = *((uint32_t *)src_tmp);
 #endif
-        }
-        if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && cbuf[x].full == ck.full) {
-            abuf[x] = 0x00;
-        }
+        *abuf = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+    }
+#if LV_COLOR_DEPTH == 16
+    else if(cf == LV_IMG_CF_RGB565A8) {
+        const lv_color_t * src_tmp = (const lv_color_t *)src;
+        src_tmp += ys_int * src_stride + xs_int;
+        *cbuf = *src_tmp;
+
+        const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
+        a_tmp += ys_int * src_stride + xs_int;
+        *abuf = *a_tmp;
+    }
+#endif
+    else {
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+        const uint8_t * src_tmp = src;
+        src_tmp += ys_int * src_stride + xs_int;
+        cbuf->full = src_tmp[0];
+#elif LV_COLOR_DEPTH == 16
+        const lv_color_t * src_tmp = (const lv_color_t *)src;
+        src_tmp += ys_int * src_stride + xs_int;
+        *cbuf = *src_tmp;
+#elif LV_COLOR_DEPTH == 32
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
+        cbuf->full = *((uint32_t *)src_tmp);
+#endif
+        if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && cbuf->full == ck.full) *abuf = 0x00;
+        else *abuf = 0xff;
     }
 }
 
-static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+/**
+ * Get an anti-aliased pixel of the image. The pixel and its neighbors should be on the image.
+ */
+TRANSFORM_INLINE void get_px_aa(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                                int32_t xs_int, int32_t ys_int, int32_t x_next, int32_t y_next,
+                                int32_t xs_fract, int32_t ys_fract, lv_img_cf_t cf, lv_color_t ck,
+                                lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
+    LV_UNUSED(src_h);
+    LV_UNUSED(ck);
+
+    int32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : (int32_t)sizeof(lv_color_t);
+    const uint8_t * px_base = src + (ys_int * src_stride * px_size) + xs_int * px_size;
+    const uint8_t * px_hor = px_base + x_next * px_size;
+    const uint8_t * px_ver = px_base + y_next * src_stride * px_size;
+    lv_color_t c_base;
+    lv_color_t c_ver;
+    lv_color_t c_hor;
+
+    if(cf != LV_IMG_CF_TRUE_COLOR) {
+        lv_opa_t a_base;
+        lv_opa_t a_ver;
+        lv_opa_t a_hor;
+        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+            a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        }
+#if LV_COLOR_DEPTH == 16
+        else if(cf == LV_IMG_CF_RGB565A8) {
+            const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
+            a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
+            a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
+            a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
+        }
+#endif
+        else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+            if(((const lv_color_t *)px_base)->full == ck.full ||
+               ((const lv_color_t *)px_ver)->full == ck.full ||
+               ((const lv_color_t *)px_hor)->full == ck.full) {
+                *abuf = 0x00;
+                return;
+            }
+            else {
+                a_base = 0xff;
+                a_ver = 0xff;
+                a_hor = 0xff;
+            }
         }
         else {
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * LV_IMG_PX_SIZE_ALPHA_BYTE) + xs_int * LV_IMG_PX_SIZE_ALPHA_BYTE;
+            a_base = 0xff;
+            a_ver = 0xff;
+            a_hor = 0xff;
+        }
+
+        if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
+        if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
+        *abuf = (a_ver + a_hor) >> 1;
+
+        if(*abuf == 0x00) return;
 
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            cbuf[x].full = src_tmp[0];
+        c_base.full = px_base[0];
+        c_ver.full = px_ver[0];
+        c_hor.full = px_hor[0];
 #elif LV_COLOR_DEPTH == 16
-            cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+        c_base.full = px_base[0] + (px_base[1] << 8);
+        c_ver.full = px_ver[0] + (px_ver[1] << 8);
+        c_hor.full = px_hor[0] + (px_hor[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x].full = *((uint32_t *)src_tmp);
+        c_base.full = *((uint32_t *)px_base);
+        c_ver.full = *((uint32_t *)px_ver);
+        c_hor.full = *((uint32_t *)px_hor);
 #endif
-            abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+    }
+    /*No alpha channel -> RGB*/
+    else {
+        c_base = *((const lv_color_t *) px_base);
+        c_hor = *((const lv_color_t *) px_hor);
+        c_ver = *((const lv_color_t *) px_ver);
+        *abuf = 0xff;
+    }
+
+    if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
+        *cbuf = c_base;
+    }
+    else {
+        c_ver = lv_color_mix(c_ver, c_base, ys_fract);
+        c_hor = lv_color_mix(c_hor, c_base, xs_fract);
+        *cbuf = lv_color_mix(c_hor, c_ver, LV_OPA_50);
+    }
+}
+
+/**
+ * Transform the pixels between `x_start` and `x_end` which are surely on the image (with their neighbors if `aa`).
+ * Inlined for every color format so the loops have no bounds and format checks.
+ */
+TRANSFORM_INLINE void inner_run_cf(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                   const zoom_col_t * cols, int32_t x_start, int32_t x_end,
+                                   lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck, bool aa)
+{
+    int32_t x;
+    if(cols) {
+        /*Not rotated: the row is the same and the columns are precomputed*/
+        int32_t ys_int = ys_ups >> 8;
+        int32_t ys_fract;
+        int32_t y_next;
+        get_neighbor(ys_ups, &ys_fract, &y_next);
+        for(x = x_start; x < x_end; x++) {
+            const zoom_col_t * col = &cols[x - x_start];
+            if(aa) get_px_aa(src, src_h, src_stride, col->x, ys_int, col->next, y_next, col->fract, ys_fract, cf, ck,
+                                 &cbuf[x], &abuf[x]);
+            else get_px(src, src_h, src_stride, col->x, ys_int, cf, ck, &cbuf[x], &abuf[x]);
+        }
+    }
+    else {
+        /*Step the coordinates incrementally, it's the same as `(step * x) >> 8`*/
+        int32_t xs_acc = xs_step * x_start;
+        int32_t ys_acc = ys_step * x_start;
+        for(x = x_start; x < x_end; x++) {
+            int32_t xs_cur = xs_ups + (xs_acc >> 8);
+            int32_t ys_cur = ys_ups + (ys_acc >> 8);
+            xs_acc += xs_step;
+            ys_acc += ys_step;
+            if(aa) {
+                int32_t xs_fract, ys_fract, x_next, y_next;
+                get_neighbor(xs_cur, &xs_fract, &x_next);
+                get_neighbor(ys_cur, &ys_fract, &y_next);
+                get_px_aa(src, src_h, src_stride, xs_cur >> 8, ys_cur >> 8, x_next, y_next, xs_fract, ys_fract, cf, ck,
+                          &cbuf[x], &abuf[x]);
+            }
+            else {
+                get_px(src, src_h, src_stride, xs_cur >> 8, ys_cur >> 8, cf, ck, &cbuf[x], &abuf[x]);
+            }
         }
     }
 }
 
+static void inner_run(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
+                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, const zoom_col_t * cols,
+                      int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, lv_color_t ck,
+                      bool aa)
+{
+    if(x_start >= x_end) return;
+
+#define INNER_RUN(cf_const, aa_const) \
+    inner_run_cf(src, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, cols, x_start, x_end, \
+                 cbuf, abuf, cf_const, ck, aa_const)
+
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            if(aa) INNER_RUN(LV_IMG_CF_TRUE_COLOR, true);
+            else INNER_RUN(LV_IMG_CF_TRUE_COLOR, false);
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            if(aa) INNER_RUN(LV_IMG_CF_TRUE_COLOR_ALPHA, true);
+            else INNER_RUN(LV_IMG_CF_TRUE_COLOR_ALPHA, false);
+            break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+            if(aa) INNER_RUN(LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED, true);
+            else INNER_RUN(LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED, false);
+            break;
 #if LV_COLOR_DEPTH == 16
-static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                           int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+        case LV_IMG_CF_RGB565A8:
+            if(aa) INNER_RUN(LV_IMG_CF_RGB565A8, true);
+            else INNER_RUN(LV_IMG_CF_RGB565A8, false);
+            break;
+#endif
+        default:
+            break;
+    }
+
+#undef INNER_RUN
+}
+
+static void no_aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                       int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf,
+                       lv_img_cf_t cf, lv_color_t ck)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
         if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
+            abuf[x] = 0x00;
         }
         else {
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
-
-            const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-            a_tmp += ys_int * src_stride + xs_int;
-            abuf[x] = *a_tmp;
+            get_px(src, src_h, src_stride, xs_int, ys_int, cf, ck, &cbuf[x], &abuf[x]);
         }
     }
 }
-#endif
 
-
-static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
-                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
+static void aa_edge(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                    int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf,
+                    lv_img_cf_t cf, lv_color_t ck)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
-    bool has_alpha;
-    int32_t px_size;
-    lv_color_t ck = _LV_COLOR_ZERO_INITIALIZER;
-    switch(cf) {
-        case LV_IMG_CF_TRUE_COLOR:
-            has_alpha = false;
-            px_size = sizeof(lv_color_t);
-            break;
-        case LV_IMG_CF_TRUE_COLOR_ALPHA:
-            has_alpha = true;
-            px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
-            break;
-        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
-                has_alpha = true;
-                px_size = sizeof(lv_color_t);
-                lv_disp_t * d = _lv_refr_get_disp_refreshing();
-                ck = d->driver->color_chroma_key;
-                break;
-            }
-#if LV_COLOR_DEPTH == 16
-        case LV_IMG_CF_RGB565A8:
-            has_alpha = true;
-            px_size = sizeof(lv_color_t);
-            break;
-#endif
-        default:
-            return;
-    }
+    int32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : (int32_t)sizeof(lv_color_t);
 
     lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -316,119 +604,24 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
 
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
+        int32_t xs_fract;
+        int32_t ys_fract;
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
-
-        const uint8_t * src_tmp = src;
-        src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
-
+        get_neighbor(xs_ups, &xs_fract, &x_next);
+        get_neighbor(ys_ups, &ys_fract, &y_next);
 
         if(xs_int + x_next >= 0 &&
            xs_int + x_next <= src_w - 1 &&
            ys_int + y_next >= 0 &&
            ys_int + y_next <= src_h - 1) {
-
-            const uint8_t * px_base = src_tmp;
-            const uint8_t * px_hor = src_tmp + x_next * px_size;
-            const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
-            lv_color_t c_base;
-            lv_color_t c_ver;
-            lv_color_t c_hor;
-
-            if(has_alpha) {
-                lv_opa_t a_base;
-                lv_opa_t a_ver;
-                lv_opa_t a_hor;
-                if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
-                    a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                }
-#if LV_COLOR_DEPTH == 16
-                else if(cf == LV_IMG_CF_RGB565A8) {
-                    const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-                    a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
-                    a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
-                    a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
-                }
-#endif
-                else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
-                    if(((lv_color_t *)px_base)->full == ck.full ||
-                       ((lv_color_t *)px_ver)->full == ck.full ||
-                       ((lv_color_t *)px_hor)->full == ck.full) {
-                        abuf[x] = 0x00;
-                        continue;
-                    }
-                    else {
-                        a_base = 0xff;
-                        a_ver = 0xff;
-                        a_hor = 0xff;
-                    }
-                }
-                else {
-                    a_base = 0xff;
-                    a_ver = 0xff;
-                    a_hor = 0xff;
-                }
-
-                if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
-                if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
-                abuf[x] = (a_ver + a_hor) >> 1;
-
-                if(abuf[x] == 0x00) continue;
-
-#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-                c_base.full = px_base[0];
-                c_ver.full = px_ver[0];
-                c_hor.full = px_hor[0];
-#elif LV_COLOR_DEPTH == 16
-                c_base.full = px_base[0] + (px_base[1] << 8);
-                c_ver.full = px_ver[0] + (px_ver[1] << 8);
-                c_hor.full = px_hor[0] + (px_hor[1] << 8);
-#elif LV_COLOR_DEPTH == 32
-                c_base.full = *((uint32_t *)px_base);
-                c_ver.full = *((uint32_t *)px_ver);
-                c_hor.full = *((uint32_t *)px_hor);
-#endif
-            }
-            /*No alpha channel -> RGB*/
-            else {
-                c_base = *((const lv_color_t *) px_base);
-                c_hor = *((const lv_color_t *) px_hor);
-                c_ver = *((const lv_color_t *) px_ver);
-                abuf[x] = 0xff;
-            }
-
-            if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
-                cbuf[x] = c_base;
-            }
-            else {
-                c_ver = lv_color_mix(c_ver, c_base, ys_fract);
-                c_hor = lv_color_mix(c_hor, c_base, xs_fract);
-                cbuf[x] = lv_color_mix(c_hor, c_ver, LV_OPA_50);
-            }
+            get_px_aa(src, src_h, src_stride, xs_int, ys_int, x_next, y_next, xs_fract, ys_fract, cf, ck,
+                      &cbuf[x], &abuf[x]);
         }
         /*Partially out of the image*/
         else {
+            const uint8_t * src_tmp = src;
+            src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
             cbuf[x].full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
@@ -466,31 +659,70 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
     }
 }
 
-static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
-                                     int32_t * yout)
+static void transform_init(point_transform_dsc_t * t)
 {
+    int32_t angle_low = t->angle / 10;
+    int32_t angle_high = angle_low + 1;
+    int32_t angle_rem = t->angle  - (angle_low * 10);
+
+    int32_t s1 = lv_trigo_sin(angle_low);
+    int32_t s2 = lv_trigo_sin(angle_high);
+
+    int32_t c1 = lv_trigo_sin(angle_low + 90);
+    int32_t c2 = lv_trigo_sin(angle_high + 90);
+
+    t->sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
+    t->cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
+    t->sinma = t->sinma >> (LV_TRIGO_SHIFT - 10);
+    t->cosma = t->cosma >> (LV_TRIGO_SHIFT - 10);
+    t->pivot_x_256 = t->pivot.x * 256;
+    t->pivot_y_256 = t->pivot.y * 256;
+
+    /*The accumulators are linear in Y so they can be stepped to the next rows*/
     if(t->angle == 0 && t->zoom == LV_IMG_ZOOM_NONE) {
-        *xout = xin * 256;
-        *yout = yin * 256;
-        return;
+        t->x_row_step = 0;
+        t->y_row_step = 256;
+        t->shift = 0;
+    }
+    else if(t->angle == 0) {
+        t->x_row_step = 0;
+        t->y_row_step = t->zoom;
+        t->shift = 0;
+    }
+    else if(t->zoom == LV_IMG_ZOOM_NONE) {
+        t->x_row_step = -t->sinma;
+        t->y_row_step = t->cosma;
+        t->shift = 2;
+    }
+    else {
+        t->x_row_step = -t->sinma * t->zoom;
+        t->y_row_step = t->cosma * t->zoom;
+        t->shift = 10;
     }
+}
 
+static void transform_point_acc(const point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * x_acc,
+                                int32_t * y_acc)
+{
     xin -= t->pivot.x;
     yin -= t->pivot.y;
 
-    if(t->angle == 0) {
-        *xout = ((int32_t)(xin * t->zoom)) + (t->pivot_x_256);
-        *yout = ((int32_t)(yin * t->zoom)) + (t->pivot_y_256);
+    if(t->angle == 0 && t->zoom == LV_IMG_ZOOM_NONE) {
+        *x_acc = xin * 256;
+        *y_acc = yin * 256;
+    }
+    else if(t->angle == 0) {
+        *x_acc = xin * t->zoom;
+        *y_acc = yin * t->zoom;
     }
     else if(t->zoom == LV_IMG_ZOOM_NONE) {
-        *xout = ((t->cosma * xin - t->sinma * yin) >> 2) + (t->pivot_x_256);
-        *yout = ((t->sinma * xin + t->cosma * yin) >> 2) + (t->pivot_y_256);
+        *x_acc = t->cosma * xin - t->sinma * yin;
+        *y_acc = t->sinma * xin + t->cosma * yin;
     }
     else {
-        *xout = (((t->cosma * xin - t->sinma * yin) * t->zoom) >> 10) + (t->pivot_x_256);
-        *yout = (((t->sinma * xin + t->cosma * yin) * t->zoom) >> 10) + (t->pivot_y_256);
+        *x_acc = (t->cosma * xin - t->sinma * yin) * t->zoom;
+        *y_acc = (t->sinma * xin + t->cosma * yin) * t->zoom;
     }
 }
 
 #endif
-
@@ -0,0 +1,463 @@
+/**
+ * @file lv_fs_mmap.c
+ *
+ * A read only driver which maps the files to the memory, so `lv_fs_get_ptr()` can give pointers into them
+ * and the image decoder and the font loader can use the data in place, without copying it into the RAM.
+ * - On ESP32 the files are packed into a data partition (see `scripts/fs_mmap_pack.py`)
+ *   which is mapped with `esp_partition_mmap()` once. `LV_FS_MMAP_PATH` is the label of the partition.
+ * - Elsewhere every opened file is mapped with POSIX `mmap()`. `LV_FS_MMAP_PATH` is the working directory.
+ */
+
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_FS_MMAP
+
+#include <string.h>
+#ifdef ESP_PLATFORM
+    #include "esp_partition.h"
+#else
+    #include <fcntl.h>
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_FS_MMAP_LETTER == '\0'
+    #error "LV_FS_MMAP_LETTER must be an upper case ASCII letter"
+#endif
+
+#ifdef ESP_PLATFORM
+    #define PACK_MAGIC      0x4D4D564CUL    /*"LVMM" in little endian*/
+    #define PACK_NAME_LEN   56
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+} mmap_file_t;
+
+#ifdef ESP_PLATFORM
+/*The partition starts with a header and `cnt` entries. The data of the files is aligned to 4 bytes.*/
+typedef struct {
+    uint32_t magic;
+    uint32_t cnt;
+} pack_header_t;
+
+typedef struct {
+    char name[PACK_NAME_LEN];   /*Path relative to the root without leading '/', e.g. "icons/cog.bin"*/
+    uint32_t offset;            /*From the start of the partition*/
+    uint32_t size;
+} pack_entry_t;
+
+typedef struct {
+    char path[PACK_NAME_LEN];   /*The directory with a trailing '/' or "" for the root*/
+    uint32_t idx;
+    uint32_t last_dir_idx;      /*Entry whose sub directory was listed last*/
+} pack_dir_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_get_ptr(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len, const void ** ptr_p);
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn);
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
+
+#ifdef ESP_PLATFORM
+    static bool fs_ready(lv_fs_drv_t * drv);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#ifdef ESP_PLATFORM
+    static const pack_header_t * pack;
+    static esp_partition_mmap_handle_t pack_handle;
+    static uint32_t pack_size;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register a driver for the File system interface
+ */
+void lv_fs_mmap_init(void)
+{
+#ifdef ESP_PLATFORM
+    /*Map the whole partition once. It remains mapped, so the pointers into the files never get invalid.*/
+    const esp_partition_t * part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                            LV_FS_MMAP_PATH);
+    if(part == NULL) {
+        LV_LOG_WARN("no \"%s\" partition", LV_FS_MMAP_PATH);
+    }
+    else {
+        const void * ptr;
+        if(esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &ptr, &pack_handle) != ESP_OK) {
+            LV_LOG_WARN("couldn't map the \"%s\" partition", LV_FS_MMAP_PATH);
+        }
+        else if(((const pack_header_t *)ptr)->magic != PACK_MAGIC) {
+            LV_LOG_WARN("the \"%s\" partition has no files", LV_FS_MMAP_PATH);
+            esp_partition_munmap(pack_handle);
+        }
+        else {
+            pack = ptr;
+            pack_size = part->size;
+        }
+    }
+#endif
+
+    /*---------------------------------------------------
+     * Register the file system interface in LVGL
+     *--------------------------------------------------*/
+
+    /*Add a simple drive to open images*/
+    static lv_fs_drv_t fs_drv; /*A driver descriptor*/
+    lv_fs_drv_init(&fs_drv);
+
+    /*Set up fields...*/
+    fs_drv.letter = LV_FS_MMAP_LETTER;
+    fs_drv.cache_size = 0;  /*The data is read from the memory anyway*/
+
+#ifdef ESP_PLATFORM
+    fs_drv.ready_cb = fs_ready;
+#endif
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+    fs_drv.get_ptr_cb = fs_get_ptr;
+
+    fs_drv.dir_close_cb = fs_dir_close;
+    fs_drv.dir_open_cb = fs_dir_open;
+    fs_drv.dir_read_cb = fs_dir_read;
+
+    lv_fs_drv_register(&fs_drv);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#ifdef ESP_PLATFORM
+
+static bool fs_ready(lv_fs_drv_t * drv)
+{
+    LV_UNUSED(drv);
+    return pack != NULL;
+}
+
+static const pack_entry_t * pack_entry(uint32_t idx)
+{
+    return &((const pack_entry_t *)(pack + 1))[idx];
+}
+
+#endif
+
+/**
+ * Open a file
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @param mode only FS_MODE_RD is supported
+ * @return a file handle or NULL in case of fail
+ */
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    if(mode != LV_FS_MODE_RD) return NULL;
+
+    mmap_file_t * f = lv_mem_alloc(sizeof(mmap_file_t));
+    LV_ASSERT_MALLOC(f);
+    if(f == NULL) return NULL;
+    f->pos = 0;
+
+#ifdef ESP_PLATFORM
+    if(pack == NULL) {
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    if(path[0] == '/') path++;
+    uint32_t i;
+    for(i = 0; i < pack->cnt; i++) {
+        const pack_entry_t * e = pack_entry(i);
+        if(strncmp(e->name, path, PACK_NAME_LEN) == 0 && e->offset <= pack_size && e->size <= pack_size - e->offset) {
+            f->data = (const uint8_t *)pack + e->offset;
+            f->size = e->size;
+            return f;
+        }
+    }
+
+    lv_mem_free(f);
+    return NULL;
+#else
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_MMAP_PATH "%s", path);
+
+    int fd = open(buf, O_RDONLY);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) != 0 || (uint64_t)st.st_size > UINT32_MAX) {
+        if(fd >= 0) close(fd);
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    /*Empty files can't be mapped*/
+    f->size = st.st_size;
+    f->data = NULL;
+    if(f->size > 0) {
+        void * map = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED) f->data = map;
+    }
+
+    /*The mapping remains valid without the file descriptor*/
+    close(fd);
+    if(f->size > 0 && f->data == NULL) {
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    return f;
+#endif
+}
+
+/**
+ * Close an opened file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle. (opened with fs_open)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+#ifndef ESP_PLATFORM
+    if(f->data) munmap((void *)f->data, f->size);
+#endif
+    lv_mem_free(f);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read data from an opened file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    *br = f->pos < f->size ? LV_MIN(btr, f->size - f->pos) : 0;
+    if(*br) lv_memcpy(buf, f->data + f->pos, *br);
+    f->pos += *br;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read pointer. The position can be after the end of the file, but reading there gives 0 bytes.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable. (opened with fs_open )
+ * @param pos the new position of read pointer
+ * @param whence tells from where to interpret the `pos`. See @lv_fs_whence_t
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            f->pos = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            f->pos += pos;
+            break;
+        case LV_FS_SEEK_END:
+            f->pos = f->size + pos;
+            break;
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param pos_p pointer to to store the result
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    *pos_p = ((mmap_file_t *)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give a pointer into the mapped file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param pos position of the first byte
+ * @param len number of bytes which will be read from the pointer
+ * @param ptr_p store the pointer here
+ * @return LV_FS_RES_OK or LV_FS_RES_INV_PARAM if the range is not in the file
+ */
+static lv_fs_res_t fs_get_ptr(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len, const void ** ptr_p)
+{
+    LV_UNUSED(drv);
+    mmap_file_t * f = file_p;
+    if(pos > f->size || len > f->size - pos) return LV_FS_RES_INV_PARAM;
+
+    *ptr_p = f->data + pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Initialize a 'fs_read_dir_t' variable for directory reading
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to a directory
+ * @return pointer to an initialized 'DIR' or 'pack_dir_t' variable
+ */
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+#ifdef ESP_PLATFORM
+    if(pack == NULL) return NULL;
+
+    while(path[0] == '/') path++;
+    size_t len = strlen(path);
+    if(len + 1 >= PACK_NAME_LEN) return NULL;
+
+    pack_dir_t * d = lv_mem_alloc(sizeof(pack_dir_t));
+    LV_ASSERT_MALLOC(d);
+    if(d == NULL) return NULL;
+
+    strcpy(d->path, path);
+    if(len && d->path[len - 1] != '/') strcpy(&d->path[len], "/");
+    d->idx = 0;
+    d->last_dir_idx = UINT32_MAX;
+    return d;
+#else
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_MMAP_PATH "%s", path);
+    return opendir(buf);
+#endif
+}
+
+/**
+ * Read the next filename from a directory.
+ * The name of the directories will begin with '/'
+ * @param drv pointer to a driver where this function belongs
+ * @param dir_p pointer to an initialized 'DIR' or 'pack_dir_t' variable
+ * @param fn pointer to a buffer to store the filename
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn)
+{
+    LV_UNUSED(drv);
+
+#ifdef ESP_PLATFORM
+    pack_dir_t * d = dir_p;
+    size_t len = strlen(d->path);
+    strcpy(fn, "");
+    for(; d->idx < pack->cnt; d->idx++) {
+        const char * name = pack_entry(d->idx)->name;
+        if(strncmp(name, d->path, len) != 0) continue;
+
+        /*The packer sorts the names, so the files of a sub directory follow each other*/
+        const char * sub = name + len;
+        const char * sep = strchr(sub, '/');
+        if(sep == NULL) {
+            lv_snprintf(fn, LV_FS_MAX_FN_LENGTH, "%s", sub);
+            d->idx++;
+            break;
+        }
+
+        if(d->last_dir_idx != UINT32_MAX) {
+            const char * last = pack_entry(d->last_dir_idx)->name + len;
+            if(strncmp(last, sub, sep - sub + 1) == 0) continue;
+        }
+
+        d->last_dir_idx = d->idx;
+        lv_snprintf(fn, LV_FS_MAX_FN_LENGTH, "/%.*s", (int)(sep - sub), sub);
+        d->idx++;
+        break;
+    }
+#else
+    struct dirent * entry;
+    do {
+        entry = readdir(dir_p);
+        if(entry) {
+            if(entry->d_type == DT_DIR) lv_snprintf(fn, LV_FS_MAX_FN_LENGTH, "/%s", entry->d_name);
+            else lv_snprintf(fn, LV_FS_MAX_FN_LENGTH, "%s", entry->d_name);
+        }
+        else {
+            strcpy(fn, "");
+        }
+    } while(strcmp(fn, "/.") == 0 || strcmp(fn, "/..") == 0);
+#endif
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close the directory reading
+ * @param drv pointer to a driver where this function belongs
+ * @param dir_p pointer to an initialized 'DIR' or 'pack_dir_t' variable
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p)
+{
+    LV_UNUSED(drv);
+#ifdef ESP_PLATFORM
+    lv_mem_free(dir_p);
+#else
+    closedir(dir_p);
+#endif
+    return LV_FS_RES_OK;
+}
+#else /*LV_USE_FS_MMAP == 0*/
+
+#if defined(LV_FS_MMAP_LETTER) && LV_FS_MMAP_LETTER != '\0'
+    #warning "LV_USE_FS_MMAP is not enabled but LV_FS_MMAP_LETTER is set"
+#endif
+
+#endif /*LV_USE_FS_MMAP*/
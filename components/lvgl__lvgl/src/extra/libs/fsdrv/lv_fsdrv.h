@@ -44,6 +44,10 @@ void lv_fs_stdio_init(void);
 void lv_fs_posix_init(void);
 #endif
 
+#if LV_USE_FS_MMAP != '\0'
+void lv_fs_mmap_init(void);
+#endif
+
 #if LV_USE_FS_WIN32 != '\0'
 void lv_fs_win32_init(void);
 #endif
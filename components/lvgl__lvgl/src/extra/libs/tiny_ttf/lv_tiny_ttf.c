@@ -3,6 +3,7 @@
 #if LV_USE_TINY_TTF
 #include <stdio.h>
 #include "../../../misc/lv_lru.h"
+#include "../../../draw/sw/lv_draw_sw.h"
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -75,6 +76,13 @@ typedef struct ttf_font_desc {
     int ascent;
     int descent;
     lv_lru_t * bitmap_cache;
+    lv_lru_t * glyph_cache;
+    lv_lru_t * kern_cache;
+    uint8_t * atlas;        /*If not NULL the bitmaps are stored here and `bitmap_cache` only indexes them*/
+    size_t atlas_size;
+    size_t atlas_used;
+    uint16_t weight;
+    int bold_r;             /*Grow the strokes by this many [px] on each side to get `weight`*/
 } ttf_font_desc_t;
 
 typedef struct ttf_bitmap_cache_key {
@@ -82,6 +90,159 @@ typedef struct ttf_bitmap_cache_key {
     lv_coord_t line_height;
 } ttf_bitmap_cache_key_t;
 
+/*The glyph cache uses the key of the bitmap cache, the box depends on the size too*/
+typedef struct ttf_glyph_cache_value {
+    int glyph_index;    /*0 if the font has no glyph for the letter*/
+    int adv;            /*Advance width in font units*/
+    int x1;             /*Box of the bitmap in [px]*/
+    int y1;
+    int x2;
+    int y2;
+} ttf_glyph_cache_value_t;
+
+typedef struct ttf_kern_cache_key {
+    int glyph_index;
+    int glyph_index_next;
+} ttf_kern_cache_key_t;
+
+/*Look up the glyph of a letter and its metrics at the current size*/
+static void ttf_get_glyph(const lv_font_t * font, uint32_t unicode_letter, ttf_glyph_cache_value_t * glyph)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    ttf_bitmap_cache_key_t cache_key;
+    lv_memset_00(&cache_key, sizeof(cache_key)); /*Zero padding*/
+    cache_key.unicode_letter = unicode_letter;
+    cache_key.line_height = font->line_height;
+    if(dsc->glyph_cache) {
+        ttf_glyph_cache_value_t * cached = NULL;
+        lv_lru_get(dsc->glyph_cache, &cache_key, sizeof(cache_key), (void **)&cached);
+        if(cached) {
+            *glyph = *cached;
+            return;
+        }
+    }
+
+    glyph->glyph_index = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
+    glyph->adv = 0;
+    glyph->x1 = glyph->y1 = glyph->x2 = glyph->y2 = 0;
+    if(glyph->glyph_index != 0) {
+        int lsb;
+        stbtt_GetGlyphHMetrics(&dsc->info, glyph->glyph_index, &glyph->adv, &lsb);
+        stbtt_GetGlyphBitmapBox(&dsc->info, glyph->glyph_index, dsc->scale, dsc->scale,
+                                &glyph->x1, &glyph->y1, &glyph->x2, &glyph->y2);
+    }
+
+    if(dsc->glyph_cache) {
+        /*Missing glyphs are cached too, the fallback fonts are asked for them repeatedly*/
+        ttf_glyph_cache_value_t * value = lv_mem_alloc(sizeof(ttf_glyph_cache_value_t));
+        if(value == NULL) return;
+        *value = *glyph;
+        if(LV_LRU_OK != lv_lru_set(dsc->glyph_cache, &cache_key, sizeof(cache_key), value,
+                                   sizeof(ttf_glyph_cache_value_t))) {
+            lv_mem_free(value);
+        }
+    }
+}
+
+/*Get the kerning between two glyphs in font units*/
+static int ttf_get_kern(ttf_font_desc_t * dsc, int g1, int g2)
+{
+    if(dsc->info.kern == 0 && dsc->info.gpos == 0) return 0;
+
+    ttf_kern_cache_key_t cache_key;
+    cache_key.glyph_index = g1;
+    cache_key.glyph_index_next = g2;
+    if(dsc->kern_cache) {
+        int * cached = NULL;
+        lv_lru_get(dsc->kern_cache, &cache_key, sizeof(cache_key), (void **)&cached);
+        if(cached) return *cached;
+    }
+
+    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
+
+    if(dsc->kern_cache) {
+        int * value = lv_mem_alloc(sizeof(int));
+        if(value == NULL) return k;
+        *value = k;
+        if(LV_LRU_OK != lv_lru_set(dsc->kern_cache, &cache_key, sizeof(cache_key), value, sizeof(int))) {
+            lv_mem_free(value);
+        }
+    }
+    return k;
+}
+
+/*The bitmaps are in the atlas, nothing to free when the index drops them*/
+static void ttf_atlas_value_free_cb(void * v)
+{
+    LV_UNUSED(v);
+}
+
+static lv_lru_t * ttf_bitmap_cache_create(ttf_font_desc_t * dsc, size_t cache_size, size_t average_length)
+{
+    if(dsc->atlas) return lv_lru_create(cache_size, average_length, ttf_atlas_value_free_cb, lv_mem_free);
+    else return lv_lru_create(cache_size, average_length, lv_mem_free, lv_mem_free);
+}
+
+/*Take `size` bytes from the atlas. Start over with an empty atlas if it's full.*/
+static uint8_t * ttf_atlas_alloc(ttf_font_desc_t * dsc, size_t size)
+{
+    if(size > dsc->atlas_size) {
+        LV_LOG_WARN("glyph of %u bytes doesn't fit into the atlas", (unsigned int)size);
+        return NULL;
+    }
+
+    if(dsc->atlas_used + size > dsc->atlas_size) {
+        LV_LOG_INFO("atlas is full, flushing it");
+        lv_lru_t * index = ttf_bitmap_cache_create(dsc, dsc->atlas_size, dsc->bitmap_cache->average_item_length);
+        if(index == NULL) {
+            LV_LOG_ERROR("failed to create lru cache");
+            return NULL;
+        }
+        lv_lru_del(dsc->bitmap_cache);
+        dsc->bitmap_cache = index;
+        dsc->atlas_used = 0;
+    }
+
+    uint8_t * buf = dsc->atlas + dsc->atlas_used;
+    dsc->atlas_used += size;
+    return buf;
+}
+
+/*Grow the strokes of a `w` x `h` bitmap by `r` pixels with a separable maximum filter*/
+static void ttf_embolden(uint8_t * buf, int w, int h, int r)
+{
+    uint8_t * tmp = lv_mem_buf_get(LV_MAX(w, h));
+    if(tmp == NULL) return;
+
+    int x, y, i;
+    for(y = 0; y < h; y++) {
+        uint8_t * row = buf + y * w;
+        lv_memcpy(tmp, row, w);
+        for(x = 0; x < w; x++) {
+            uint8_t m = 0;
+            int i_end = LV_MIN(x + r, w - 1);
+            for(i = LV_MAX(x - r, 0); i <= i_end; i++) {
+                if(tmp[i] > m) m = tmp[i];
+            }
+            row[x] = m;
+        }
+    }
+
+    for(x = 0; x < w; x++) {
+        for(y = 0; y < h; y++) tmp[y] = buf[y * w + x];
+        for(y = 0; y < h; y++) {
+            uint8_t m = 0;
+            int i_end = LV_MIN(y + r, h - 1);
+            for(i = LV_MAX(y - r, 0); i <= i_end; i++) {
+                if(tmp[i] > m) m = tmp[i];
+            }
+            buf[y * w + x] = m;
+        }
+    }
+
+    lv_mem_buf_release(tmp);
+}
+
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
 {
@@ -98,31 +259,29 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
-    if(g1 == 0) {
+    ttf_glyph_cache_value_t g1;
+    ttf_get_glyph(font, unicode_letter, &g1);
+    if(g1.glyph_index == 0) {
         /* Glyph not found */
         return false;
     }
-    int x1, y1, x2, y2;
 
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int g2 = 0;
+    int k = 0;
     if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
+        ttf_glyph_cache_value_t g2;
+        ttf_get_glyph(font, unicode_letter_next, &g2);
+        k = ttf_get_kern(dsc, g1.glyph_index, g2.glyph_index);
     }
-    int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
-                                     0.5f); /*Horizontal space required by the glyph in [px]*/
-
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
-                                     0.5f); /*Horizontal space required by the glyph in [px]*/
-    dsc_out->box_w = (x2 - x1 + 1);         /*width of the bitmap in [px]*/
-    dsc_out->box_h = (y2 - y1 + 1);         /*height of the bitmap in [px]*/
-    dsc_out->ofs_x = x1;                    /*X offset of the bitmap in [pf]*/
-    dsc_out->ofs_y = -y2;                   /*Y offset of the bitmap measured from the as line*/
-    dsc_out->bpp = 8;                       /*Bits per pixel: 1/2/4/8*/
+
+    /*The emboldened glyphs are wider by `bold_r` on both sides*/
+    int r = dsc->bold_r;
+    dsc_out->adv_w = (uint16_t)(floor((((float)g1.adv + (float)k) * dsc->scale) +
+                                      0.5f) + 2 * r); /*Horizontal space required by the glyph in [px]*/
+    dsc_out->box_w = (g1.x2 - g1.x1 + 1 + 2 * r);   /*width of the bitmap in [px]*/
+    dsc_out->box_h = (g1.y2 - g1.y1 + 1 + 2 * r);   /*height of the bitmap in [px]*/
+    dsc_out->ofs_x = g1.x1;                         /*X offset of the bitmap in [pf]*/
+    dsc_out->ofs_y = -g1.y2 - r;                    /*Y offset of the bitmap measured from the as line*/
+    dsc_out->bpp = 8;                               /*Bits per pixel: 1/2/4/8*/
     dsc_out->is_placeholder = false;
     return true; /*true: glyph found; false: glyph was not found*/
 }
@@ -131,17 +290,6 @@ static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
     const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
-    int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
-    if(g1 == 0) {
-        /* Glyph not found */
-        return NULL;
-    }
-    int x1, y1, x2, y2;
-    stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int w, h;
-    w = x2 - x1 + 1;
-    h = y2 - y1 + 1;
-    uint32_t stride = w;
     /*Try to load from cache*/
     ttf_bitmap_cache_key_t cache_key;
     lv_memset(&cache_key, 0, sizeof(cache_key)); /*Zero padding*/
@@ -152,10 +300,21 @@ static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t
     if(buffer) {
         return buffer;
     }
+    ttf_glyph_cache_value_t g1;
+    ttf_get_glyph(font, unicode_letter, &g1);
+    if(g1.glyph_index == 0) {
+        /* Glyph not found */
+        return NULL;
+    }
+    int r = dsc->bold_r;
+    int w, h;
+    w = g1.x2 - g1.x1 + 1 + 2 * r;
+    h = g1.y2 - g1.y1 + 1 + 2 * r;
+    uint32_t stride = w;
     LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
     /*Prepare space in cache*/
     size_t szb = h * stride;
-    buffer = lv_mem_alloc(szb);
+    buffer = dsc->atlas ? ttf_atlas_alloc(dsc, szb) : lv_mem_alloc(szb);
     if(!buffer) {
         LV_LOG_ERROR("failed to allocate cache value");
         return NULL;
@@ -163,16 +322,18 @@ static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t
     lv_memset(buffer, 0, szb);
     if(LV_LRU_OK != lv_lru_set(dsc->bitmap_cache, &cache_key, sizeof(cache_key), buffer, szb)) {
         LV_LOG_ERROR("failed to add cache value");
-        lv_mem_free(buffer);
+        if(dsc->atlas == NULL) lv_mem_free(buffer);
         return NULL;
     }
     /*Render into cache*/
-    stbtt_MakeGlyphBitmap(info, buffer, w, h, stride, dsc->scale, dsc->scale, g1);
+    stbtt_MakeGlyphBitmap(info, buffer + r * stride + r, w - 2 * r, h - 2 * r, stride, dsc->scale, dsc->scale,
+                          g1.glyph_index);
+    if(r > 0) ttf_embolden(buffer, w, h, r);
     return buffer;
 }
 
 static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
-                                      size_t cache_size)
+                                      size_t cache_size, uint16_t weight, size_t atlas_size)
 {
     if((path == NULL && data == NULL) || 0 >= font_size) {
         LV_LOG_ERROR("tiny_ttf: invalid argument\n");
@@ -211,16 +372,53 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     }
 #endif
 
-    dsc->bitmap_cache = lv_lru_create(cache_size, font_size * font_size, lv_mem_free, lv_mem_free);
+    dsc->weight = weight;
+    dsc->bold_r = 0;
+    dsc->atlas = NULL;
+    dsc->atlas_size = 0;
+    dsc->atlas_used = 0;
+    if(atlas_size > 0) {
+        /*One large, long lived buffer instead of a heap block per glyph, e.g. in external RAM*/
+        dsc->atlas = lv_mem_ext_alloc(atlas_size);
+        if(dsc->atlas == NULL) {
+            LV_LOG_ERROR("tiny_ttf: out of memory\n");
+            goto err_after_dsc;
+        }
+        dsc->atlas_size = atlas_size;
+        cache_size = atlas_size;
+    }
+
+    /*Have at least one slot in the hash table even if the glyphs are larger than the cache*/
+    dsc->bitmap_cache = ttf_bitmap_cache_create(dsc, cache_size, LV_MIN((size_t)font_size * font_size, cache_size));
     if(dsc->bitmap_cache == NULL) {
         LV_LOG_ERROR("failed to create lru cache");
-        goto err_after_dsc;
+        goto err_after_atlas;
+    }
+
+    /*The metrics are needed by each letter of each text, don't get them from the font data every time*/
+    dsc->glyph_cache = NULL;
+    dsc->kern_cache = NULL;
+    if(LV_TINY_TTF_GLYPH_CACHE_CNT > 0) {
+        dsc->glyph_cache = lv_lru_create(LV_TINY_TTF_GLYPH_CACHE_CNT * sizeof(ttf_glyph_cache_value_t),
+                                         sizeof(ttf_glyph_cache_value_t), lv_mem_free, lv_mem_free);
+        if(dsc->glyph_cache == NULL) {
+            LV_LOG_ERROR("failed to create lru cache");
+            goto err_after_bitmap_cache;
+        }
+    }
+    if(LV_TINY_TTF_KERN_CACHE_CNT > 0) {
+        dsc->kern_cache = lv_lru_create(LV_TINY_TTF_KERN_CACHE_CNT * sizeof(int), sizeof(int),
+                                        lv_mem_free, lv_mem_free);
+        if(dsc->kern_cache == NULL) {
+            LV_LOG_ERROR("failed to create lru cache");
+            goto err_after_glyph_cache;
+        }
     }
 
     lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
     if(out_font == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
-        goto err_after_bitmap_cache;
+        goto err_after_kern_cache;
     }
     lv_memset(out_font, 0, sizeof(lv_font_t));
     out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
@@ -228,8 +426,14 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     out_font->dsc = dsc;
     lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
+err_after_kern_cache:
+    if(dsc->kern_cache) lv_lru_del(dsc->kern_cache);
+err_after_glyph_cache:
+    if(dsc->glyph_cache) lv_lru_del(dsc->glyph_cache);
 err_after_bitmap_cache:
     lv_lru_del(dsc->bitmap_cache);
+err_after_atlas:
+    if(dsc->atlas) lv_mem_ext_free(dsc->atlas);
 err_after_dsc:
     TTF_FREE(dsc);
     return NULL;
@@ -237,21 +441,38 @@ err_after_dsc:
 #if LV_TINY_TTF_FILE_SUPPORT
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, lv_coord_t font_size, size_t cache_size)
 {
-    return lv_tiny_ttf_create(path, NULL, 0, font_size, cache_size);
+    return lv_tiny_ttf_create(path, NULL, 0, font_size, cache_size, 400, 0);
 }
 lv_font_t * lv_tiny_ttf_create_file(const char * path, lv_coord_t font_size)
 {
     return lv_tiny_ttf_create_file_ex(path, font_size, 4096);
 }
+lv_font_t * lv_tiny_ttf_create_file_atlas(const char * path, lv_coord_t font_size, uint16_t weight, size_t atlas_size)
+{
+    if(atlas_size == 0) {
+        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
+        return NULL;
+    }
+    return lv_tiny_ttf_create(path, NULL, 0, font_size, 0, weight, atlas_size);
+}
 #endif /*LV_TINY_TTF_FILE_SUPPORT*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t font_size, size_t cache_size)
 {
-    return lv_tiny_ttf_create(NULL, data, data_size, font_size, cache_size);
+    return lv_tiny_ttf_create(NULL, data, data_size, font_size, cache_size, 400, 0);
 }
 lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coord_t font_size)
 {
     return lv_tiny_ttf_create_data_ex(data, data_size, font_size, 4096);
 }
+lv_font_t * lv_tiny_ttf_create_data_atlas(const void * data, size_t data_size, lv_coord_t font_size, uint16_t weight,
+                                          size_t atlas_size)
+{
+    if(atlas_size == 0) {
+        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
+        return NULL;
+    }
+    return lv_tiny_ttf_create(NULL, data, data_size, font_size, 0, weight, atlas_size);
+}
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
 {
     if(font_size <= 0) {
@@ -264,6 +485,13 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
     stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
     font->line_height = (lv_coord_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
     font->base_line = (lv_coord_t)(dsc->scale * (line_gap - dsc->descent));
+
+    /*Only the default instance of variable fonts can be rendered. Make it bolder by thickening the strokes:
+     *going from 400 to 700 adds about 5% of the font size to the stems.*/
+    dsc->bold_r = dsc->weight > 400 ? (font_size * (dsc->weight - 400) + 6000) / 12000 : 0;
+
+    /*The cached texts of this font have the old size*/
+    lv_draw_sw_text_cache_clear();
 }
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
@@ -276,7 +504,11 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
             }
 #endif
             lv_lru_del(ttf->bitmap_cache);
+            if(ttf->glyph_cache) lv_lru_del(ttf->glyph_cache);
+            if(ttf->kern_cache) lv_lru_del(ttf->kern_cache);
+            if(ttf->atlas) lv_mem_ext_free(ttf->atlas);
             TTF_FREE(ttf);
+            lv_draw_sw_text_cache_clear();
         }
         TTF_FREE(font);
     }
@@ -35,6 +35,10 @@ lv_font_t * lv_tiny_ttf_create_file(const char * path, lv_coord_t font_size);
 
 /* create a font from the specified file or path with the specified line height with the specified cache size.*/
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, lv_coord_t font_size, size_t cache_size);
+
+/* create a font from the specified file or path with the specified line height and weight (400: regular, 700: bold).
+ * The glyphs are rendered into an atlas of atlas_size bytes which is flushed when it's full.*/
+lv_font_t * lv_tiny_ttf_create_file_atlas(const char * path, lv_coord_t font_size, uint16_t weight, size_t atlas_size);
 #endif /*LV_TINY_TTF_FILE_SUPPORT*/
 
 /* create a font from the specified data pointer with the specified line height.*/
@@ -43,6 +47,11 @@ lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coor
 /* create a font from the specified data pointer with the specified line height and the specified cache size.*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t font_size, size_t cache_size);
 
+/* create a font from the specified data pointer with the specified line height and weight (400: regular, 700: bold).
+ * The glyphs are rendered into an atlas of atlas_size bytes which is flushed when it's full.*/
+lv_font_t * lv_tiny_ttf_create_data_atlas(const void * data, size_t data_size, lv_coord_t font_size, uint16_t weight,
+                                          size_t atlas_size);
+
 /* set the size of the font to a new font_size*/
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size);
 
@@ -11,6 +11,7 @@
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
+#include "../draw/sw/lv_draw_sw_thread.h"
 
 /*********************
  *      DEFINES
@@ -45,6 +46,8 @@
  * @param font_p pointer to a font
  * @param letter a UNICODE character code
  * @return pointer to the bitmap of the letter
+ * @note the bitmap might be overwritten when an other glyph is loaded. While drawing with multiple threads
+ *       get and use the bitmap between `lv_draw_sw_thread_lock()` and `lv_draw_sw_thread_unlock()`.
  */
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
@@ -77,7 +80,10 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
     dsc_out->resolved_font = NULL;
 
     while(f) {
+        /*The fonts might cache the last glyph or decompressed bitmaps*/
+        lv_draw_sw_thread_lock();
         bool found = f->get_glyph_dsc(f, dsc_out, letter, letter_next);
+        lv_draw_sw_thread_unlock();
         if(found) {
             if(!dsc_out->is_placeholder) {
                 dsc_out->resolved_font = f;
@@ -96,7 +102,9 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
 
 #if LV_USE_FONT_PLACEHOLDER
     if(placeholder_font != NULL) {
+        lv_draw_sw_thread_lock();
         placeholder_font->get_glyph_dsc(placeholder_font, dsc_out, letter, letter_next);
+        lv_draw_sw_thread_unlock();
         dsc_out->resolved_font = placeholder_font;
         return true;
     }
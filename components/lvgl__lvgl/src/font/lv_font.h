@@ -92,6 +92,8 @@ typedef struct _lv_font_t {
  * @param font_p pointer to a font
  * @param letter a UNICODE character code
  * @return pointer to the bitmap of the letter
+ * @note the bitmap might be overwritten when an other glyph is loaded. While drawing with multiple threads
+ *       get and use the bitmap between `lv_draw_sw_thread_lock()` and `lv_draw_sw_thread_unlock()`.
  */
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter);
 
@@ -14,10 +14,15 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
+#include "../misc/lv_lru.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    /*Used to size the hash table of the bitmap cache*/
+    #define BITMAP_CACHE_AVG_SIZE LV_MIN(256, LV_FONT_COMPRESSED_CACHE_SIZE)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +33,13 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+typedef struct {
+    const lv_font_t * font;
+    uint32_t gid;
+} bitmap_cache_key_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -36,6 +48,11 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
+static inline uint32_t kern_pair_gid(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t pair, uint32_t side);
+static bool accel_add_cmap(lv_font_fmt_txt_accel_t * accel, const lv_font_fmt_txt_cmap_t * cmap);
+static bool accel_add_kern_pairs(lv_font_fmt_txt_accel_t * accel, const lv_font_fmt_txt_kern_pair_t * kdsc);
+static bool accel_set_gid(lv_font_fmt_txt_accel_t * accel, uint32_t letter, uint32_t gid);
+static void accel_free(lv_font_fmt_txt_accel_t * accel);
 
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
@@ -44,6 +61,11 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
     static inline uint8_t rle_next(void);
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+    static uint8_t * bitmap_cache_get(const lv_font_t * font, uint32_t gid);
+    static uint8_t * bitmap_cache_add(const lv_font_t * font, uint32_t gid, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                      uint32_t buf_size);
+#endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -56,6 +78,8 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static uint8_t rle_prev_v;
     static uint8_t rle_cnt;
     static rle_state_t rle_state;
+    static uint32_t bitmap_cache_hit_cnt;
+    static uint32_t bitmap_cache_miss_cnt;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -98,6 +122,15 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
         if(gsize == 0) return NULL;
 
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+        uint8_t * cached = bitmap_cache_get(font, gid);
+        if(cached) {
+            bitmap_cache_hit_cnt++;
+            return cached;
+        }
+#endif
+        bitmap_cache_miss_cnt++;
+
         uint32_t buf_size = gsize;
         /*Compute memory size needed to hold decompressed glyph, rounding up*/
         switch(fdsc->bpp) {
@@ -115,6 +148,12 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+        /*Decompress straight into the cache. If it can't be cached use the common buffer*/
+        cached = bitmap_cache_add(font, gid, gdsc, buf_size);
+        if(cached) return cached;
+#endif
+
         if(last_buf_size < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MALLOC(tmp);
@@ -189,6 +228,100 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+/**
+ * Create lookup tables to get the glyph ids and kerning values of a font in constant time
+ * instead of searching the character maps and kern pairs on every letter.
+ * Worth it for fonts with many glyphs or sparse character maps, e.g. CJK fonts.
+ * @param font pointer to a font in `lv_font_fmt_txt_dsc_t` format. It needs a `cache` to store the tables.
+ * @return true: the tables are created; false: out of memory or the font can't have tables
+ */
+bool lv_font_fmt_txt_accel_create(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->cache == NULL) return false;
+
+    lv_font_fmt_txt_accel_delete(font);
+
+    lv_font_fmt_txt_accel_t * accel = lv_mem_alloc(sizeof(lv_font_fmt_txt_accel_t));
+    LV_ASSERT_MALLOC(accel);
+    if(accel == NULL) return false;
+    lv_memset_00(accel, sizeof(lv_font_fmt_txt_accel_t));
+
+    /*Go backward so that the first character map containing a letter wins as in `get_glyph_dsc_id()`*/
+    int32_t i;
+    for(i = fdsc->cmap_num - 1; i >= 0; i--) {
+        if(!accel_add_cmap(accel, &fdsc->cmaps[i])) {
+            LV_LOG_WARN("couldn't create the glyph id table");
+            accel_free(accel);
+            return false;
+        }
+    }
+
+    if(fdsc->kern_dsc && fdsc->kern_classes == 0) {
+        if(!accel_add_kern_pairs(accel, fdsc->kern_dsc)) {
+            LV_LOG_WARN("couldn't create the kern pair table");
+            accel_free(accel);
+            return false;
+        }
+    }
+
+    fdsc->cache->accel = accel;
+    fdsc->cache->last_letter = 0;
+    fdsc->cache->last_glyph_id = 0;
+
+    return true;
+}
+
+/**
+ * Free the lookup tables of a font created by `lv_font_fmt_txt_accel_create()`
+ * @param font pointer to a font
+ */
+void lv_font_fmt_txt_accel_delete(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->cache == NULL || fdsc->cache->accel == NULL) return;
+
+    accel_free(fdsc->cache->accel);
+    fdsc->cache->accel = NULL;
+}
+
+#if LV_USE_FONT_COMPRESSED
+
+/**
+ * Get statistics about the cache of decompressed glyph bitmaps
+ * @param mon_p pointer to a `lv_font_fmt_txt_bitmap_cache_monitor_t` variable to store the result
+ */
+void lv_font_fmt_txt_bitmap_cache_monitor(lv_font_fmt_txt_bitmap_cache_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_font_fmt_txt_bitmap_cache_monitor_t));
+    mon_p->hit_cnt = bitmap_cache_hit_cnt;
+    mon_p->miss_cnt = bitmap_cache_miss_cnt;
+
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+    mon_p->total_size = LV_FONT_COMPRESSED_CACHE_SIZE;
+    lv_lru_t * cache = LV_GC_ROOT(_lv_font_bitmap_cache);
+    if(cache) mon_p->used_size = cache->total_memory - cache->free_memory;
+#endif
+}
+
+/**
+ * Drop all the cached glyph bitmaps and reset the statistics.
+ * Has to be called if a font with cached glyphs is deleted.
+ */
+void lv_font_fmt_txt_bitmap_cache_clear(void)
+{
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+    if(LV_GC_ROOT(_lv_font_bitmap_cache)) {
+        lv_lru_del(LV_GC_ROOT(_lv_font_bitmap_cache));
+        LV_GC_ROOT(_lv_font_bitmap_cache) = NULL;
+    }
+#endif
+    bitmap_cache_hit_cnt = 0;
+    bitmap_cache_miss_cnt = 0;
+}
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**
  * Free the allocated memories.
  */
@@ -212,6 +345,12 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+    /*The lookup tables know all the letters of the BMP*/
+    if(fdsc->cache && fdsc->cache->accel && letter <= 0xFFFF) {
+        const uint16_t * page = fdsc->cache->accel->gid_pages[letter >> 8];
+        return page ? page[letter & 0xFF] : 0;
+    }
+
     /*Check the cache first*/
     if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
 
@@ -220,7 +359,7 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -276,7 +415,21 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
-        if(kdsc->glyph_ids_size == 0) {
+        const lv_font_fmt_txt_accel_t * accel = fdsc->cache ? fdsc->cache->accel : NULL;
+        if(accel && accel->kern_pair_index) {
+            /*Only the pairs of the left glyph need to be checked. They are ordered by the right glyph id.*/
+            if(gid_left < accel->glyph_cnt) {
+                uint32_t i;
+                for(i = accel->kern_pair_index[gid_left]; i < accel->kern_pair_index[gid_left + 1]; i++) {
+                    uint32_t right = kern_pair_gid(kdsc, i, 1);
+                    if(right >= gid_right) {
+                        if(right == gid_right) value = kdsc->values[i];
+                        break;
+                    }
+                }
+            }
+        }
+        else if(kdsc->glyph_ids_size == 0) {
             /*Use binary search to find the kern value.
              *The pairs are ordered left_id first, then right_id secondly.*/
             const uint16_t * g_ids = kdsc->glyph_ids;
@@ -344,6 +497,122 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
     else return (int32_t) ref16_p[1] - element16_p[1];
 }
 
+/**
+ * Get a glyph id from a kern pair
+ * @param kdsc the kern pairs
+ * @param pair index of the pair
+ * @param side 0: left glyph id, 1: right glyph id
+ * @return the glyph id
+ */
+static inline uint32_t kern_pair_gid(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t pair, uint32_t side)
+{
+    if(kdsc->glyph_ids_size == 0) return ((const uint8_t *)kdsc->glyph_ids)[pair * 2 + side];
+    else return ((const uint16_t *)kdsc->glyph_ids)[pair * 2 + side];
+}
+
+static bool accel_add_cmap(lv_font_fmt_txt_accel_t * accel, const lv_font_fmt_txt_cmap_t * cmap)
+{
+    uint32_t rcp;
+    uint32_t i;
+
+    switch(cmap->type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+            for(rcp = 0; rcp < cmap->range_length; rcp++) {
+                if(!accel_set_gid(accel, cmap->range_start + rcp, cmap->glyph_id_start + rcp)) return false;
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+                for(rcp = 0; rcp < cmap->range_length; rcp++) {
+                    if(!accel_set_gid(accel, cmap->range_start + rcp, cmap->glyph_id_start + gid_ofs_8[rcp])) return false;
+                }
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            /*The letters in the range but not in the list are not searched in the other maps*/
+            for(rcp = 0; rcp < cmap->range_length; rcp++) {
+                if(!accel_set_gid(accel, cmap->range_start + rcp, 0)) return false;
+            }
+
+            for(i = 0; i < cmap->list_length; i++) {
+                rcp = cmap->unicode_list[i];
+                if(rcp >= cmap->range_length) continue;
+
+                uint32_t gid = cmap->glyph_id_start;
+                if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) gid += i;
+                else gid += ((const uint16_t *)cmap->glyph_id_ofs_list)[i];
+
+                if(!accel_set_gid(accel, cmap->range_start + rcp, gid)) return false;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+static bool accel_add_kern_pairs(lv_font_fmt_txt_accel_t * accel, const lv_font_fmt_txt_kern_pair_t * kdsc)
+{
+    if(kdsc->glyph_ids_size > 1) return true; /*Invalid, there is nothing to find*/
+
+    uint32_t i;
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        uint32_t left = kern_pair_gid(kdsc, i, 0);
+        if(left >= accel->glyph_cnt) accel->glyph_cnt = left + 1;
+    }
+
+    size_t size = (accel->glyph_cnt + 1) * sizeof(uint32_t);
+    accel->kern_pair_index = lv_mem_ext_alloc(size);
+    if(accel->kern_pair_index == NULL) return false;
+    lv_memset_00(accel->kern_pair_index, size);
+
+    /*Count the pairs of each left glyph and sum the counts up to get where the pairs of a glyph start.
+     *The pairs are ordered by the left glyph id.*/
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        accel->kern_pair_index[kern_pair_gid(kdsc, i, 0) + 1]++;
+    }
+
+    for(i = 1; i <= accel->glyph_cnt; i++) {
+        accel->kern_pair_index[i] += accel->kern_pair_index[i - 1];
+    }
+
+    return true;
+}
+
+static bool accel_set_gid(lv_font_fmt_txt_accel_t * accel, uint32_t letter, uint32_t gid)
+{
+    if(gid > UINT16_MAX) return false;
+    if(gid >= accel->glyph_cnt) accel->glyph_cnt = gid + 1;
+
+    /*The letters out of the BMP are searched in the character maps*/
+    if(letter > 0xFFFF) return true;
+
+    uint16_t ** page = &accel->gid_pages[letter >> 8];
+    if(*page == NULL) {
+        if(gid == 0) return true;
+
+        *page = lv_mem_ext_alloc(256 * sizeof(uint16_t));
+        if(*page == NULL) return false;
+        lv_memset_00(*page, 256 * sizeof(uint16_t));
+    }
+
+    (*page)[letter & 0xFF] = (uint16_t)gid;
+    return true;
+}
+
+static void accel_free(lv_font_fmt_txt_accel_t * accel)
+{
+    uint32_t i;
+    for(i = 0; i < 256; i++) {
+        lv_mem_ext_free(accel->gid_pages[i]);
+    }
+
+    lv_mem_ext_free(accel->kern_pair_index);
+    lv_mem_free(accel);
+}
+
 #if LV_USE_FONT_COMPRESSED
 /**
  * The compress a glyph's bitmap
@@ -416,6 +685,64 @@ static inline void decompress_line(uint8_t * out, lv_coord_t w)
     }
 }
 
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+
+static uint8_t * bitmap_cache_get(const lv_font_t * font, uint32_t gid)
+{
+    if(LV_GC_ROOT(_lv_font_bitmap_cache) == NULL) return NULL;
+
+    bitmap_cache_key_t key;
+    lv_memset_00(&key, sizeof(key));    /*Clear the padding too as it's part of the hashed key*/
+    key.font = font;
+    key.gid = gid;
+
+    void * bitmap = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_font_bitmap_cache), &key, sizeof(key), &bitmap);
+    return bitmap;
+}
+
+/**
+ * Decompress a glyph into a new cache entry
+ * @param font pointer to the font
+ * @param gid id of the glyph
+ * @param gdsc descriptor of the glyph
+ * @param buf_size size of the decompressed bitmap in bytes
+ * @return the decompressed bitmap or NULL if it couldn't be cached
+ */
+static uint8_t * bitmap_cache_add(const lv_font_t * font, uint32_t gid, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                  uint32_t buf_size)
+{
+    if(buf_size > LV_FONT_COMPRESSED_CACHE_SIZE) return NULL;
+
+    if(LV_GC_ROOT(_lv_font_bitmap_cache) == NULL) {
+        LV_GC_ROOT(_lv_font_bitmap_cache) = lv_lru_create(LV_FONT_COMPRESSED_CACHE_SIZE, BITMAP_CACHE_AVG_SIZE,
+                                                          lv_mem_ext_free, NULL);
+        if(LV_GC_ROOT(_lv_font_bitmap_cache) == NULL) return NULL;
+    }
+
+    uint8_t * bitmap = lv_mem_ext_alloc(buf_size);
+    if(bitmap == NULL) return NULL;
+
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+
+    bitmap_cache_key_t key;
+    lv_memset_00(&key, sizeof(key));
+    key.font = font;
+    key.gid = gid;
+
+    /*The new item is the most recently used so only older glyphs are evicted to make room for it*/
+    if(lv_lru_set(LV_GC_ROOT(_lv_font_bitmap_cache), &key, sizeof(key), bitmap, buf_size) != LV_LRU_OK) {
+        lv_mem_ext_free(bitmap);
+        return NULL;
+    }
+
+    return bitmap;
+}
+
+#endif /*LV_FONT_COMPRESSED_CACHE_SIZE*/
+
 /**
  * Read bits from an input buffer. The read can cross byte boundary.
  * @param in the input buffer to read from.
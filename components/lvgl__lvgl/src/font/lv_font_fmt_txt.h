@@ -151,11 +151,32 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+/** Lookup tables created by `lv_font_fmt_txt_accel_create()`*/
+typedef struct {
+    /*Glyph ids of the Basic Multilingual Plane in 256 pages of 256 letters.
+     *`NULL` pages have no glyphs, 0 glyph id means no glyph*/
+    uint16_t * gid_pages[256];
+
+    /*Index of the first kern pair of each left glyph id (`glyph_cnt + 1` items).
+     *Only if `kern_dsc` is a `lv_font_fmt_txt_kern_pair_t`*/
+    uint32_t * kern_pair_index;
+    uint32_t glyph_cnt;
+} lv_font_fmt_txt_accel_t;
+
 typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+    lv_font_fmt_txt_accel_t * accel;
 } lv_font_fmt_txt_glyph_cache_t;
 
+/** Statistics of the decompressed glyph bitmap cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of bitmaps returned from the cache*/
+    uint32_t miss_cnt;      /**< Number of bitmaps which had to be decompressed*/
+    uint32_t used_size;     /**< Size of the cached bitmaps in bytes*/
+    uint32_t total_size;    /**< Size of the cache in bytes (`LV_FONT_COMPRESSED_CACHE_SIZE`)*/
+} lv_font_fmt_txt_bitmap_cache_monitor_t;
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -193,7 +214,7 @@ typedef struct {
      */
     uint16_t bitmap_format  : 2;
 
-    /*Cache the last letter and is glyph id*/
+    /*Cache the last letter and its glyph id and the optional lookup tables*/
     lv_font_fmt_txt_glyph_cache_t * cache;
 } lv_font_fmt_txt_dsc_t;
 
@@ -220,6 +241,37 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Create lookup tables to get the glyph ids and kerning values of a font in constant time
+ * instead of searching the character maps and kern pairs on every letter.
+ * Worth it for fonts with many glyphs or sparse character maps, e.g. CJK fonts.
+ * @param font pointer to a font in `lv_font_fmt_txt_dsc_t` format. It needs a `cache` to store the tables.
+ * @return true: the tables are created; false: out of memory or the font can't have tables
+ */
+bool lv_font_fmt_txt_accel_create(const lv_font_t * font);
+
+/**
+ * Free the lookup tables of a font created by `lv_font_fmt_txt_accel_create()`
+ * @param font pointer to a font
+ */
+void lv_font_fmt_txt_accel_delete(const lv_font_t * font);
+
+#if LV_USE_FONT_COMPRESSED
+
+/**
+ * Get statistics about the cache of decompressed glyph bitmaps
+ * @param mon_p pointer to a `lv_font_fmt_txt_bitmap_cache_monitor_t` variable to store the result
+ */
+void lv_font_fmt_txt_bitmap_cache_monitor(lv_font_fmt_txt_bitmap_cache_monitor_t * mon_p);
+
+/**
+ * Drop all the cached glyph bitmaps and reset the statistics.
+ * Has to be called if a font with cached glyphs is deleted.
+ */
+void lv_font_fmt_txt_bitmap_cache_clear(void);
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**
  * Free the allocated memories.
  */
@@ -13,10 +13,91 @@
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
 #include "lv_font_loader.h"
+#include "../draw/sw/lv_draw_sw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_FONT_FMT_TXT_LARGE == 0
+    #define MAX_BITMAP_INDEX    ((1UL << 20) - 1)
+#else
+    #define MAX_BITMAP_INDEX    UINT32_MAX
+#endif
+
+#define MMAP_FONT_MAGIC     "LVFM"
+#define MMAP_FONT_VERSION   1
 
 /**********************
  *      TYPEDEFS
  **********************/
+
+/*The descriptor of the loaded fonts. If the file system can map the file (see `lv_fs_get_ptr()`)
+ *the tables and bitmaps are used in place and the file is kept open until the font is freed.*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;  /*Has to be the first*/
+    lv_fs_file_t file;          /*The kept file or `drv == NULL`*/
+    const uint8_t * map;        /*The whole file in the memory or NULL*/
+    uint32_t map_size;
+    uint8_t * file_buf;         /*The whole file read into the RAM if it can't be mapped (only mappable fonts)*/
+} font_loader_dsc_t;
+
+/*The mappable font format written by `scripts/font_bin_to_mmap.py`.
+ *It has no pointers and bit fields to parse: every table is aligned to 4 bytes, referenced by its offset
+ *from the start of the file and has the layout used by `lv_font_fmt_txt_dsc_t`.
+ *So the font is used in place from a mapped file. The numbers are little endian.*/
+typedef struct {
+    char magic[4];              /*MMAP_FONT_MAGIC*/
+    uint16_t version;           /*MMAP_FONT_VERSION*/
+    uint16_t glyph_dsc_size;    /*8: the bit fields of `lv_font_fmt_txt_glyph_dsc_t`, 16: `LV_FONT_FMT_TXT_LARGE`*/
+    uint32_t file_size;
+    int16_t line_height;
+    int16_t base_line;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    uint8_t subpx;
+    uint8_t bpp;
+    uint8_t bitmap_format;
+    uint8_t kern_type;          /*0: no kerning, 1: `mmap_font_kern_pair_t`, 2: `mmap_font_kern_classes_t`*/
+    uint16_t kern_scale;
+    uint16_t cmap_num;
+    uint16_t reserved;
+    uint32_t glyph_cnt;
+    uint32_t glyph_dsc_ofs;     /*`glyph_cnt` glyph descriptors of `glyph_dsc_size` bytes*/
+    uint32_t bitmap_ofs;
+    uint32_t bitmap_size;
+    uint32_t cmap_ofs;          /*`cmap_num` `mmap_font_cmap_t`*/
+    uint32_t kern_ofs;
+} mmap_font_header_t;
+
+typedef struct {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint32_t unicode_list_ofs;      /*`list_length` `uint16_t` or 0*/
+    uint32_t glyph_id_ofs_list_ofs; /*`list_length` `uint8_t` (FORMAT0_FULL) or `uint16_t` (SPARSE_FULL) or 0*/
+    uint16_t list_length;
+    uint8_t type;
+    uint8_t reserved;
+} mmap_font_cmap_t;
+
+typedef struct {
+    uint32_t pair_cnt;
+    uint32_t glyph_ids_ofs;     /*`pair_cnt * 2` glyph ids*/
+    uint32_t values_ofs;        /*`pair_cnt` values*/
+    uint8_t glyph_ids_size;     /*0: the glyph ids are `uint8_t`, 1: `uint16_t`*/
+    uint8_t reserved[3];
+} mmap_font_kern_pair_t;
+
+typedef struct {
+    uint32_t class_pair_values_ofs; /*`left_class_cnt * right_class_cnt` values*/
+    uint32_t left_class_mapping_ofs;
+    uint32_t right_class_mapping_ofs;
+    uint32_t mapping_length;        /*Length of the class mappings*/
+    uint8_t left_class_cnt;
+    uint8_t right_class_cnt;
+    uint8_t reserved[2];
+} mmap_font_kern_classes_t;
+
 typedef struct {
     lv_fs_file_t * fp;
     int8_t bit_pos;
@@ -65,10 +146,16 @@ typedef struct cmap_table_bin {
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
 static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool load_mmap_font(lv_fs_file_t * fp, lv_font_t * font);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
+static const void * map_ptr(const lv_font_fmt_txt_dsc_t * font_dsc, uint32_t pos, uint32_t len, uint32_t align);
+static const void * load_data(lv_fs_file_t * fp, const lv_font_fmt_txt_dsc_t * font_dsc, uint32_t len, uint32_t align);
+static void free_data(const font_loader_dsc_t * ldsc, const void * p);
+static bool mmap_glyph_dsc_is_native(uint32_t size);
+static lv_font_fmt_txt_glyph_dsc_t * mmap_glyph_dsc_convert(const uint8_t * data, uint32_t size, uint32_t cnt);
 
 /**********************
  *      MACROS
@@ -90,14 +177,21 @@ lv_font_t * lv_font_load(const char * font_name)
     if(res != LV_FS_RES_OK)
         return NULL;
 
+    /*Mappable fonts start with a magic number, the others with the length of the "head" table*/
+    char magic[4];
+    uint32_t br;
+    bool mmap_font = lv_fs_read(&file, magic, sizeof(magic), &br) == LV_FS_RES_OK && br == sizeof(magic) &&
+                     memcmp(magic, MMAP_FONT_MAGIC, sizeof(magic)) == 0;
+
     lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
     if(font) {
         memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
+        if(!(mmap_font ? load_mmap_font(&file, font) : lvgl_load_font(&file, font))) {
             LV_LOG_WARN("Error loading font file: %s\n", font_name);
             /*
             * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
+            * All non-null pointers can be assumed as allocated
+            * (or pointing into the mapped file) and
             * `lv_font_free` should free them correctly.
             */
             lv_font_free(font);
@@ -105,7 +199,10 @@ lv_font_t * lv_font_load(const char * font_name)
         }
     }
 
-    lv_fs_close(&file);
+    /*Keep the file open if the font uses its data in place. `lv_font_free` will close it.*/
+    font_loader_dsc_t * ldsc = font ? (font_loader_dsc_t *)font->dsc : NULL;
+    if(ldsc && ldsc->map && ldsc->file_buf == NULL) lv_memcpy_small(&ldsc->file, &file, sizeof(file));
+    else lv_fs_close(&file);
 
     return font;
 }
@@ -118,19 +215,24 @@ void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+        font_loader_dsc_t * ldsc = (font_loader_dsc_t *)dsc;
 
         if(NULL != dsc) {
 
+            lv_draw_sw_text_cache_clear();
+
+#if LV_USE_FONT_COMPRESSED
+            /*Don't let a new font at the same address get the glyphs of this one*/
+            if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) lv_font_fmt_txt_bitmap_cache_clear();
+#endif
+
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
                     (lv_font_fmt_txt_kern_pair_t *)dsc->kern_dsc;
 
                 if(NULL != kern_dsc) {
-                    if(kern_dsc->glyph_ids)
-                        lv_mem_free((void *)kern_dsc->glyph_ids);
-
-                    if(kern_dsc->values)
-                        lv_mem_free((void *)kern_dsc->values);
+                    free_data(ldsc, kern_dsc->glyph_ids);
+                    free_data(ldsc, kern_dsc->values);
 
                     lv_mem_free((void *)kern_dsc);
                 }
@@ -140,14 +242,9 @@ void lv_font_free(lv_font_t * font)
                     (lv_font_fmt_txt_kern_classes_t *)dsc->kern_dsc;
 
                 if(NULL != kern_dsc) {
-                    if(kern_dsc->class_pair_values)
-                        lv_mem_free((void *)kern_dsc->class_pair_values);
-
-                    if(kern_dsc->left_class_mapping)
-                        lv_mem_free((void *)kern_dsc->left_class_mapping);
-
-                    if(kern_dsc->right_class_mapping)
-                        lv_mem_free((void *)kern_dsc->right_class_mapping);
+                    free_data(ldsc, kern_dsc->class_pair_values);
+                    free_data(ldsc, kern_dsc->left_class_mapping);
+                    free_data(ldsc, kern_dsc->right_class_mapping);
 
                     lv_mem_free((void *)kern_dsc);
                 }
@@ -158,20 +255,16 @@ void lv_font_free(lv_font_t * font)
 
             if(NULL != cmaps) {
                 for(int i = 0; i < dsc->cmap_num; ++i) {
-                    if(NULL != cmaps[i].glyph_id_ofs_list)
-                        lv_mem_free((void *)cmaps[i].glyph_id_ofs_list);
-                    if(NULL != cmaps[i].unicode_list)
-                        lv_mem_free((void *)cmaps[i].unicode_list);
+                    free_data(ldsc, cmaps[i].glyph_id_ofs_list);
+                    free_data(ldsc, cmaps[i].unicode_list);
                 }
                 lv_mem_free(cmaps);
             }
 
-            if(NULL != dsc->glyph_bitmap) {
-                lv_mem_free((void *)dsc->glyph_bitmap);
-            }
-            if(NULL != dsc->glyph_dsc) {
-                lv_mem_free((void *)dsc->glyph_dsc);
-            }
+            free_data(ldsc, dsc->glyph_bitmap);
+            free_data(ldsc, dsc->glyph_dsc);
+            if(ldsc->file.drv) lv_fs_close(&ldsc->file);
+            if(ldsc->file_buf) lv_mem_free(ldsc->file_buf);
             lv_mem_free(dsc);
         }
         lv_mem_free(font);
@@ -182,6 +275,65 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get a pointer to a part of the mapped font file
+ * @param font_dsc  the descriptor created by `lvgl_load_font`
+ * @param pos       position in the file
+ * @param len       length of the data
+ * @param align     required alignment of the pointer in bytes (power of 2)
+ * @return          pointer to the data in place or NULL if not mapped or not aligned
+ */
+static const void * map_ptr(const lv_font_fmt_txt_dsc_t * font_dsc, uint32_t pos, uint32_t len, uint32_t align)
+{
+    const font_loader_dsc_t * ldsc = (const font_loader_dsc_t *)font_dsc;
+    if(ldsc->map == NULL || pos > ldsc->map_size || len > ldsc->map_size - pos) return NULL;
+
+    const uint8_t * p = ldsc->map + pos;
+    if((lv_uintptr_t)p & (align - 1)) return NULL;
+    return p;
+}
+
+/**
+ * Use the next `len` bytes of the file in place if it's mapped, else read them into a new buffer.
+ * In both cases the read write pointer is moved after the data.
+ * @param fp        the font file
+ * @param font_dsc  the descriptor created by `lvgl_load_font`
+ * @param len       length of the data
+ * @param align     required alignment of the data in bytes (power of 2)
+ * @return          pointer to the data or NULL on error. Free it with `free_data()`.
+ */
+static const void * load_data(lv_fs_file_t * fp, const lv_font_fmt_txt_dsc_t * font_dsc, uint32_t len, uint32_t align)
+{
+    uint32_t pos;
+    if(lv_fs_tell(fp, &pos) == LV_FS_RES_OK) {
+        const void * p = map_ptr(font_dsc, pos, len, align);
+        if(p && lv_fs_seek(fp, len, LV_FS_SEEK_CUR) == LV_FS_RES_OK) return p;
+    }
+
+    void * buf = lv_mem_alloc(len);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return NULL;
+
+    if(lv_fs_read(fp, buf, len, NULL) != LV_FS_RES_OK) {
+        lv_mem_free(buf);
+        return NULL;
+    }
+    return buf;
+}
+
+/**
+ * Free the data loaded by `load_data()` unless it's in the mapped file
+ * @param ldsc      the descriptor of the font
+ * @param p         pointer to the data or NULL
+ */
+static void free_data(const font_loader_dsc_t * ldsc, const void * p)
+{
+    if(p == NULL) return;
+    if(ldsc->map && (const uint8_t *)p >= ldsc->map && (const uint8_t *)p <= ldsc->map + ldsc->map_size) return;
+
+    lv_mem_free((void *)p);
+}
+
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 {
     bit_iterator_t it;
@@ -262,11 +414,8 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
         switch(cmap_table[i].format_type) {
             case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
                     uint8_t ids_size = sizeof(uint8_t) * cmap_table[i].data_entries_count;
-                    uint8_t * glyph_id_ofs_list = lv_mem_alloc(ids_size);
-
-                    cmap->glyph_id_ofs_list = glyph_id_ofs_list;
-
-                    if(lv_fs_read(fp, glyph_id_ofs_list, ids_size, NULL) != LV_FS_RES_OK) {
+                    cmap->glyph_id_ofs_list = load_data(fp, font_dsc, ids_size, sizeof(uint8_t));
+                    if(cmap->glyph_id_ofs_list == NULL) {
                         return false;
                     }
 
@@ -278,21 +427,16 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
             case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
             case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY: {
                     uint32_t list_size = sizeof(uint16_t) * cmap_table[i].data_entries_count;
-                    uint16_t * unicode_list = (uint16_t *)lv_mem_alloc(list_size);
-
-                    cmap->unicode_list = unicode_list;
+                    cmap->unicode_list = load_data(fp, font_dsc, list_size, sizeof(uint16_t));
                     cmap->list_length = cmap_table[i].data_entries_count;
-
-                    if(lv_fs_read(fp, unicode_list, list_size, NULL) != LV_FS_RES_OK) {
+                    if(cmap->unicode_list == NULL) {
                         return false;
                     }
 
                     if(cmap_table[i].format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-                        uint16_t * buf = lv_mem_alloc(sizeof(uint16_t) * cmap->list_length);
-
-                        cmap->glyph_id_ofs_list = buf;
-
-                        if(lv_fs_read(fp, buf, sizeof(uint16_t) * cmap->list_length, NULL) != LV_FS_RES_OK) {
+                        cmap->glyph_id_ofs_list = load_data(fp, font_dsc, sizeof(uint16_t) * cmap->list_length,
+                                                            sizeof(uint16_t));
+                        if(cmap->glyph_id_ofs_list == NULL) {
                             return false;
                         }
                     }
@@ -351,6 +495,13 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     font_dsc->glyph_dsc = glyph_dsc;
 
     int cur_bmp_size = 0;
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+
+    /*Byte aligned bitmaps can be used in place from a mapped file*/
+    const uint8_t * glyf_in_place = NULL;
+    if(nbits % 8 == 0 && (uint32_t)glyph_length <= MAX_BITMAP_INDEX) {
+        glyf_in_place = map_ptr(font_dsc, start, glyph_length, 1);
+    }
 
     for(unsigned int i = 0; i < loca_count; ++i) {
         lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
@@ -396,7 +547,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             return -1;
         }
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
         int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
         int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
@@ -408,12 +558,23 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
+        if(glyf_in_place) {
+            /*The bitmap follows the glyph's descriptor in the table*/
+            gdsc->bitmap_index = glyph_offset[i] + nbits / 8;
+            continue;
+        }
+
         gdsc->bitmap_index = cur_bmp_size;
         if(gdsc->box_w * gdsc->box_h != 0) {
             cur_bmp_size += bmp_size;
         }
     }
 
+    if(glyf_in_place) {
+        font_dsc->glyph_bitmap = glyf_in_place;
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -427,8 +588,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
         bit_iterator_t bit_it = init_bit_iterator(fp);
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
         read_bits(&bit_it, nbits, &res);
         if(res != LV_FS_RES_OK) {
             return -1;
@@ -482,13 +641,24 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  */
 static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+    font_loader_dsc_t * ldsc = lv_mem_alloc(sizeof(font_loader_dsc_t));
+    LV_ASSERT_MALLOC(ldsc);
+    if(ldsc == NULL) return false;
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(ldsc, 0, sizeof(font_loader_dsc_t));
 
+    lv_font_fmt_txt_dsc_t * font_dsc = &ldsc->dsc;
     font->dsc = font_dsc;
 
+    /*Use the file in place if the file system can map it*/
+    uint32_t file_size;
+    const void * map;
+    if(lv_fs_seek(fp, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(fp, &file_size) == LV_FS_RES_OK &&
+       lv_fs_get_ptr(fp, 0, file_size, &map) == LV_FS_RES_OK) {
+        ldsc->map = map;
+        ldsc->map_size = file_size;
+    }
+
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
     if(header_length < 0) {
@@ -619,19 +789,16 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
             ids_size = sizeof(int16_t) * 2 * glyph_entries;
         }
 
-        uint8_t * glyph_ids = lv_mem_alloc(ids_size);
-        int8_t * values = lv_mem_alloc(glyph_entries);
-
         kern_pair->glyph_ids_size = format;
         kern_pair->pair_cnt = glyph_entries;
-        kern_pair->glyph_ids = glyph_ids;
-        kern_pair->values = values;
 
-        if(lv_fs_read(fp, glyph_ids, ids_size, NULL) != LV_FS_RES_OK) {
+        kern_pair->glyph_ids = load_data(fp, font_dsc, ids_size, format == 0 ? sizeof(uint8_t) : sizeof(uint16_t));
+        if(kern_pair->glyph_ids == NULL) {
             return -1;
         }
 
-        if(lv_fs_read(fp, values, glyph_entries, NULL) != LV_FS_RES_OK) {
+        kern_pair->values = load_data(fp, font_dsc, glyph_entries, sizeof(int8_t));
+        if(kern_pair->values == NULL) {
             return -1;
         }
     }
@@ -656,19 +823,21 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
         int kern_values_length = sizeof(int8_t) * kern_table_rows * kern_table_cols;
 
-        uint8_t * kern_left = lv_mem_alloc(kern_class_mapping_length);
-        uint8_t * kern_right = lv_mem_alloc(kern_class_mapping_length);
-        int8_t * kern_values = lv_mem_alloc(kern_values_length);
-
-        kern_classes->left_class_mapping  = kern_left;
-        kern_classes->right_class_mapping = kern_right;
         kern_classes->left_class_cnt = kern_table_rows;
         kern_classes->right_class_cnt = kern_table_cols;
-        kern_classes->class_pair_values = kern_values;
 
-        if(lv_fs_read(fp, kern_left, kern_class_mapping_length, NULL) != LV_FS_RES_OK ||
-           lv_fs_read(fp, kern_right, kern_class_mapping_length, NULL) != LV_FS_RES_OK ||
-           lv_fs_read(fp, kern_values, kern_values_length, NULL) != LV_FS_RES_OK) {
+        kern_classes->left_class_mapping = load_data(fp, font_dsc, kern_class_mapping_length, sizeof(uint8_t));
+        if(kern_classes->left_class_mapping == NULL) {
+            return -1;
+        }
+
+        kern_classes->right_class_mapping = load_data(fp, font_dsc, kern_class_mapping_length, sizeof(uint8_t));
+        if(kern_classes->right_class_mapping == NULL) {
+            return -1;
+        }
+
+        kern_classes->class_pair_values = load_data(fp, font_dsc, kern_values_length, sizeof(int8_t));
+        if(kern_classes->class_pair_values == NULL) {
             return -1;
         }
     }
@@ -679,3 +848,254 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
     return kern_length;
 }
+
+/**
+ * Check whether the glyph descriptors of a mappable font can be used in place
+ * @param size      size of a glyph descriptor in the file
+ * @return          true: the descriptors have the same layout as `lv_font_fmt_txt_glyph_dsc_t`
+ */
+static bool mmap_glyph_dsc_is_native(uint32_t size)
+{
+    if(size != sizeof(lv_font_fmt_txt_glyph_dsc_t)) return false;
+
+    /*The layout of the bit fields depends on the compiler. Check it with a known descriptor.*/
+#if LV_FONT_FMT_TXT_LARGE == 0
+    static const uint8_t ref[8] = {0x45, 0x23, 0xC1, 0xAB, 0x01, 0x02, 0xFD, 0x04};
+#else
+    static const uint8_t ref[16] = {0x45, 0x23, 0x01, 0x00, 0xBC, 0x0A, 0x00, 0x00,
+                                    0x01, 0x00, 0x02, 0x00, 0xFD, 0xFF, 0x04, 0x00
+                                   };
+#endif
+    lv_font_fmt_txt_glyph_dsc_t dsc;
+    LV_ASSERT(sizeof(ref) == sizeof(dsc));
+    lv_memcpy_small(&dsc, ref, sizeof(dsc));
+    return dsc.bitmap_index == 0x12345 && dsc.adv_w == 0xABC && dsc.box_w == 1 && dsc.box_h == 2 &&
+           dsc.ofs_x == -3 && dsc.ofs_y == 4;
+}
+
+/**
+ * Convert the glyph descriptors of a mappable font to `lv_font_fmt_txt_glyph_dsc_t`
+ * if they can't be used in place.
+ * @param data      the descriptors in the file
+ * @param size      size of a descriptor in the file (8 or 16)
+ * @param cnt       number of descriptors
+ * @return          the converted descriptors or NULL on error
+ */
+static lv_font_fmt_txt_glyph_dsc_t * mmap_glyph_dsc_convert(const uint8_t * data, uint32_t size, uint32_t cnt)
+{
+    lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = lv_mem_alloc(cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    LV_ASSERT_MALLOC(glyph_dsc);
+    if(glyph_dsc == NULL) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        const uint8_t * d = &data[i * size];
+        uint32_t bitmap_index;
+        uint32_t adv_w;
+        int32_t box_w;
+        int32_t box_h;
+        int32_t ofs_x;
+        int32_t ofs_y;
+        if(size == 8) {
+            uint32_t v = d[0] | (d[1] << 8) | (d[2] << 16) | ((uint32_t)d[3] << 24);
+            bitmap_index = v & 0xFFFFF;
+            adv_w = v >> 20;
+            box_w = d[4];
+            box_h = d[5];
+            ofs_x = (int8_t)d[6];
+            ofs_y = (int8_t)d[7];
+        }
+        else {
+            bitmap_index = d[0] | (d[1] << 8) | (d[2] << 16) | ((uint32_t)d[3] << 24);
+            adv_w = d[4] | (d[5] << 8) | (d[6] << 16) | ((uint32_t)d[7] << 24);
+            box_w = d[8] | (d[9] << 8);
+            box_h = d[10] | (d[11] << 8);
+            ofs_x = (int16_t)(d[12] | (d[13] << 8));
+            ofs_y = (int16_t)(d[14] | (d[15] << 8));
+        }
+
+        lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
+        gdsc->bitmap_index = bitmap_index;
+        gdsc->adv_w = adv_w;
+        gdsc->box_w = box_w;
+        gdsc->box_h = box_h;
+        gdsc->ofs_x = ofs_x;
+        gdsc->ofs_y = ofs_y;
+
+        /*A font converted for `LV_FONT_FMT_TXT_LARGE` might not fit into the small descriptors*/
+        if(gdsc->bitmap_index != bitmap_index || gdsc->adv_w != adv_w || gdsc->box_w != box_w ||
+           gdsc->box_h != box_h || gdsc->ofs_x != ofs_x || gdsc->ofs_y != ofs_y) {
+            LV_LOG_WARN("The glyphs need LV_FONT_FMT_TXT_LARGE");
+            lv_mem_free(glyph_dsc);
+            return NULL;
+        }
+    }
+
+    return glyph_dsc;
+}
+
+/*
+ * Loads a `lv_font_t` from a mappable font file (see `mmap_font_header_t`), given a `lv_fs_file_t`.
+ * The tables are used in place if the file system can map the file, else the whole file is read
+ * into the RAM with a single read. Only the descriptors of the character maps and kerning tables
+ * (which contain pointers) are allocated.
+ *
+ * Similarly to `lvgl_load_font` the font needs to be freed with `lv_font_free` when it fails.
+ */
+static bool load_mmap_font(lv_fs_file_t * fp, lv_font_t * font)
+{
+    font_loader_dsc_t * ldsc = lv_mem_alloc(sizeof(font_loader_dsc_t));
+    LV_ASSERT_MALLOC(ldsc);
+    if(ldsc == NULL) return false;
+
+    memset(ldsc, 0, sizeof(font_loader_dsc_t));
+
+    lv_font_fmt_txt_dsc_t * font_dsc = &ldsc->dsc;
+    font->dsc = font_dsc;
+
+    uint32_t file_size;
+    if(lv_fs_seek(fp, 0, LV_FS_SEEK_END) != LV_FS_RES_OK || lv_fs_tell(fp, &file_size) != LV_FS_RES_OK ||
+       file_size < sizeof(mmap_font_header_t)) {
+        return false;
+    }
+
+    const void * map;
+    if(lv_fs_get_ptr(fp, 0, file_size, &map) == LV_FS_RES_OK && ((lv_uintptr_t)map & 0x3) == 0) {
+        ldsc->map = map;
+    }
+    else {
+        ldsc->file_buf = lv_mem_alloc(file_size);
+        LV_ASSERT_MALLOC(ldsc->file_buf);
+        if(ldsc->file_buf == NULL) return false;
+
+        uint32_t br;
+        if(lv_fs_seek(fp, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+           lv_fs_read(fp, ldsc->file_buf, file_size, &br) != LV_FS_RES_OK || br != file_size) {
+            return false;
+        }
+        ldsc->map = ldsc->file_buf;
+    }
+    ldsc->map_size = file_size;
+
+    const mmap_font_header_t * header = (const mmap_font_header_t *)ldsc->map;
+    if(header->version != MMAP_FONT_VERSION || header->file_size != file_size ||
+       (header->glyph_dsc_size != 8 && header->glyph_dsc_size != 16)) {
+        LV_LOG_WARN("Unknown mappable font version or size");
+        return false;
+    }
+
+    font->base_line = header->base_line;
+    font->line_height = header->line_height;
+    font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    font->subpx = header->subpx;
+    font->underline_position = header->underline_position;
+    font->underline_thickness = header->underline_thickness;
+
+    font_dsc->bpp = header->bpp;
+    font_dsc->kern_scale = header->kern_scale;
+    font_dsc->bitmap_format = header->bitmap_format;
+
+    /*glyphs*/
+    font_dsc->glyph_bitmap = map_ptr(font_dsc, header->bitmap_ofs, header->bitmap_size, 1);
+    if(font_dsc->glyph_bitmap == NULL) return false;
+
+    if(header->glyph_cnt > UINT32_MAX / header->glyph_dsc_size) return false;
+    const uint8_t * glyph_dsc = map_ptr(font_dsc, header->glyph_dsc_ofs, header->glyph_cnt * header->glyph_dsc_size, 4);
+    if(glyph_dsc == NULL) return false;
+
+    if(mmap_glyph_dsc_is_native(header->glyph_dsc_size)) {
+        font_dsc->glyph_dsc = (const lv_font_fmt_txt_glyph_dsc_t *)glyph_dsc;
+    }
+    else {
+        font_dsc->glyph_dsc = mmap_glyph_dsc_convert(glyph_dsc, header->glyph_dsc_size, header->glyph_cnt);
+        if(font_dsc->glyph_dsc == NULL) return false;
+    }
+
+    /*cmaps*/
+    const mmap_font_cmap_t * cmap_bin = map_ptr(font_dsc, header->cmap_ofs,
+                                                header->cmap_num * sizeof(mmap_font_cmap_t), 4);
+    if(cmap_bin == NULL) return false;
+
+    lv_font_fmt_txt_cmap_t * cmaps = lv_mem_alloc(header->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+    LV_ASSERT_MALLOC(cmaps);
+    if(cmaps == NULL) return false;
+
+    memset(cmaps, 0, header->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+    font_dsc->cmaps = cmaps;
+    font_dsc->cmap_num = header->cmap_num;
+
+    for(unsigned int i = 0; i < font_dsc->cmap_num; ++i) {
+        lv_font_fmt_txt_cmap_t * cmap = &cmaps[i];
+        cmap->range_start = cmap_bin[i].range_start;
+        cmap->range_length = cmap_bin[i].range_length;
+        cmap->glyph_id_start = cmap_bin[i].glyph_id_start;
+        cmap->list_length = cmap_bin[i].list_length;
+        cmap->type = cmap_bin[i].type;
+
+        uint32_t id_size = cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL ? sizeof(uint8_t) : sizeof(uint16_t);
+        if(cmap_bin[i].unicode_list_ofs) {
+            cmap->unicode_list = map_ptr(font_dsc, cmap_bin[i].unicode_list_ofs, cmap->list_length * sizeof(uint16_t),
+                                         sizeof(uint16_t));
+            if(cmap->unicode_list == NULL) return false;
+        }
+        if(cmap_bin[i].glyph_id_ofs_list_ofs) {
+            cmap->glyph_id_ofs_list = map_ptr(font_dsc, cmap_bin[i].glyph_id_ofs_list_ofs, cmap->list_length * id_size,
+                                              id_size);
+            if(cmap->glyph_id_ofs_list == NULL) return false;
+        }
+    }
+
+    /*kern*/
+    if(header->kern_type == 1) {
+        const mmap_font_kern_pair_t * kern_bin = map_ptr(font_dsc, header->kern_ofs, sizeof(mmap_font_kern_pair_t), 4);
+        if(kern_bin == NULL || kern_bin->pair_cnt > UINT32_MAX / 4) return false;
+
+        lv_font_fmt_txt_kern_pair_t * kern_pair = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_pair_t));
+        LV_ASSERT_MALLOC(kern_pair);
+        if(kern_pair == NULL) return false;
+
+        memset(kern_pair, 0, sizeof(lv_font_fmt_txt_kern_pair_t));
+        font_dsc->kern_dsc = kern_pair;
+        font_dsc->kern_classes = 0;
+
+        uint32_t id_size = kern_bin->glyph_ids_size == 0 ? sizeof(uint8_t) : sizeof(uint16_t);
+        kern_pair->glyph_ids_size = kern_bin->glyph_ids_size;
+        kern_pair->pair_cnt = kern_bin->pair_cnt;
+        kern_pair->glyph_ids = map_ptr(font_dsc, kern_bin->glyph_ids_ofs, kern_bin->pair_cnt * 2 * id_size, id_size);
+        kern_pair->values = map_ptr(font_dsc, kern_bin->values_ofs, kern_bin->pair_cnt, 1);
+        if(kern_pair->glyph_ids == NULL || kern_pair->values == NULL) return false;
+    }
+    else if(header->kern_type == 2) {
+        const mmap_font_kern_classes_t * kern_bin = map_ptr(font_dsc, header->kern_ofs,
+                                                            sizeof(mmap_font_kern_classes_t), 4);
+        if(kern_bin == NULL) return false;
+
+        lv_font_fmt_txt_kern_classes_t * kern_classes = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_classes_t));
+        LV_ASSERT_MALLOC(kern_classes);
+        if(kern_classes == NULL) return false;
+
+        memset(kern_classes, 0, sizeof(lv_font_fmt_txt_kern_classes_t));
+        font_dsc->kern_dsc = kern_classes;
+        font_dsc->kern_classes = 1;
+
+        kern_classes->left_class_cnt = kern_bin->left_class_cnt;
+        kern_classes->right_class_cnt = kern_bin->right_class_cnt;
+        kern_classes->class_pair_values = map_ptr(font_dsc, kern_bin->class_pair_values_ofs,
+                                                  kern_bin->left_class_cnt * kern_bin->right_class_cnt, 1);
+        kern_classes->left_class_mapping = map_ptr(font_dsc, kern_bin->left_class_mapping_ofs,
+                                                   kern_bin->mapping_length, 1);
+        kern_classes->right_class_mapping = map_ptr(font_dsc, kern_bin->right_class_mapping_ofs,
+                                                    kern_bin->mapping_length, 1);
+        if(kern_classes->class_pair_values == NULL || kern_classes->left_class_mapping == NULL ||
+           kern_classes->right_class_mapping == NULL) {
+            return false;
+        }
+    }
+    else if(header->kern_type != 0) {
+        LV_LOG_WARN("Unknown kern type: %d", header->kern_type);
+        return false;
+    }
+
+    return true;
+}
@@ -188,6 +188,39 @@
     #endif
 #endif     /*LV_MEM_CUSTOM*/
 
+/*1: use a custom allocator for large caches (e.g. glyph cache) which can live in slower, external RAM;
+ *0: allocate them with `lv_mem_alloc()` and `lv_mem_free()` too*/
+#ifndef LV_MEM_EXT_CUSTOM
+    #ifdef CONFIG_LV_MEM_EXT_CUSTOM
+        #define LV_MEM_EXT_CUSTOM CONFIG_LV_MEM_EXT_CUSTOM
+    #else
+        #define LV_MEM_EXT_CUSTOM 0
+    #endif
+#endif
+#if LV_MEM_EXT_CUSTOM
+    #ifndef LV_MEM_EXT_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_MEM_EXT_CUSTOM_INCLUDE
+            #define LV_MEM_EXT_CUSTOM_INCLUDE CONFIG_LV_MEM_EXT_CUSTOM_INCLUDE
+        #else
+            #define LV_MEM_EXT_CUSTOM_INCLUDE <stdlib.h>   /*Header for the external memory functions*/
+        #endif
+    #endif
+    #ifndef LV_MEM_EXT_CUSTOM_ALLOC
+        #ifdef CONFIG_LV_MEM_EXT_CUSTOM_ALLOC
+            #define LV_MEM_EXT_CUSTOM_ALLOC CONFIG_LV_MEM_EXT_CUSTOM_ALLOC
+        #else
+            #define LV_MEM_EXT_CUSTOM_ALLOC   malloc
+        #endif
+    #endif
+    #ifndef LV_MEM_EXT_CUSTOM_FREE
+        #ifdef CONFIG_LV_MEM_EXT_CUSTOM_FREE
+            #define LV_MEM_EXT_CUSTOM_FREE CONFIG_LV_MEM_EXT_CUSTOM_FREE
+        #else
+            #define LV_MEM_EXT_CUSTOM_FREE    free
+        #endif
+    #endif
+#endif     /*LV_MEM_EXT_CUSTOM*/
+
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
  *You will see an error log message if there wasn't enough buffers. */
 #ifndef LV_MEM_BUF_MAX_NUM
@@ -198,6 +231,50 @@
     #endif
 #endif
 
+/*Size of the arena in bytes `lv_mem_buf_get()` takes the intermediate buffers from (per drawing thread).
+ *The buffers are stacked in it and it's emptied after every refresh so drawing doesn't call the heap.
+ *Requests which don't fit cause an error and an assert. 0: use `LV_MEM_BUF_MAX_NUM` buffers from the heap*/
+#ifndef LV_MEM_BUF_ARENA_SIZE
+    #ifdef CONFIG_LV_MEM_BUF_ARENA_SIZE
+        #define LV_MEM_BUF_ARENA_SIZE CONFIG_LV_MEM_BUF_ARENA_SIZE
+    #else
+        #define LV_MEM_BUF_ARENA_SIZE 0
+    #endif
+#endif
+
+/*1: allocate the arenas with a custom allocator (e.g. from fast internal RAM when `malloc()` can return
+ *external RAM); 0: allocate them with `lv_mem_alloc()` and `lv_mem_free()`*/
+#ifndef LV_MEM_BUF_ARENA_CUSTOM
+    #ifdef CONFIG_LV_MEM_BUF_ARENA_CUSTOM
+        #define LV_MEM_BUF_ARENA_CUSTOM CONFIG_LV_MEM_BUF_ARENA_CUSTOM
+    #else
+        #define LV_MEM_BUF_ARENA_CUSTOM 0
+    #endif
+#endif
+#if LV_MEM_BUF_ARENA_CUSTOM
+    #ifndef LV_MEM_BUF_ARENA_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_MEM_BUF_ARENA_CUSTOM_INCLUDE
+            #define LV_MEM_BUF_ARENA_CUSTOM_INCLUDE CONFIG_LV_MEM_BUF_ARENA_CUSTOM_INCLUDE
+        #else
+            #define LV_MEM_BUF_ARENA_CUSTOM_INCLUDE <stdlib.h>   /*Header for the arena's memory functions*/
+        #endif
+    #endif
+    #ifndef LV_MEM_BUF_ARENA_CUSTOM_ALLOC
+        #ifdef CONFIG_LV_MEM_BUF_ARENA_CUSTOM_ALLOC
+            #define LV_MEM_BUF_ARENA_CUSTOM_ALLOC CONFIG_LV_MEM_BUF_ARENA_CUSTOM_ALLOC
+        #else
+            #define LV_MEM_BUF_ARENA_CUSTOM_ALLOC   malloc
+        #endif
+    #endif
+    #ifndef LV_MEM_BUF_ARENA_CUSTOM_FREE
+        #ifdef CONFIG_LV_MEM_BUF_ARENA_CUSTOM_FREE
+            #define LV_MEM_BUF_ARENA_CUSTOM_FREE CONFIG_LV_MEM_BUF_ARENA_CUSTOM_FREE
+        #else
+            #define LV_MEM_BUF_ARENA_CUSTOM_FREE    free
+        #endif
+    #endif
+#endif     /*LV_MEM_BUF_ARENA_CUSTOM*/
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #ifndef LV_MEMCPY_MEMSET_STD
     #ifdef CONFIG_LV_MEMCPY_MEMSET_STD
@@ -293,7 +370,7 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *A buffered shadow has shadow size^2 RAM cost*/
     #ifndef LV_SHADOW_CACHE_SIZE
         #ifdef CONFIG_LV_SHADOW_CACHE_SIZE
             #define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -301,6 +378,19 @@
             #define LV_SHADOW_CACHE_SIZE 0
         #endif
     #endif
+    #if LV_SHADOW_CACHE_SIZE
+        /*Size of all the buffered shadows in bytes, by default 4 shadows of the max. size
+         *(with Kconfig set as the number of shadows, LV_SHADOW_CACHE_CNT).
+         *The least recently used ones are dropped to make room.
+         *Allocated with the `LV_MEM_EXT_CUSTOM` allocator. 0: blur the shadows on every draw*/
+        #ifndef LV_SHADOW_CACHE_MEM_SIZE
+            #ifdef CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+                #define LV_SHADOW_CACHE_MEM_SIZE CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+            #else
+                #define LV_SHADOW_CACHE_MEM_SIZE (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 4)
+            #endif
+        #endif
+    #endif
 
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
@@ -355,6 +445,30 @@
         #define LV_IMG_CACHE_DEF_SIZE 0
     #endif
 #endif
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Limit of the RAM used by the opened images in bytes. The least recently used ones are closed to make room.
+     *0: limit only the number of images*/
+    #ifndef LV_IMG_CACHE_MEM_SIZE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_SIZE
+            #define LV_IMG_CACHE_MEM_SIZE CONFIG_LV_IMG_CACHE_MEM_SIZE
+        #else
+            #define LV_IMG_CACHE_MEM_SIZE 0
+        #endif
+    #endif
+#endif
+
+/*Size of the text cache in bytes.
+ *The software renderer draws the text of a label into an 8 bit opacity map once
+ *and blends this map with a single fill while the text, font and layout of the label don't change.
+ *A text needs width x height bytes. Texts larger than the cache are drawn letter by letter.
+ *0: to disable caching*/
+#ifndef LV_TEXT_CACHE_SIZE
+    #ifdef CONFIG_LV_TEXT_CACHE_SIZE
+        #define LV_TEXT_CACHE_SIZE CONFIG_LV_TEXT_CACHE_SIZE
+    #else
+        #define LV_TEXT_CACHE_SIZE 0
+    #endif
+#endif
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -368,6 +482,8 @@
 
 /*Default gradient buffer size.
  *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
+ *The maps are found by their stops, direction, size and dithering mode and the least recently used ones are dropped.
+ *With ordered dithering the dithered rows are cached too (8 times the size of the map).
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
@@ -412,6 +528,85 @@
     #endif
 #endif
 
+/*Number of threads rendering with the software renderer.
+ *The areas to redraw are cut into horizontal bands and the bands are drawn in parallel
+ *by the thread calling `lv_timer_handler()` and LV_DRAW_SW_THREAD_CNT - 1 worker threads.
+ *Requires LV_MEM_CUSTOM 1 with a thread safe `malloc` and the draw event callbacks of the application
+ *have to be thread safe too.
+ *1: render on the calling thread only*/
+#ifndef LV_DRAW_SW_THREAD_CNT
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_DRAW_SW_THREAD_CNT
+            #define LV_DRAW_SW_THREAD_CNT CONFIG_LV_DRAW_SW_THREAD_CNT
+        #else
+            #define LV_DRAW_SW_THREAD_CNT 0
+        #endif
+    #else
+        #define LV_DRAW_SW_THREAD_CNT 1
+    #endif
+#endif
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*1: use FreeRTOS tasks; 0: use pthreads*/
+    #ifndef LV_DRAW_SW_THREAD_FREERTOS
+        #ifdef CONFIG_LV_DRAW_SW_THREAD_FREERTOS
+            #define LV_DRAW_SW_THREAD_FREERTOS CONFIG_LV_DRAW_SW_THREAD_FREERTOS
+        #else
+            #define LV_DRAW_SW_THREAD_FREERTOS 0
+        #endif
+    #endif
+
+    /*Stack size of the worker threads in bytes*/
+    #ifndef LV_DRAW_SW_THREAD_STACK_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_THREAD_STACK_SIZE
+            #define LV_DRAW_SW_THREAD_STACK_SIZE CONFIG_LV_DRAW_SW_THREAD_STACK_SIZE
+        #else
+            #define LV_DRAW_SW_THREAD_STACK_SIZE (16 * 1024)
+        #endif
+    #endif
+
+    /*Priority of the worker tasks. Only used with FreeRTOS.*/
+    #ifndef LV_DRAW_SW_THREAD_PRIO
+        #ifdef CONFIG_LV_DRAW_SW_THREAD_PRIO
+            #define LV_DRAW_SW_THREAD_PRIO CONFIG_LV_DRAW_SW_THREAD_PRIO
+        #else
+            #define LV_DRAW_SW_THREAD_PRIO 5
+        #endif
+    #endif
+
+    /*Areas lower than this many rows per thread are drawn by the calling thread only*/
+    #ifndef LV_DRAW_SW_THREAD_MIN_HEIGHT
+        #ifdef CONFIG_LV_DRAW_SW_THREAD_MIN_HEIGHT
+            #define LV_DRAW_SW_THREAD_MIN_HEIGHT CONFIG_LV_DRAW_SW_THREAD_MIN_HEIGHT
+        #else
+            #define LV_DRAW_SW_THREAD_MIN_HEIGHT 16
+        #endif
+    #endif
+
+    /*Storage class specifier of thread-local variables*/
+    #ifndef LV_DRAW_SW_THREAD_LOCAL
+        #ifdef CONFIG_LV_DRAW_SW_THREAD_LOCAL
+            #define LV_DRAW_SW_THREAD_LOCAL CONFIG_LV_DRAW_SW_THREAD_LOCAL
+        #else
+            #define LV_DRAW_SW_THREAD_LOCAL __thread
+        #endif
+    #endif
+#endif
+
+/*Blend with vectorized kernels chosen by the CPU's features in `lv_init()` instead of the C loops.
+ *Built-in: SSE2 and AVX2 on x86 with GCC or Clang, PIE on the ESP32-S3 (fill only).
+ *Other kernels can be set by `lv_draw_sw_blend_set_kernels()`*/
+#ifndef LV_DRAW_SW_BLEND_SIMD
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_DRAW_SW_BLEND_SIMD
+            #define LV_DRAW_SW_BLEND_SIMD CONFIG_LV_DRAW_SW_BLEND_SIMD
+        #else
+            #define LV_DRAW_SW_BLEND_SIMD 0
+        #endif
+    #else
+        #define LV_DRAW_SW_BLEND_SIMD 1
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -848,6 +1043,43 @@
     #endif
 #endif
 
+/*Number of style property lookups to cache per object.
+ *The resolved values are kept for the object's current state and are invalidated when a style changes.
+ *Needs around 12 bytes per entry on 32 bit systems for every object which has styles.
+ *Must be a power of 2 (max 256). 0: to disable caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Maximal size of the recorded draw calls of an object in bytes.
+ *Objects which weren't changed since they were drawn replay their recorded draw calls
+ *instead of sending the draw events and building the draw descriptors again.
+ *Objects with larger recordings or masks (e.g. clip corner) are always drawn with the draw events.
+ *0: to disable recording*/
+#ifndef LV_OBJ_DRAW_LIST_SIZE
+    #ifdef CONFIG_LV_OBJ_DRAW_LIST_SIZE
+        #define LV_OBJ_DRAW_LIST_SIZE CONFIG_LV_OBJ_DRAW_LIST_SIZE
+    #else
+        #define LV_OBJ_DRAW_LIST_SIZE 0
+    #endif
+#endif
+
+/*Maximal total size of the kept layers of the objects in bytes.
+ *The objects enabled with `lv_obj_set_layer_cache()` keep their rendered layer (e.g. for opa_layered or transform)
+ *between the frames and only blend or transform it until one of their descendants is invalidated.
+ *0: to disable keeping the layers*/
+#ifndef LV_OBJ_LAYER_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_LAYER_CACHE_SIZE
+        #define LV_OBJ_LAYER_CACHE_SIZE CONFIG_LV_OBJ_LAYER_CACHE_SIZE
+    #else
+        #define LV_OBJ_LAYER_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #ifndef LV_ENABLE_GC
@@ -1228,6 +1460,18 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache of decompressed glyph bitmaps in bytes. Allocated with the `LV_MEM_EXT_CUSTOM` allocator.
+     *Glyphs drawn again and again (e.g. digits of a clock) don't need to be decompressed while they are cached.
+     *0: no cache, decompress the glyphs every time*/
+    #ifndef LV_FONT_COMPRESSED_CACHE_SIZE
+        #ifdef CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+            #define LV_FONT_COMPRESSED_CACHE_SIZE CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+        #else
+            #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
@@ -1978,6 +2222,55 @@
 
 /*File system interfaces for common APIs */
 
+/*Number of blocks of `LV_FS_..._CACHE_SIZE` bytes shared by the open files of each driver with a cache.
+ *The least recently used block is replaced. Blocks read in order replace themselves first.
+ *0: cache one block per open file*/
+#ifndef LV_FS_CACHE_BLOCK_CNT
+    #ifdef CONFIG_LV_FS_CACHE_BLOCK_CNT
+        #define LV_FS_CACHE_BLOCK_CNT CONFIG_LV_FS_CACHE_BLOCK_CNT
+    #else
+        #define LV_FS_CACHE_BLOCK_CNT 0
+    #endif
+#endif
+#if LV_FS_CACHE_BLOCK_CNT
+    /*1: read the next block on a worker thread when a file is read sequentially*/
+    #ifndef LV_FS_CACHE_PREFETCH
+        #ifdef CONFIG_LV_FS_CACHE_PREFETCH
+            #define LV_FS_CACHE_PREFETCH CONFIG_LV_FS_CACHE_PREFETCH
+        #else
+            #define LV_FS_CACHE_PREFETCH 0
+        #endif
+    #endif
+    #if LV_FS_CACHE_PREFETCH
+        /*1: use a FreeRTOS task; 0: use a pthread*/
+        #ifndef LV_FS_CACHE_PREFETCH_FREERTOS
+            #ifdef CONFIG_LV_FS_CACHE_PREFETCH_FREERTOS
+                #define LV_FS_CACHE_PREFETCH_FREERTOS CONFIG_LV_FS_CACHE_PREFETCH_FREERTOS
+            #else
+                #define LV_FS_CACHE_PREFETCH_FREERTOS 0
+            #endif
+        #endif
+
+        /*Stack size of the prefetch thread in bytes*/
+        #ifndef LV_FS_CACHE_PREFETCH_STACK_SIZE
+            #ifdef CONFIG_LV_FS_CACHE_PREFETCH_STACK_SIZE
+                #define LV_FS_CACHE_PREFETCH_STACK_SIZE CONFIG_LV_FS_CACHE_PREFETCH_STACK_SIZE
+            #else
+                #define LV_FS_CACHE_PREFETCH_STACK_SIZE (4 * 1024)
+            #endif
+        #endif
+
+        /*Priority of the prefetch task. Only used with FreeRTOS.*/
+        #ifndef LV_FS_CACHE_PREFETCH_PRIO
+            #ifdef CONFIG_LV_FS_CACHE_PREFETCH_PRIO
+                #define LV_FS_CACHE_PREFETCH_PRIO CONFIG_LV_FS_CACHE_PREFETCH_PRIO
+            #else
+                #define LV_FS_CACHE_PREFETCH_PRIO 4
+            #endif
+        #endif
+    #endif
+#endif
+
 /*API for fopen, fread, etc*/
 #ifndef LV_USE_FS_STDIO
     #ifdef CONFIG_LV_USE_FS_STDIO
@@ -2042,6 +2335,31 @@
     #endif
 #endif
 
+/*API for mmap (POSIX) or esp_partition_mmap (ESP32). The files can be read in place with `lv_fs_get_ptr()`*/
+#ifndef LV_USE_FS_MMAP
+    #ifdef CONFIG_LV_USE_FS_MMAP
+        #define LV_USE_FS_MMAP CONFIG_LV_USE_FS_MMAP
+    #else
+        #define LV_USE_FS_MMAP 0
+    #endif
+#endif
+#if LV_USE_FS_MMAP
+    #ifndef LV_FS_MMAP_LETTER
+        #ifdef CONFIG_LV_FS_MMAP_LETTER
+            #define LV_FS_MMAP_LETTER CONFIG_LV_FS_MMAP_LETTER
+        #else
+            #define LV_FS_MMAP_LETTER '\0'     /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+        #endif
+    #endif
+    #ifndef LV_FS_MMAP_PATH
+        #ifdef CONFIG_LV_FS_MMAP_PATH
+            #define LV_FS_MMAP_PATH CONFIG_LV_FS_MMAP_PATH
+        #else
+            #define LV_FS_MMAP_PATH ""          /*The working directory (POSIX) or the label of the data partition (ESP32)*/
+        #endif
+    #endif
+#endif
+
 /*API for CreateFile, ReadFile, etc*/
 #ifndef LV_USE_FS_WIN32
     #ifdef CONFIG_LV_USE_FS_WIN32
@@ -2234,6 +2552,22 @@
             #define LV_TINY_TTF_FILE_SUPPORT 0
         #endif
     #endif
+
+    /*Number of glyph metrics (glyph index, box and advance) and kerning pairs cached per font. 0: don't cache*/
+    #ifndef LV_TINY_TTF_GLYPH_CACHE_CNT
+        #ifdef CONFIG_LV_TINY_TTF_GLYPH_CACHE_CNT
+            #define LV_TINY_TTF_GLYPH_CACHE_CNT CONFIG_LV_TINY_TTF_GLYPH_CACHE_CNT
+        #else
+            #define LV_TINY_TTF_GLYPH_CACHE_CNT 256
+        #endif
+    #endif
+    #ifndef LV_TINY_TTF_KERN_CACHE_CNT
+        #ifdef CONFIG_LV_TINY_TTF_KERN_CACHE_CNT
+            #define LV_TINY_TTF_KERN_CACHE_CNT CONFIG_LV_TINY_TTF_KERN_CACHE_CNT
+        #else
+            #define LV_TINY_TTF_KERN_CACHE_CNT 512
+        #endif
+    #endif
 #endif
 
 /*Rlottie library*/
@@ -2525,6 +2859,12 @@ LV_EXPORT_CONST_INT(LV_DPI_DEF);
     #define LV_LOG_TRACE_ANIM       0
 #endif  /*LV_USE_LOG*/
 
+#if LV_DRAW_SW_THREAD_CNT <= 1
+    #ifndef LV_DRAW_SW_THREAD_LOCAL
+        #define LV_DRAW_SW_THREAD_LOCAL
+    #endif
+#endif  /*LV_DRAW_SW_THREAD_CNT*/
+
 
 /*If running without lv_conf.h add typedefs with default value*/
 #ifdef LV_CONF_SKIP
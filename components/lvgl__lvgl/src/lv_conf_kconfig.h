@@ -41,6 +41,45 @@ extern "C" {
 #  define CONFIG_LV_MEM_SIZE (CONFIG_LV_MEM_SIZE_KILOBYTES * 1024U)
 #endif
 
+/*******************
+ * LV_SHADOW_CACHE_MEM_SIZE
+ *******************/
+
+#ifdef CONFIG_LV_SHADOW_CACHE_CNT
+#  define CONFIG_LV_SHADOW_CACHE_MEM_SIZE \
+    (CONFIG_LV_SHADOW_CACHE_SIZE * CONFIG_LV_SHADOW_CACHE_SIZE * CONFIG_LV_SHADOW_CACHE_CNT)
+#endif
+
+/*******************
+ * LV_MEM_EXT
+ *******************/
+
+#if defined(ESP_PLATFORM) && defined(CONFIG_LV_MEM_EXT_USE_SPIRAM)
+#  define CONFIG_LV_MEM_EXT_CUSTOM 1
+#  define CONFIG_LV_MEM_EXT_CUSTOM_INCLUDE "esp_heap_caps.h"
+#  define CONFIG_LV_MEM_EXT_CUSTOM_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#  define CONFIG_LV_MEM_EXT_CUSTOM_FREE heap_caps_free
+#endif
+
+/*******************
+ * LV_MEM_BUF_ARENA
+ *******************/
+
+#if defined(ESP_PLATFORM) && defined(CONFIG_LV_MEM_BUF_ARENA_USE_INTERNAL_RAM)
+#  define CONFIG_LV_MEM_BUF_ARENA_CUSTOM 1
+#  define CONFIG_LV_MEM_BUF_ARENA_CUSTOM_INCLUDE "esp_heap_caps.h"
+#  define CONFIG_LV_MEM_BUF_ARENA_CUSTOM_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#  define CONFIG_LV_MEM_BUF_ARENA_CUSTOM_FREE heap_caps_free
+#endif
+
+/*******************
+ * LV_TICK_CUSTOM
+ *******************/
+
+#if defined(ESP_PLATFORM) && defined(CONFIG_LV_TICK_CUSTOM)
+#  define CONFIG_LV_TICK_CUSTOM_SYS_TIME_EXPR (esp_timer_get_time() / 1000LL)
+#endif
+
 /*------------------
  * MONITOR POSITION
  *-----------------*/
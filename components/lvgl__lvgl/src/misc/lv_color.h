@@ -550,12 +550,12 @@ static inline void LV_ATTRIBUTE_FAST_MEM lv_color_mix_with_alpha(lv_color_t bg_c
     /*Both colors have alpha. Expensive calculation need to be applied*/
     else {
         /*Save the parameters and the result. If they will be asked again don't compute again*/
-        static lv_opa_t fg_opa_save     = 0;
-        static lv_opa_t bg_opa_save     = 0;
-        static lv_color_t fg_color_save = _LV_COLOR_ZERO_INITIALIZER;
-        static lv_color_t bg_color_save = _LV_COLOR_ZERO_INITIALIZER;
-        static lv_color_t res_color_saved = _LV_COLOR_ZERO_INITIALIZER;
-        static lv_opa_t res_opa_saved = 0;
+        static LV_DRAW_SW_THREAD_LOCAL lv_opa_t fg_opa_save     = 0;
+        static LV_DRAW_SW_THREAD_LOCAL lv_opa_t bg_opa_save     = 0;
+        static LV_DRAW_SW_THREAD_LOCAL lv_color_t fg_color_save = _LV_COLOR_ZERO_INITIALIZER;
+        static LV_DRAW_SW_THREAD_LOCAL lv_color_t bg_color_save = _LV_COLOR_ZERO_INITIALIZER;
+        static LV_DRAW_SW_THREAD_LOCAL lv_color_t res_color_saved = _LV_COLOR_ZERO_INITIALIZER;
+        static LV_DRAW_SW_THREAD_LOCAL lv_opa_t res_opa_saved = 0;
 
         if(fg_opa != fg_opa_save || bg_opa != bg_opa_save || fg_color.full != fg_color_save.full ||
            bg_color.full != bg_color_save.full) {
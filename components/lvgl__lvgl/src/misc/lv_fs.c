@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_fs.h"
+#include "lv_fs_cache.h"
 
 #include "../misc/lv_assert.h"
 #include "lv_ll.h"
@@ -90,6 +91,7 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 
     file_p->drv = drv;
     file_p->file_d = file_d;
+    file_p->cache = NULL;
 
     if(drv->cache_size) {
         file_p->cache = lv_mem_alloc(sizeof(lv_fs_file_cache_t));
@@ -97,6 +99,8 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
         lv_memset_00(file_p->cache, sizeof(lv_fs_file_cache_t));
         file_p->cache->start = UINT32_MAX;  /*Set an invalid range by default*/
         file_p->cache->end = UINT32_MAX - 1;
+        file_p->cache->shared = drv->cache_block_cnt > 0;
+        file_p->cache->last_block = UINT32_MAX;
     }
 
     return LV_FS_RES_OK;
@@ -112,9 +116,11 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
+    if(file_p->cache && file_p->cache->shared) _lv_fs_cache_detach(file_p);
+
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
-    if(file_p->drv->cache_size && file_p->cache) {
+    if(file_p->cache) {
         if(file_p->cache->buffer) {
             lv_mem_free(file_p->cache->buffer);
         }
@@ -211,7 +217,10 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     uint32_t br_tmp = 0;
     lv_fs_res_t res;
 
-    if(file_p->drv->cache_size) {
+    if(file_p->cache && file_p->cache->shared) {
+        res = _lv_fs_cache_read(file_p, buf, btr, &br_tmp);
+    }
+    else if(file_p->cache) {
         res = lv_fs_read_cached(file_p, (char *)buf, btr, &br_tmp);
     }
     else {
@@ -236,7 +245,13 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     }
 
     uint32_t bw_tmp = 0;
-    lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    lv_fs_res_t res;
+    if(file_p->cache && file_p->cache->shared) {
+        res = _lv_fs_cache_write(file_p, buf, btw, &bw_tmp);
+    }
+    else {
+        res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    }
     if(bw != NULL) *bw = bw_tmp;
 
     return res;
@@ -253,7 +268,21 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
     }
 
     lv_fs_res_t res = LV_FS_RES_OK;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache && file_p->cache->shared) {
+        /*The blocks are read from their position, only the size of the file needs the driver*/
+        switch(whence) {
+            case LV_FS_SEEK_SET:
+                file_p->cache->file_position = pos;
+                break;
+            case LV_FS_SEEK_CUR:
+                file_p->cache->file_position += pos;
+                break;
+            case LV_FS_SEEK_END:
+                res = _lv_fs_cache_seek_end(file_p, pos);
+                break;
+        }
+    }
+    else if(file_p->cache) {
         switch(whence) {
             case LV_FS_SEEK_SET: {
                     file_p->cache->file_position = pos;
@@ -286,6 +315,12 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
                             file_p->cache->file_position = tmp_position;
                         }
                     }
+
+                    /*The FS position is not at the end of the cached data anymore, so drop it*/
+                    if(res == LV_FS_RES_OK) {
+                        file_p->cache->start = UINT32_MAX;
+                        file_p->cache->end = UINT32_MAX - 1;
+                    }
                     break;
                 }
         }
@@ -310,7 +345,7 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     }
 
     lv_fs_res_t res;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache) {
         *pos = file_p->cache->file_position;
         res = LV_FS_RES_OK;
     }
@@ -321,6 +356,15 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+lv_fs_res_t lv_fs_get_ptr(lv_fs_file_t * file_p, uint32_t pos, uint32_t len, const void ** ptr)
+{
+    *ptr = NULL;
+    if(file_p->drv == NULL) return LV_FS_RES_INV_PARAM;
+    if(file_p->drv->get_ptr_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    return file_p->drv->get_ptr_cb(file_p->drv, file_p->file_d, pos, len, ptr);
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -393,6 +437,7 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p)
 void lv_fs_drv_init(lv_fs_drv_t * drv)
 {
     lv_memset_00(drv, sizeof(lv_fs_drv_t));
+    drv->cache_block_cnt = LV_FS_CACHE_BLOCK_CNT;
 }
 
 void lv_fs_drv_register(lv_fs_drv_t * drv_p)
@@ -66,9 +66,14 @@ typedef enum {
     LV_FS_SEEK_END = 0x02,      /**< Set the position from the end of the file*/
 } lv_fs_whence_t;
 
+struct _lv_fs_block_cache_t;
+
 typedef struct _lv_fs_drv_t {
     char letter;
-    uint16_t cache_size;
+    uint16_t cache_size;        /**< >0: read the files in blocks of this many bytes and cache them*/
+    uint16_t cache_block_cnt;   /**< >0: share this many blocks between the open files with LRU replacement,
+                                     0: cache one block per open file*/
+    struct _lv_fs_block_cache_t * block_cache;  /**< The shared blocks, created when they are used first*/
     bool (*ready_cb)(struct _lv_fs_drv_t * drv);
 
     void * (*open_cb)(struct _lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
@@ -77,6 +82,9 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*write_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
     lv_fs_res_t (*seek_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+    /**Optional: give a pointer to `len` bytes at `pos` of a file which can be read in place (e.g. mapped)*/
+    lv_fs_res_t (*get_ptr_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len,
+                              const void ** ptr_p);
 
     void * (*dir_open_cb)(struct _lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
@@ -92,6 +100,9 @@ typedef struct {
     uint32_t end;
     uint32_t file_position;
     void * buffer;
+    bool shared;            /**< The blocks are in the driver's `block_cache` instead of `buffer`*/
+    uint32_t last_block;    /**< The last block read from the shared blocks*/
+    uint32_t seq_cnt;       /**< Number of blocks read in order until `last_block`*/
 } lv_fs_file_cache_t;
 
 typedef struct {
@@ -105,6 +116,15 @@ typedef struct {
     lv_fs_drv_t * drv;
 } lv_fs_dir_t;
 
+/** Statistics of a driver's shared block cache*/
+typedef struct {
+    uint32_t hit_cnt;           /**< Blocks found in the cache*/
+    uint32_t miss_cnt;          /**< Blocks read from the file system when needed*/
+    uint32_t read_cnt;          /**< Number of `read_cb` calls*/
+    uint32_t prefetch_cnt;      /**< Blocks read in advance by the prefetch thread*/
+    uint32_t prefetch_hit_cnt;  /**< Prefetched blocks which were used later*/
+} lv_fs_cache_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -198,6 +218,33 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get a pointer to a part of a file which can be read in place, without copying it.
+ * Only the drivers which map the files to the memory (e.g. `LV_USE_FS_MMAP`) support it.
+ * The pointer remains valid until the file is closed. The read write pointer is not changed.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param pos       position of the first byte expressed in bytes index (0: start of file)
+ * @param len       number of bytes which will be read from the pointer
+ * @param ptr       store the pointer here (NULL on error)
+ * @return          LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver can't map the file,
+ *                  LV_FS_RES_INV_PARAM if the range is not in the file
+ */
+lv_fs_res_t lv_fs_get_ptr(lv_fs_file_t * file_p, uint32_t pos, uint32_t len, const void ** ptr);
+
+/**
+ * Get the statistics of the shared block cache of a driver (see `cache_block_cnt` in `lv_fs_drv_t`)
+ * @param drv       pointer to a driver
+ * @param mon_p     store the statistics here (all zero if the driver has no shared blocks)
+ */
+void lv_fs_drv_cache_monitor(lv_fs_drv_t * drv, lv_fs_cache_monitor_t * mon_p);
+
+/**
+ * Free the shared block cache of a driver and reset its statistics.
+ * The blocks are allocated again with the current `cache_size` and `cache_block_cnt` when they are needed.
+ * @param drv       pointer to a driver
+ */
+void lv_fs_drv_cache_free(lv_fs_drv_t * drv);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
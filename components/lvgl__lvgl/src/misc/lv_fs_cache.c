@@ -0,0 +1,740 @@
+/**
+ * @file lv_fs_cache.c
+ * Blocks of the files shared by the open files of a driver
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_cache.h"
+#include "lv_mem.h"
+#include "lv_assert.h"
+#include "lv_log.h"
+#include "lv_math.h"
+
+/*The blocks can be shared by setting `cache_block_cnt` of any driver, but prefetching needs the config*/
+#if LV_FS_CACHE_BLOCK_CNT
+    #define USE_PREFETCH LV_FS_CACHE_PREFETCH
+#else
+    #define USE_PREFETCH 0
+#endif
+
+#if USE_PREFETCH
+    #if LV_FS_CACHE_PREFETCH_FREERTOS
+        #ifdef ESP_PLATFORM
+            #include "freertos/FreeRTOS.h"
+            #include "freertos/task.h"
+            #include "freertos/semphr.h"
+        #else
+            #include "FreeRTOS.h"
+            #include "task.h"
+            #include "semphr.h"
+        #endif
+    #else
+        #include <pthread.h>
+        #include <limits.h>
+    #endif
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*A file is read sequentially if this many blocks were read in order*/
+#define SEQ_MIN_CNT 2
+
+#define PREFETCH_QUEUE_LEN 4
+
+#if USE_PREFETCH
+    #if LV_FS_CACHE_PREFETCH_FREERTOS
+        #ifdef ESP_PLATFORM
+            #define TASK_STACK_DEPTH    LV_FS_CACHE_PREFETCH_STACK_SIZE    /*ESP-IDF counts the stack in bytes*/
+        #else
+            #define TASK_STACK_DEPTH    (LV_FS_CACHE_PREFETCH_STACK_SIZE / sizeof(StackType_t))
+        #endif
+    #endif
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const lv_fs_file_cache_t * owner;   /*The file whose data is in the block or NULL if unused*/
+    uint32_t index;                     /*Position of the block in the file in `block_size` units*/
+    uint32_t len;                       /*Number of valid bytes, less than `block_size` at the end of the file*/
+    uint32_t life;                      /*Time of the last use. The smallest is the least recently used.*/
+    uint8_t * data;
+    bool prefetched;                    /*Read by the prefetch thread and not used yet*/
+} block_t;
+
+typedef struct _lv_fs_block_cache_t {
+    block_t * blocks;
+    uint8_t * data;
+    uint16_t block_cnt;
+    uint16_t block_size;
+    uint32_t life_cnt;
+    lv_fs_cache_monitor_t monitor;
+} lv_fs_block_cache_t;
+
+#if USE_PREFETCH
+#if LV_FS_CACHE_PREFETCH_FREERTOS
+typedef TaskHandle_t sync_thread_t;
+typedef SemaphoreHandle_t sync_sem_t;
+typedef SemaphoreHandle_t sync_mutex_t;
+#else
+typedef pthread_t sync_thread_t;
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t cnt;
+} sync_sem_t;
+typedef pthread_mutex_t sync_mutex_t;
+#endif
+
+typedef struct {
+    lv_fs_file_t file;      /*Copy of the file to read, its `cache` identifies the blocks*/
+    uint32_t index;
+} prefetch_req_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_block_cache_t * block_cache_get(lv_fs_drv_t * drv);
+static block_t * block_find(lv_fs_block_cache_t * bc, const lv_fs_file_cache_t * owner, uint32_t index);
+static block_t * block_load(const lv_fs_file_t * file_p, lv_fs_block_cache_t * bc, uint32_t index,
+                            lv_fs_res_t * res);
+static void block_drop(lv_fs_block_cache_t * bc, const lv_fs_file_cache_t * owner);
+static void seq_update(lv_fs_block_cache_t * bc, lv_fs_file_cache_t * fc, uint32_t index);
+static void cache_lock(void);
+static void cache_unlock(void);
+
+#if USE_PREFETCH
+static void prefetch_request(const lv_fs_file_t * file_p, lv_fs_block_cache_t * bc, uint32_t index);
+static void prefetch_cancel(const lv_fs_drv_t * drv, const lv_fs_file_cache_t * owner);
+static bool prefetch_start(void);
+static void prefetch_run(void);
+
+static bool sem_init(sync_sem_t * sem);
+static void sem_deinit(sync_sem_t * sem);
+static void sem_give(sync_sem_t * sem);
+static void sem_take(sync_sem_t * sem);
+static bool mutex_init(sync_mutex_t * mutex);
+static void mutex_deinit(sync_mutex_t * mutex);
+static void mutex_lock(sync_mutex_t * mutex);
+static void mutex_unlock(sync_mutex_t * mutex);
+static bool thread_create(void);
+static void thread_join(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if USE_PREFETCH
+static sync_mutex_t cache_mutex;    /*Guards the blocks and the driver calls of the files with shared blocks*/
+static bool mutex_ready;
+static sync_thread_t prefetch_thread;
+static sync_sem_t prefetch_sem;     /*Given when a request is added or the thread has to exit*/
+static bool prefetch_running;
+static bool prefetch_failed;
+static bool prefetch_quit;
+static prefetch_req_t prefetch_reqs[PREFETCH_QUEUE_LEN];
+static uint32_t prefetch_req_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_fs_res_t _lv_fs_cache_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    lv_fs_file_cache_t * fc = file_p->cache;
+    uint8_t * buf8 = buf;
+    lv_fs_res_t res = LV_FS_RES_OK;
+    *br = 0;
+
+    cache_lock();
+
+    lv_fs_block_cache_t * bc = block_cache_get(drv);
+    if(bc == NULL) {
+        /*Couldn't allocate the blocks, read directly*/
+        res = drv->seek_cb(drv, file_p->file_d, fc->file_position, LV_FS_SEEK_SET);
+        if(res == LV_FS_RES_OK) res = drv->read_cb(drv, file_p->file_d, buf, btr, br);
+        if(res == LV_FS_RES_OK) fc->file_position += *br;
+        cache_unlock();
+        return res;
+    }
+
+    uint32_t bs = bc->block_size;
+    while(btr > 0) {
+        uint32_t index = fc->file_position / bs;
+        uint32_t ofs = fc->file_position % bs;
+        block_t * b = block_find(bc, fc, index);
+
+        if(b == NULL && ofs == 0 && btr >= bs) {
+            /*Whole blocks are read directly into the buffer instead of copying them from the blocks*/
+            uint32_t len = btr - btr % bs;
+            uint32_t rn = 0;
+            res = drv->seek_cb(drv, file_p->file_d, fc->file_position, LV_FS_SEEK_SET);
+            if(res == LV_FS_RES_OK) res = drv->read_cb(drv, file_p->file_d, buf8, len, &rn);
+            bc->monitor.read_cnt++;
+            if(res != LV_FS_RES_OK) break;
+
+            seq_update(bc, fc, index);
+            if(rn >= bs) fc->last_block = index + rn / bs - 1;
+            buf8 += rn;
+            btr -= rn;
+            *br += rn;
+            fc->file_position += rn;
+            if(rn < len) break;     /*End of the file*/
+            continue;
+        }
+
+        if(b) {
+            bc->monitor.hit_cnt++;
+            if(b->prefetched) {
+                bc->monitor.prefetch_hit_cnt++;
+                b->prefetched = false;
+            }
+            b->life = ++bc->life_cnt;
+        }
+        else {
+            bc->monitor.miss_cnt++;
+            b = block_load(file_p, bc, index, &res);
+            if(b == NULL) break;
+        }
+
+        seq_update(bc, fc, index);
+
+        if(ofs >= b->len) break;    /*End of the file*/
+
+        uint32_t n = LV_MIN(btr, b->len - ofs);
+        lv_memcpy(buf8, b->data + ofs, n);
+        buf8 += n;
+        btr -= n;
+        *br += n;
+        fc->file_position += n;
+        if(b->len < bs && btr > 0) break;   /*The last block is read to its end*/
+    }
+
+#if USE_PREFETCH
+    /*Read the next block while the caller processes this data*/
+    if(res == LV_FS_RES_OK && fc->seq_cnt >= SEQ_MIN_CNT) {
+        block_t * last = block_find(bc, fc, fc->last_block);
+        if(last == NULL || last->len == bs) prefetch_request(file_p, bc, fc->last_block + 1);
+    }
+#endif
+
+    cache_unlock();
+    return res;
+}
+
+lv_fs_res_t _lv_fs_cache_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    lv_fs_file_cache_t * fc = file_p->cache;
+
+    cache_lock();
+
+    *bw = 0;
+    lv_fs_res_t res = drv->seek_cb(drv, file_p->file_d, fc->file_position, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = drv->write_cb(drv, file_p->file_d, buf, btw, bw);
+    fc->file_position += *bw;
+
+    /*The cached blocks might be outdated*/
+    if(drv->block_cache) block_drop(drv->block_cache, fc);
+
+    cache_unlock();
+    return res;
+}
+
+lv_fs_res_t _lv_fs_cache_seek_end(lv_fs_file_t * file_p, uint32_t pos)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+
+    cache_lock();
+
+    lv_fs_res_t res = drv->seek_cb(drv, file_p->file_d, pos, LV_FS_SEEK_END);
+    uint32_t new_pos;
+    if(res == LV_FS_RES_OK) res = drv->tell_cb(drv, file_p->file_d, &new_pos);
+    if(res == LV_FS_RES_OK) file_p->cache->file_position = new_pos;
+
+    cache_unlock();
+    return res;
+}
+
+void _lv_fs_cache_detach(lv_fs_file_t * file_p)
+{
+    cache_lock();
+
+#if USE_PREFETCH
+    prefetch_cancel(file_p->drv, file_p->cache);
+#endif
+    if(file_p->drv->block_cache) block_drop(file_p->drv->block_cache, file_p->cache);
+
+    cache_unlock();
+}
+
+void _lv_fs_cache_deinit(void)
+{
+#if USE_PREFETCH
+    if(prefetch_running) {
+        prefetch_quit = true;
+        sem_give(&prefetch_sem);
+        thread_join();
+        sem_deinit(&prefetch_sem);
+        prefetch_running = false;
+        prefetch_quit = false;
+    }
+
+    if(mutex_ready) {
+        mutex_deinit(&cache_mutex);
+        mutex_ready = false;
+    }
+
+    prefetch_req_cnt = 0;
+    prefetch_failed = false;
+#endif
+}
+
+void lv_fs_drv_cache_monitor(lv_fs_drv_t * drv, lv_fs_cache_monitor_t * mon_p)
+{
+    cache_lock();
+    if(drv->block_cache) *mon_p = drv->block_cache->monitor;
+    else lv_memset_00(mon_p, sizeof(lv_fs_cache_monitor_t));
+    cache_unlock();
+}
+
+void lv_fs_drv_cache_free(lv_fs_drv_t * drv)
+{
+    cache_lock();
+
+    lv_fs_block_cache_t * bc = drv->block_cache;
+    if(bc) {
+#if USE_PREFETCH
+        prefetch_cancel(drv, NULL);
+#endif
+        lv_mem_free(bc->data);
+        lv_mem_free(bc->blocks);
+        lv_mem_free(bc);
+        drv->block_cache = NULL;
+    }
+
+    cache_unlock();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the shared blocks of a driver and allocate them if needed
+ * @param drv       pointer to a driver
+ * @return          the blocks or NULL if they couldn't be allocated
+ */
+static lv_fs_block_cache_t * block_cache_get(lv_fs_drv_t * drv)
+{
+    if(drv->block_cache) return drv->block_cache;
+    if(drv->cache_size == 0 || drv->cache_block_cnt == 0) return NULL;
+
+    lv_fs_block_cache_t * bc = lv_mem_alloc(sizeof(lv_fs_block_cache_t));
+    LV_ASSERT_MALLOC(bc);
+    if(bc == NULL) return NULL;
+    lv_memset_00(bc, sizeof(lv_fs_block_cache_t));
+
+    bc->blocks = lv_mem_alloc(sizeof(block_t) * drv->cache_block_cnt);
+    bc->data = lv_mem_alloc((uint32_t)drv->cache_size * drv->cache_block_cnt);
+    LV_ASSERT_MALLOC(bc->blocks);
+    LV_ASSERT_MALLOC(bc->data);
+    if(bc->blocks == NULL || bc->data == NULL) {
+        LV_LOG_WARN("Couldn't allocate the shared blocks, reading without cache");
+        lv_mem_free(bc->blocks);
+        lv_mem_free(bc->data);
+        lv_mem_free(bc);
+        return NULL;
+    }
+
+    lv_memset_00(bc->blocks, sizeof(block_t) * drv->cache_block_cnt);
+    bc->block_cnt = drv->cache_block_cnt;
+    bc->block_size = drv->cache_size;
+    uint32_t i;
+    for(i = 0; i < bc->block_cnt; i++) {
+        bc->blocks[i].data = bc->data + i * bc->block_size;
+    }
+
+    drv->block_cache = bc;
+    return bc;
+}
+
+static block_t * block_find(lv_fs_block_cache_t * bc, const lv_fs_file_cache_t * owner, uint32_t index)
+{
+    uint32_t i;
+    for(i = 0; i < bc->block_cnt; i++) {
+        block_t * b = &bc->blocks[i];
+        if(b->owner == owner && b->index == index) return b;
+    }
+
+    return NULL;
+}
+
+/**
+ * Read a block of a file into an unused or the least recently used block
+ * @param file_p    the file to read
+ * @param bc        the shared blocks
+ * @param index     index of the block in the file
+ * @param res       store the result of the driver here
+ * @return          the read block or NULL on error
+ */
+static block_t * block_load(const lv_fs_file_t * file_p, lv_fs_block_cache_t * bc, uint32_t index,
+                            lv_fs_res_t * res)
+{
+    block_t * b = &bc->blocks[0];
+    uint32_t i;
+    for(i = 0; i < bc->block_cnt; i++) {
+        if(bc->blocks[i].owner == NULL) {
+            b = &bc->blocks[i];
+            break;
+        }
+        if(bc->blocks[i].life < b->life) b = &bc->blocks[i];
+    }
+
+    b->owner = NULL;
+    b->prefetched = false;
+
+    lv_fs_drv_t * drv = file_p->drv;
+    uint32_t br = 0;
+    *res = drv->seek_cb(drv, file_p->file_d, index * bc->block_size, LV_FS_SEEK_SET);
+    if(*res == LV_FS_RES_OK) *res = drv->read_cb(drv, file_p->file_d, b->data, bc->block_size, &br);
+    bc->monitor.read_cnt++;
+    if(*res != LV_FS_RES_OK) return NULL;
+
+    b->owner = file_p->cache;
+    b->index = index;
+    b->len = br;
+    b->life = ++bc->life_cnt;
+    return b;
+}
+
+/**
+ * Mark the blocks of a file unused
+ * @param bc        the shared blocks
+ * @param owner     the file
+ */
+static void block_drop(lv_fs_block_cache_t * bc, const lv_fs_file_cache_t * owner)
+{
+    uint32_t i;
+    for(i = 0; i < bc->block_cnt; i++) {
+        if(bc->blocks[i].owner == owner) {
+            bc->blocks[i].owner = NULL;
+            bc->blocks[i].life = 0;
+        }
+    }
+}
+
+/**
+ * Detect sequential reading when a block of a file is read
+ * @param bc        the shared blocks
+ * @param fc        the cache data of the file
+ * @param index     index of the read block
+ */
+static void seq_update(lv_fs_block_cache_t * bc, lv_fs_file_cache_t * fc, uint32_t index)
+{
+    if(index == fc->last_block) return;
+
+    if(index == fc->last_block + 1) {
+        fc->seq_cnt++;
+
+        /*A streamed block is unlikely to be read again, so replace it first instead of the blocks of other files*/
+        if(fc->seq_cnt >= SEQ_MIN_CNT) {
+            block_t * prev = block_find(bc, fc, fc->last_block);
+            if(prev) prev->life = 0;
+        }
+    }
+    else {
+        fc->seq_cnt = 0;
+    }
+
+    fc->last_block = index;
+}
+
+#if USE_PREFETCH
+
+static void cache_lock(void)
+{
+    /*The mutex is created by the calling thread before the prefetch thread is started*/
+    if(!mutex_ready) mutex_ready = mutex_init(&cache_mutex);
+    if(mutex_ready) mutex_lock(&cache_mutex);
+}
+
+static void cache_unlock(void)
+{
+    if(mutex_ready) mutex_unlock(&cache_mutex);
+}
+
+/**
+ * Ask the prefetch thread to read a block of a file
+ * @param file_p    the file
+ * @param bc        the shared blocks
+ * @param index     index of the block to read
+ */
+static void prefetch_request(const lv_fs_file_t * file_p, lv_fs_block_cache_t * bc, uint32_t index)
+{
+    if(block_find(bc, file_p->cache, index)) return;
+
+    uint32_t i;
+    for(i = 0; i < prefetch_req_cnt; i++) {
+        if(prefetch_reqs[i].file.cache == file_p->cache && prefetch_reqs[i].index == index) return;
+    }
+
+    if(!prefetch_start()) return;
+
+    /*Drop the oldest request if the queue is full*/
+    if(prefetch_req_cnt == PREFETCH_QUEUE_LEN) {
+        lv_memcpy(&prefetch_reqs[0], &prefetch_reqs[1], sizeof(prefetch_req_t) * (PREFETCH_QUEUE_LEN - 1));
+        prefetch_req_cnt--;
+    }
+
+    prefetch_reqs[prefetch_req_cnt].file = *file_p;
+    prefetch_reqs[prefetch_req_cnt].index = index;
+    prefetch_req_cnt++;
+    sem_give(&prefetch_sem);
+}
+
+/**
+ * Remove the requests of a file or a driver from the queue
+ * @param drv       the driver of the files
+ * @param owner     the file or NULL to remove all the requests of the driver
+ */
+static void prefetch_cancel(const lv_fs_drv_t * drv, const lv_fs_file_cache_t * owner)
+{
+    uint32_t i;
+    uint32_t cnt = 0;
+    for(i = 0; i < prefetch_req_cnt; i++) {
+        const lv_fs_file_t * f = &prefetch_reqs[i].file;
+        if(f->drv == drv && (owner == NULL || f->cache == owner)) continue;
+        prefetch_reqs[cnt] = prefetch_reqs[i];
+        cnt++;
+    }
+    prefetch_req_cnt = cnt;
+}
+
+static bool prefetch_start(void)
+{
+    if(prefetch_running) return true;
+    if(prefetch_failed || !mutex_ready) return false;
+
+    if(!sem_init(&prefetch_sem)) {
+        prefetch_failed = true;
+        return false;
+    }
+
+    if(!thread_create()) {
+        LV_LOG_WARN("Couldn't start the prefetch thread, reading the blocks when needed");
+        sem_deinit(&prefetch_sem);
+        prefetch_failed = true;
+        return false;
+    }
+
+    prefetch_running = true;
+    return true;
+}
+
+static void prefetch_run(void)
+{
+    while(1) {
+        sem_take(&prefetch_sem);
+        if(prefetch_quit) break;
+
+        /*The driver is called with the lock held, so the file is never accessed by two threads at once*/
+        mutex_lock(&cache_mutex);
+        if(prefetch_req_cnt > 0) {
+            prefetch_req_t req = prefetch_reqs[0];
+            prefetch_req_cnt--;
+            lv_memcpy(&prefetch_reqs[0], &prefetch_reqs[1], sizeof(prefetch_req_t) * prefetch_req_cnt);
+
+            lv_fs_block_cache_t * bc = req.file.drv->block_cache;
+            if(bc && block_find(bc, req.file.cache, req.index) == NULL) {
+                lv_fs_res_t res;
+                block_t * b = block_load(&req.file, bc, req.index, &res);
+                if(b) {
+                    b->prefetched = true;
+                    bc->monitor.prefetch_cnt++;
+                }
+            }
+        }
+        mutex_unlock(&cache_mutex);
+    }
+}
+
+#if LV_FS_CACHE_PREFETCH_FREERTOS
+
+static sync_sem_t join_sem;
+
+static void prefetch_task(void * p)
+{
+    LV_UNUSED(p);
+    prefetch_run();
+
+    /*Tell `thread_join` that the task is done*/
+    xSemaphoreGive(join_sem);
+    vTaskDelete(NULL);
+}
+
+static bool sem_init(sync_sem_t * sem)
+{
+    *sem = xSemaphoreCreateCounting(PREFETCH_QUEUE_LEN + 1, 0);
+    return *sem != NULL;
+}
+
+static void sem_deinit(sync_sem_t * sem)
+{
+    vSemaphoreDelete(*sem);
+}
+
+static void sem_give(sync_sem_t * sem)
+{
+    xSemaphoreGive(*sem);
+}
+
+static void sem_take(sync_sem_t * sem)
+{
+    xSemaphoreTake(*sem, portMAX_DELAY);
+}
+
+static bool mutex_init(sync_mutex_t * mutex)
+{
+    *mutex = xSemaphoreCreateMutex();
+    return *mutex != NULL;
+}
+
+static void mutex_deinit(sync_mutex_t * mutex)
+{
+    vSemaphoreDelete(*mutex);
+}
+
+static void mutex_lock(sync_mutex_t * mutex)
+{
+    xSemaphoreTake(*mutex, portMAX_DELAY);
+}
+
+static void mutex_unlock(sync_mutex_t * mutex)
+{
+    xSemaphoreGive(*mutex);
+}
+
+static bool thread_create(void)
+{
+    if(!sem_init(&join_sem)) return false;
+    if(xTaskCreate(prefetch_task, "lv_fs_prefetch", TASK_STACK_DEPTH, NULL, LV_FS_CACHE_PREFETCH_PRIO,
+                   &prefetch_thread) != pdPASS) {
+        sem_deinit(&join_sem);
+        return false;
+    }
+    return true;
+}
+
+static void thread_join(void)
+{
+    xSemaphoreTake(join_sem, portMAX_DELAY);
+    sem_deinit(&join_sem);
+}
+
+#else
+
+static void * prefetch_thread_run(void * p)
+{
+    LV_UNUSED(p);
+    prefetch_run();
+    return NULL;
+}
+
+static bool sem_init(sync_sem_t * sem)
+{
+    sem->cnt = 0;
+    if(pthread_mutex_init(&sem->mutex, NULL) != 0) return false;
+    if(pthread_cond_init(&sem->cond, NULL) != 0) {
+        pthread_mutex_destroy(&sem->mutex);
+        return false;
+    }
+    return true;
+}
+
+static void sem_deinit(sync_sem_t * sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->mutex);
+}
+
+static void sem_give(sync_sem_t * sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    sem->cnt++;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+static void sem_take(sync_sem_t * sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    while(sem->cnt == 0) pthread_cond_wait(&sem->cond, &sem->mutex);
+    sem->cnt--;
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+static bool mutex_init(sync_mutex_t * mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0;
+}
+
+static void mutex_deinit(sync_mutex_t * mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+static void mutex_lock(sync_mutex_t * mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+static void mutex_unlock(sync_mutex_t * mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+static bool thread_create(void)
+{
+    pthread_attr_t attr;
+    if(pthread_attr_init(&attr) != 0) return false;
+    size_t stack_size = LV_FS_CACHE_PREFETCH_STACK_SIZE;
+#ifdef PTHREAD_STACK_MIN
+    if(stack_size < (size_t)PTHREAD_STACK_MIN) stack_size = (size_t)PTHREAD_STACK_MIN;
+#endif
+    pthread_attr_setstacksize(&attr, stack_size);
+    bool ok = pthread_create(&prefetch_thread, &attr, prefetch_thread_run, NULL) == 0;
+    pthread_attr_destroy(&attr);
+    return ok;
+}
+
+static void thread_join(void)
+{
+    pthread_join(prefetch_thread, NULL);
+}
+
+#endif /*LV_FS_CACHE_PREFETCH_FREERTOS*/
+
+#else
+
+static void cache_lock(void)
+{
+    /*Only the calling thread accesses the blocks*/
+}
+
+static void cache_unlock(void)
+{
+}
+
+#endif /*USE_PREFETCH*/
@@ -0,0 +1,77 @@
+/**
+ * @file lv_fs_cache.h
+ * Blocks of the files shared by the open files of a driver
+ */
+
+#ifndef LV_FS_CACHE_H
+#define LV_FS_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Read from a file opened with shared blocks (`file_p->cache->shared`)
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param buf       pointer to a buffer where the read bytes are stored
+ * @param btr       Bytes To Read
+ * @param br        store the number of read bytes here
+ * @return          LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t _lv_fs_cache_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br);
+
+/**
+ * Write into a file opened with shared blocks and drop its cached blocks
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param buf       pointer to a buffer with the bytes to write
+ * @param btw       Bytes To Write
+ * @param bw        store the number of written bytes here
+ * @return          LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t _lv_fs_cache_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+
+/**
+ * Move the position of a file opened with shared blocks relative to the end of the file
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param pos       the position relative to the end of the file
+ * @return          LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t _lv_fs_cache_seek_end(lv_fs_file_t * file_p, uint32_t pos);
+
+/**
+ * Drop the blocks of a file before it's closed. The prefetch thread won't access the file after it.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ */
+void _lv_fs_cache_detach(lv_fs_file_t * file_p);
+
+/**
+ * Stop the prefetch thread
+ */
+void _lv_fs_cache_deinit(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FS_CACHE_H*/
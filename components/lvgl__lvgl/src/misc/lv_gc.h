@@ -19,6 +19,7 @@ extern "C" {
 #include "lv_ll.h"
 #include "lv_timer.h"
 #include "lv_types.h"
+#include "lv_lru.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
 #include "../core/lv_obj_pos.h"
@@ -32,6 +33,12 @@ extern "C" {
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_MEM_BUF_ARENA_SIZE
+#    define LV_MEM_BUF_ARENA            1
+#else
+#    define LV_MEM_BUF_ARENA            0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -50,16 +57,22 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_img_cache_ll, LV_IMG_CACHE_DEF, 1)                                 \
+    LV_DISPATCH_COND(f, _lv_img_cache_entry_t**, _lv_img_cache_buckets, LV_IMG_CACHE_DEF, 1)           \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
+    LV_DISPATCH(f, lv_timer_t**, _lv_timer_heap) /*Running lv_timers ordered by their next run*/       \
+    LV_DISPATCH_COND(f, LV_DRAW_SW_THREAD_LOCAL lv_mem_buf_arr_t , lv_mem_buf, LV_MEM_BUF_ARENA, 0)    \
+    LV_DISPATCH_COND(f, LV_DRAW_SW_THREAD_LOCAL lv_mem_buf_arena_t , lv_mem_buf_arena, LV_MEM_BUF_ARENA, 1)    \
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH_COND(f, LV_DRAW_SW_THREAD_LOCAL _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)    \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
     LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
-    LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
+    LV_DISPATCH_COND(f, lv_lru_t *, _lv_font_bitmap_cache, LV_USE_FONT_COMPRESSED, 1)                   \
+    LV_DISPATCH(f, lv_lru_t *, _lv_text_cache)                                                         \
+    LV_DISPATCH(f, lv_lru_t *, _lv_shadow_cache)                                                       \
+    LV_DISPATCH(f, lv_lru_t *, _lv_grad_cache)                                                         \
     LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
@@ -21,6 +21,14 @@
     #include LV_MEM_POOL_INCLUDE
 #endif
 
+#if LV_MEM_EXT_CUSTOM != 0
+    #include LV_MEM_EXT_CUSTOM_INCLUDE
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE && LV_MEM_BUF_ARENA_CUSTOM
+    #include LV_MEM_BUF_ARENA_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -39,10 +47,18 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#define MEM_BUF_NONE       UINT32_MAX   /*`last` of an empty arena*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Precedes every buffer in the arena*/
+typedef struct {
+    uint32_t prev;      /*Offset of the header of the buffer below this one*/
+    uint32_t used;
+} mem_buf_header_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -50,6 +66,11 @@
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
 
+#if LV_MEM_BUF_ARENA_SIZE
+    static void * mem_buf_arena_get(uint32_t size);
+    static void mem_buf_arena_release(void * p);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -216,6 +237,44 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     return new_p;
 }
 
+/**
+ * Allocate memory for a large, long lived cache. It's allocated with `LV_MEM_EXT_CUSTOM_ALLOC`
+ * (e.g. from external RAM) if `LV_MEM_EXT_CUSTOM` is enabled, else with `lv_mem_alloc()`.
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL on failure
+ */
+void * lv_mem_ext_alloc(size_t size)
+{
+#if LV_MEM_EXT_CUSTOM == 0
+    return lv_mem_alloc(size);
+#else
+    MEM_TRACE("allocating %lu bytes of external memory", (unsigned long)size);
+    if(size == 0) return &zero_mem;
+
+    void * alloc = LV_MEM_EXT_CUSTOM_ALLOC(size);
+    if(alloc == NULL) LV_LOG_INFO("couldn't allocate external memory (%lu bytes)", (unsigned long)size);
+    else MEM_TRACE("allocated at %p", alloc);
+    return alloc;
+#endif
+}
+
+/**
+ * Free a memory allocated with `lv_mem_ext_alloc()`
+ * @param data pointer to the memory to free
+ */
+void lv_mem_ext_free(void * data)
+{
+#if LV_MEM_EXT_CUSTOM == 0
+    lv_mem_free(data);
+#else
+    MEM_TRACE("freeing %p of external memory", data);
+    if(data == &zero_mem) return;
+    if(data == NULL) return;
+
+    LV_MEM_EXT_CUSTOM_FREE(data);
+#endif
+}
+
 lv_res_t lv_mem_test(void)
 {
     if(zero_mem != ZERO_MEM_SENTINEL) {
@@ -269,6 +328,28 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 }
 
 
+/**
+ * Allocate the arena of the temporary buffers for the calling thread if `LV_MEM_BUF_ARENA_SIZE > 0`.
+ * Called by `lv_init()` and the drawing threads, else it's allocated when a buffer is needed first.
+ */
+void lv_mem_buf_init(void)
+{
+#if LV_MEM_BUF_ARENA_SIZE
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf_arena);
+    if(arena->mem) return;
+
+    /*Allocated only once and kept to not call the heap while drawing*/
+#if LV_MEM_BUF_ARENA_CUSTOM
+    arena->mem = LV_MEM_BUF_ARENA_CUSTOM_ALLOC(LV_MEM_BUF_ARENA_SIZE);
+#else
+    arena->mem = lv_mem_alloc(LV_MEM_BUF_ARENA_SIZE);
+#endif
+    LV_ASSERT_MALLOC(arena->mem);
+    arena->top = 0;
+    arena->last = MEM_BUF_NONE;
+#endif
+}
+
 /**
  * Get a temporal buffer with the given size.
  * @param size the required size
@@ -279,6 +360,9 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
+#if LV_MEM_BUF_ARENA_SIZE
+    return mem_buf_arena_get(size);
+#else
     /*Try to find a free buffer with suitable size*/
     int8_t i_guess = -1;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
@@ -323,6 +407,7 @@ void * lv_mem_buf_get(uint32_t size)
     LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
     LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
     return NULL;
+#endif
 }
 
 /**
@@ -333,6 +418,9 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
+#if LV_MEM_BUF_ARENA_SIZE
+    mem_buf_arena_release(p);
+#else
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
             LV_GC_ROOT(lv_mem_buf[i]).used = 0;
@@ -341,13 +429,23 @@ void lv_mem_buf_release(void * p)
     }
 
     LV_LOG_ERROR("p is not a known buffer");
+#endif
 }
 
 /**
- * Free all memory buffers
+ * Free all memory buffers.
+ * With `LV_MEM_BUF_ARENA_SIZE > 0` the arena is only emptied to reuse its memory in the next frame.
  */
 void lv_mem_buf_free_all(void)
 {
+#if LV_MEM_BUF_ARENA_SIZE
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf_arena);
+    arena->top = 0;
+    arena->last = MEM_BUF_NONE;
+    arena->frame_peak = arena->peak;
+    arena->max_peak = LV_MAX(arena->max_peak, arena->peak);
+    arena->peak = 0;
+#else
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p) {
             lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
@@ -356,7 +454,41 @@ void lv_mem_buf_free_all(void)
             LV_GC_ROOT(lv_mem_buf[i]).size = 0;
         }
     }
+#endif
+}
+
+/**
+ * Free all the memory of the temporary buffers, including the arena of the calling thread.
+ */
+void lv_mem_buf_deinit(void)
+{
+#if LV_MEM_BUF_ARENA_SIZE
+#if LV_MEM_BUF_ARENA_CUSTOM
+    if(LV_GC_ROOT(lv_mem_buf_arena).mem) LV_MEM_BUF_ARENA_CUSTOM_FREE(LV_GC_ROOT(lv_mem_buf_arena).mem);
+#else
+    lv_mem_free(LV_GC_ROOT(lv_mem_buf_arena).mem);
+#endif
+    lv_memset_00(&LV_GC_ROOT(lv_mem_buf_arena), sizeof(lv_mem_buf_arena_t));
+#else
+    lv_mem_buf_free_all();
+#endif
+}
+
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Get the usage of the temporary buffer arena of the calling thread
+ * @param mon_p pointer to a `lv_mem_buf_monitor_t` variable to store the result
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p)
+{
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf_arena);
+    mon_p->size = LV_MEM_BUF_ARENA_SIZE;
+    mon_p->used = arena->top;
+    mon_p->frame_peak = arena->frame_peak;
+    mon_p->max_peak = LV_MAX(arena->max_peak, arena->peak);
+    mon_p->overflow_cnt = arena->overflow_cnt;
 }
+#endif
 
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
@@ -564,3 +696,68 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Stack a buffer on the top of the arena
+ * @param size the required size
+ * @return pointer to the buffer or NULL if it doesn't fit
+ */
+static void * mem_buf_arena_get(uint32_t size)
+{
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf_arena);
+    if(arena->mem == NULL) {
+        lv_mem_buf_init();
+        if(arena->mem == NULL) return NULL;
+    }
+
+    uint32_t free_size = LV_MEM_BUF_ARENA_SIZE - arena->top;
+    uint32_t buf_size = UINT32_MAX;
+    if(size <= free_size) buf_size = ((size + ALIGN_MASK) & ~ALIGN_MASK) + sizeof(mem_buf_header_t);
+    if(buf_size > free_size) {
+        arena->overflow_cnt++;
+        LV_LOG_ERROR("%d bytes don't fit into the arena, %d bytes are in use. (increase LV_MEM_BUF_ARENA_SIZE)",
+                     (int)size, (int)arena->top);
+        LV_ASSERT_MSG(false, "The arena is full. Increase LV_MEM_BUF_ARENA_SIZE.");
+        return NULL;
+    }
+
+    mem_buf_header_t * header = (mem_buf_header_t *)&arena->mem[arena->top];
+    header->prev = arena->last;
+    header->used = 1;
+    arena->last = arena->top;
+    arena->top += buf_size;
+    arena->peak = LV_MAX(arena->peak, arena->top);
+
+    MEM_TRACE("stacked at %d", (int)arena->last);
+    return header + 1;
+}
+
+/**
+ * Release a buffer of the arena. The memory of the released buffers on the top of the arena is reused.
+ * @param p pointer to the buffer
+ */
+static void mem_buf_arena_release(void * p)
+{
+    /*Like with the buffer pool releasing NULL is ignored*/
+    if(p == NULL) return;
+
+    lv_mem_buf_arena_t * arena = &LV_GC_ROOT(lv_mem_buf_arena);
+    uint8_t * p8 = p;
+    if(arena->mem == NULL || p8 < arena->mem + sizeof(mem_buf_header_t) || p8 >= arena->mem + arena->top) {
+        LV_LOG_ERROR("p is not a known buffer");
+        return;
+    }
+
+    mem_buf_header_t * header = (mem_buf_header_t *)p - 1;
+    header->used = 0;
+
+    /*The buffers are usually released in reverse order, but if not, wait for the ones above*/
+    while(arena->last != MEM_BUF_NONE) {
+        header = (mem_buf_header_t *)&arena->mem[arena->last];
+        if(header->used) break;
+        arena->top = arena->last;
+        arena->last = header->prev;
+    }
+}
+#endif
@@ -51,6 +51,30 @@ typedef struct {
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+/**
+ * Arena the temporary buffers are stacked in if `LV_MEM_BUF_ARENA_SIZE > 0`
+ */
+typedef struct {
+    uint8_t * mem;          /**< `LV_MEM_BUF_ARENA_SIZE` bytes, allocated on the first use*/
+    uint32_t top;           /**< Offset of the first free byte*/
+    uint32_t last;          /**< Offset of the header of the topmost buffer*/
+    uint32_t peak;          /**< Highest `top` since the arena was emptied*/
+    uint32_t frame_peak;    /**< `peak` when the arena was emptied last time*/
+    uint32_t max_peak;      /**< Highest `peak` ever*/
+    uint32_t overflow_cnt;
+} lv_mem_buf_arena_t;
+
+/**
+ * Usage of the temporary buffer arena
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the arena*/
+    uint32_t used;          /**< Bytes used by the buffers in use now*/
+    uint32_t frame_peak;    /**< Most bytes used during the last frame*/
+    uint32_t max_peak;      /**< Most bytes used during any frame*/
+    uint32_t overflow_cnt;  /**< Number of requests which didn't fit into the arena*/
+} lv_mem_buf_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -88,6 +112,20 @@ void lv_mem_free(void * data);
  */
 void * lv_mem_realloc(void * data_p, size_t new_size);
 
+/**
+ * Allocate memory for a large, long lived cache. It's allocated with `LV_MEM_EXT_CUSTOM_ALLOC`
+ * (e.g. from external RAM) if `LV_MEM_EXT_CUSTOM` is enabled, else with `lv_mem_alloc()`.
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL on failure
+ */
+void * lv_mem_ext_alloc(size_t size);
+
+/**
+ * Free a memory allocated with `lv_mem_ext_alloc()`
+ * @param data pointer to the memory to free
+ */
+void lv_mem_ext_free(void * data);
+
 /**
  *
  * @return
@@ -102,6 +140,12 @@ lv_res_t lv_mem_test(void);
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
 
+/**
+ * Allocate the arena of the temporary buffers for the calling thread if `LV_MEM_BUF_ARENA_SIZE > 0`.
+ * Called by `lv_init()` and the drawing threads, else it's allocated when a buffer is needed first.
+ */
+void lv_mem_buf_init(void);
+
 /**
  * Get a temporal buffer with the given size.
  * @param size the required size
@@ -115,10 +159,24 @@ void * lv_mem_buf_get(uint32_t size);
 void lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Free all memory buffers.
+ * With `LV_MEM_BUF_ARENA_SIZE > 0` the arena is only emptied to reuse its memory in the next frame.
  */
 void lv_mem_buf_free_all(void);
 
+/**
+ * Free all the memory of the temporary buffers, including the arena of the calling thread.
+ */
+void lv_mem_buf_deinit(void);
+
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Get the usage of the temporary buffer arena of the calling thread
+ * @param mon_p pointer to a `lv_mem_buf_monitor_t` variable to store the result
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p);
+#endif
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -5,6 +5,7 @@ CSRCS += lv_async.c
 CSRCS += lv_bidi.c
 CSRCS += lv_color.c
 CSRCS += lv_fs.c
+CSRCS += lv_fs_cache.c
 CSRCS += lv_gc.c
 CSRCS += lv_ll.c
 CSRCS += lv_log.c
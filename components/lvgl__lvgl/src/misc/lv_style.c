@@ -139,6 +139,7 @@ uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
 static uint16_t last_custom_prop_id = (uint16_t)_LV_STYLE_LAST_BUILT_IN_PROP;
 static const lv_style_value_t null_style_value = { .num = 0 };
+static uint32_t style_version;
 
 /**********************
  *      MACROS
@@ -157,6 +158,7 @@ void lv_style_init(lv_style_t * style)
 #endif
 
     lv_memset_00(style, sizeof(lv_style_t));
+    style->version = ++style_version;
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
@@ -173,6 +175,7 @@ void lv_style_reset(lv_style_t * style)
 
     if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
     lv_memset_00(style, sizeof(lv_style_t));
+    style->version = ++style_version;
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
@@ -230,6 +233,8 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+    style->version = ++style_version;
+
     if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
@@ -393,6 +398,11 @@ uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop)
     return 0;
 }
 
+uint32_t _lv_style_get_version(const lv_style_t * style)
+{
+    return style->version;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -422,6 +432,8 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    style->version = ++style_version;
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
@@ -333,6 +333,7 @@ typedef struct {
     uint16_t prop1;
     uint8_t has_group;
     uint8_t prop_cnt;
+    uint32_t version;   /*See `_lv_style_get_version()`*/
 } lv_style_t;
 
 /**********************
@@ -519,6 +520,15 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop);
  */
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop);
 
+/**
+ * Get the version of a style. It's set from a global counter when the style is initialized, reset or when a property
+ * is set or removed in it, so the style changed last has the highest version.
+ * Caches of resolved style properties can compare it to see if a style has changed since they were filled.
+ * @param style pointer to a style
+ * @return the version of the style. 0 for constant styles.
+ */
+uint32_t _lv_style_get_version(const lv_style_t * style);
+
 #include "lv_style_gen.h"
 
 static inline void lv_style_set_size(lv_style_t * style, lv_coord_t value)
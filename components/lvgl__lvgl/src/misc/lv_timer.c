@@ -17,6 +17,7 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_MIN_CAPACITY 16
 
 /**********************
  *      TYPEDEFS
@@ -25,16 +26,23 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static bool timer_runs_before(const lv_timer_t * a, const lv_timer_t * b);
+static bool heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static uint32_t heap_size;
+static uint32_t heap_capacity;
+static uint32_t handler_run;
 
 /**********************
  *      MACROS
@@ -55,6 +63,10 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+    heap_size = 0;
+    heap_capacity = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,39 +107,23 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
+    /*Run the ready timers in the order of their due time. The running timers are kept in a min-heap,
+     *so only the ready ones need to be visited.
+     *A timer which has already run in this call is sorted after the others with the same due time.
+     *So if it's on the top again, every timer that was ready has run and it's time to stop.*/
+    handler_run++;
+    while(heap_size > 0) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(timer->handler_run == handler_run) break;
+        if(timer->repeat_count != 0 && lv_timer_time_remaining(timer) > 0) break;
+
+        lv_timer_exec(timer);
+    }
 
     uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    if(heap_size > 0) {
+        lv_timer_t * next = LV_GC_ROOT(_lv_timer_heap)[0];
+        time_till_next = next->repeat_count == 0 ? 0 : lv_timer_time_remaining(next);
     }
 
     busy_time += lv_tick_elaps(handler_start);
@@ -178,8 +174,14 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->heap_index = 0;
+    new_timer->handler_run = handler_run - 1;
 
-    timer_created = true;
+    if(!heap_insert(new_timer)) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), new_timer);
+        lv_mem_free(new_timer);
+        return NULL;
+    }
 
     return new_timer;
 }
@@ -200,8 +202,11 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+
+    /*Let the handler know if the running timer is deleted by its callback*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
 }
@@ -213,11 +218,16 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     timer->paused = false;
+    if(timer->heap_index == 0) {
+        /*Growing the heap might fail. Then the timer stays paused to not get lost.*/
+        if(!heap_insert(timer)) timer->paused = true;
+    }
 }
 
 /**
@@ -228,6 +238,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_update(timer);
 }
 
 /**
@@ -237,6 +248,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 /**
@@ -247,6 +259,7 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+    heap_update(timer);
 }
 
 /**
@@ -257,6 +270,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_update(timer);
 }
 
 /**
@@ -293,37 +307,34 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a ready timer and delete it if its repeat count is over
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted by its callback `if(timer->repeat_count == 0)` is not executed below.*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->handler_run = handler_run;
+
+    /*Move it to its next place in the heap before the callback might change the timers*/
+    heap_update(timer);
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    LV_GC_ROOT(_lv_timer_act) = timer;
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
+
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself as well*/
+        LV_GC_ROOT(_lv_timer_act) = NULL;
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
     }
-
-    return exec;
 }
 
 /**
@@ -339,3 +350,119 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Decide which timer has to run first.
+ * Timers whose repeat count is over come first to be deleted as soon as possible.
+ * Then the earlier due time wins. The due times are compared as a signed difference
+ * to handle the overflow of the tick, so it works with periods below 2^31 ms.
+ * On equal due time the timer which hasn't run for more `lv_timer_handler` calls comes first.
+ * @param a pointer to a timer
+ * @param b pointer to an other timer
+ * @return true if `a` has to run before `b`
+ */
+static bool timer_runs_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    if((a->repeat_count == 0) != (b->repeat_count == 0)) return a->repeat_count == 0;
+
+    int32_t due_diff = (int32_t)((a->last_run + a->period) - (b->last_run + b->period));
+    if(due_diff != 0) return due_diff < 0;
+
+    return (int32_t)(a->handler_run - b->handler_run) < 0;
+}
+
+/**
+ * Add a timer to the heap of the running timers
+ * @param timer pointer to a timer which is not in the heap
+ * @return false if the heap couldn't grow
+ */
+static bool heap_insert(lv_timer_t * timer)
+{
+    if(heap_size == heap_capacity) {
+        uint32_t new_capacity = heap_capacity == 0 ? HEAP_MIN_CAPACITY : heap_capacity * 2;
+        lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_capacity * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return false;
+
+        LV_GC_ROOT(_lv_timer_heap) = new_heap;
+        heap_capacity = new_capacity;
+    }
+
+    LV_GC_ROOT(_lv_timer_heap)[heap_size] = timer;
+    heap_size++;
+    timer->heap_index = heap_size;
+    heap_sift_up(heap_size - 1);
+
+    return true;
+}
+
+/**
+ * Remove a timer from the heap if it's there
+ * @param timer pointer to a timer
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    if(timer->heap_index == 0) return;
+
+    uint32_t i = timer->heap_index - 1;
+    timer->heap_index = 0;
+    heap_size--;
+    if(i == heap_size) return;
+
+    /*Fill the gap with the last timer and move it up or down to its place*/
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    heap[i] = heap[heap_size];
+    heap[i]->heap_index = i + 1;
+    heap_sift_up(i);
+    heap_sift_down(heap[i]->heap_index - 1);
+}
+
+/**
+ * Restore the order of the heap after the due time of a timer has changed
+ * @param timer pointer to a timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    if(timer->heap_index == 0) return;
+
+    heap_sift_up(timer->heap_index - 1);
+    heap_sift_down(timer->heap_index - 1);
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!timer_runs_before(timer, heap[parent])) break;
+
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i + 1;
+        i = parent;
+    }
+
+    heap[i] = timer;
+    timer->heap_index = i + 1;
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+
+    while(1) {
+        uint32_t child = i * 2 + 1;
+        if(child >= heap_size) break;
+        if(child + 1 < heap_size && timer_runs_before(heap[child + 1], heap[child])) child++;
+        if(!timer_runs_before(heap[child], timer)) break;
+
+        heap[i] = heap[child];
+        heap[i]->heap_index = i + 1;
+        i = child;
+    }
+
+    heap[i] = timer;
+    timer->heap_index = i + 1;
+}
@@ -48,6 +48,8 @@ typedef struct _lv_timer_t {
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
+    uint32_t heap_index; /**< Position in the timer heap + 1, 0 if not scheduled. Internal.*/
+    uint32_t handler_run; /**< The `lv_timer_handler` call in which it ran last. Internal.*/
 } lv_timer_t;
 
 /**********************
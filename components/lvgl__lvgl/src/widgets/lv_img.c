@@ -12,6 +12,7 @@
 #include "../core/lv_disp.h"
 #include "../misc/lv_assert.h"
 #include "../draw/lv_img_decoder.h"
+#include "../draw/sw/lv_draw_sw_thread.h"
 #include "../misc/lv_fs.h"
 #include "../misc/lv_txt.h"
 #include "../misc/lv_math.h"
@@ -598,14 +599,26 @@ static void draw_img(lv_event_t * e)
             bg_coords.y2 += obj->coords.y1;
         }
 
-        lv_area_t ori_coords;
-        lv_area_copy(&ori_coords, &obj->coords);
-        lv_area_copy(&obj->coords, &bg_coords);
+#if LV_DRAW_SW_THREAD_CNT > 1
+        /*Other threads might draw this image too, so don't change its coordinates*/
+        if(lv_draw_sw_thread_is_active()) {
+            _lv_obj_set_draw_coords(obj, &bg_coords);
+            lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+            _lv_obj_set_draw_coords(obj, NULL);
+            if(res != LV_RES_OK) return;
+        }
+        else
+#endif
+        {
+            lv_area_t ori_coords;
+            lv_area_copy(&ori_coords, &obj->coords);
+            lv_area_copy(&obj->coords, &bg_coords);
 
-        lv_res_t res = lv_obj_event_base(MY_CLASS, e);
-        if(res != LV_RES_OK) return;
+            lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+            if(res != LV_RES_OK) return;
 
-        lv_area_copy(&obj->coords, &ori_coords);
+            lv_area_copy(&obj->coords, &ori_coords);
+        }
 
         if(code == LV_EVENT_DRAW_MAIN) {
             if(img->h == 0 || img->w == 0) return;
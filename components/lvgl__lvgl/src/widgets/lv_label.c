@@ -12,6 +12,7 @@
 #include "../misc/lv_assert.h"
 #include "../core/lv_group.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw_thread.h"
 #include "../misc/lv_color.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_bidi.h"
@@ -835,6 +836,9 @@ static void draw_main(lv_event_t * e)
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
 
+    /*The bands of the label drawn by other threads would overwrite the hint*/
+    if(lv_draw_sw_thread_is_active()) hint = NULL;
+
 #else
     /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
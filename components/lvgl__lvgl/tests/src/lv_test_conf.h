@@ -34,6 +34,19 @@ uint32_t custom_tick_get(void);
 
 typedef void * lv_user_data_t;
 
+#if defined(LV_MEM_CUSTOM) && LV_MEM_CUSTOM
+#include <stddef.h>
+
+/*Count the heap calls to see if drawing needs any*/
+void * lv_test_malloc(size_t size);
+void * lv_test_realloc(void * p, size_t size);
+void lv_test_free(void * p);
+uint32_t lv_test_get_heap_call_cnt(void);
+#define LV_MEM_CUSTOM_ALLOC lv_test_malloc
+#define LV_MEM_CUSTOM_REALLOC lv_test_realloc
+#define LV_MEM_CUSTOM_FREE lv_test_free
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -1,6 +1,8 @@
 #ifndef LV_TEST_HELPERS_H
 #define LV_TEST_HELPERS_H
 
+#include <time.h>
+
 #ifdef LVGL_CI_USING_SYS_HEAP
 /* Skip checking heap as we don't have the info available */
 #define LV_HEAP_CHECK(x) do {} while(0)
@@ -17,6 +19,21 @@ static inline uint32_t lv_test_get_free_mem(void)
 }
 #endif /* LVGL_CI_USING_SYS_HEAP */
 
+/*Redraw the whole screen so that the test frame buffer holds everything*/
+static inline void lv_test_refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Monotonic time in [us] for the benchmarks*/
+static inline uint32_t lv_test_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
 
 #endif /*LV_TEST_HELPERS_H*/
 
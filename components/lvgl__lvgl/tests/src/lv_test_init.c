@@ -97,4 +97,32 @@ void lv_test_assert_fail(void)
     TEST_FAIL();
 }
 
+#if LV_MEM_CUSTOM
+/*Atomic as the drawing threads allocate too*/
+static uint32_t heap_call_cnt;
+
+void * lv_test_malloc(size_t size)
+{
+    __atomic_add_fetch(&heap_call_cnt, 1, __ATOMIC_RELAXED);
+    return malloc(size);
+}
+
+void * lv_test_realloc(void * p, size_t size)
+{
+    __atomic_add_fetch(&heap_call_cnt, 1, __ATOMIC_RELAXED);
+    return realloc(p, size);
+}
+
+void lv_test_free(void * p)
+{
+    __atomic_add_fetch(&heap_call_cnt, 1, __ATOMIC_RELAXED);
+    free(p);
+}
+
+uint32_t lv_test_get_heap_call_cnt(void)
+{
+    return __atomic_load_n(&heap_call_cnt, __ATOMIC_RELAXED);
+}
+#endif
+
 #endif
@@ -0,0 +1,168 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+/*Number of one second ticks to simulate per refresh mode*/
+#define TICK_CNT 60
+
+#if LV_FONT_MONTSERRAT_48
+#define TIME_FONT &lv_font_montserrat_48
+#else
+#define TIME_FONT LV_FONT_DEFAULT
+#endif
+
+static lv_color_t buf1[HOR_RES * VER_RES];
+static lv_color_t buf2[HOR_RES * VER_RES];
+static lv_color_t ref_buf[HOR_RES * VER_RES];
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static lv_disp_t * disp;
+static lv_disp_t * disp_orig;
+
+static lv_color_t * on_screen;
+static uint32_t px_sum;
+static uint32_t frame_cnt;
+
+static lv_obj_t * time_label;
+static lv_obj_t * sec_label;
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+
+    /*Remember which buffer is shown after the frame is complete*/
+    if(lv_disp_flush_is_last(drv)) on_screen = color_p;
+    lv_disp_flush_ready(drv);
+}
+
+static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(time);
+
+    px_sum += px;
+    frame_cnt++;
+}
+
+/*A clock face like the wallclock's: big hh:mm, seconds and a date line*/
+static void create_clock(lv_obj_t * scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x222244), 0);
+    lv_obj_set_style_text_color(scr, lv_color_hex(0xaaaaaa), 0);
+
+    time_label = lv_label_create(scr);
+    lv_obj_set_style_text_font(time_label, TIME_FONT, 0);
+    lv_label_set_text(time_label, "12:34");
+    lv_obj_set_pos(time_label, 32, 32);
+
+    sec_label = lv_label_create(scr);
+    lv_label_set_text(sec_label, "00");
+    lv_obj_align_to(sec_label, time_label, LV_ALIGN_OUT_RIGHT_BOTTOM, 24, 0);
+
+    lv_obj_t * date_label = lv_label_create(scr);
+    lv_label_set_text(date_label, "Saturday October 18, 2026");
+    lv_obj_align(date_label, LV_ALIGN_BOTTOM_RIGHT, -32, -32);
+}
+
+static void disp_create(bool direct_mode, bool full_refresh)
+{
+    lv_memset_00(buf1, sizeof(buf1));
+    lv_memset_00(buf2, sizeof(buf2));
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, HOR_RES * VER_RES);
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp_drv.direct_mode = direct_mode;
+    disp_drv.full_refresh = full_refresh;
+
+    disp_orig = lv_disp_get_default();
+    disp = lv_disp_drv_register(&disp_drv);
+    lv_disp_set_default(disp);
+
+    create_clock(lv_scr_act());
+    lv_refr_now(disp);
+
+    px_sum = 0;
+    frame_cnt = 0;
+}
+
+static void disp_delete(void)
+{
+    lv_disp_remove(disp);
+    lv_disp_set_default(disp_orig);
+
+    /*The draw context belongs to the driver, so it's not freed by `lv_disp_remove`*/
+    disp_drv.draw_ctx_deinit(&disp_drv, disp_drv.draw_ctx);
+    lv_mem_free(disp_drv.draw_ctx);
+    disp = NULL;
+}
+
+/*Advance the seconds once per "tick" and refresh. The minutes roll over once half way.
+ *Return the average rendered pixels per frame.*/
+static uint32_t run_ticks(void)
+{
+    uint32_t i;
+    for(i = 1; i <= TICK_CNT; i++) {
+        lv_label_set_text_fmt(sec_label, "%02"LV_PRIu32, i % 60);
+        if(i == TICK_CNT / 2) lv_label_set_text(time_label, "12:35");
+        lv_refr_now(disp);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(TICK_CNT, frame_cnt);
+    return px_sum / frame_cnt;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_direct_mode_renders_only_dirty_areas(void)
+{
+    disp_create(false, true);
+    uint32_t full_px = run_ticks();
+    disp_delete();
+
+    disp_create(true, false);
+    uint32_t direct_px = run_ticks();
+    disp_delete();
+
+    TEST_PRINTF("pixels rendered per frame: full_refresh %"LV_PRIu32", direct_mode %"LV_PRIu32" (%"LV_PRIu32"x fewer)",
+                full_px, direct_px, full_px / LV_MAX(direct_px, 1));
+
+    TEST_ASSERT_EQUAL_UINT32(HOR_RES * VER_RES, full_px);
+    /*A seconds tick has to cost less than 5% of a full refresh*/
+    TEST_ASSERT_LESS_THAN_UINT32(full_px / 20, direct_px);
+}
+
+void test_direct_mode_keeps_buffers_in_sync(void)
+{
+    /*Render the final state with full refresh as the reference*/
+    disp_create(false, true);
+    run_ticks();
+    lv_memcpy(ref_buf, on_screen, sizeof(ref_buf));
+    disp_delete();
+
+    /*The shown buffer has to match the reference even though only the dirty areas were rendered into it
+     *and the two buffers were alternating all the time*/
+    disp_create(true, false);
+    run_ticks();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, on_screen, sizeof(ref_buf));
+    disp_delete();
+}
+
+#endif
@@ -0,0 +1,177 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define LINE_LEN    200
+#define MASK_MAX    3
+#define RANDOM_CNT  5000
+
+#if LV_DRAW_COMPLEX
+typedef union {
+    lv_draw_mask_radius_param_t radius;
+    lv_draw_mask_angle_param_t angle;
+    lv_draw_mask_line_param_t line;
+    lv_draw_mask_fade_param_t fade;
+} mask_param_t;
+
+static mask_param_t params[MASK_MAX];
+static int16_t ids[MASK_MAX];
+static uint32_t mask_cnt;
+
+static void rand_area(lv_area_t * a)
+{
+    a->x1 = (lv_coord_t)lv_rand(0, LINE_LEN) - 20;
+    a->y1 = (lv_coord_t)lv_rand(0, 60) - 10;
+    a->x2 = (lv_coord_t)lv_rand(a->x1, a->x1 + LINE_LEN);
+    a->y2 = (lv_coord_t)lv_rand(a->y1, a->y1 + 60);
+}
+
+/*Rounded rectangles (the most common), their inverse (borders and arcs) and a few others*/
+static void add_rand_mask(void)
+{
+    mask_param_t * p = &params[mask_cnt];
+    lv_area_t a;
+    rand_area(&a);
+    switch(lv_rand(0, 5)) {
+        case 0:
+        case 1:
+            lv_draw_mask_radius_init(&p->radius, &a, (lv_coord_t)lv_rand(0, 40), false);
+            break;
+        case 2:
+            lv_draw_mask_radius_init(&p->radius, &a, (lv_coord_t)lv_rand(0, 40), true);
+            break;
+        case 3:
+            lv_draw_mask_angle_init(&p->angle, a.x1, a.y1, (lv_coord_t)lv_rand(0, 359), (lv_coord_t)lv_rand(0, 359));
+            break;
+        case 4:
+            lv_draw_mask_line_points_init(&p->line, a.x1, a.y1, a.x2, a.y2, lv_rand(0, 3));
+            break;
+        default:
+            lv_draw_mask_fade_init(&p->fade, &a, (lv_opa_t)lv_rand(0, 255), a.y1, (lv_opa_t)lv_rand(0, 255), a.y2);
+            break;
+    }
+    ids[mask_cnt] = lv_draw_mask_add(p, NULL);
+    mask_cnt++;
+}
+
+static void remove_masks(void)
+{
+    while(mask_cnt) {
+        mask_cnt--;
+        lv_draw_mask_remove_id(ids[mask_cnt]);
+        lv_draw_mask_free_param(&params[mask_cnt]);
+    }
+}
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+#if LV_DRAW_COMPLEX
+    remove_masks();
+#endif
+}
+
+void test_draw_mask_span_same_as_apply(void)
+{
+#if LV_DRAW_COMPLEX
+    static lv_opa_t ref_buf[LINE_LEN];
+    static lv_opa_t span_buf[LINE_LEN];
+    static lv_opa_t res_buf[LINE_LEN];
+    lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+
+    uint32_t i;
+    for(i = 0; i < RANDOM_CNT; i++) {
+        uint32_t cnt = lv_rand(1, MASK_MAX);
+        while(mask_cnt < cnt) add_rand_mask();
+
+        lv_coord_t abs_x = (lv_coord_t)lv_rand(0, LINE_LEN) - 40;
+        lv_coord_t abs_y = (lv_coord_t)lv_rand(0, 80) - 20;
+        lv_coord_t len = (lv_coord_t)lv_rand(1, LINE_LEN);
+        lv_opa_t opa = lv_rand(0, 1) ? LV_OPA_COVER : (lv_opa_t)lv_rand(LV_OPA_MIN, LV_OPA_COVER);
+
+        lv_memset(ref_buf, opa, len);
+        lv_draw_mask_res_t ref_res = lv_draw_mask_apply(ref_buf, abs_x, abs_y, len);
+        if(ref_res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(ref_buf, len);
+
+        /*The parts out of the spans can contain anything*/
+        lv_memset(span_buf, 0x5A, len);
+        uint32_t span_cnt = lv_draw_mask_apply_spans(span_buf, abs_x, abs_y, len, opa, spans);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_MASK_SPAN_MAX, span_cnt);
+
+        lv_memset_00(res_buf, len);
+        lv_coord_t x = 0;
+        uint32_t j;
+        for(j = 0; j < span_cnt; j++) {
+            TEST_ASSERT_GREATER_OR_EQUAL_INT32(x, spans[j].x);
+            TEST_ASSERT_GREATER_THAN_INT32(0, spans[j].len);
+            TEST_ASSERT_LESS_OR_EQUAL_INT32(len, spans[j].x + spans[j].len);
+            if(spans[j].res == LV_DRAW_MASK_RES_FULL_COVER) {
+                lv_memset(&res_buf[spans[j].x], opa, spans[j].len);
+            }
+            else {
+                TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, spans[j].res);
+                lv_memcpy(&res_buf[spans[j].x], &span_buf[spans[j].x], spans[j].len);
+            }
+            x = spans[j].x + spans[j].len;
+        }
+
+        lv_coord_t k;
+        for(k = 0; k < len; k++) {
+            if(ref_buf[k] != res_buf[k]) break;
+        }
+        if(k != len) {
+            TEST_PRINTF("differs at x=%d of a %d px long line at %d;%d with %"LV_PRIu32" masks: %d instead of %d",
+                        k, len, abs_x, abs_y, mask_cnt, res_buf[k], ref_buf[k]);
+        }
+        TEST_ASSERT_EQUAL_INT32(len, k);
+
+        /*Change some of the masks for the next round*/
+        if(lv_rand(0, 1)) remove_masks();
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_mask_span_rounded_rect(void)
+{
+#if LV_DRAW_COMPLEX
+    static lv_opa_t buf[LINE_LEN];
+    lv_draw_mask_span_t spans[LV_DRAW_MASK_SPAN_MAX];
+
+    lv_area_t a;
+    lv_area_set(&a, 10, 10, 109, 59);
+    lv_draw_mask_radius_init(&params[0].radius, &a, 20, false);
+    ids[0] = lv_draw_mask_add(&params[0], NULL);
+    mask_cnt = 1;
+
+    /*In the middle the whole rectangle is covered without calculating the mask*/
+    uint32_t span_cnt = lv_draw_mask_apply_spans(buf, 0, 35, LINE_LEN, LV_OPA_COVER, spans);
+    TEST_ASSERT_EQUAL_UINT32(1, span_cnt);
+    TEST_ASSERT_EQUAL_INT32(10, spans[0].x);
+    TEST_ASSERT_EQUAL_INT32(100, spans[0].len);
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_FULL_COVER, spans[0].res);
+
+    /*On the corners only the anti-aliased edges are calculated*/
+    span_cnt = lv_draw_mask_apply_spans(buf, 0, 15, LINE_LEN, LV_OPA_COVER, spans);
+    TEST_ASSERT_EQUAL_UINT32(3, span_cnt);
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, spans[0].res);
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_FULL_COVER, spans[1].res);
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, spans[2].res);
+    TEST_ASSERT_EQUAL_INT32(spans[0].x + spans[0].len, spans[1].x);
+    TEST_ASSERT_EQUAL_INT32(110, spans[2].x + spans[2].len + (spans[0].x - 10));   /*Symmetric*/
+
+    /*Out of the rectangle*/
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_mask_apply_spans(buf, 0, 5, LINE_LEN, LV_OPA_COVER, spans));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
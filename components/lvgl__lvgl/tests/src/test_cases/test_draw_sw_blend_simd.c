@@ -0,0 +1,253 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define BUF_W       160
+#define BUF_H       40
+#define BUF_SIZE    (BUF_W * BUF_H)
+
+#define RANDOM_CNT  3000
+#define MASK_EXT    9       /*Make the mask wider than the blended area by max. this many pixels per side*/
+
+#define BENCH_W     128
+#define BENCH_H     32
+#define BENCH_CNT   300
+
+#if LV_DRAW_SW_BLEND_SIMD
+static lv_color_t dest_buf[BUF_SIZE];
+static lv_color_t ref_buf[BUF_SIZE];
+static lv_color_t src_buf[BUF_SIZE];
+static lv_opa_t mask_buf[(BUF_W + 2 * MASK_EXT) * BUF_H];
+
+static lv_area_t buf_area;
+static lv_draw_ctx_t draw_ctx;
+
+/*The kernels expect 0xFF in the unused byte of 32 bit colors*/
+static lv_color_t rand_color(void)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 32
+    c.full = lv_rand(0, 0xFFFFFF) | 0xFF000000;
+#elif LV_COLOR_DEPTH == 16
+    c.full = (uint16_t)lv_rand(0, 0xFFFF);
+#else
+    c.full = (uint8_t)lv_rand(0, 0xFF);
+#endif
+    return c;
+}
+
+/*Mostly fully transparent and opaque runs, like the masks of texts and rounded corners*/
+static void fill_rand_mask(lv_opa_t * mask, uint32_t size)
+{
+    uint32_t i = 0;
+    while(i < size) {
+        uint32_t run = lv_rand(1, 20);
+        uint32_t type = lv_rand(0, 3);
+        for(; run > 0 && i < size; run--, i++) {
+            if(type == 0) mask[i] = LV_OPA_TRANSP;
+            else if(type == 1) mask[i] = LV_OPA_COVER;
+            else mask[i] = (lv_opa_t)lv_rand(0, 255);
+        }
+    }
+}
+
+static lv_opa_t rand_opa(void)
+{
+    /*Test around the limits where the C implementation takes other paths*/
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_MAX + 1, LV_OPA_MAX, LV_OPA_MAX - 1, LV_OPA_MIN + 1, LV_OPA_50};
+    uint32_t i = lv_rand(0, sizeof(opas) / sizeof(opas[0]));
+    return i < sizeof(opas) / sizeof(opas[0]) ? opas[i] : (lv_opa_t)lv_rand(LV_OPA_MIN + 1, LV_OPA_COVER);
+}
+
+static void blend(const lv_draw_sw_blend_kernels_t * kernels, lv_color_t * buf, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_draw_sw_blend_set_kernels(kernels);
+    draw_ctx.buf = buf;
+    lv_draw_sw_blend_basic(&draw_ctx, dsc);
+}
+
+/*Tell if the kernel set has the kernel used with these parameters by `lv_draw_sw_blend_basic()`*/
+static bool has_kernel(const lv_draw_sw_blend_kernels_t * kernels, bool mask, bool image, lv_opa_t opa)
+{
+    if(mask) return image ? kernels->map_mask != NULL : kernels->fill_mask != NULL;
+    if(image) return kernels->map_opa != NULL;
+    return opa >= LV_OPA_MAX ? kernels->fill != NULL : kernels->fill_opa != NULL;
+}
+
+static uint32_t bench(const lv_draw_sw_blend_kernels_t * kernels, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_draw_sw_blend_set_kernels(kernels);
+    draw_ctx.buf = dest_buf;
+
+    uint32_t start = lv_test_time_us();
+    uint32_t i;
+    for(i = 0; i < BENCH_CNT; i++) {
+        lv_draw_sw_blend_basic(&draw_ctx, dsc);
+    }
+    return lv_test_time_us() - start;
+}
+#endif
+
+void setUp(void)
+{
+#if LV_DRAW_SW_BLEND_SIMD
+    lv_area_set(&buf_area, 0, 0, BUF_W - 1, BUF_H - 1);
+    lv_memset_00(&draw_ctx, sizeof(draw_ctx));
+    draw_ctx.buf_area = &buf_area;
+    draw_ctx.clip_area = &buf_area;
+    _lv_refr_set_disp_refreshing(lv_disp_get_default());
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_DRAW_SW_BLEND_SIMD
+    _lv_refr_set_disp_refreshing(NULL);
+    lv_draw_sw_blend_simd_init();
+#endif
+}
+
+void test_draw_sw_blend_simd_init(void)
+{
+#if LV_DRAW_SW_BLEND_SIMD
+    TEST_ASSERT_NULL(lv_draw_sw_blend_simd_get_kernels(LV_DRAW_SW_BLEND_SIMD_NONE));
+
+    /*The best available kernels are used*/
+    const lv_draw_sw_blend_kernels_t * best = NULL;
+    uint32_t simd;
+    for(simd = 0; simd < _LV_DRAW_SW_BLEND_SIMD_LAST; simd++) {
+        const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_simd_get_kernels(simd);
+        if(kernels) best = kernels;
+    }
+    TEST_ASSERT_EQUAL_PTR(best, lv_draw_sw_blend_get_kernels());
+
+#if defined(__x86_64__) && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+    TEST_ASSERT_NOT_NULL(lv_draw_sw_blend_simd_get_kernels(LV_DRAW_SW_BLEND_SIMD_SSE2));
+#elif defined(CONFIG_IDF_TARGET_ESP32S3) && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+    TEST_ASSERT_NOT_NULL(lv_draw_sw_blend_simd_get_kernels(LV_DRAW_SW_BLEND_SIMD_PIE));
+#endif
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_simd_same_as_c(void)
+{
+#if LV_DRAW_SW_BLEND_SIMD
+    uint32_t simd;
+    for(simd = LV_DRAW_SW_BLEND_SIMD_NONE + 1; simd < _LV_DRAW_SW_BLEND_SIMD_LAST; simd++) {
+        const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_simd_get_kernels(simd);
+        if(kernels == NULL) continue;
+
+        uint32_t i;
+        for(i = 0; i < RANDOM_CNT; i++) {
+            uint32_t j;
+            for(j = 0; j < BUF_SIZE; j++) {
+                dest_buf[j] = rand_color();
+                src_buf[j] = rand_color();
+            }
+            lv_memcpy(ref_buf, dest_buf, sizeof(dest_buf));
+
+            /*Various widths and alignments with the mask and the image wider than the blended area*/
+            lv_area_t blend_area;
+            blend_area.x1 = (lv_coord_t)lv_rand(0, BUF_W - 1);
+            blend_area.y1 = (lv_coord_t)lv_rand(0, BUF_H - 4);
+            blend_area.x2 = (lv_coord_t)lv_rand(blend_area.x1, BUF_W - 1);
+            blend_area.y2 = (lv_coord_t)lv_rand(blend_area.y1, BUF_H - 1);
+
+            lv_area_t mask_area = blend_area;
+            mask_area.x1 -= (lv_coord_t)lv_rand(0, MASK_EXT);
+            mask_area.x2 += (lv_coord_t)lv_rand(0, MASK_EXT);
+            fill_rand_mask(mask_buf, lv_area_get_size(&mask_area));
+
+            lv_draw_sw_blend_dsc_t dsc;
+            lv_memset_00(&dsc, sizeof(dsc));
+            dsc.blend_area = &blend_area;
+            dsc.mask_area = &mask_area;
+            dsc.mask_buf = lv_rand(0, 1) ? mask_buf : NULL;
+            dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            dsc.src_buf = lv_rand(0, 1) ? src_buf : NULL;
+            dsc.color = rand_color();
+            dsc.opa = rand_opa();
+            dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+            blend(NULL, ref_buf, &dsc);
+            blend(kernels, dest_buf, &dsc);
+
+            for(j = 0; j < BUF_SIZE; j++) {
+                if(ref_buf[j].full != dest_buf[j].full) break;
+            }
+            if(j != BUF_SIZE) {
+                TEST_PRINTF("%s differs at x=%"LV_PRIu32", y=%"LV_PRIu32" with opa %d, %s, %s",
+                            kernels->name, j % BUF_W, j / BUF_W, dsc.opa, dsc.mask_buf ? "mask" : "no mask",
+                            dsc.src_buf ? "image" : "color");
+            }
+            TEST_ASSERT_EQUAL_UINT32(BUF_SIZE, j);
+        }
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_simd_benchmark(void)
+{
+#if LV_DRAW_SW_BLEND_SIMD
+    lv_area_t blend_area;
+    lv_area_set(&blend_area, 3, 0, 3 + BENCH_W - 1, BENCH_H - 1);
+
+    fill_rand_mask(mask_buf, BENCH_W * BENCH_H);
+
+    lv_draw_sw_blend_dsc_t dsc;
+    lv_memset_00(&dsc, sizeof(dsc));
+    dsc.blend_area = &blend_area;
+    dsc.mask_area = &blend_area;
+    dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    dsc.color = lv_color_hex(0x3080c0);
+    dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+    static const struct {
+        const char * name;
+        bool mask;
+        bool image;
+        lv_opa_t opa;
+    } cases[] = {
+        {"fill", false, false, LV_OPA_COVER},
+        {"fill_opa", false, false, LV_OPA_70},
+        {"fill_mask", true, false, LV_OPA_COVER},
+        {"fill_mask + opa", true, false, LV_OPA_70},
+        {"map_opa", false, true, LV_OPA_70},
+        {"map_mask", true, true, LV_OPA_COVER},
+        {"map_mask + opa", true, true, LV_OPA_70},
+    };
+
+    uint32_t simd;
+    for(simd = LV_DRAW_SW_BLEND_SIMD_NONE + 1; simd < _LV_DRAW_SW_BLEND_SIMD_LAST; simd++) {
+        const lv_draw_sw_blend_kernels_t * kernels = lv_draw_sw_blend_simd_get_kernels(simd);
+        if(kernels == NULL) continue;
+
+        uint32_t i;
+        for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+            /*Not every set has every kernel (e.g. not with the rounding of some 16 bit configurations)*/
+            if(!has_kernel(kernels, cases[i].mask, cases[i].image, cases[i].opa)) continue;
+
+            dsc.mask_buf = cases[i].mask ? mask_buf : NULL;
+            dsc.src_buf = cases[i].image ? src_buf : NULL;
+            dsc.opa = cases[i].opa;
+
+            uint32_t c_time = bench(NULL, &dsc);
+            uint32_t simd_time = bench(kernels, &dsc);
+            TEST_PRINTF("%s %s: %"LV_PRIu32" ns per pixel row of %d, %"LV_PRIu32" percent of the time of C",
+                        kernels->name, cases[i].name, (uint32_t)((uint64_t)simd_time * 1000 / (BENCH_CNT * BENCH_H)),
+                        BENCH_W, (uint32_t)((uint64_t)simd_time * 100 / LV_MAX(c_time, 1)));
+        }
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
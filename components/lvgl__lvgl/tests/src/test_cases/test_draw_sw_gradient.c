@@ -0,0 +1,322 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define HOR_RES     800
+#define VER_RES     480
+
+#define BENCH_CNT   20
+
+#if LV_DRAW_COMPLEX && LV_GRAD_CACHE_DEF_SIZE
+#define GRAD_CACHE_TEST   1
+#else
+#define GRAD_CACHE_TEST   0
+#endif
+
+#if GRAD_CACHE_TEST
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+static lv_obj_t * grad_create(lv_coord_t w, lv_coord_t h, lv_grad_dir_t dir, lv_color_t c1, lv_color_t c2)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, c1, 0);
+    lv_obj_set_style_bg_grad_color(obj, c2, 0);
+    lv_obj_set_style_bg_grad_dir(obj, dir, 0);
+    return obj;
+}
+
+#if _DITHER_GRADIENT == 0
+static bool same_rgb(lv_color_t c1, lv_color_t c2)
+{
+    return lv_color_to32(c1) == lv_color_to32(c2);
+}
+#endif
+
+/*Draw the screen without cache as reference, then with the cached gradients*/
+static void check_same_pixels(bool parallel)
+{
+    lv_gradient_set_cache_size(0);
+    lv_test_refr_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_test_refr_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*The bands drawn in parallel share the cached gradients*/
+    if(!parallel) return;
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    lv_draw_sw_thread_set_cnt(1);
+#else
+    LV_UNUSED(parallel);
+#endif
+}
+#endif
+
+void setUp(void)
+{
+#if GRAD_CACHE_TEST
+    lv_gradient_free_cache();
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*Every band of a parallel redraw looks up the gradients it crosses on its own*/
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if GRAD_CACHE_TEST
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+#endif
+#endif
+}
+
+void test_draw_sw_gradient_cache_hit(void)
+{
+#if GRAD_CACHE_TEST
+    lv_grad_cache_monitor_t mon;
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(LV_GRAD_CACHE_DEF_SIZE, mon.total_size);
+
+    lv_obj_t * obj = grad_create(200, 300, LV_GRAD_DIR_VER, lv_color_hex(0xff0000), lv_color_hex(0x0000ff));
+
+    /*The first draw computes the map*/
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+    uint32_t ver_size = mon.used_size;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(300 * sizeof(lv_color_t), ver_size);
+
+    /*Redrawing uses it*/
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+
+    /*An other object with the same colors and height uses the same map, even if it's wider*/
+    lv_obj_t * obj2 = grad_create(300, 300, LV_GRAD_DIR_VER, lv_color_hex(0xff0000), lv_color_hex(0x0000ff));
+    lv_obj_set_pos(obj2, 400, 100);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+
+    /*Other colors or direction need a new map*/
+    lv_obj_set_style_bg_grad_color(obj2, lv_color_hex(0x00ff00), 0);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * ver_size, mon.used_size);
+
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(5, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3 * ver_size - 100 * sizeof(lv_color_t), mon.used_size);
+
+    lv_gradient_free_cache();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.miss_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_gradient_cache_lru(void)
+{
+#if GRAD_CACHE_TEST
+    /*Room for 2 maps*/
+    lv_grad_cache_monitor_t mon;
+    lv_obj_t * a = grad_create(100, 100, LV_GRAD_DIR_VER, lv_color_hex(0xff0000), lv_color_hex(0x0000ff));
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    uint32_t item_size = mon.used_size;
+    lv_gradient_set_cache_size(2 * item_size + item_size / 2);
+
+    lv_obj_t * b = grad_create(100, 100, LV_GRAD_DIR_VER, lv_color_hex(0x00ff00), lv_color_hex(0x0000ff));
+    lv_obj_t * c = grad_create(100, 100, LV_GRAD_DIR_VER, lv_color_hex(0x0000ff), lv_color_hex(0xffffff));
+    lv_obj_set_x(b, 200);
+    lv_obj_set_x(c, 400);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * item_size, mon.used_size);
+
+    /*`a` was drawn first so it was dropped for `c`*/
+    lv_obj_add_flag(a, LV_OBJ_FLAG_HIDDEN);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.miss_cnt);
+
+    /*`b` is used more recently than `c` now*/
+    lv_obj_add_flag(c, LV_OBJ_FLAG_HIDDEN);
+    lv_test_refr_screen();
+    lv_obj_clear_flag(a, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(b, LV_OBJ_FLAG_HIDDEN);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(5, mon.miss_cnt);
+
+    lv_obj_clear_flag(b, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(a, LV_OBJ_FLAG_HIDDEN);
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(5, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * item_size, mon.used_size);
+
+    /*Too large for the cache: drawn without caching it*/
+    lv_obj_t * large = grad_create(100, VER_RES, LV_GRAD_DIR_VER, lv_color_hex(0xff0000), lv_color_hex(0x00ff00));
+    lv_obj_set_x(large, 600);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    lv_gradient_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(7, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * item_size, mon.used_size);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_gradient_pixels(void)
+{
+#if GRAD_CACHE_TEST
+    lv_obj_t * obj = grad_create(HOR_RES, VER_RES, LV_GRAD_DIR_VER, lv_color_hex(0x102030), lv_color_hex(0xf0e0d0));
+
+#if _DITHER_GRADIENT == 0
+    /*Every row or column has the color of the map*/
+    lv_grad_dsc_t grad;
+    lv_memset_00(&grad, sizeof(grad));
+    grad.dir = LV_GRAD_DIR_VER;
+    grad.stops_count = 2;
+    grad.stops[0].color = lv_color_hex(0x102030);
+    grad.stops[0].frac = 0;
+    grad.stops[1].color = lv_color_hex(0xf0e0d0);
+    grad.stops[1].frac = 255;
+
+    int32_t x;
+    int32_t y;
+    lv_test_refr_screen();
+    for(y = 0; y < VER_RES; y++) {
+        lv_color_t c = lv_gradient_calculate(&grad, VER_RES, y);
+        for(x = 0; x < HOR_RES; x++) {
+            if(!same_rgb(c, test_fb[y * HOR_RES + x])) {
+                TEST_PRINTF("vertical gradient differs at %"LV_PRId32";%"LV_PRId32, x, y);
+                TEST_FAIL();
+            }
+        }
+    }
+
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+    lv_test_refr_screen();
+    for(x = 0; x < HOR_RES; x++) {
+        lv_color_t c = lv_gradient_calculate(&grad, HOR_RES, x);
+        for(y = 0; y < VER_RES; y++) {
+            if(!same_rgb(c, test_fb[y * HOR_RES + x])) {
+                TEST_PRINTF("horizontal gradient differs at %"LV_PRId32";%"LV_PRId32, x, y);
+                TEST_FAIL();
+            }
+        }
+    }
+#endif
+
+    /*Rounded, clipped and dithered gradients are the same as the ones computed for every draw*/
+    lv_obj_set_size(obj, 500, 300);
+    lv_obj_set_pos(obj, -30, 250);
+    lv_obj_set_style_radius(obj, 40, 0);
+
+    lv_obj_t * obj2 = grad_create(300, 400, LV_GRAD_DIR_HOR, lv_color_hex(0x00ff40), lv_color_hex(0x4000ff));
+    lv_obj_set_pos(obj2, 520, 20);
+    lv_obj_set_style_bg_main_stop(obj2, 60, 0);
+    lv_obj_set_style_bg_grad_stop(obj2, 200, 0);
+
+    static const lv_dither_mode_t dithers[] = {LV_DITHER_NONE, LV_DITHER_ORDERED, LV_DITHER_ERR_DIFF};
+    uint32_t i;
+    for(i = 0; i < sizeof(dithers) / sizeof(dithers[0]); i++) {
+        /*The error diffusion starts again in every band drawn in parallel*/
+        bool parallel = dithers[i] != LV_DITHER_ERR_DIFF;
+        lv_obj_set_style_bg_dither_mode(obj, dithers[i], 0);
+        lv_obj_set_style_bg_dither_mode(obj2, dithers[i], 0);
+        lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+        check_same_pixels(parallel);
+        lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+        check_same_pixels(parallel);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_gradient_bench(void)
+{
+#if GRAD_CACHE_TEST
+    static const lv_grad_dir_t dirs[] = {LV_GRAD_DIR_VER, LV_GRAD_DIR_HOR};
+#if _DITHER_GRADIENT
+    static const lv_dither_mode_t dithers[] = {LV_DITHER_NONE, LV_DITHER_ORDERED, LV_DITHER_ERR_DIFF};
+#else
+    static const lv_dither_mode_t dithers[] = {LV_DITHER_NONE};
+#endif
+
+    lv_obj_t * obj = grad_create(HOR_RES, VER_RES, LV_GRAD_DIR_VER, lv_color_hex(0x102030), lv_color_hex(0xf0e0d0));
+
+    uint32_t d;
+    for(d = 0; d < sizeof(dithers) / sizeof(dithers[0]); d++) {
+        lv_obj_set_style_bg_dither_mode(obj, dithers[d], 0);
+        uint32_t r;
+        for(r = 0; r < 2; r++) {
+            lv_obj_set_style_bg_grad_dir(obj, dirs[r], 0);
+
+            /*Computed for every draw*/
+            lv_gradient_set_cache_size(0);
+            lv_test_refr_screen();
+            uint32_t i;
+            uint32_t start = lv_test_time_us();
+            for(i = 0; i < BENCH_CNT; i++) lv_test_refr_screen();
+            uint32_t uncached_time = lv_test_time_us() - start;
+
+            lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+            lv_test_refr_screen();
+            start = lv_test_time_us();
+            for(i = 0; i < BENCH_CNT; i++) lv_test_refr_screen();
+            uint32_t cached_time = lv_test_time_us() - start;
+
+            TEST_PRINTF("%s gradient, dither %d: %"LV_PRIu32" us per %dx%d screen, "
+                        "%"LV_PRIu32" percent of the time without cache",
+                        dirs[r] == LV_GRAD_DIR_VER ? "vertical" : "horizontal", (int)dithers[d],
+                        cached_time / BENCH_CNT, HOR_RES, VER_RES,
+                        (uint32_t)((uint64_t)cached_time * 100 / LV_MAX(uncached_time, 1)));
+        }
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
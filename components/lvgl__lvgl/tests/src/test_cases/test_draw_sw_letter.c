@@ -0,0 +1,117 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BUF_W       120
+#define BUF_H       80
+#define BUF_SIZE    (BUF_W * BUF_H)
+
+#define RANDOM_CNT  2000
+
+static lv_color_t dest_buf[BUF_SIZE];
+static lv_color_t ref_buf[BUF_SIZE];
+
+static lv_area_t buf_area;
+static lv_area_t clip_area;
+static lv_draw_sw_ctx_t * draw_ctx;
+
+/*Not the plain software blend so the letters are always drawn via opacity masks*/
+static void blend_via_mask(lv_draw_ctx_t * ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_draw_sw_blend_basic(ctx, dsc);
+}
+
+/*The blend sets 0xFF in the unused byte of 32 bit colors where it mixes*/
+static lv_color_t rand_color(void)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 32
+    c.full = lv_rand(0, 0xFFFFFF) | 0xFF000000;
+#elif LV_COLOR_DEPTH == 16
+    c.full = (uint16_t)lv_rand(0, 0xFFFF);
+#else
+    c.full = (uint8_t)lv_rand(0, 0xFF);
+#endif
+    return c;
+}
+
+static void draw_letter(lv_color_t * buf, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos, uint32_t letter,
+                        bool via_mask)
+{
+    draw_ctx->base_draw.buf = buf;
+    draw_ctx->blend = via_mask ? blend_via_mask : lv_draw_sw_blend_basic;
+    lv_draw_letter(&draw_ctx->base_draw, dsc, pos, letter);
+}
+
+void setUp(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    draw_ctx = (lv_draw_sw_ctx_t *)disp->driver->draw_ctx;
+    lv_area_set(&buf_area, 0, 0, BUF_W - 1, BUF_H - 1);
+    draw_ctx->base_draw.buf_area = &buf_area;
+    draw_ctx->base_draw.clip_area = &clip_area;
+    _lv_refr_set_disp_refreshing(disp);
+}
+
+void tearDown(void)
+{
+    draw_ctx->blend = lv_draw_sw_blend_basic;
+    _lv_refr_set_disp_refreshing(NULL);
+}
+
+void test_draw_sw_letter_same_as_via_mask(void)
+{
+    /*1 bpp, 4 bpp and compressed 3 bpp fonts*/
+    static const lv_font_t * fonts[] = {
+        &lv_font_unscii_8,
+#if LV_FONT_UNSCII_16
+        &lv_font_unscii_16,
+#endif
+        &lv_font_montserrat_14,
+#if LV_FONT_MONTSERRAT_48
+        &lv_font_montserrat_48,
+#endif
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+        &lv_font_montserrat_28_compressed,
+#endif
+    };
+
+    uint32_t i;
+    for(i = 0; i < RANDOM_CNT; i++) {
+        uint32_t j;
+        for(j = 0; j < BUF_SIZE; j++) dest_buf[j] = rand_color();
+        lv_memcpy(ref_buf, dest_buf, sizeof(dest_buf));
+
+        /*Clip some letters on any side*/
+        clip_area.x1 = (lv_coord_t)lv_rand(0, BUF_W / 2);
+        clip_area.y1 = (lv_coord_t)lv_rand(0, BUF_H / 2);
+        clip_area.x2 = (lv_coord_t)lv_rand(clip_area.x1, BUF_W - 1);
+        clip_area.y2 = (lv_coord_t)lv_rand(clip_area.y1, BUF_H - 1);
+
+        lv_draw_label_dsc_t dsc;
+        lv_draw_label_dsc_init(&dsc);
+        dsc.font = fonts[lv_rand(0, sizeof(fonts) / sizeof(fonts[0]) - 1)];
+        dsc.color = rand_color();
+        dsc.opa = lv_rand(0, 3) ? LV_OPA_COVER : LV_OPA_MAX;
+
+        lv_point_t pos;
+        pos.x = (lv_coord_t)lv_rand(0, BUF_W + 40) - 40;
+        pos.y = (lv_coord_t)lv_rand(0, BUF_H + 40) - 40;
+        uint32_t letter = lv_rand('!', '~');
+
+        draw_letter(ref_buf, &dsc, &pos, letter, true);
+        draw_letter(dest_buf, &dsc, &pos, letter, false);
+
+        for(j = 0; j < BUF_SIZE; j++) {
+            if(ref_buf[j].full != dest_buf[j].full) break;
+        }
+        if(j != BUF_SIZE) {
+            TEST_PRINTF("'%c' differs at x=%"LV_PRIu32", y=%"LV_PRIu32" with %d px font",
+                        (char)letter, j % BUF_W, j / BUF_W, lv_font_get_line_height(dsc.font));
+        }
+        TEST_ASSERT_EQUAL_UINT32(BUF_SIZE, j);
+    }
+}
+
+#endif
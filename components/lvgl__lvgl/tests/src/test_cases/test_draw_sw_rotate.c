@@ -0,0 +1,160 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include <string.h>
+
+#define HOR_RES     800
+#define VER_RES     480
+#define BUF_SIZE    (HOR_RES * VER_RES)
+
+#define RANDOM_CNT  200
+#define BENCH_CNT   20
+
+static lv_color_t src_buf[BUF_SIZE];
+static lv_color_t dest_buf[BUF_SIZE];
+static lv_color_t ref_buf[BUF_SIZE];
+
+static void fill_rand(lv_color_t * buf, uint32_t px_cnt)
+{
+    uint8_t * p = (uint8_t *)buf;
+    uint32_t i;
+    for(i = 0; i < px_cnt * sizeof(lv_color_t); i++) p[i] = (uint8_t)lv_rand(0, 0xFF);
+}
+
+/*Rotate pixel by pixel*/
+static void rotate_ref(const lv_color_t * src, lv_color_t * dest, int32_t w, int32_t h,
+                       int32_t src_stride, int32_t dest_stride, lv_disp_rot_t rotation)
+{
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color_t c = src[y * src_stride + x];
+            switch(rotation) {
+                case LV_DISP_ROT_NONE:
+                    dest[y * dest_stride + x] = c;
+                    break;
+                case LV_DISP_ROT_90:
+                    dest[(w - 1 - x) * dest_stride + y] = c;
+                    break;
+                case LV_DISP_ROT_180:
+                    dest[(h - 1 - y) * dest_stride + (w - 1 - x)] = c;
+                    break;
+                case LV_DISP_ROT_270:
+                    dest[x * dest_stride + (h - 1 - y)] = c;
+                    break;
+            }
+        }
+    }
+}
+
+/*The former pixel at a time rotation of `lv_refr.c` as reference for the benchmark*/
+static void rotate_90_px(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
+                         const lv_color_t * orig_color_p, lv_color_t * rot_buf)
+{
+    uint32_t invert = (area_w * area_h) - 1;
+    uint32_t initial_i = ((area_w - 1) * area_h);
+    for(lv_coord_t y = 0; y < area_h; y++) {
+        uint32_t i = initial_i + y;
+        if(invert_i) i = invert - i;
+        for(lv_coord_t x = 0; x < area_w; x++) {
+            rot_buf[i] = *(orig_color_p++);
+            if(invert_i) i += area_h;
+            else i -= area_h;
+        }
+    }
+}
+
+void setUp(void)
+{
+    fill_rand(src_buf, BUF_SIZE);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_draw_sw_rotate_same_as_px(void)
+{
+    static const lv_disp_rot_t rots[] = {LV_DISP_ROT_NONE, LV_DISP_ROT_90, LV_DISP_ROT_180, LV_DISP_ROT_270};
+
+    uint32_t i;
+    for(i = 0; i < RANDOM_CNT; i++) {
+        /*Mostly sizes which are not multiple of the tiles*/
+        int32_t w = lv_rand(1, 100);
+        int32_t h = lv_rand(1, 100);
+        int32_t src_stride = w + lv_rand(0, 10);
+        int32_t dest_stride;
+        lv_disp_rot_t rot = rots[i % 4];
+        if(rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270) dest_stride = h + lv_rand(0, 10);
+        else dest_stride = w + lv_rand(0, 10);
+
+        /*The padding of the destination has to remain untouched*/
+        fill_rand(dest_buf, BUF_SIZE);
+        lv_memcpy(ref_buf, dest_buf, sizeof(ref_buf));
+
+        rotate_ref(src_buf, ref_buf, w, h, src_stride, dest_stride, rot);
+        lv_draw_sw_rotate(src_buf, dest_buf, w, h, src_stride, dest_stride, rot);
+        if(memcmp(ref_buf, dest_buf, sizeof(ref_buf)) != 0) {
+            TEST_PRINTF("differs with %"LV_PRId32"x%"LV_PRId32", strides %"LV_PRId32", %"LV_PRId32", rotation %d",
+                        w, h, src_stride, dest_stride, (int)rot);
+            TEST_FAIL();
+        }
+    }
+}
+
+void test_draw_sw_rotate_sqr_same_as_px(void)
+{
+    static const lv_disp_rot_t rots[] = {LV_DISP_ROT_90, LV_DISP_ROT_270};
+
+    uint32_t i;
+    for(i = 0; i < RANDOM_CNT; i++) {
+        int32_t w = lv_rand(1, 100);
+        int32_t stride = w + lv_rand(0, 10);
+        lv_disp_rot_t rot = rots[i % 2];
+
+        lv_memcpy(dest_buf, src_buf, sizeof(dest_buf));
+        lv_memcpy(ref_buf, src_buf, sizeof(ref_buf));
+
+        rotate_ref(src_buf, ref_buf, w, w, stride, stride, rot);
+        lv_draw_sw_rotate_sqr(dest_buf, w, stride, rot);
+        if(memcmp(ref_buf, dest_buf, sizeof(ref_buf)) != 0) {
+            TEST_PRINTF("differs with %"LV_PRId32"x%"LV_PRId32", stride %"LV_PRId32", rotation %d",
+                        w, w, stride, (int)rot);
+            TEST_FAIL();
+        }
+    }
+}
+
+void test_draw_sw_rotate_bench(void)
+{
+    static const lv_disp_rot_t rots[] = {LV_DISP_ROT_90, LV_DISP_ROT_270};
+
+    uint32_t r;
+    for(r = 0; r < 2; r++) {
+        uint32_t i;
+        uint32_t start = lv_test_time_us();
+        for(i = 0; i < BENCH_CNT; i++) {
+            rotate_90_px(rots[r] == LV_DISP_ROT_270, HOR_RES, VER_RES, src_buf, ref_buf);
+        }
+        uint32_t px_time = lv_test_time_us() - start;
+
+        start = lv_test_time_us();
+        for(i = 0; i < BENCH_CNT; i++) {
+            lv_draw_sw_rotate(src_buf, dest_buf, HOR_RES, VER_RES, HOR_RES, VER_RES, rots[r]);
+        }
+        uint32_t tile_time = lv_test_time_us() - start;
+
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, dest_buf, sizeof(ref_buf));
+        TEST_PRINTF("rotate %d: %"LV_PRIu32" us per %dx%d screen, %"LV_PRIu32" percent of the time of pixel at a time",
+                    rots[r] == LV_DISP_ROT_90 ? 90 : 270, tile_time / BENCH_CNT, HOR_RES, VER_RES,
+                    (uint32_t)((uint64_t)tile_time * 100 / LV_MAX(px_time, 1)));
+    }
+}
+
+#endif
@@ -0,0 +1,214 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+#define FRAME_CNT       2
+#define BENCH_REFR_CNT  3
+
+#if LV_DRAW_SW_THREAD_CNT > 1 && LV_USE_DEMO_BENCHMARK
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+/*Start a scene of the benchmark demo. Returns false after the last scene.*/
+static bool start_scene(uint32_t scene_no)
+{
+    lv_demo_benchmark_close();
+    lv_demo_benchmark_run_scene(scene_no);
+
+    /*The scenes create their objects on the 3rd child of the screen*/
+    lv_obj_t * scene_bg = lv_obj_get_child(lv_scr_act(), 2);
+    return scene_bg && lv_obj_get_child_cnt(scene_bg) > 0;
+}
+
+/*Draw the screen on the calling thread only and with `thread_cnt` threads and compare them.
+ *How an area is drawn can depend on its size (e.g. a layer which needs alpha is skipped with
+ *LV_COLOR_SCREEN_TRANSP 0) so draw the same bands one by one for the reference.*/
+static void check_parallel(uint32_t scene_no, uint32_t thread_cnt)
+{
+    lv_draw_sw_thread_set_cnt(1);
+
+    /*Draw the areas invalidated by the scene first to have only 1 area per refresh*/
+    lv_refr_now(NULL);
+
+    uint32_t band_cnt = thread_cnt * 2;
+    uint32_t b;
+    for(b = 0; b < band_cnt; b++) {
+        lv_area_t a;
+        a.x1 = 0;
+        a.x2 = HOR_RES - 1;
+        a.y1 = (lv_coord_t)(VER_RES * b / band_cnt);
+        a.y2 = (lv_coord_t)(VER_RES * (b + 1) / band_cnt - 1);
+        _lv_inv_area(NULL, &a);
+        lv_refr_now(NULL);
+
+        /*The test display flushes every area to the beginning of the frame buffer*/
+        lv_memcpy(&ref_fb[a.y1 * HOR_RES], test_fb, lv_area_get_size(&a) * sizeof(lv_color_t));
+    }
+
+    lv_draw_sw_thread_set_cnt(thread_cnt);
+    lv_test_refr_screen();
+
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES; i++) {
+        if(ref_fb[i].full != test_fb[i].full) break;
+    }
+
+    if(i != HOR_RES * VER_RES) {
+        TEST_PRINTF("scene %"LV_PRIu32" with %"LV_PRIu32" threads differs at x=%"LV_PRIu32", y=%"LV_PRIu32,
+                    scene_no, thread_cnt, i % HOR_RES, i / HOR_RES);
+    }
+    TEST_ASSERT_EQUAL_UINT32(HOR_RES * VER_RES, i);
+}
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+#if LV_DRAW_SW_THREAD_CNT > 1 && LV_USE_DEMO_BENCHMARK
+    lv_demo_benchmark_close();
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+#endif
+}
+
+void test_draw_sw_thread_bands(void)
+{
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_monitor_t mon;
+    lv_draw_sw_thread_monitor(&mon);
+    uint32_t render_cnt = mon.render_cnt;
+    uint32_t serial_cnt = mon.serial_cnt;
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 200, 200);
+    lv_refr_now(NULL);
+
+    /*The whole screen was drawn in parallel*/
+    lv_draw_sw_thread_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(render_cnt + 1, mon.render_cnt);
+    TEST_ASSERT_EQUAL_UINT32(serial_cnt, mon.serial_cnt);
+
+    /*An area lower than the minimal band height is drawn on the calling thread only*/
+    lv_obj_set_height(obj, LV_DRAW_SW_THREAD_MIN_HEIGHT - 4);
+    lv_refr_now(NULL);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    lv_draw_sw_thread_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(serial_cnt + 1, mon.serial_cnt);
+
+    /*It's also the case if only 1 thread is set*/
+    lv_draw_sw_thread_set_cnt(1);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_draw_sw_thread_get_cnt());
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_draw_sw_thread_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(serial_cnt + 2, mon.serial_cnt);
+
+    lv_draw_sw_thread_set_cnt(1000);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_THREAD_CNT, lv_draw_sw_thread_get_cnt());
+
+    lv_obj_del(obj);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_thread_same_as_serial(void)
+{
+#if LV_DRAW_SW_THREAD_CNT > 1 && LV_USE_DEMO_BENCHMARK
+    static const uint32_t thread_cnts[] = {2, LV_DRAW_SW_THREAD_CNT};
+    uint32_t scene_no;
+    for(scene_no = 0; start_scene(scene_no); scene_no++) {
+        uint32_t frame;
+        for(frame = 0; frame < FRAME_CNT; frame++) {
+            /*Move the objects of the scene*/
+            lv_tick_inc(97);
+            lv_timer_handler();
+
+            uint32_t i;
+            for(i = 0; i < sizeof(thread_cnts) / sizeof(thread_cnts[0]); i++) {
+                check_parallel(scene_no, thread_cnts[i]);
+            }
+        }
+    }
+
+    /*All the scenes with and without opacity*/
+    TEST_ASSERT_GREATER_THAN_UINT32(60, scene_no);
+
+    /*The threads can be stopped and started again*/
+    lv_draw_sw_thread_deinit();
+    TEST_ASSERT_TRUE(start_scene(0));
+    check_parallel(0, LV_DRAW_SW_THREAD_CNT);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_thread_shared_glyphs(void)
+{
+#if LV_DRAW_SW_THREAD_CNT > 1 && LV_USE_DEMO_BENCHMARK && LV_USE_TINY_TTF
+    /*The glyphs are drawn from copies while the other threads render new ones into the atlas,
+     *which is too small for all of them so it's flushed again and again*/
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data_atlas(ubuntu_font, ubuntu_font_size, 60, 400, 8 * 1024);
+    TEST_ASSERT_NOT_NULL(font);
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "0123456789 abcdefgh\nijklmnopqrstuvwxyz\nABCDEFGHIJKLMNOP\nQRSTUVWXYZ 9876543210");
+
+    check_parallel(0, 2);
+    check_parallel(0, LV_DRAW_SW_THREAD_CNT);
+
+    lv_obj_del(label);
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_thread_benchmark(void)
+{
+#if LV_DRAW_SW_THREAD_CNT > 1 && LV_USE_DEMO_BENCHMARK
+    uint32_t thread_cnt;
+    uint32_t serial_time = 0;
+    for(thread_cnt = 1; thread_cnt <= LV_DRAW_SW_THREAD_CNT; thread_cnt *= 2) {
+        lv_draw_sw_thread_set_cnt(thread_cnt);
+
+        /*Every other scene is the same with opacity, measure the normal ones*/
+        uint32_t time_sum = 0;
+        uint32_t frame_cnt = 0;
+        uint32_t scene_no;
+        for(scene_no = 0; start_scene(scene_no); scene_no += 2) {
+            lv_tick_inc(97);
+            lv_test_refr_screen();
+
+            uint32_t start = lv_test_time_us();
+            uint32_t i;
+            for(i = 0; i < BENCH_REFR_CNT; i++) lv_test_refr_screen();
+            time_sum += lv_test_time_us() - start;
+            frame_cnt += BENCH_REFR_CNT;
+        }
+
+        if(thread_cnt == 1) serial_time = time_sum;
+        TEST_PRINTF("benchmark scenes, %"LV_PRIu32" drawing threads: %"LV_PRIu32" us per full screen frame, "
+                    "%"LV_PRIu32" percent of the time with 1 thread",
+                    thread_cnt, time_sum / frame_cnt, (uint32_t)((uint64_t)time_sum * 100 / serial_time));
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
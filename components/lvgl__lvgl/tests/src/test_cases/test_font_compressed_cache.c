@@ -0,0 +1,124 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define CACHE_ENABLED (LV_FONT_MONTSERRAT_28_COMPRESSED && LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE)
+
+#if CACHE_ENABLED
+static const lv_font_t * font = &lv_font_montserrat_28_compressed;
+
+static uint32_t bitmap_size(uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, letter, '\0');
+    return (g.box_w * g.box_h * g.bpp + 7) / 8;
+}
+#endif
+
+void setUp(void)
+{
+#if CACHE_ENABLED
+    lv_font_fmt_txt_bitmap_cache_clear();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_font_compressed_cache_hit(void)
+{
+#if CACHE_ENABLED
+    static uint8_t ref[1024];
+    lv_font_fmt_txt_bitmap_cache_monitor_t mon;
+
+    uint32_t size = bitmap_size('A');
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(ref), size);
+
+    const uint8_t * bmp1 = lv_font_get_glyph_bitmap(font, 'A');
+    TEST_ASSERT_NOT_NULL(bmp1);
+    lv_memcpy(ref, bmp1, size);
+
+    lv_font_fmt_txt_bitmap_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(size, mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(LV_FONT_COMPRESSED_CACHE_SIZE, mon.total_size);
+
+    /*The same glyph again comes from the cache*/
+    const uint8_t * bmp2 = lv_font_get_glyph_bitmap(font, 'A');
+    TEST_ASSERT_EQUAL_PTR(bmp1, bmp2);
+    TEST_ASSERT_EQUAL_MEMORY(ref, bmp2, size);
+
+    lv_font_fmt_txt_bitmap_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+
+    /*A freshly decompressed glyph is the same as the cached one*/
+    lv_font_fmt_txt_bitmap_cache_clear();
+    const uint8_t * bmp3 = lv_font_get_glyph_bitmap(font, 'A');
+    TEST_ASSERT_EQUAL_MEMORY(ref, bmp3, size);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_compressed_cache_stays_in_budget(void)
+{
+#if CACHE_ENABLED
+    lv_font_fmt_txt_bitmap_cache_monitor_t mon;
+    uint32_t letter;
+    uint32_t miss_cnt = 0;
+
+    /*All the printable ASCII glyphs don't fit into the cache, so the old ones have to be evicted*/
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        for(letter = '!'; letter <= '~'; letter++) {
+            if(bitmap_size(letter) == 0) continue;
+            TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font, letter));
+            miss_cnt++;
+
+            lv_font_fmt_txt_bitmap_cache_monitor(&mon);
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_FONT_COMPRESSED_CACHE_SIZE, mon.used_size);
+        }
+    }
+
+    /*Going around in the same order is the worst case for an LRU: everything misses*/
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, mon.miss_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_compressed_cache_redraw(void)
+{
+#if CACHE_ENABLED
+    lv_font_fmt_txt_bitmap_cache_monitor_t mon;
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "12:34:56");
+
+    lv_refr_now(NULL);
+    lv_font_fmt_txt_bitmap_cache_monitor(&mon);
+    uint32_t miss_cnt = mon.miss_cnt;
+    uint32_t hit_cnt = mon.hit_cnt;
+    TEST_ASSERT_GREATER_THAN_UINT32(0, miss_cnt);
+
+    /*Redrawing the same text doesn't decompress anything.
+     *Render the text again instead of using the text cache.*/
+    lv_draw_sw_text_cache_clear();
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    lv_font_fmt_txt_bitmap_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 8, mon.hit_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
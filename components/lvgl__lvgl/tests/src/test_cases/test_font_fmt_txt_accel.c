@@ -0,0 +1,236 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+/*A small font with 26 glyphs for 'A'..'Z' and kern pairs between them*/
+#define TEST_GLYPH_CNT  26
+#define TEST_PAIR_MAX   (TEST_GLYPH_CNT * TEST_GLYPH_CNT)
+
+static lv_font_fmt_txt_glyph_dsc_t test_glyph_dsc[TEST_GLYPH_CNT + 1];
+static uint8_t test_pair_ids_8[TEST_PAIR_MAX * 2];
+static uint16_t test_pair_ids_16[TEST_PAIR_MAX * 2];
+static int8_t test_pair_values[TEST_PAIR_MAX];
+static lv_font_fmt_txt_kern_pair_t test_kern_pairs;
+static lv_font_fmt_txt_cmap_t test_cmaps[2];
+static lv_font_fmt_txt_glyph_cache_t test_cache;
+static lv_font_fmt_txt_dsc_t test_dsc;
+static lv_font_t test_font;
+
+/*The same font without lookup tables*/
+static lv_font_fmt_txt_glyph_cache_t plain_cache;
+static lv_font_fmt_txt_dsc_t plain_dsc;
+static lv_font_t plain_font;
+
+static void test_font_init(uint32_t glyph_ids_size)
+{
+    lv_memset_00(test_glyph_dsc, sizeof(test_glyph_dsc));
+    lv_memset_00(test_cmaps, sizeof(test_cmaps));
+    lv_memset_00(&test_cache, sizeof(test_cache));
+    lv_memset_00(&test_dsc, sizeof(test_dsc));
+    lv_memset_00(&test_font, sizeof(test_font));
+
+    uint32_t i;
+    for(i = 1; i <= TEST_GLYPH_CNT; i++) {
+        test_glyph_dsc[i].adv_w = (8 + i) << 4;
+        test_glyph_dsc[i].box_w = 8;
+        test_glyph_dsc[i].box_h = 10;
+    }
+
+    /*Some pairs of each left glyph, ordered by left then right glyph id*/
+    uint32_t cnt = 0;
+    uint32_t left;
+    uint32_t right;
+    for(left = 1; left <= TEST_GLYPH_CNT; left++) {
+        for(right = 1; right <= TEST_GLYPH_CNT; right++) {
+            if((left * 7 + right) % 3) continue;
+            test_pair_ids_8[cnt * 2] = left;
+            test_pair_ids_8[cnt * 2 + 1] = right;
+            test_pair_ids_16[cnt * 2] = left;
+            test_pair_ids_16[cnt * 2 + 1] = right;
+            test_pair_values[cnt] = (int8_t)(left - right);
+            cnt++;
+        }
+    }
+
+    test_kern_pairs.glyph_ids = glyph_ids_size == 0 ? (const void *)test_pair_ids_8 : (const void *)test_pair_ids_16;
+    test_kern_pairs.values = test_pair_values;
+    test_kern_pairs.pair_cnt = cnt;
+    test_kern_pairs.glyph_ids_size = glyph_ids_size;
+
+    /*'A'..'M' continuously and 'N'..'Z' as a sparse list of every other letter*/
+    static const uint16_t sparse_list[] = {0, 2, 4, 6, 8, 10, 12};
+    test_cmaps[0].range_start = 'A';
+    test_cmaps[0].range_length = 13;
+    test_cmaps[0].glyph_id_start = 1;
+    test_cmaps[0].type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY;
+    test_cmaps[1].range_start = 'N';
+    test_cmaps[1].range_length = 13;
+    test_cmaps[1].glyph_id_start = 14;
+    test_cmaps[1].unicode_list = sparse_list;
+    test_cmaps[1].list_length = 7;
+    test_cmaps[1].type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY;
+
+    test_dsc.glyph_dsc = test_glyph_dsc;
+    test_dsc.cmaps = test_cmaps;
+    test_dsc.kern_dsc = &test_kern_pairs;
+    test_dsc.kern_scale = 16 * 16;    /*Kern values in pixels*/
+    test_dsc.cmap_num = 2;
+    test_dsc.bpp = 1;
+    test_dsc.kern_classes = 0;
+    test_dsc.cache = &test_cache;
+
+    test_font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    test_font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    test_font.line_height = 12;
+    test_font.dsc = &test_dsc;
+}
+
+static void plain_copy(const lv_font_t * font)
+{
+    plain_font = *font;
+    plain_dsc = *(const lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_memset_00(&plain_cache, sizeof(plain_cache));
+    plain_dsc.cache = &plain_cache;
+    plain_font.dsc = &plain_dsc;
+}
+
+static void compare_letter(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
+{
+    lv_font_glyph_dsc_t dsc;
+    lv_font_glyph_dsc_t plain;
+    lv_memset_00(&dsc, sizeof(dsc));
+    lv_memset_00(&plain, sizeof(plain));
+
+    bool found = font->get_glyph_dsc(font, &dsc, letter, letter_next);
+    bool plain_found = plain_font.get_glyph_dsc(&plain_font, &plain, letter, letter_next);
+    TEST_ASSERT_EQUAL(plain_found, found);
+    if(!found) return;
+
+    TEST_ASSERT_EQUAL_UINT16(plain.adv_w, dsc.adv_w);
+    TEST_ASSERT_EQUAL_UINT16(plain.box_w, dsc.box_w);
+    TEST_ASSERT_EQUAL_UINT16(plain.box_h, dsc.box_h);
+    TEST_ASSERT_EQUAL_INT16(plain.ofs_x, dsc.ofs_x);
+    TEST_ASSERT_EQUAL_INT16(plain.ofs_y, dsc.ofs_y);
+    TEST_ASSERT_EQUAL_UINT8(plain.bpp, dsc.bpp);
+}
+
+/*Every letter of the font has to be found the same way with and without the lookup tables*/
+static void compare_font(const lv_font_t * font)
+{
+    plain_copy(font);
+    TEST_ASSERT_TRUE(lv_font_fmt_txt_accel_create(font));
+
+    uint32_t letter;
+    for(letter = 0; letter <= 0x10100; letter++) {
+        compare_letter(font, letter, letter + 1);
+    }
+
+    lv_font_fmt_txt_accel_delete(font);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_font_fmt_txt_accel_builtin_fonts(void)
+{
+    compare_font(&lv_font_montserrat_14);
+#if LV_FONT_SIMSUN_16_CJK
+    compare_font(&lv_font_simsun_16_cjk);
+#endif
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    compare_font(&lv_font_dejavu_16_persian_hebrew);
+#endif
+}
+
+void test_font_fmt_txt_accel_kern_pairs(void)
+{
+    uint32_t glyph_ids_size;
+    for(glyph_ids_size = 0; glyph_ids_size <= 1; glyph_ids_size++) {
+        test_font_init(glyph_ids_size);
+        plain_copy(&test_font);
+        TEST_ASSERT_TRUE(lv_font_fmt_txt_accel_create(&test_font));
+
+        /*'A' is 9 px wide, 1 px less before 'B' and there is no pair for "AC"*/
+        lv_font_glyph_dsc_t dsc;
+        lv_font_get_glyph_dsc(&test_font, &dsc, 'A', 'B');
+        TEST_ASSERT_EQUAL_UINT16(8, dsc.adv_w);
+        lv_font_get_glyph_dsc(&test_font, &dsc, 'A', 'C');
+        TEST_ASSERT_EQUAL_UINT16(9, dsc.adv_w);
+
+        /*All pairs of letters around 'A'..'Z' with and without kerning*/
+        uint32_t left;
+        uint32_t right;
+        for(left = '@'; left <= '['; left++) {
+            for(right = '@'; right <= '['; right++) {
+                compare_letter(&test_font, left, right);
+            }
+        }
+
+        lv_font_fmt_txt_accel_delete(&test_font);
+    }
+}
+
+void test_font_fmt_txt_accel_delete(void)
+{
+    test_font_init(0);
+    TEST_ASSERT_TRUE(lv_font_fmt_txt_accel_create(&test_font));
+    TEST_ASSERT_NOT_NULL(test_cache.accel);
+
+    /*Creating it again replaces the tables*/
+    TEST_ASSERT_TRUE(lv_font_fmt_txt_accel_create(&test_font));
+    lv_font_fmt_txt_accel_delete(&test_font);
+    TEST_ASSERT_NULL(test_cache.accel);
+
+    /*It's fine to delete twice*/
+    lv_font_fmt_txt_accel_delete(&test_font);
+
+    /*No tables without a cache to store them*/
+    test_dsc.cache = NULL;
+    TEST_ASSERT_FALSE(lv_font_fmt_txt_accel_create(&test_font));
+}
+
+void test_font_fmt_txt_accel_benchmark(void)
+{
+#if LV_FONT_SIMSUN_16_CJK
+    const lv_font_t * font = &lv_font_simsun_16_cjk;
+    const char * txt = "盗提陽帯鼻画輕ッ冊ェル写父ぁフ結想正四O夫源庭場天續鳥れ講猿苦階給了製守8祝己妳薄泣塩帰ぺ吃変輪那着仍嗯爭熱創味保字宿"
+                       "捨準查達肯ァ薬得査障該降察ね網加昼料等図邪秋コ態品屬久原殊候路願楽確針上被怕悲風份重歡っ附ぷ既4黨價娘朝凍僅際洋止右航";
+    uint32_t i;
+    lv_point_t size_plain;
+    lv_point_t size_accel;
+
+    clock_t start = clock();
+    for(i = 0; i < 200; i++) {
+        lv_txt_get_size(&size_plain, txt, font, 0, 0, 200, LV_TEXT_FLAG_NONE);
+    }
+    clock_t plain_time = clock() - start;
+
+    TEST_ASSERT_TRUE(lv_font_fmt_txt_accel_create(font));
+    start = clock();
+    for(i = 0; i < 200; i++) {
+        lv_txt_get_size(&size_accel, txt, font, 0, 0, 200, LV_TEXT_FLAG_NONE);
+    }
+    clock_t accel_time = clock() - start;
+    lv_font_fmt_txt_accel_delete(font);
+
+    TEST_PRINTF("CJK text layout: %"LV_PRIu32" us without, %"LV_PRIu32" us with lookup tables",
+                (uint32_t)(plain_time * 1000000 / CLOCKS_PER_SEC), (uint32_t)(accel_time * 1000000 / CLOCKS_PER_SEC));
+
+    TEST_ASSERT_EQUAL_INT32(size_plain.x, size_accel.x);
+    TEST_ASSERT_EQUAL_INT32(size_plain.y, size_accel.y);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -26,6 +26,7 @@
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
 void test_font_loader(void);
+void test_font_loader_mmap_format(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +73,34 @@ void test_font_loader(void)
     lv_font_free(font_3_bin);
 }
 
+void test_font_loader_mmap_format(void)
+{
+    /*The fonts converted by `scripts/font_bin_to_mmap.py` are read into the RAM by these drivers*/
+    const char * drvs[] = {"A", "B"};
+    for(uint32_t i = 0; i < sizeof(drvs) / sizeof(drvs[0]); i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "%s:src/test_fonts/font_1.lvf", drvs[i]);
+        lv_font_t * font_1_mmap = lv_font_load(path);
+        lv_snprintf(path, sizeof(path), "%s:src/test_fonts/font_2.lvf", drvs[i]);
+        lv_font_t * font_2_mmap = lv_font_load(path);
+        lv_snprintf(path, sizeof(path), "%s:src/test_fonts/font_3.lvf", drvs[i]);
+        lv_font_t * font_3_mmap = lv_font_load(path);
+
+        compare_fonts(&font_1, font_1_mmap);
+        compare_fonts(&font_2, font_2_mmap);
+        compare_fonts(&font_3, font_3_mmap);
+
+        lv_font_free(font_1_mmap);
+        lv_font_free(font_2_mmap);
+        lv_font_free(font_3_mmap);
+    }
+
+    /*Converted with `--large`: the glyph descriptors are converted if they don't match the configuration*/
+    lv_font_t * font_1_large = lv_font_load("A:src/test_fonts/font_1_large.lvf");
+    compare_fonts(&font_1, font_1_large);
+    lv_font_free(font_1_large);
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
@@ -50,4 +50,29 @@ void test_read(void)
     lv_fs_close(&fb);
 }
 
+void test_read_after_seek_end(void)
+{
+    /*'A' has cache. Getting the size moves the file system's position away from the cached data.*/
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "A:src/test_files/readtest.txt", LV_FS_MODE_RD));
+
+    uint8_t buf[150];
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, 4, &br));
+
+    uint32_t size;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &size));
+    TEST_ASSERT_GREATER_OR_EQUAL(strlen(read_exp), size);
+
+    /*Read across the end of the previously cached data*/
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, 60, &br));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf + 60, 90, &br));
+    TEST_ASSERT_EQUAL(90, br);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp, buf, sizeof(buf));
+
+    lv_fs_close(&f);
+}
+
 #endif
@@ -0,0 +1,337 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#define READ_PATH   "B:src/test_files/readtest.txt"
+#define BENCH_CNT   10
+
+/*'B' is the POSIX driver without cache. Its shared blocks are configured by the tests.*/
+static lv_fs_drv_t * drv;
+static uint16_t cache_size_ori;
+static uint16_t cache_block_cnt_ori;
+static lv_fs_res_t (*read_cb_ori)(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static uint32_t read_cb_cnt;
+
+static lv_fs_res_t read_cb_count(lv_fs_drv_t * d, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    read_cb_cnt++;
+    return read_cb_ori(d, file_p, buf, btr, br);
+}
+
+static void cache_set(uint16_t block_size, uint16_t block_cnt)
+{
+    lv_fs_drv_cache_free(drv);
+    drv->cache_size = block_size;
+    drv->cache_block_cnt = block_cnt;
+}
+
+/*Read the whole file without cache*/
+static uint32_t file_read_ref(uint8_t * buf, uint32_t buf_size)
+{
+    FILE * f = fopen(&READ_PATH[2], "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint32_t size = (uint32_t)fread(buf, 1, buf_size, f);
+    fclose(f);
+    return size;
+}
+
+void setUp(void)
+{
+    drv = lv_fs_get_drv('B');
+    TEST_ASSERT_NOT_NULL(drv);
+    cache_size_ori = drv->cache_size;
+    cache_block_cnt_ori = drv->cache_block_cnt;
+    read_cb_ori = drv->read_cb;
+    drv->read_cb = read_cb_count;
+    read_cb_cnt = 0;
+}
+
+void tearDown(void)
+{
+    cache_set(cache_size_ori, cache_block_cnt_ori);
+    drv->read_cb = read_cb_ori;
+}
+
+void test_fs_cache_random_read(void)
+{
+    static uint8_t ref[1024];
+    uint32_t size = file_read_ref(ref, sizeof(ref));
+
+    cache_set(64, 3);
+
+    lv_fs_file_t f[2];
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[0], READ_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[1], READ_PATH, LV_FS_MODE_RD));
+
+    uint32_t pos[2] = {0, 0};
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        uint32_t fi = i & 1;
+        switch(lv_rand(0, 3)) {
+            case 0:
+                pos[fi] = lv_rand(0, size + 10);
+                TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f[fi], pos[fi], LV_FS_SEEK_SET));
+                break;
+            case 1: {
+                    uint32_t ofs = lv_rand(0, 100);
+                    pos[fi] += ofs;
+                    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f[fi], ofs, LV_FS_SEEK_CUR));
+                    break;
+                }
+            case 2:
+                pos[fi] = size;
+                TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f[fi], 0, LV_FS_SEEK_END));
+                break;
+            default:
+                break;
+        }
+
+        uint32_t tell;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f[fi], &tell));
+        TEST_ASSERT_EQUAL_UINT32(pos[fi], tell);
+
+        /*Reads both inside and across the blocks, and whole blocks*/
+        uint8_t buf[200];
+        uint32_t btr = lv_rand(1, sizeof(buf));
+        uint32_t br;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f[fi], buf, btr, &br));
+
+        uint32_t exp = pos[fi] >= size ? 0 : LV_MIN(btr, size - pos[fi]);
+        TEST_ASSERT_EQUAL_UINT32(exp, br);
+        if(br) TEST_ASSERT_EQUAL_MEMORY(&ref[pos[fi]], buf, br);
+        pos[fi] += br;
+    }
+
+    lv_fs_close(&f[0]);
+    lv_fs_close(&f[1]);
+}
+
+void test_fs_cache_lru(void)
+{
+    cache_set(64, 2);
+
+    lv_fs_file_t f[2];
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[0], READ_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f[1], READ_PATH, LV_FS_MODE_RD));
+
+    /*The blocks are shared by the files, a block of one file replaces the least recently used block of the other*/
+    static const struct {
+        uint32_t fi;
+        uint32_t pos;
+    } reads[] = {
+        {0, 0},     /*miss*/
+        {1, 200},   /*miss*/
+        {0, 10},    /*hit*/
+        {0, 400},   /*miss, replaces the block of the second file*/
+        {1, 200},   /*miss, replaces the first block of the first file*/
+        {0, 410},   /*hit*/
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(reads) / sizeof(reads[0]); i++) {
+        uint8_t buf[8];
+        uint32_t br;
+        lv_fs_seek(&f[reads[i].fi], reads[i].pos, LV_FS_SEEK_SET);
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f[reads[i].fi], buf, sizeof(buf), &br));
+        TEST_ASSERT_EQUAL_UINT32(sizeof(buf), br);
+    }
+
+    lv_fs_cache_monitor_t mon;
+    lv_fs_drv_cache_monitor(drv, &mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.read_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, read_cb_cnt);
+
+    lv_fs_close(&f[0]);
+    lv_fs_close(&f[1]);
+}
+
+void test_fs_cache_scan_resistant(void)
+{
+    cache_set(64, 3);
+
+    lv_fs_file_t fa;
+    lv_fs_file_t fb;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fa, READ_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fb, READ_PATH, LV_FS_MODE_RD));
+
+    uint8_t buf[20];
+    uint32_t br;
+    lv_fs_seek(&fa, 300, LV_FS_SEEK_SET);
+    lv_fs_read(&fa, buf, sizeof(buf), &br);
+
+    /*Streaming `fb` reuses its own blocks instead of replacing the block of `fa`*/
+    do {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fb, buf, sizeof(buf), &br));
+    } while(br);
+
+    lv_fs_cache_monitor_t mon;
+    lv_fs_drv_cache_monitor(drv, &mon);
+    uint32_t hit_cnt = mon.hit_cnt;
+
+    lv_fs_seek(&fa, 310, LV_FS_SEEK_SET);
+    lv_fs_read(&fa, buf, sizeof(buf), &br);
+    lv_fs_drv_cache_monitor(drv, &mon);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 1, mon.hit_cnt);
+
+    lv_fs_close(&fa);
+    lv_fs_close(&fb);
+}
+
+void test_fs_cache_write(void)
+{
+    char path[64];
+    lv_snprintf(path, sizeof(path), "B:/tmp/lv_test_fs_cache_%d.txt", (int)getpid());
+    FILE * fp = fopen(&path[2], "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fputs("0123456789abcdefghijklmnopqrstuvwxyz", fp);
+    fclose(fp);
+
+    cache_set(16, 2);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD | LV_FS_MODE_WR));
+
+    char buf[8];
+    uint32_t br;
+    lv_fs_read(&f, buf, 4, &br);
+    TEST_ASSERT_EQUAL_MEMORY("0123", buf, 4);
+
+    /*The written data replaces the cached block*/
+    uint32_t bw;
+    lv_fs_seek(&f, 2, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, "XYZ", 3, &bw));
+    TEST_ASSERT_EQUAL_UINT32(3, bw);
+
+    lv_fs_read(&f, buf, 2, &br);
+    TEST_ASSERT_EQUAL_MEMORY("56", buf, 2);
+
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    lv_fs_read(&f, buf, 8, &br);
+    TEST_ASSERT_EQUAL_MEMORY("01XYZ567", buf, 8);
+
+    lv_fs_close(&f);
+    remove(&path[2]);
+}
+
+void test_fs_cache_prefetch(void)
+{
+#if LV_FS_CACHE_BLOCK_CNT
+#if LV_FS_CACHE_PREFETCH
+    cache_set(64, 4);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, READ_PATH, LV_FS_MODE_RD));
+
+    /*Reading two blocks in order asks for the third one*/
+    uint8_t buf[100];
+    uint32_t br;
+    lv_fs_read(&f, buf, 100, &br);
+
+    lv_fs_cache_monitor_t mon;
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        lv_fs_drv_cache_monitor(drv, &mon);
+        if(mon.prefetch_cnt) break;
+        usleep(1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, mon.prefetch_cnt);
+
+    lv_fs_read(&f, buf, 40, &br);
+    lv_fs_drv_cache_monitor(drv, &mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.prefetch_hit_cnt);
+
+    lv_fs_close(&f);
+#endif
+#endif
+}
+
+/*Replay the accesses of the font loader and the decoders*/
+static void bench_font(void)
+{
+    lv_font_t * font = lv_font_load("B:src/test_fonts/font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    lv_font_free(font);
+}
+
+#if LV_USE_SJPG
+static void bench_sjpg(void)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, "B:../examples/libs/sjpg/small_image.sjpg",
+                                                     lv_color_black(), 0));
+    static uint8_t line[1024 * sizeof(lv_color_t)];
+    lv_coord_t y;
+    for(y = 0; y < dsc.header.h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, LV_MIN(dsc.header.w, 1024), line));
+    }
+    lv_img_decoder_close(&dsc);
+}
+#endif
+
+#if LV_USE_GIF
+static void bench_gif(void)
+{
+    gd_GIF * gif = gd_open_gif_file("B:../examples/libs/gif/bulb.gif");
+    TEST_ASSERT_NOT_NULL(gif);
+    /*The animation loops forever, play a few rounds*/
+    uint32_t i;
+    for(i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+    }
+    gd_close_gif(gif);
+}
+#endif
+
+static void bench_run(const char * name, void (*cb)(void))
+{
+    uint32_t i;
+    uint32_t read_cnt[2];
+    uint32_t elapsed[2];
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        if(c == 0) cache_set(0, 0);
+        else cache_set(512, 8);
+
+        read_cb_cnt = 0;
+        uint32_t start = lv_test_time_us();
+        for(i = 0; i < BENCH_CNT; i++) cb();
+        elapsed[c] = lv_test_time_us() - start;
+        read_cnt[c] = read_cb_cnt;
+    }
+
+    lv_fs_cache_monitor_t mon;
+    lv_fs_drv_cache_monitor(drv, &mon);
+    uint32_t access_cnt = mon.hit_cnt + mon.miss_cnt;
+    TEST_PRINTF("%s: %"LV_PRIu32" -> %"LV_PRIu32" reads, %"LV_PRIu32" -> %"LV_PRIu32" us, "
+                "%"LV_PRIu32" percent hits, %"LV_PRIu32" prefetched", name, read_cnt[0] / BENCH_CNT,
+                read_cnt[1] / BENCH_CNT, elapsed[0] / BENCH_CNT, elapsed[1] / BENCH_CNT,
+                access_cnt ? mon.hit_cnt * 100 / access_cnt : 0, mon.prefetch_cnt / BENCH_CNT);
+
+    TEST_ASSERT_LESS_THAN_UINT32(read_cnt[0], read_cnt[1]);
+}
+
+void test_fs_cache_bench(void)
+{
+    /*The loader reads the bit packed glyphs byte by byte*/
+    bench_run("font loader", bench_font);
+
+#if LV_USE_SJPG
+    /*The JPEG decoder reads the header in small pieces and the fragments in chunks*/
+    bench_run("sjpg", bench_sjpg);
+#endif
+
+#if LV_USE_GIF
+    /*The LZW data is read byte by byte*/
+    bench_run("gif", bench_gif);
+#endif
+}
+
+#endif
@@ -0,0 +1,281 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_FS_MMAP
+#include <stdio.h>
+#include <unistd.h>
+
+#define IMG_W   13
+#define IMG_H   7
+
+/*Write an image file in the `.bin` format with the given color format and pattern. Return the written data.*/
+static uint8_t * img_file_create(char * path, lv_img_cf_t cf, uint32_t * data_size)
+{
+    lv_snprintf(path, 64, "/tmp/lv_test_fs_mmap_%d_%d.bin", (int)getpid(), (int)cf);
+
+    lv_img_header_t header;
+    lv_memset_00(&header, sizeof(header));
+    header.cf = cf;
+    header.w = IMG_W;
+    header.h = IMG_H;
+
+    *data_size = lv_img_buf_get_img_size(IMG_W, IMG_H, cf);
+    uint8_t * data = lv_mem_alloc(*data_size);
+    uint32_t i;
+    for(i = 0; i < *data_size; i++) data[i] = (uint8_t)(i * 37 + 11);
+    if(cf == LV_IMG_CF_TRUE_COLOR) {
+        /*Avoid the chroma key color and make the colors valid in any color depth*/
+        lv_color_t * px = (lv_color_t *)data;
+        for(i = 0; i < IMG_W * IMG_H; i++) px[i] = lv_color_make(i * 7, 255 - i, i * 3);
+    }
+
+    FILE * f = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(data, 1, *data_size, f);
+    fclose(f);
+    return data;
+}
+
+/*Decode the image with the mapping and the posix driver and compare the result*/
+static void check_img(lv_img_cf_t cf, bool in_place)
+{
+    char path[64];
+    uint32_t data_size;
+    uint8_t * data = img_file_create(path, cf, &data_size);
+
+    char src_mmap[72];
+    char src_posix[72];
+    lv_snprintf(src_mmap, sizeof(src_mmap), "C:%s", path);
+    lv_snprintf(src_posix, sizeof(src_posix), "B:%s", path);
+
+    lv_img_decoder_dsc_t dsc_mmap;
+    lv_img_decoder_dsc_t dsc_posix;
+    lv_color_t color = lv_palette_main(LV_PALETTE_RED);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc_mmap, src_mmap, color, 0));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc_posix, src_posix, color, 0));
+
+    /*The data is used in place from the mapped file, else it's decoded line by line*/
+    if(in_place) TEST_ASSERT_EQUAL_MEMORY(data, dsc_mmap.img_data, data_size);
+    else TEST_ASSERT_NULL(dsc_mmap.img_data);
+
+    uint8_t buf_mmap[IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    uint8_t buf_posix[IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x += 5) {
+            lv_coord_t len = LV_MIN(5, IMG_W - x);
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc_mmap, x, y, len, buf_mmap));
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc_posix, x, y, len, buf_posix));
+            TEST_ASSERT_EQUAL_MEMORY(buf_posix, buf_mmap, len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+        }
+    }
+
+    lv_img_decoder_close(&dsc_mmap);
+    lv_img_decoder_close(&dsc_posix);
+    lv_mem_free(data);
+    remove(path);
+}
+
+static uint32_t mem_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/*Compare the glyphs of the same font loaded by two drivers*/
+static void check_same_glyphs(const lv_font_t * f1, const lv_font_t * f2)
+{
+    uint8_t buf[1024];
+    uint32_t letter;
+    for(letter = 0x20; letter < 0x7F; letter++) {
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found = lv_font_get_glyph_dsc(f1, &g1, letter, 'A');
+        TEST_ASSERT_EQUAL(found, lv_font_get_glyph_dsc(f2, &g2, letter, 'A'));
+        if(!found) continue;
+
+        TEST_ASSERT_EQUAL(g1.adv_w, g2.adv_w);
+        TEST_ASSERT_EQUAL(g1.box_w, g2.box_w);
+        TEST_ASSERT_EQUAL(g1.box_h, g2.box_h);
+        TEST_ASSERT_EQUAL(g1.ofs_x, g2.ofs_x);
+        TEST_ASSERT_EQUAL(g1.ofs_y, g2.ofs_y);
+
+        /*Copy the first bitmap, the compressed ones are decompressed into a common buffer*/
+        uint32_t size = (g1.box_w * g1.box_h * g1.bpp + 7) / 8;
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(buf), size);
+        if(size == 0) continue;
+        lv_memcpy(buf, lv_font_get_glyph_bitmap(f1, letter), size);
+        TEST_ASSERT_EQUAL_MEMORY(buf, lv_font_get_glyph_bitmap(f2, letter), size);
+    }
+}
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_fs_mmap_read(void)
+{
+#if LV_USE_FS_MMAP
+    /*Read the expected content with an other driver*/
+    static char read_exp[1024];
+    lv_fs_file_t f;
+    uint32_t exp_len;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "B:src/test_files/readtest.txt", LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, read_exp, sizeof(read_exp), &exp_len));
+    lv_fs_close(&f);
+    TEST_ASSERT_GREATER_THAN(200, exp_len);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "C:src/test_files/readtest.txt", LV_FS_MODE_RD));
+
+    /*Use an odd size to read across the end of the file*/
+    uint8_t buf[79];
+    uint32_t cnt = 0;
+    uint32_t br = 1;
+    while(br) {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+        if(br) TEST_ASSERT_EQUAL_MEMORY(read_exp + cnt, buf, br);
+        cnt += br;
+    }
+    TEST_ASSERT_EQUAL(exp_len, cnt);
+
+    uint32_t pos;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 10, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 5, LV_FS_SEEK_CUR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &pos));
+    TEST_ASSERT_EQUAL(15, pos);
+
+    /*The pointers point into the file and don't move the read pointer*/
+    const void * ptr;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_get_ptr(&f, 0, cnt, &ptr));
+    TEST_ASSERT_EQUAL_MEMORY(read_exp, ptr, cnt);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_get_ptr(&f, 100, 20, &ptr));
+    TEST_ASSERT_EQUAL_MEMORY(read_exp + 100, ptr, 20);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &pos));
+    TEST_ASSERT_EQUAL(15, pos);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_INV_PARAM, lv_fs_get_ptr(&f, cnt - 10, 11, &ptr));
+    TEST_ASSERT_NULL(ptr);
+    lv_fs_close(&f);
+
+    /*Other drivers can't give pointers*/
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "B:src/test_files/readtest.txt", LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, lv_fs_get_ptr(&f, 0, 10, &ptr));
+    lv_fs_close(&f);
+
+    /*Read only*/
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "C:src/test_files/readtest.txt", LV_FS_MODE_WR));
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "C:src/test_files/no_such_file.txt", LV_FS_MODE_RD));
+
+    lv_fs_dir_t d;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_dir_open(&d, "C:src/test_files"));
+    char fn[LV_FS_MAX_FN_LENGTH];
+    bool found = false;
+    do {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_dir_read(&d, fn));
+        if(strcmp(fn, "readtest.txt") == 0) found = true;
+    } while(fn[0] != '\0');
+    lv_fs_dir_close(&d);
+    TEST_ASSERT_TRUE(found);
+#endif
+}
+
+void test_fs_mmap_img(void)
+{
+#if LV_USE_FS_MMAP
+    /*Used in place*/
+    check_img(LV_IMG_CF_TRUE_COLOR, true);
+    check_img(LV_IMG_CF_ALPHA_8BIT, true);
+
+    /*Decoded line by line from the mapped file*/
+    check_img(LV_IMG_CF_ALPHA_4BIT, false);
+    check_img(LV_IMG_CF_ALPHA_1BIT, false);
+    check_img(LV_IMG_CF_INDEXED_2BIT, false);
+    check_img(LV_IMG_CF_INDEXED_8BIT, false);
+#endif
+}
+
+void test_fs_mmap_font(void)
+{
+#if LV_USE_FS_MMAP
+    const char * names[] = {"src/test_fonts/font_1.fnt", "src/test_fonts/font_2.fnt", "src/test_fonts/font_3.fnt"};
+    uint32_t i;
+    for(i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "B:%s", names[i]);
+        uint32_t used_read = mem_used();
+        lv_font_t * font_read = lv_font_load(path);
+        used_read = mem_used() - used_read;
+
+        lv_snprintf(path, sizeof(path), "C:%s", names[i]);
+        uint32_t used_mapped = mem_used();
+        lv_font_t * font_mapped = lv_font_load(path);
+        used_mapped = mem_used() - used_mapped;
+
+        TEST_ASSERT_NOT_NULL(font_read);
+        TEST_ASSERT_NOT_NULL(font_mapped);
+
+#if LV_MEM_CUSTOM == 0
+        /*The character maps and kerning tables are used in place (the bitmaps are not byte aligned in these fonts).
+         *font_3 has no such tables so only the kept file is added.*/
+        if(i < 2) TEST_ASSERT_LESS_THAN(used_read * 2 / 3, used_mapped);
+#else
+        LV_UNUSED(used_read);
+        LV_UNUSED(used_mapped);
+#endif
+
+        check_same_glyphs(font_read, font_mapped);
+
+        lv_font_free(font_read);
+        lv_font_free(font_mapped);
+    }
+#endif
+}
+
+void test_fs_mmap_font_in_place(void)
+{
+#if LV_USE_FS_MMAP
+    /*The fonts converted by `scripts/font_bin_to_mmap.py` have no tables to parse*/
+    const char * names[] = {"src/test_fonts/font_1", "src/test_fonts/font_2", "src/test_fonts/font_3"};
+    uint32_t i;
+    for(i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "B:%s.fnt", names[i]);
+        lv_font_t * font_bin = lv_font_load(path);
+
+        lv_snprintf(path, sizeof(path), "C:%s.lvf", names[i]);
+        uint32_t used_mapped = mem_used();
+        lv_font_t * font_mapped = lv_font_load(path);
+        used_mapped = mem_used() - used_mapped;
+
+        TEST_ASSERT_NOT_NULL(font_bin);
+        TEST_ASSERT_NOT_NULL(font_mapped);
+
+#if LV_MEM_CUSTOM == 0 && LV_FONT_FMT_TXT_LARGE == 0
+        /*Only the font, its descriptor, the kept file and the character map and kerning descriptors are allocated.
+         *The glyph descriptors, bitmaps and lists (5..7 kB) are used in place.*/
+        TEST_ASSERT_LESS_THAN(512, used_mapped);
+#else
+        LV_UNUSED(used_mapped);
+#endif
+
+        check_same_glyphs(font_bin, font_mapped);
+
+        lv_font_free(font_bin);
+        lv_font_free(font_mapped);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,254 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <stdlib.h>
+
+#if LV_IMG_CACHE_DEF_SIZE
+/*Decodes "T:<width>/<name>" paths to a square true color image in RAM*/
+static lv_img_decoder_t * decoder;
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+
+static lv_res_t test_decoder_info(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+
+    const char * path = src;
+    if(path[0] != 'T' || path[1] != ':') return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    header->w = (uint32_t)strtol(&path[2], NULL, 10);
+    header->h = header->w;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    uint8_t * data = lv_mem_alloc(size);
+    TEST_ASSERT_NOT_NULL(data);
+    lv_memset_00(data, size);
+    dsc->img_data = data;
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void test_decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    lv_mem_free((void *)dsc->img_data);
+    close_cnt++;
+}
+
+/*RAM used by a cached test image*/
+static uint32_t img_size(const char * path)
+{
+    uint32_t w = (uint32_t)strtol(&path[2], NULL, 10);
+    return sizeof(_lv_img_cache_entry_t) + strlen(path) + 1 + w * w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+}
+
+static _lv_img_cache_entry_t * open_img(const char * path)
+{
+    return _lv_img_cache_open(path, lv_color_black(), 0);
+}
+#endif
+
+void setUp(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, test_decoder_info);
+    lv_img_decoder_set_open_cb(decoder, test_decoder_open);
+    lv_img_decoder_set_close_cb(decoder, test_decoder_close);
+    open_cnt = 0;
+    close_cnt = 0;
+
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_mem_size(0);
+#endif
+}
+
+void tearDown(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Close the test images while their decoder exists*/
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_mem_size(LV_IMG_CACHE_MEM_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(open_cnt, close_cnt);
+    lv_img_decoder_delete(decoder);
+#endif
+}
+
+void test_img_cache_hit(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_img_cache_entry_t * entry = open_img("T:10/a");
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_PTR(entry, open_img("T:10/a"));
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+
+    /*The path is compared, not the pointer*/
+    char path[] = "T:10/a";
+    TEST_ASSERT_EQUAL_PTR(entry, open_img(path));
+
+    /*Other colors and frames are opened separately*/
+    TEST_ASSERT_NOT_EQUAL(entry, _lv_img_cache_open("T:10/a", lv_color_white(), 0));
+    TEST_ASSERT_NOT_EQUAL(entry, _lv_img_cache_open("T:10/a", lv_color_black(), 1));
+    TEST_ASSERT_EQUAL_UINT32(3, open_cnt);
+
+    lv_img_cache_monitor_t mon;
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3 * img_size("T:10/a"), mon.used_size);
+
+    /*Every color and frame of the image is closed*/
+    lv_img_cache_invalidate_src("T:10/a");
+    TEST_ASSERT_EQUAL_UINT32(3, close_cnt);
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+#endif
+}
+
+void test_img_cache_least_recently_used(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_set_size(3);
+    open_img("T:10/a");
+    open_img("T:10/b");
+    open_img("T:10/c");
+    open_img("T:10/a");
+
+    /*"b" is the least recently used*/
+    open_img("T:10/d");
+    TEST_ASSERT_EQUAL_UINT32(4, open_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+
+    open_img("T:10/a");
+    open_img("T:10/c");
+    open_img("T:10/d");
+    TEST_ASSERT_EQUAL_UINT32(4, open_cnt);
+
+    open_img("T:10/b");
+    TEST_ASSERT_EQUAL_UINT32(5, open_cnt);
+
+    lv_img_cache_monitor_t mon;
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(4, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(5, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.entry_cnt);
+#endif
+}
+
+void test_img_cache_mem_size(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Room for two small images*/
+    lv_img_cache_set_mem_size(2 * img_size("T:10/a") + img_size("T:10/a") / 2);
+    open_img("T:10/a");
+    open_img("T:10/b");
+    open_img("T:10/c");
+
+    lv_img_cache_monitor_t mon;
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * img_size("T:10/a"), mon.used_size);
+
+    /*An image larger than the limit is still opened but closes all the others*/
+    TEST_ASSERT_NOT_NULL(open_img("T:30/large"));
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(img_size("T:30/large"), mon.used_size);
+
+    /*Lowering the limit closes the images right away*/
+    open_img("T:10/a");
+    lv_img_cache_set_mem_size(img_size("T:10/a"));
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(img_size("T:10/a"), mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(img_size("T:10/a"), mon.total_size);
+#endif
+}
+
+void test_img_cache_pin(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_set_size(2);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin("T:10/icon"));
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+
+    /*The other images take turns in the other entry*/
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        open_img(i % 2 ? "T:10/a" : "T:10/b");
+    }
+    TEST_ASSERT_EQUAL_UINT32(11, open_cnt);
+
+    open_img("T:10/icon");
+    TEST_ASSERT_EQUAL_UINT32(11, open_cnt);
+
+    /*Only pinned images: the cache grows*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin("T:10/a"));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin("T:10/b"));
+    lv_img_cache_monitor_t mon;
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.entry_cnt);
+
+    /*Unpinned images can be closed again*/
+    lv_img_cache_unpin("T:10/icon");
+    lv_img_cache_unpin("T:10/a");
+    lv_img_cache_unpin("T:10/b");
+    open_img("T:10/c");
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.entry_cnt);
+
+    /*The cache is disabled with 0 entries*/
+    lv_img_cache_set_size(0);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_cache_pin("T:10/icon"));
+#endif
+}
+
+void test_img_cache_many(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Many images in the same buckets*/
+    lv_img_cache_set_size(100);
+
+    char path[16];
+    uint32_t round;
+    for(round = 0; round < 3; round++) {
+        uint32_t i;
+        for(i = 0; i < 100; i++) {
+            lv_snprintf(path, sizeof(path), "T:4/%"LV_PRIu32, i);
+            _lv_img_cache_entry_t * entry = open_img(path);
+            TEST_ASSERT_NOT_NULL(entry);
+            TEST_ASSERT_EQUAL_STRING(path, entry->dec_dsc.src);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, open_cnt);
+
+    lv_img_cache_monitor_t mon;
+    lv_img_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(200, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(100, mon.entry_cnt);
+
+    /*One more closes the least recently used, i.e. the first one*/
+    open_img("T:4/x");
+    open_img("T:4/1");
+    open_img("T:4/0");
+    TEST_ASSERT_EQUAL_UINT32(102, open_cnt);
+#endif
+}
+
+#endif
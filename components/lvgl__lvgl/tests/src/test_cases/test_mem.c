@@ -3,6 +3,8 @@
 
 #include "unity/unity.h"
 
+#define REFR_CNT 4
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -10,7 +12,7 @@ void setUp(void)
 
 void tearDown(void)
 {
-    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
 }
 
 /* #3324 */
@@ -23,4 +25,106 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+void test_mem_buf_arena_stack(void)
+{
+#if LV_MEM_BUF_ARENA_SIZE
+    lv_mem_buf_free_all();
+
+    lv_mem_buf_monitor_t mon;
+    uint8_t * buf1 = lv_mem_buf_get(100);
+    uint8_t * buf2 = lv_mem_buf_get(3);
+    uint8_t * buf3 = lv_mem_buf_get(1000);
+    TEST_ASSERT_NOT_NULL(buf1);
+    TEST_ASSERT_TRUE(buf1 < buf2 && buf2 < buf3);
+    TEST_ASSERT_EQUAL(0, (lv_uintptr_t)buf2 % sizeof(void *));
+    TEST_ASSERT_EQUAL(0, (lv_uintptr_t)buf3 % sizeof(void *));
+    lv_memset_ff(buf3, 1000);
+
+    lv_mem_buf_monitor(&mon);
+    uint32_t used = mon.used;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1103, used);
+
+    /*The memory of a buffer is reused only when the ones above it are released too*/
+    lv_mem_buf_release(buf2);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(used, mon.used);
+
+    lv_mem_buf_release(buf3);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_LESS_THAN_UINT32(used - 1000, mon.used);
+    TEST_ASSERT_EQUAL_PTR(buf2, lv_mem_buf_get(8));
+
+    lv_mem_buf_release(buf2);
+    lv_mem_buf_release(buf1);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used);
+    TEST_ASSERT_EQUAL_UINT32(used, mon.max_peak);
+
+    /*Emptying the arena finishes the frame*/
+    lv_mem_buf_get(10);
+    lv_mem_buf_free_all();
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used);
+    TEST_ASSERT_EQUAL_UINT32(used, mon.frame_peak);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.overflow_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_mem_buf_no_heap_calls_while_drawing(void)
+{
+#if LV_MEM_BUF_ARENA_SIZE && LV_MEM_CUSTOM
+    /*Something like a clock face*/
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x224488), 0);
+    lv_obj_set_style_bg_grad_color(lv_scr_act(), lv_color_hex(0x112233), 0);
+    lv_obj_set_style_bg_grad_dir(lv_scr_act(), LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * panel = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(panel, 500, 300);
+    lv_obj_center(panel);
+    lv_obj_set_style_radius(panel, 30, 0);
+    lv_obj_set_style_shadow_width(panel, 40, 0);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_70, 0);
+
+    lv_obj_t * time_label = lv_label_create(panel);
+    lv_label_set_text(time_label, "12:34");
+    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -30);
+
+    lv_obj_t * date_label = lv_label_create(panel);
+    lv_label_set_text(date_label, "Sunday\nOctober 18, 2026");
+    lv_obj_align(date_label, LV_ALIGN_CENTER, 0, 40);
+
+    lv_obj_t * line = lv_line_create(panel);
+    static const lv_point_t points[] = {{0, 0}, {400, 0}};
+    lv_line_set_points(line, points, 2);
+    lv_obj_set_style_line_width(line, 4, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+    lv_obj_align(line, LV_ALIGN_CENTER, 0, 10);
+
+    /*Let the caches fill up. The draw calls of the objects are recorded in the second frame.*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+
+    uint32_t heap_call_cnt = lv_test_get_heap_call_cnt();
+    for(i = 0; i < REFR_CNT; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    TEST_ASSERT_EQUAL_UINT32(heap_call_cnt, lv_test_get_heap_call_cnt());
+
+    lv_mem_buf_monitor_t mon;
+    lv_mem_buf_monitor(&mon);
+    TEST_PRINTF("arena peak: %"LV_PRIu32" bytes", mon.max_peak);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, mon.max_peak);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.overflow_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
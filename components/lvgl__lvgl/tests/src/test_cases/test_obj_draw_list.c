@@ -0,0 +1,288 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+#if LV_OBJ_DRAW_LIST_SIZE
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint32_t draw_cnt;
+
+/*Draw the screen with the draw events as reference*/
+static void refr_ref(void)
+{
+    lv_obj_enable_draw_list(false);
+    lv_test_refr_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_obj_enable_draw_list(true);
+}
+
+/*Draw the screen a few times to draw, record and replay the objects*/
+static void check_same_pixels(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_test_refr_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+}
+
+static void draw_main_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+#endif
+
+void setUp(void)
+{
+#if LV_OBJ_DRAW_LIST_SIZE
+    draw_cnt = 0;
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_OBJ_DRAW_LIST_SIZE
+    lv_obj_enable_draw_list(true);
+#endif
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+#endif
+}
+
+void test_obj_draw_list_replay(void)
+{
+#if LV_OBJ_DRAW_LIST_SIZE
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*Every band of a parallel redraw would draw the label*/
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Hello");
+    lv_obj_center(label);
+    lv_obj_add_event_cb(label, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Drawn, recorded, then replayed without events*/
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    /*Changed: drawn in the frame of the change and recorded in the next*/
+    lv_label_set_text(label, "World");
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(3, draw_cnt);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+
+    /*Changed in every frame: never recorded*/
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_label_set_text_fmt(label, "%"LV_PRIu32, i);
+        lv_test_refr_screen();
+    }
+    TEST_ASSERT_EQUAL_UINT32(7, draw_cnt);
+
+    /*Moving the parent moves the label too*/
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(8, draw_cnt);
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_parent(label, cont);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    uint32_t cnt = draw_cnt;
+    lv_obj_set_pos(cont, 100, 100);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(cnt + 1, draw_cnt);
+
+    /*Style changes record it again*/
+    lv_test_refr_screen();
+    cnt = draw_cnt;
+    lv_obj_set_style_text_color(cont, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(cnt + 1, draw_cnt);
+
+    /*Disabled replaying: always drawn*/
+    lv_test_refr_screen();
+    cnt = draw_cnt;
+    lv_obj_enable_draw_list(false);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(cnt + 2, draw_cnt);
+#endif
+}
+
+void test_obj_draw_list_unrelated_style_change(void)
+{
+#if LV_OBJ_DRAW_LIST_SIZE
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+    static lv_style_t style_other;
+    lv_style_init(&style_other);
+    lv_style_set_bg_color(&style_other, lv_palette_main(LV_PALETTE_GREEN));
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Hello");
+    lv_obj_add_event_cb(label, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Transformed images are recorded as `lv_draw_img()` calls too*/
+    LV_IMG_DECLARE(img_caret_down);
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_caret_down);
+    lv_img_set_angle(img, 300);
+    lv_img_set_zoom(img, 384);
+    lv_obj_set_pos(img, 200, 100);
+    lv_obj_add_event_cb(img, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * other = lv_obj_create(lv_scr_act());
+    lv_obj_add_style(other, &style_other, 0);
+    lv_obj_set_pos(other, 100, 50);
+
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+
+    /*Changing the styles of another object keeps replaying them*/
+    lv_style_set_bg_color(&style_other, lv_palette_main(LV_PALETTE_RED));
+    lv_obj_report_style_change(&style_other);
+    lv_obj_set_style_border_width(other, 6, 0);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+
+    /*Even without reporting the change*/
+    lv_style_set_bg_color(&style_other, lv_palette_main(LV_PALETTE_BLUE));
+    lv_obj_invalidate(other);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+
+    refr_ref();
+    check_same_pixels();
+
+    lv_obj_del(other);
+    lv_style_reset(&style_other);
+#endif
+}
+
+void test_obj_draw_list_not_recorded(void)
+{
+#if LV_OBJ_DRAW_LIST_SIZE && LV_DRAW_COMPLEX
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+    /*Masks which clip the children can't be recorded*/
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_radius(cont, 30, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_add_event_cb(cont, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Drawn, tried to record and drawn again, then always drawn*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(5, draw_cnt);
+
+    /*Neither too many draw calls*/
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_add_event_cb(label, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    char * txt = lv_mem_alloc(LV_OBJ_DRAW_LIST_SIZE + 1);
+    lv_memset(txt, 'a', LV_OBJ_DRAW_LIST_SIZE);
+    txt[LV_OBJ_DRAW_LIST_SIZE] = '\0';
+    lv_label_set_text(label, txt);
+    lv_mem_free(txt);
+
+    draw_cnt = 0;
+    for(i = 0; i < 4; i++) lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(4 + 5, draw_cnt);
+#endif
+}
+
+void test_obj_draw_list_same_pixels(void)
+{
+#if LV_OBJ_DRAW_LIST_SIZE
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 380, 440);
+    lv_obj_set_pos(cont, 10, 20);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t * label = lv_label_create(cont);
+    lv_obj_set_width(label, lv_pct(100));
+    lv_label_set_text(label, "A long text which is wrapped to a few lines to see that every line is replayed. "
+                      "#ff0000 Recolored# too.");
+    lv_label_set_recolor(label, true);
+
+    lv_obj_t * btn = lv_btn_create(cont);
+    lv_obj_t * btn_label = lv_label_create(btn);
+    lv_label_set_text(btn_label, LV_SYMBOL_OK " Button");
+
+    lv_obj_t * cb = lv_checkbox_create(cont);
+    lv_checkbox_set_text(cb, "Checkbox");
+    lv_obj_add_state(cb, LV_STATE_CHECKED);
+
+    lv_obj_t * sw = lv_switch_create(cont);
+    lv_obj_t * slider = lv_slider_create(cont);
+    lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+
+    lv_obj_t * dd = lv_dropdown_create(cont);
+    lv_obj_t * ta = lv_textarea_create(cont);
+    lv_textarea_set_text(ta, "Text area");
+    lv_obj_set_height(ta, 200);
+
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_arc_set_value(arc, 70);
+    lv_obj_set_pos(arc, 420, 20);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, LV_SYMBOL_SETTINGS);
+    lv_obj_set_pos(img, 620, 20);
+
+    static lv_point_t points[] = {{0, 0}, {60, 40}, {120, 10}, {180, 60}};
+    lv_obj_t * line = lv_line_create(lv_scr_act());
+    lv_line_set_points(line, points, 4);
+    lv_obj_set_style_line_width(line, 5, 0);
+    lv_obj_set_pos(line, 420, 200);
+
+    lv_obj_t * chart = lv_chart_create(lv_scr_act());
+    lv_obj_set_size(chart, 300, 150);
+    lv_obj_set_pos(chart, 420, 300);
+    lv_chart_series_t * ser = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_BLUE), LV_CHART_AXIS_PRIMARY_Y);
+    uint32_t i;
+    for(i = 0; i < 10; i++) lv_chart_set_next_value(chart, ser, (lv_coord_t)((i * 37) % 100));
+
+    refr_ref();
+    check_same_pixels();
+
+    /*Change some objects*/
+    lv_label_set_text(btn_label, "Changed");
+    lv_obj_add_state(sw, LV_STATE_CHECKED);
+    lv_dropdown_set_selected(dd, 2);
+    lv_arc_set_value(arc, 20);
+    refr_ref();
+    check_same_pixels();
+
+    /*Scroll the children of the container*/
+    lv_obj_scroll_to_y(cont, 100, LV_ANIM_OFF);
+    refr_ref();
+    check_same_pixels();
+
+    /*Move a recorded object*/
+    lv_obj_set_pos(img, 650, 40);
+    lv_obj_set_style_opa(chart, LV_OPA_50, 0);
+    refr_ref();
+    check_same_pixels();
+#endif
+}
+
+#endif
@@ -0,0 +1,220 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+#if LV_OBJ_LAYER_CACHE_SIZE
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint32_t draw_cnt;
+
+static void draw_main_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+/*An opaque container which can be rendered into a layer without alpha channel*/
+static lv_obj_t * cont_create(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_set_pos(cont, 100, 100);
+    lv_obj_set_style_radius(cont, 0, 0);
+    lv_obj_set_style_bg_color(cont, lv_palette_lighten(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_layer_cache(cont, true);
+    return cont;
+}
+
+/*Draw the screen with temporary layers as reference, then with the kept layer*/
+static void check_same_pixels(lv_obj_t * cont)
+{
+    lv_obj_set_layer_cache(cont, false);
+    lv_test_refr_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_obj_set_layer_cache(cont, true);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_test_refr_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*The bands drawn in parallel transform the same kept layer.
+     *(The temporary layers of the bands are clipped differently so their rotated edges might differ.)*/
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+    for(i = 0; i < 2; i++) {
+        lv_test_refr_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+}
+#endif
+
+void setUp(void)
+{
+#if LV_OBJ_LAYER_CACHE_SIZE
+    draw_cnt = 0;
+#endif
+#if LV_OBJ_DRAW_LIST_SIZE
+    /*Count the draw events of the children, not the replays of their recorded draw calls*/
+    lv_obj_enable_draw_list(false);
+#endif
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*Every band of a parallel redraw would draw the children*/
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_OBJ_DRAW_LIST_SIZE
+    lv_obj_enable_draw_list(true);
+#endif
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+#endif
+}
+
+void test_obj_layer_cache_transform(void)
+{
+#if LV_OBJ_LAYER_CACHE_SIZE
+    lv_obj_t * cont = cont_create();
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "Hello");
+    lv_obj_add_event_cb(label, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_set_style_transform_zoom(cont, 300, 0);
+
+    /*Drawn with a temporary layer, then rendered into the kept layer*/
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    /*Only the kept layer is transformed and blended*/
+    int32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_set_style_transform_zoom(cont, 310 + i * 10, 0);
+        lv_obj_set_style_transform_angle(cont, i * 50, 0);
+        lv_obj_set_style_opa_layered(cont, 250 - i * 20, 0);
+        lv_test_refr_screen();
+    }
+    lv_obj_set_style_transform_pivot_x(cont, 20, 0);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    /*A changed child is drawn in the frame of the change and kept again in the next*/
+    lv_label_set_text(label, "World");
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(3, draw_cnt);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+
+    /*Changed in every frame: never kept*/
+    for(i = 0; i < 3; i++) {
+        lv_label_set_text_fmt(label, "%"LV_PRId32, i);
+        lv_test_refr_screen();
+    }
+    TEST_ASSERT_EQUAL_UINT32(7, draw_cnt);
+
+    /*Other styles of the object render the layer again*/
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(8, draw_cnt);
+    lv_obj_set_style_bg_color(cont, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(10, draw_cnt);
+
+    /*Moved: rendered again at the new position*/
+    lv_obj_set_pos(cont, 120, 80);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(12, draw_cnt);
+
+    /*Disabled: drawn in every frame*/
+    lv_obj_set_layer_cache(cont, false);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(14, draw_cnt);
+#endif
+}
+
+void test_obj_layer_cache_too_large(void)
+{
+#if LV_OBJ_LAYER_CACHE_SIZE
+    lv_obj_t * cont = cont_create();
+    lv_obj_set_size(cont, 2000, LV_OBJ_LAYER_CACHE_SIZE / sizeof(lv_color_t) / 2000 + 1);
+    lv_obj_set_pos(cont, 0, 0);
+    lv_obj_set_style_opa_layered(cont, LV_OPA_50, 0);
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "Hello");
+    lv_obj_add_event_cb(label, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Drawn with temporary layers in every frame*/
+    lv_test_refr_screen();
+    uint32_t frame_cnt = draw_cnt;
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(3 * frame_cnt, draw_cnt);
+
+    /*Fits into the limit: kept from the second frame*/
+    lv_obj_set_size(cont, 300, 200);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    uint32_t cnt = draw_cnt;
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(cnt, draw_cnt);
+#endif
+}
+
+void test_obj_layer_cache_same_pixels(void)
+{
+#if LV_OBJ_LAYER_CACHE_SIZE
+    lv_obj_t * cont = cont_create();
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "A kept layer");
+
+    lv_obj_t * btn = lv_btn_create(cont);
+    lv_obj_t * btn_label = lv_label_create(btn);
+    lv_label_set_text(btn_label, LV_SYMBOL_OK " Button");
+
+    lv_obj_t * slider = lv_slider_create(cont);
+    lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+
+    /*Faded*/
+    lv_obj_set_style_opa_layered(cont, LV_OPA_70, 0);
+    check_same_pixels(cont);
+
+    /*Zoomed*/
+    lv_obj_set_style_opa_layered(cont, LV_OPA_COVER, 0);
+    lv_obj_set_style_transform_zoom(cont, 320, 0);
+    check_same_pixels(cont);
+
+    /*Rotated around the center*/
+    lv_obj_set_style_transform_zoom(cont, 200, 0);
+    lv_obj_set_style_transform_angle(cont, 300, 0);
+    lv_obj_set_style_transform_pivot_x(cont, lv_pct(50), 0);
+    lv_obj_set_style_transform_pivot_y(cont, lv_pct(50), 0);
+    check_same_pixels(cont);
+
+    /*A child changed*/
+    lv_label_set_text(label, "Changed");
+    check_same_pixels(cont);
+#endif
+}
+
+#endif
@@ -0,0 +1,245 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include <time.h>
+
+#define BENCH_REFR_CNT 10
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+static const lv_part_t parts[] = {
+    LV_PART_MAIN, LV_PART_SCROLLBAR, LV_PART_INDICATOR, LV_PART_KNOB,
+    LV_PART_SELECTED, LV_PART_ITEMS, LV_PART_TICKS, LV_PART_CURSOR
+};
+
+static bool value_eq(lv_style_prop_t prop, lv_style_value_t v1, lv_style_value_t v2)
+{
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+        case LV_STYLE_BG_IMG_RECOLOR:
+        case LV_STYLE_BORDER_COLOR:
+        case LV_STYLE_OUTLINE_COLOR:
+        case LV_STYLE_SHADOW_COLOR:
+        case LV_STYLE_IMG_RECOLOR:
+        case LV_STYLE_LINE_COLOR:
+        case LV_STYLE_ARC_COLOR:
+        case LV_STYLE_TEXT_COLOR:
+            return v1.color.full == v2.color.full;
+        case LV_STYLE_BG_GRAD:
+        case LV_STYLE_BG_IMG_SRC:
+        case LV_STYLE_ARC_IMG_SRC:
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_COLOR_FILTER_DSC:
+        case LV_STYLE_ANIM:
+        case LV_STYLE_TRANSITION:
+            return v1.ptr == v2.ptr;
+        default:
+            return v1.num == v2.num;
+    }
+}
+
+/*Compare every property of every part of `obj` and its children with and without the cache*/
+static void check_tree(lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+        lv_style_prop_t prop;
+        for(prop = 1; prop <= _LV_STYLE_LAST_BUILT_IN_PROP; prop++) {
+            lv_obj_enable_style_cache(false);
+            lv_style_value_t ref = lv_obj_get_style_prop(obj, parts[i], prop);
+            lv_obj_enable_style_cache(true);
+            lv_style_value_t miss = lv_obj_get_style_prop(obj, parts[i], prop);
+            lv_style_value_t hit = lv_obj_get_style_prop(obj, parts[i], prop);
+            TEST_ASSERT_TRUE(value_eq(prop, ref, miss));
+            TEST_ASSERT_TRUE(value_eq(prop, ref, hit));
+        }
+    }
+
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        check_tree(lv_obj_get_child(obj, i));
+    }
+}
+
+#if LV_USE_DEMO_WIDGETS
+/*The demo initializes its static styles again on every call, so create it only once*/
+static void load_demo_widgets(void)
+{
+    static lv_obj_t * scr;
+    if(scr == NULL) {
+        scr = lv_obj_create(NULL);
+        lv_scr_load(scr);
+        lv_demo_widgets();
+    }
+    else {
+        lv_scr_load(scr);
+    }
+}
+#endif
+
+/*Resolve the styles the way drawing the objects does*/
+static void init_draw_dscs(lv_obj_t * obj)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &rect_dsc);
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+    lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN);
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        init_draw_dscs(lv_obj_get_child(obj, i));
+    }
+}
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    lv_obj_enable_style_cache(true);
+#endif
+}
+
+void test_obj_style_cache_follows_style_changes(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    static lv_style_t style;
+    static lv_style_t style_pr;
+    lv_style_init(&style);
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style, lv_color_hex(0x112233));
+    lv_style_set_text_color(&style, lv_color_hex(0x223344));
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0x334455));
+
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    TEST_ASSERT_NULL(obj->style_cache);
+
+    lv_obj_add_style(obj, &style, 0);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX32(0x112233, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+    TEST_ASSERT_NOT_NULL(obj->style_cache);
+
+    /*The state is part of the key*/
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX32(0x334455, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX32(0x112233, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+
+    /*Local styles*/
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x445566), 0);
+    TEST_ASSERT_EQUAL_HEX32(0x445566, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_COLOR, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x112233, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+
+    /*Changing a shared style, even without reporting it*/
+    lv_style_set_bg_color(&style, lv_color_hex(0x556677));
+    TEST_ASSERT_EQUAL_HEX32(0x556677, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_HEX32(0x556677, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+
+    /*Only the object's own styles invalidate its cache*/
+    static lv_style_t style_other;
+    lv_style_init(&style_other);
+    uint32_t version = _lv_obj_get_style_version(obj);
+    lv_style_set_bg_color(&style_other, lv_color_hex(0x778899));
+    lv_obj_set_style_bg_color(parent, lv_color_hex(0x8899aa), 0);
+    TEST_ASSERT_EQUAL_UINT32(version, _lv_obj_get_style_version(obj));
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0x99aabb));
+    TEST_ASSERT_NOT_EQUAL(version, _lv_obj_get_style_version(obj));
+    TEST_ASSERT_EQUAL_HEX32(0x556677, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_HEX32(0x99aabb, lv_color_to32(lv_obj_get_style_bg_color(obj, 0)) & 0xffffff);
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    lv_style_reset(&style_other);
+
+    /*Adding and removing styles while refreshing is disabled*/
+    lv_obj_enable_style_refresh(false);
+    lv_obj_remove_style(obj, &style, 0);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_style_prop_get_default(LV_STYLE_BG_COLOR).color),
+                            lv_color_to32(lv_obj_get_style_bg_color(obj, 0)));
+
+    /*Inherited values are looked up in the cache of the parent*/
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_obj_get_style_text_color(parent, 0)),
+                            lv_color_to32(lv_obj_get_style_text_color(obj, 0)));
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x667788), 0);
+    TEST_ASSERT_EQUAL_HEX32(0x667788, lv_color_to32(lv_obj_get_style_text_color(obj, 0)) & 0xffffff);
+
+    /*The cache is freed with the last style*/
+    lv_obj_remove_style_all(obj);
+    TEST_ASSERT_NULL(obj->style_cache);
+
+    lv_obj_del(parent);
+    lv_style_reset(&style);
+    lv_style_reset(&style_pr);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_obj_style_cache_same_values(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE && LV_USE_DEMO_WIDGETS
+    load_demo_widgets();
+    lv_refr_now(NULL);
+    check_tree(lv_scr_act());
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_obj_style_cache_benchmark(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE && LV_USE_DEMO_WIDGETS
+    load_demo_widgets();
+    lv_test_refr_screen();
+
+    uint32_t i;
+    lv_obj_enable_style_cache(false);
+    clock_t start = clock();
+    for(i = 0; i < BENCH_REFR_CNT; i++) lv_test_refr_screen();
+    clock_t off_time = clock() - start;
+
+    lv_obj_enable_style_cache(true);
+    lv_test_refr_screen();
+    start = clock();
+    for(i = 0; i < BENCH_REFR_CNT; i++) lv_test_refr_screen();
+    clock_t on_time = clock() - start;
+
+    /*Only the style lookups of drawing every object*/
+    lv_obj_enable_style_cache(false);
+    start = clock();
+    for(i = 0; i < BENCH_REFR_CNT; i++) init_draw_dscs(lv_scr_act());
+    clock_t dsc_off_time = clock() - start;
+
+    lv_obj_enable_style_cache(true);
+    init_draw_dscs(lv_scr_act());
+    start = clock();
+    for(i = 0; i < BENCH_REFR_CNT; i++) init_draw_dscs(lv_scr_act());
+    clock_t dsc_on_time = clock() - start;
+
+    TEST_PRINTF("demo widgets, full screen refresh: %"LV_PRIu32" us without the style cache, %"LV_PRIu32" us with it",
+                (uint32_t)(off_time * 1000000 / CLOCKS_PER_SEC / BENCH_REFR_CNT),
+                (uint32_t)(on_time * 1000000 / CLOCKS_PER_SEC / BENCH_REFR_CNT));
+    TEST_PRINTF("demo widgets, draw descriptors of all objects: %"LV_PRIu32" us without the style cache, %"LV_PRIu32" us with it",
+                (uint32_t)(dsc_off_time * 1000000 / CLOCKS_PER_SEC / BENCH_REFR_CNT),
+                (uint32_t)(dsc_on_time * 1000000 / CLOCKS_PER_SEC / BENCH_REFR_CNT));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
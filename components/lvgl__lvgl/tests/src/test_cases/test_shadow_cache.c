@@ -0,0 +1,232 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include <time.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE >= 64
+#if LV_SHADOW_CACHE_MEM_SIZE
+#define SHADOW_CACHE_TEST   1
+#endif
+#endif
+
+#ifndef SHADOW_CACHE_TEST
+#define SHADOW_CACHE_TEST   0
+#endif
+
+#if SHADOW_CACHE_TEST
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+static lv_obj_t * shadow_create(lv_coord_t w, lv_coord_t h, lv_coord_t shadow_w, lv_coord_t spread, lv_coord_t radius)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xeeeeee), 0);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, shadow_w, 0);
+    lv_obj_set_style_shadow_spread(obj, spread, 0);
+    lv_obj_set_style_shadow_ofs_y(obj, 3, 0);
+    lv_obj_set_style_shadow_color(obj, lv_color_hex(0x203040), 0);
+    return obj;
+}
+#endif
+
+void setUp(void)
+{
+#if SHADOW_CACHE_TEST
+    lv_draw_sw_shadow_cache_clear();
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*Every band of a parallel redraw looks up the shadows it crosses on its own*/
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+#endif
+}
+
+void test_shadow_cache_hit(void)
+{
+#if SHADOW_CACHE_TEST
+    lv_draw_sw_shadow_cache_monitor_t mon;
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(LV_SHADOW_CACHE_MEM_SIZE, mon.total_size);
+
+    lv_obj_t * obj = shadow_create(200, 100, 30, 0, 10);
+    lv_obj_center(obj);
+
+    /*The first draw blurs the corner*/
+    lv_test_refr_screen();
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(40 * 40, mon.used_size);
+
+    /*Redrawing only copies it*/
+    lv_test_refr_screen();
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+
+    /*An other object with the same shadow uses the same corner*/
+    lv_obj_t * obj2 = shadow_create(150, 120, 30, 0, 10);
+    lv_obj_align(obj2, LV_ALIGN_TOP_LEFT, 40, 40);
+    lv_test_refr_screen();
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(3, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, mon.miss_cnt);
+
+    /*Both corners are kept if the shadow changes*/
+    lv_obj_set_style_shadow_width(obj2, 20, 0);
+    lv_test_refr_screen();
+    lv_test_refr_screen();
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(6, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(40 * 40 + 30 * 30, mon.used_size);
+
+    lv_draw_sw_shadow_cache_clear();
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.hit_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_shadow_cache_same_pixels(void)
+{
+#if SHADOW_CACHE_TEST
+    /*Small objects where the other corners of the blurred rectangle reach into the corner too,
+     *large spreads and radii clamped to the size*/
+    static const struct {
+        lv_coord_t w;
+        lv_coord_t h;
+        lv_coord_t shadow_w;
+        lv_coord_t spread;
+        lv_coord_t radius;
+    } shadows[] = {
+        {120, 60, 30, 0, 10},
+        {12, 60, 30, 0, 10},
+        {60, 8, 30, 0, 10},
+        {10, 10, 30, 0, 10},
+        {20, 20, 30, 0, 10},
+        {120, 60, 15, 5, 0},
+        {14, 16, 15, 5, 0},
+        {120, 60, 16, 10, LV_RADIUS_CIRCLE},
+        {40, 40, 16, 10, LV_RADIUS_CIRCLE},
+        {30, 40, 16, 10, LV_RADIUS_CIRCLE},
+        {40, 40, 16, -5, LV_RADIUS_CIRCLE},
+        {60, 40, 1, 4, 6},
+    };
+
+    uint32_t cnt = sizeof(shadows) / sizeof(shadows[0]);
+    lv_obj_t * objs[sizeof(shadows) / sizeof(shadows[0])];
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        objs[i] = shadow_create(shadows[i].w, shadows[i].h, shadows[i].shadow_w, shadows[i].spread, shadows[i].radius);
+        lv_obj_center(objs[i]);
+    }
+
+    uint32_t j;
+    for(i = 0; i < cnt; i++) {
+        for(j = 0; j < cnt; j++) {
+            if(i == j) lv_obj_clear_flag(objs[j], LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_add_flag(objs[j], LV_OBJ_FLAG_HIDDEN);
+        }
+
+        /*Draw the shadow alone with an empty cache*/
+        lv_draw_sw_shadow_cache_clear();
+        lv_test_refr_screen();
+        lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+        /*Cache the corners of all the other shadows and draw it again*/
+        for(j = 0; j < cnt; j++) {
+            if(i == j) lv_obj_add_flag(objs[j], LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_clear_flag(objs[j], LV_OBJ_FLAG_HIDDEN);
+        }
+        lv_draw_sw_shadow_cache_clear();
+        lv_test_refr_screen();
+        for(j = 0; j < cnt; j++) {
+            if(i == j) lv_obj_clear_flag(objs[j], LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_add_flag(objs[j], LV_OBJ_FLAG_HIDDEN);
+        }
+        lv_test_refr_screen();
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_shadow_cache_stays_in_budget(void)
+{
+#if SHADOW_CACHE_TEST
+    lv_draw_sw_shadow_cache_monitor_t mon;
+    lv_obj_t * obj = shadow_create(200, 100, 10, 0, 10);
+    lv_obj_center(obj);
+
+    /*Much more corners than the cache can hold*/
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_obj_set_style_shadow_width(obj, (lv_coord_t)(10 + i), 0);
+        lv_obj_set_style_radius(obj, (lv_coord_t)(LV_SHADOW_CACHE_SIZE - 10 - i), 0);
+        lv_refr_now(NULL);
+
+        lv_draw_sw_shadow_cache_monitor(&mon);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_SHADOW_CACHE_MEM_SIZE, mon.used_size);
+    }
+    TEST_ASSERT_EQUAL_UINT32(40, mon.miss_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_shadow_cache_benchmark(void)
+{
+#if SHADOW_CACHE_TEST
+    lv_obj_t * obj = shadow_create(200, 100, 40, 0, 20);
+    lv_obj_center(obj);
+
+    /*Redraw the object with and without the cache*/
+    uint32_t i;
+    clock_t start = clock();
+    for(i = 0; i < 100; i++) {
+        lv_draw_sw_shadow_cache_clear();
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+    clock_t plain_time = clock() - start;
+
+    start = clock();
+    for(i = 0; i < 100; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+    clock_t cached_time = clock() - start;
+
+    TEST_PRINTF("100 redraws of a shadow: %"LV_PRIu32" us with blurring, %"LV_PRIu32" us from the shadow cache",
+                (uint32_t)(plain_time * 1000000 / CLOCKS_PER_SEC), (uint32_t)(cached_time * 1000000 / CLOCKS_PER_SEC));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
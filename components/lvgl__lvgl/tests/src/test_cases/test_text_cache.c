@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include <time.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+
+#if LV_FONT_MONTSERRAT_48
+#define TIME_FONT &lv_font_montserrat_48
+#else
+#define TIME_FONT LV_FONT_DEFAULT
+#endif
+
+#if LV_TEXT_CACHE_SIZE
+extern lv_color_t test_fb[];
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+#endif
+
+void setUp(void)
+{
+#if LV_TEXT_CACHE_SIZE
+    lv_draw_sw_text_cache_clear();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+#if LV_DRAW_SW_THREAD_CNT > 1
+    lv_draw_sw_thread_set_cnt(LV_DRAW_SW_THREAD_CNT);
+#endif
+}
+
+void test_text_cache_hit(void)
+{
+#if LV_TEXT_CACHE_SIZE
+    lv_draw_sw_text_cache_monitor_t mon;
+    lv_draw_sw_text_cache_monitor(&mon);
+    uint32_t hit_cnt = mon.hit_cnt;
+    uint32_t miss_cnt = mon.miss_cnt;
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+    TEST_ASSERT_EQUAL_UINT32(LV_TEXT_CACHE_SIZE, mon.total_size);
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, TIME_FONT, 0);
+    lv_label_set_text(label, "12:34");
+
+    /*The first draw renders the text*/
+    lv_test_refr_screen();
+    lv_draw_sw_text_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, mon.miss_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, mon.used_size);
+
+    /*Redrawing the same text only blends the stored opacity map*/
+    lv_test_refr_screen();
+    lv_draw_sw_text_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 1, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, mon.miss_cnt);
+
+    /*The color isn't part of the opacity map*/
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_test_refr_screen();
+    lv_draw_sw_text_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 2, mon.hit_cnt);
+
+    /*A new text is a new entry*/
+    lv_label_set_text(label, "12:35");
+    lv_test_refr_screen();
+    lv_draw_sw_text_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 2, mon.miss_cnt);
+
+    lv_draw_sw_text_cache_clear();
+    lv_draw_sw_text_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_text_cache_same_pixels(void)
+{
+#if LV_TEXT_CACHE_SIZE
+#if LV_DRAW_SW_THREAD_CNT > 1
+    /*Every band of a parallel redraw looks up the labels it crosses on its own*/
+    lv_draw_sw_thread_set_cnt(1);
+#endif
+
+    /*A clock face on a gradient to see the anti-aliased edges on different background colors*/
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x224488), 0);
+    lv_obj_set_style_bg_grad_color(lv_scr_act(), lv_color_hex(0xffaaaa), 0);
+    lv_obj_set_style_bg_grad_dir(lv_scr_act(), LV_GRAD_DIR_HOR, 0);
+
+    lv_obj_t * time_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(time_label, TIME_FONT, 0);
+    lv_obj_set_style_text_color(time_label, lv_color_hex(0xeeeeee), 0);
+    lv_label_set_text(time_label, "12:34");
+    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -40);
+
+    lv_obj_t * date_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_align(date_label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_letter_space(date_label, 2, 0);
+    lv_label_set_text(date_label, "Sunday\nOctober 18, 2026");
+    lv_obj_align(date_label, LV_ALIGN_CENTER, 0, 40);
+
+    /*With recoloring enabled the labels are drawn letter by letter*/
+    lv_label_set_recolor(time_label, true);
+    lv_label_set_recolor(date_label, true);
+    lv_test_refr_screen();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_sw_text_cache_monitor_t mon;
+    lv_draw_sw_text_cache_monitor(&mon);
+    uint32_t hit_cnt = mon.hit_cnt;
+
+    /*Once when the opacity maps are rendered and once from the cache*/
+    lv_label_set_recolor(time_label, false);
+    lv_label_set_recolor(date_label, false);
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_test_refr_screen();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_sw_text_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 2, mon.hit_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_text_cache_stays_in_budget(void)
+{
+#if LV_TEXT_CACHE_SIZE
+    lv_draw_sw_text_cache_monitor_t mon;
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, TIME_FONT, 0);
+
+    /*A day of minutes is much more than the cache can hold*/
+    uint32_t i;
+    for(i = 0; i < 24 * 60; i += 7) {
+        lv_label_set_text_fmt(label, "%02"LV_PRIu32":%02"LV_PRIu32, i / 60, i % 60);
+        lv_refr_now(NULL);
+
+        lv_draw_sw_text_cache_monitor(&mon);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_TEXT_CACHE_SIZE, mon.used_size);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_text_cache_benchmark(void)
+{
+#if LV_TEXT_CACHE_SIZE
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, TIME_FONT, 0);
+    lv_label_set_text(label, "12:34:56");
+    lv_obj_center(label);
+
+    const lv_area_t * a = &label->coords;
+    uint32_t i;
+
+    /*Draw the label only, with and without the cache*/
+    lv_label_set_recolor(label, true);
+    clock_t start = clock();
+    for(i = 0; i < 100; i++) {
+        lv_obj_invalidate_area(label, a);
+        lv_refr_now(NULL);
+    }
+    clock_t plain_time = clock() - start;
+
+    lv_label_set_recolor(label, false);
+    lv_refr_now(NULL);
+    start = clock();
+    for(i = 0; i < 100; i++) {
+        lv_obj_invalidate_area(label, a);
+        lv_refr_now(NULL);
+    }
+    clock_t cached_time = clock() - start;
+
+    TEST_PRINTF("100 label redraws: %"LV_PRIu32" us letter by letter, %"LV_PRIu32" us from the text cache",
+                (uint32_t)(plain_time * 1000000 / CLOCKS_PER_SEC), (uint32_t)(cached_time * 1000000 / CLOCKS_PER_SEC));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
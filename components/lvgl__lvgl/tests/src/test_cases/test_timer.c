@@ -0,0 +1,262 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+#define BENCH_TIMER_CNT 5000
+#define BENCH_CALL_CNT  1000
+
+static uint32_t run_cnt;
+static uint32_t run_order[8];
+static lv_timer_t * other_timer;
+
+static void count_cb(lv_timer_t * timer)
+{
+    if(run_cnt < sizeof(run_order) / sizeof(run_order[0])) run_order[run_cnt] = (uint32_t)(lv_uintptr_t)timer->user_data;
+    run_cnt++;
+}
+
+static void del_self_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    lv_timer_del(timer);
+}
+
+static void del_other_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    run_cnt++;
+    if(other_timer) {
+        lv_timer_del(other_timer);
+        other_timer = NULL;
+    }
+}
+
+/*Create a one shot timer and delete it right away like animations starting and ending*/
+static void churn_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_timer_t * t = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(t, 1);
+    lv_timer_del(lv_timer_create(count_cb, 10000, NULL));
+}
+
+static void nop_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+}
+
+static bool timer_exists(lv_timer_t * timer)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == timer) return true;
+        t = lv_timer_get_next(t);
+    }
+    return false;
+}
+
+/*The time till the next timer by checking all the timers. It's what the handler used to do on every call.*/
+static uint32_t scan_time_till_next(void)
+{
+    uint32_t time_till_next = LV_NO_TIMER_READY;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(!t->paused) {
+            uint32_t elp = lv_tick_elaps(t->last_run);
+            uint32_t delay = elp >= t->period ? 0 : t->period - elp;
+            if(delay < time_till_next) time_till_next = delay;
+        }
+        t = lv_timer_get_next(t);
+    }
+    return time_till_next;
+}
+
+void setUp(void)
+{
+    run_cnt = 0;
+    other_timer = NULL;
+    lv_memset_00(run_order, sizeof(run_order));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_timer_runs_ready_timers_by_due_time(void)
+{
+    lv_timer_t * t3 = lv_timer_create(count_cb, 30, (void *)3);
+    lv_timer_t * t1 = lv_timer_create(count_cb, 10, (void *)1);
+    lv_timer_t * t2 = lv_timer_create(count_cb, 20, (void *)2);
+
+    /*Nothing is ready yet*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    /*When all of them are overdue the one which was due first runs first*/
+    lv_tick_inc(40);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, run_order[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, run_order[1]);
+    TEST_ASSERT_EQUAL_UINT32(3, run_order[2]);
+
+    /*After running they wait for their period again*/
+    lv_timer_set_period(t1, 10000);
+    lv_timer_set_period(t2, 10000);
+    lv_timer_set_period(t3, 10000);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    lv_timer_del(t3);
+}
+
+void test_timer_period_0_runs_once_per_call(void)
+{
+    lv_timer_t * t = lv_timer_create(count_cb, 0, NULL);
+
+    /*It's always ready but doesn't keep the handler running*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(t);
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * t = lv_timer_create(count_cb, 10000, NULL);
+    lv_timer_set_repeat_count(t, 2);
+
+    lv_timer_ready(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_TRUE(timer_exists(t));
+
+    lv_timer_ready(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_FALSE(timer_exists(t));
+
+    /*Setting the repeat count to 0 deletes the timer on the next call without running it*/
+    t = lv_timer_create(count_cb, 10000, NULL);
+    lv_timer_set_repeat_count(t, 0);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_FALSE(timer_exists(t));
+}
+
+void test_timer_delete_in_callback(void)
+{
+    lv_timer_t * t1 = lv_timer_create(del_self_cb, 10000, NULL);
+    lv_timer_ready(t1);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_FALSE(timer_exists(t1));
+
+    /*A ready timer deleted by an other one doesn't run*/
+    lv_timer_t * t2 = lv_timer_create(del_other_cb, 10000, NULL);
+    other_timer = lv_timer_create(count_cb, 20000, NULL);
+    lv_timer_ready(t2);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_NULL(other_timer);
+    lv_timer_del(t2);
+}
+
+void test_timer_pause_resume(void)
+{
+    lv_timer_t * t = lv_timer_create(count_cb, 10000, NULL);
+    lv_timer_ready(t);
+    lv_timer_pause(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    /*It was made ready before pausing, so it runs right after resuming*/
+    lv_timer_resume(t);
+    lv_timer_resume(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_del(t);
+}
+
+void test_timer_time_till_next(void)
+{
+    uint32_t i;
+    lv_timer_t * timers[100];
+    for(i = 0; i < 100; i++) {
+        timers[i] = lv_timer_create(nop_cb, 1000 + (i * 7919) % 50000, NULL);
+        if(i % 3 == 0) lv_timer_pause(timers[i]);
+    }
+
+    for(i = 0; i < 20; i++) {
+        lv_timer_set_period(timers[i * 5], 500 + i * 37);
+        uint32_t start = lv_tick_get();
+        uint32_t handler_next = lv_timer_handler();
+        uint32_t scan_next = scan_time_till_next();
+        /*Time may pass between the two*/
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(handler_next, scan_next);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(scan_next + lv_tick_elaps(start), handler_next);
+    }
+
+    for(i = 0; i < 100; i++) lv_timer_del(timers[i]);
+}
+
+void test_timer_benchmark(void)
+{
+    static lv_timer_t * timers[BENCH_TIMER_CNT];
+    uint32_t i;
+
+    /*Many long period timers, e.g. the timers of an application. None of them are ready.*/
+    for(i = 0; i < BENCH_TIMER_CNT; i++) {
+        timers[i] = lv_timer_create(nop_cb, 60000 + i, NULL);
+    }
+
+    clock_t start = clock();
+    for(i = 0; i < BENCH_CALL_CNT; i++) {
+        lv_timer_handler();
+    }
+    clock_t handler_time = clock() - start;
+
+    /*Walking the list once, the old handler did it twice*/
+    volatile uint32_t sum = 0;
+    start = clock();
+    for(i = 0; i < BENCH_CALL_CNT; i++) {
+        sum += scan_time_till_next();
+    }
+    clock_t scan_time = clock() - start;
+
+    /*A timer which creates and deletes timers in every call.
+     *It made the old handler start over from the first timer every time.*/
+    lv_timer_t * churn = lv_timer_create(churn_cb, 0, NULL);
+    start = clock();
+    for(i = 0; i < BENCH_CALL_CNT; i++) {
+        lv_timer_handler();
+    }
+    clock_t churn_time = clock() - start;
+    lv_timer_del(churn);
+
+    TEST_PRINTF("%d timers, per lv_timer_handler call: %"LV_PRIu32" ns (a list walk: %"LV_PRIu32" ns), "
+                "%"LV_PRIu32" ns with timers created and deleted",
+                BENCH_TIMER_CNT,
+                (uint32_t)((uint64_t)handler_time * 1000000000 / CLOCKS_PER_SEC / BENCH_CALL_CNT),
+                (uint32_t)((uint64_t)scan_time * 1000000000 / CLOCKS_PER_SEC / BENCH_CALL_CNT),
+                (uint32_t)((uint64_t)churn_time * 1000000000 / CLOCKS_PER_SEC / BENCH_CALL_CNT));
+
+    for(i = 0; i < BENCH_TIMER_CNT; i++) {
+        lv_timer_del(timers[i]);
+    }
+
+    /*Only the handler's own work is measured, it has to be much less than checking every timer*/
+    TEST_ASSERT_LESS_THAN_UINT32((uint32_t)scan_time, (uint32_t)handler_time);
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "unity/unity.h"
 
+#include "lv_test_helpers.h"
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -46,4 +48,204 @@ void test_tiny_ttf_rendering_test(void)
 #endif
 }
 
+void test_tiny_ttf_glyph_cache(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+
+    static const char letters[] = "AVAWTo.ygj";
+    lv_font_glyph_dsc_t dsc_30[sizeof(letters) - 1];
+    lv_font_glyph_dsc_t dsc;
+    uint32_t i;
+    lv_memset_00(dsc_30, sizeof(dsc_30));   /*Compare the padding too*/
+    lv_memset_00(&dsc, sizeof(dsc));
+
+    /*The cached metrics are the same as the first ones, also for the pairs with kerning*/
+    for(i = 0; i < sizeof(letters) - 1; i++) {
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc_30[i], letters[i], letters[i + 1]));
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, letters[i], letters[i + 1]));
+        TEST_ASSERT_EQUAL_MEMORY(&dsc_30[i], &dsc, sizeof(dsc));
+    }
+
+    /*The metrics of the other size are not used*/
+    lv_tiny_ttf_set_size(font, 20);
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, 'A', 'V'));
+    TEST_ASSERT_LESS_THAN(dsc_30[0].box_w, dsc.box_w);
+    TEST_ASSERT_LESS_THAN(dsc_30[0].adv_w, dsc.adv_w);
+
+    lv_tiny_ttf_set_size(font, 30);
+    for(i = 0; i < sizeof(letters) - 1; i++) {
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &dsc, letters[i], letters[i + 1]));
+        TEST_ASSERT_EQUAL_MEMORY(&dsc_30[i], &dsc, sizeof(dsc));
+    }
+
+    /*Missing glyphs are not found from the cache either*/
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &dsc, 0x4E2D, 0));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &dsc, 0x4E2D, 0));
+
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_measure_bench(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 24);
+
+    static const char txt[] = "The quick brown fox jumps over the lazy dog. "
+                              "AVA WAVE Type Yoga, 0123456789 12:34:56 88:88";
+
+    /*The first layout gets the metrics from the font data, the others from the cache*/
+    lv_point_t size_first;
+    uint32_t t = lv_test_time_us();
+    lv_txt_get_size(&size_first, txt, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    uint32_t first_time = lv_test_time_us() - t;
+
+    uint32_t i;
+    lv_point_t size;
+    t = lv_test_time_us();
+    for(i = 0; i < 100; i++) {
+        lv_txt_get_size(&size, txt, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    }
+    uint32_t cached_time = (lv_test_time_us() - t) / 100;
+
+    TEST_ASSERT_EQUAL(size_first.x, size.x);
+    TEST_ASSERT_EQUAL(size_first.y, size.y);
+    TEST_PRINTF("measuring %d letters: %"LV_PRIu32" us first, %"LV_PRIu32" us with cached metrics",
+                (int)sizeof(txt) - 1, first_time, cached_time);
+
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_atlas(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font_ref = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 100, 64 * 1024);
+
+    lv_font_glyph_dsc_t g8;
+    lv_font_glyph_dsc_t g0;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_ref, &g8, '8', 0));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_ref, &g0, '0', 0));
+    size_t size_8 = g8.box_w * g8.box_h;
+    size_t size_0 = g0.box_w * g0.box_h;
+
+    /*Room for exactly two glyphs*/
+    lv_font_t * font = lv_tiny_ttf_create_data_atlas(ubuntu_font, ubuntu_font_size, 100, 400, size_8 + size_0);
+    TEST_ASSERT_NOT_NULL(font);
+
+    /*The glyphs are stored one after the other and look the same as without the atlas*/
+    const uint8_t * bmp_8 = lv_font_get_glyph_bitmap(font, '8');
+    const uint8_t * bmp_0 = lv_font_get_glyph_bitmap(font, '0');
+    TEST_ASSERT_NOT_NULL(bmp_8);
+    TEST_ASSERT_EQUAL_PTR(bmp_8 + size_8, bmp_0);
+    TEST_ASSERT_EQUAL_MEMORY(lv_font_get_glyph_bitmap(font_ref, '8'), bmp_8, size_8);
+    TEST_ASSERT_EQUAL_MEMORY(lv_font_get_glyph_bitmap(font_ref, '0'), bmp_0, size_0);
+    TEST_ASSERT_EQUAL_PTR(bmp_8, lv_font_get_glyph_bitmap(font, '8'));
+
+    /*The atlas is full, it's started again from the beginning*/
+    const uint8_t * bmp_1 = lv_font_get_glyph_bitmap(font, '1');
+    TEST_ASSERT_EQUAL_PTR(bmp_8, bmp_1);
+    TEST_ASSERT_EQUAL_MEMORY(lv_font_get_glyph_bitmap(font_ref, '1'), bmp_1, 10);
+    TEST_ASSERT_NOT_EQUAL(bmp_0, lv_font_get_glyph_bitmap(font, '0'));
+    lv_tiny_ttf_destroy(font);
+
+    /*A glyph larger than the atlas can't be drawn*/
+    font = lv_tiny_ttf_create_data_atlas(ubuntu_font, ubuntu_font_size, 100, 400, size_8 - 1);
+    TEST_ASSERT_NULL(lv_font_get_glyph_bitmap(font, '8'));
+    lv_tiny_ttf_destroy(font);
+
+    lv_tiny_ttf_destroy(font_ref);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_weight(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font_regular = lv_tiny_ttf_create_data_atlas(ubuntu_font, ubuntu_font_size, 100, 400, 64 * 1024);
+    lv_font_t * font_bold = lv_tiny_ttf_create_data_atlas(ubuntu_font, ubuntu_font_size, 100, 700, 64 * 1024);
+
+    /*The strokes are thicker by 3 px on each side*/
+    lv_font_glyph_dsc_t g_regular;
+    lv_font_glyph_dsc_t g_bold;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_regular, &g_regular, 'l', 0));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_bold, &g_bold, 'l', 0));
+    TEST_ASSERT_EQUAL(g_regular.box_w + 6, g_bold.box_w);
+    TEST_ASSERT_EQUAL(g_regular.box_h + 6, g_bold.box_h);
+    TEST_ASSERT_EQUAL(g_regular.adv_w + 6, g_bold.adv_w);
+    TEST_ASSERT_EQUAL(g_regular.ofs_y - 3, g_bold.ofs_y);
+
+    /*'l' is a vertical stem: count the covered pixels in its middle row*/
+    const uint8_t * bmp_regular = lv_font_get_glyph_bitmap(font_regular, 'l');
+    const uint8_t * bmp_bold = lv_font_get_glyph_bitmap(font_bold, 'l');
+    uint32_t x;
+    uint32_t stem_regular = 0;
+    uint32_t stem_bold = 0;
+    for(x = 0; x < g_regular.box_w; x++) {
+        if(bmp_regular[(g_regular.box_h / 2) * g_regular.box_w + x] > 0x80) stem_regular++;
+    }
+    for(x = 0; x < g_bold.box_w; x++) {
+        if(bmp_bold[(g_bold.box_h / 2) * g_bold.box_w + x] > 0x80) stem_bold++;
+    }
+    TEST_ASSERT_EQUAL(stem_regular + 6, stem_bold);
+
+    lv_tiny_ttf_destroy(font_regular);
+    lv_tiny_ttf_destroy(font_bold);
+#else
+    TEST_PASS();
+#endif
+}
+
+static uint32_t render_time_us(lv_obj_t * label)
+{
+    /*Measure the glyphs, not the cached text*/
+    lv_draw_sw_text_cache_clear();
+    lv_obj_invalidate(label);
+    uint32_t t = lv_test_time_us();
+    lv_refr_now(NULL);
+    return lv_test_time_us() - t;
+}
+
+void test_tiny_ttf_atlas_bench(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font_atlas = lv_tiny_ttf_create_data_atlas(ubuntu_font, ubuntu_font_size, 240, 700, 512 * 1024);
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "88:88");
+    lv_obj_center(label);
+
+    /*The glyphs are rendered only for the first time*/
+    lv_obj_set_style_text_font(label, font_atlas, 0);
+    uint32_t first_time = render_time_us(label);
+    const uint8_t * bmp = lv_font_get_glyph_bitmap(font_atlas, '8');
+    uint32_t cached_time = render_time_us(label);
+    TEST_ASSERT_EQUAL_PTR(bmp, lv_font_get_glyph_bitmap(font_atlas, '8'));
+
+    TEST_PRINTF("rendering \"88:88\" at 240 px: %"LV_PRIu32" us first, %"LV_PRIu32" us from the atlas",
+                first_time, cached_time);
+
+    lv_obj_del(label);
+    lv_tiny_ttf_destroy(font_atlas);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
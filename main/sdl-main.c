@@ -84,10 +84,11 @@ int main(int argc, char **argv)
    *disable `LV_USE_MEM_MONITOR` and `LV_USE_PERF_MONITOR` in `lv_conf.h`*/
 
   while(1) {
-      /* Periodically call the lv_task handler.
-       * It could be done in a timer interrupt or an OS task too.*/
-      lv_timer_handler();
-      usleep(10* 1000);
+      /* Call the lv_task handler when its next timer is due.
+       * Paused timers (e.g. refreshing with nothing invalidated) don't count.*/
+      uint32_t idle_ms = lv_timer_handler();
+      if(idle_ms == LV_NO_TIMER_READY) idle_ms = LV_DEF_REFR_PERIOD;
+      usleep(idle_ms * 1000);
   }
 
 demo_end:
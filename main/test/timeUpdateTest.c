@@ -0,0 +1,213 @@
+// Host test for timeUpdate.c: run a simulated day through a clock
+// face laid out like the wallclock's and count which labels change
+// and how many pixels get invalidated and redrawn.
+//
+// Built by main/test/CMakeLists.txt and run with `ctest`. It doesn't
+// open a window, the display driver just counts what LVGL renders.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lvgl.h"
+#include "timeUpdate.h"
+
+
+#define HRESOLUTION 800
+#define VRESOLUTION 480
+
+// Noon on Saturday October 17, 2026 UTC, so the simulated day
+// crosses midnight and both AM and PM.
+#define START_TIME ((time_t) 1792238400)
+#define DAY_SECONDS (24 * 60 * 60)
+
+#define CHECK(COND)							\
+  do {									\
+    if (!(COND)) {							\
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND); \
+      exit(1);								\
+    }									\
+  } while (0)
+
+
+static lv_color_t buf[HRESOLUTION * VRESOLUTION / 10];
+static lv_disp_draw_buf_t dispBuf;
+static lv_disp_drv_t dispDrv;
+static lv_disp_t *disp;
+
+static uint64_t pxCount;
+static uint32_t frameCount;
+
+static TimeLabels labels;
+static uint8_t twelveHr;
+
+
+// Called by LV_ASSERT_HANDLER of the LVGL tests' lv_test_conf.h,
+// which LVGL is built with.
+void lv_test_assert_fail(void) {
+  abort();
+}
+
+
+static void flushCB(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *colorMap) {
+  (void) area;
+  (void) colorMap;
+  lv_disp_flush_ready(drv);
+}
+
+
+static void monitorCB(lv_disp_drv_t *drv, uint32_t time, uint32_t px) {
+  (void) drv;
+  (void) time;
+  pxCount += px;
+  ++frameCount;
+}
+
+
+static void setupDisplay(void) {
+  lv_disp_draw_buf_init(&dispBuf, buf, NULL, sizeof(buf) / sizeof(buf[0]));
+
+  lv_disp_drv_init(&dispDrv);
+  dispDrv.hor_res = HRESOLUTION;
+  dispDrv.ver_res = VRESOLUTION;
+  dispDrv.flush_cb = flushCB;
+  dispDrv.monitor_cb = monitorCB;
+  dispDrv.draw_buf = &dispBuf;
+  disp = lv_disp_drv_register(&dispDrv);
+}
+
+
+// The clock face of wallclock.c's `setupClockUI()` with the built-in
+// font.
+static void setupClockUI(bool twelveHrFormat) {
+  lv_obj_t *screen = lv_obj_create(NULL);
+  lv_obj_t *p;
+
+  p = labels.time = lv_label_create(screen);
+  lv_label_set_text_static(p, "00:00");
+  lv_obj_set_pos(p, 32, 32);
+
+  p = labels.ampm = lv_label_create(screen);
+  lv_label_set_text_static(p, "AM");
+  lv_obj_align_to(p, labels.time, LV_ALIGN_TOP_RIGHT, 48, 36);
+
+  p = labels.seconds = lv_label_create(screen);
+  lv_label_set_text_static(p, "00");
+  lv_obj_align_to(p, labels.time, LV_ALIGN_BOTTOM_RIGHT, 48, -50);
+
+  p = labels.date = lv_label_create(screen);
+  lv_label_set_text_static(p, "Blurday Franuary 33, 1999");
+  lv_obj_align(p, LV_ALIGN_RIGHT_MID, -32, 0);
+
+  twelveHr = twelveHrFormat;
+  labels.twelveHr = &twelveHr;
+
+  lv_obj_t *old = lv_scr_act();
+  lv_scr_load(screen);
+  lv_obj_del(old);
+}
+
+
+// Show the time `t` and redraw what was invalidated. Returns the
+// `TIME_CHANGED_*` bits.
+static unsigned tick(time_t t) {
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  unsigned changed = timeUpdateLabels(&labels, &tm);
+  lv_refr_now(disp);
+  return changed;
+}
+
+
+static void runDay(bool twelveHrFormat) {
+  uint32_t timeCount = 0;
+  uint32_t secondsCount = 0;
+  uint32_t ampmCount = 0;
+  uint32_t dateCount = 0;
+
+  setupClockUI(twelveHrFormat);
+
+  // The first tick replaces the placeholders except the seconds
+  // which are already "00"
+  CHECK(tick(START_TIME) == (TIME_CHANGED_TIME | TIME_CHANGED_AMPM | TIME_CHANGED_DATE));
+  pxCount = 0;
+  frameCount = 0;
+
+  for (time_t t = START_TIME + 1; t <= START_TIME + DAY_SECONDS; ++t) {
+    unsigned changed = tick(t);
+    if (changed & TIME_CHANGED_TIME) ++timeCount;
+    if (changed & TIME_CHANGED_SECONDS) ++secondsCount;
+    if (changed & TIME_CHANGED_AMPM) ++ampmCount;
+    if (changed & TIME_CHANGED_DATE) ++dateCount;
+  }
+
+  // Showing the same second again doesn't touch anything
+  CHECK(tick(START_TIME + DAY_SECONDS) == 0);
+  CHECK(disp->inv_p == 0);
+
+  printf("%s: %u seconds, %u hh:mm, %u AM/PM and %u date changes\n",
+	 twelveHrFormat ? "12hr" : "24hr",
+	 (unsigned) secondsCount, (unsigned) timeCount, (unsigned) ampmCount, (unsigned) dateCount);
+  printf("%s: %u frames, %llu pixels rendered, %llu per second, %llu with full screen refreshes\n",
+	 twelveHrFormat ? "12hr" : "24hr",
+	 (unsigned) frameCount, (unsigned long long) pxCount,
+	 (unsigned long long) (pxCount / DAY_SECONDS),
+	 (unsigned long long) DAY_SECONDS * HRESOLUTION * VRESOLUTION);
+
+  CHECK(secondsCount == DAY_SECONDS);
+  CHECK(timeCount == 24 * 60);
+  CHECK(ampmCount == (twelveHrFormat ? 2 : 0));
+  CHECK(dateCount == 1);
+  CHECK(frameCount == DAY_SECONDS);
+
+  // A second costs a small fraction of the screen
+  CHECK(pxCount / DAY_SECONDS < HRESOLUTION * VRESOLUTION / 100);
+}
+
+
+// Switching between 12hr and 24hr shows up with the next tick.
+static void testSwitchFormat(void) {
+  // 00:00 on the next day
+  time_t t = START_TIME + DAY_SECONDS / 2;
+
+  setupClockUI(false);
+  tick(t);
+  CHECK(strcmp(lv_label_get_text(labels.time), "00:00") == 0);
+  CHECK(strcmp(lv_label_get_text(labels.ampm), "") == 0);
+
+  twelveHr = 1;
+  CHECK(tick(t) == (TIME_CHANGED_TIME | TIME_CHANGED_AMPM));
+  CHECK(strcmp(lv_label_get_text(labels.time), "12:00") == 0);
+  CHECK(strcmp(lv_label_get_text(labels.ampm), "AM") == 0);
+
+  twelveHr = 0;
+  CHECK(tick(t) == (TIME_CHANGED_TIME | TIME_CHANGED_AMPM));
+  CHECK(strcmp(lv_label_get_text(labels.time), "00:00") == 0);
+}
+
+
+static void testMsToNextSecond(void) {
+  struct timeval tv = {.tv_sec = START_TIME};
+
+  tv.tv_usec = 0;
+  CHECK(timeUpdateMsToNextSecond(&tv) == 1000);
+  tv.tv_usec = 250000;
+  CHECK(timeUpdateMsToNextSecond(&tv) == 750);
+  tv.tv_usec = 999999;
+  CHECK(timeUpdateMsToNextSecond(&tv) == 1);
+}
+
+
+int main(void) {
+  lv_init();
+  setupDisplay();
+
+  testMsToNextSecond();
+  runDay(false);
+  runDay(true);
+  testSwitchFormat();
+
+  printf("timeUpdateTest passed\n");
+  return 0;
+}
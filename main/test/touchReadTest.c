@@ -0,0 +1,145 @@
+// Host test for touchRead.c: drag a scrollable list with a simulated
+// finger and check that the touch read timer keeps running after the
+// finger is lifted until the thrown scroll has stopped.
+//
+// Built by main/test/CMakeLists.txt and run with `ctest`.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lvgl.h"
+#include "touchRead.h"
+
+
+#define HRESOLUTION 800
+#define VRESOLUTION 480
+
+// The read period of the timer, LVGL's default
+#define READ_MS 30
+
+#define CHECK(COND)							\
+  do {									\
+    if (!(COND)) {							\
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND); \
+      exit(1);								\
+    }									\
+  } while (0)
+
+
+static lv_color_t buf[HRESOLUTION * VRESOLUTION / 10];
+static lv_disp_draw_buf_t dispBuf;
+static lv_disp_drv_t dispDrv;
+static lv_indev_drv_t indevDrv;
+
+// The simulated finger
+static lv_point_t fingerPoint;
+static bool fingerDown;
+
+
+// Called by LV_ASSERT_HANDLER of the LVGL tests' lv_test_conf.h,
+// which LVGL is built with.
+void lv_test_assert_fail(void) {
+  abort();
+}
+
+
+static void flushCB(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *colorMap) {
+  (void) area;
+  (void) colorMap;
+  lv_disp_flush_ready(drv);
+}
+
+
+static void readCB(lv_indev_drv_t *drv, lv_indev_data_t *data) {
+  (void) drv;
+  data->point = fingerPoint;
+  data->state = fingerDown ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+
+static void setup(void) {
+  lv_disp_draw_buf_init(&dispBuf, buf, NULL, sizeof(buf) / sizeof(buf[0]));
+
+  lv_disp_drv_init(&dispDrv);
+  dispDrv.hor_res = HRESOLUTION;
+  dispDrv.ver_res = VRESOLUTION;
+  dispDrv.flush_cb = flushCB;
+  dispDrv.draw_buf = &dispBuf;
+  lv_disp_drv_register(&dispDrv);
+
+  lv_indev_drv_init(&indevDrv);
+  indevDrv.type = LV_INDEV_TYPE_POINTER;
+  indevDrv.read_cb = readCB;
+}
+
+
+// One turn of wallclock.c's `lvglLoop()` after `ms` has passed
+static void loop(lv_indev_t *indev, bool touched, uint32_t ms) {
+  touchReadUpdate(indev, touched);
+  lv_tick_inc(ms);
+  lv_timer_handler();
+}
+
+
+static void testScrollThrow(void) {
+  lv_indev_t *indev = lv_indev_drv_register(&indevDrv);
+  lv_timer_t *timerP = indev->driver->read_timer;
+
+  // A list taller than the screen
+  lv_obj_t *list = lv_obj_create(lv_scr_act());
+  lv_obj_set_size(list, 400, 400);
+  lv_obj_t *content = lv_obj_create(list);
+  lv_obj_set_size(content, 300, 4000);
+  lv_obj_update_layout(list);
+
+  // Nothing touches the panel, so nothing is read
+  loop(indev, false, READ_MS);
+  CHECK(touchReadIdle(indev));
+  CHECK(timerP->paused);
+
+  // Flick it upwards
+  fingerDown = true;
+  for (lv_coord_t y = 380; y >= 80; y -= 50) {
+    fingerPoint.x = 200;
+    fingerPoint.y = y;
+    loop(indev, true, READ_MS);
+  }
+  CHECK(lv_indev_get_scroll_obj(indev) == list);
+  lv_coord_t releaseY = lv_obj_get_scroll_y(list);
+
+  // The finger is lifted, but the list keeps scrolling
+  fingerDown = false;
+  loop(indev, false, READ_MS);
+  CHECK(indev->proc.state == LV_INDEV_STATE_RELEASED);
+  CHECK(!touchReadIdle(indev));
+
+  unsigned reads = 0;
+  while (!timerP->paused) {
+    loop(indev, false, READ_MS);
+    CHECK(++reads < 1000);
+  }
+
+  CHECK(lv_indev_get_scroll_obj(indev) == NULL);
+  CHECK(lv_obj_get_scroll_y(list) > releaseY);
+  printf("scrolled %d px in %u reads after the release\n", (int) (lv_obj_get_scroll_y(list) - releaseY), reads);
+
+  // Paused for good until the next touch
+  lv_coord_t stopY = lv_obj_get_scroll_y(list);
+  for (unsigned k = 0; k < 10; ++k) loop(indev, false, READ_MS);
+  CHECK(timerP->paused);
+  CHECK(lv_obj_get_scroll_y(list) == stopY);
+
+  lv_obj_del(list);
+  lv_indev_delete(indev);
+}
+
+
+int main(void) {
+  lv_init();
+  setup();
+
+  testScrollThrow();
+
+  printf("touchReadTest passed\n");
+  return 0;
+}
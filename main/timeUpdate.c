@@ -0,0 +1,70 @@
+// Wall clock driven updates of the clock UI's labels. See
+// timeUpdate.h.
+
+#include <string.h>
+
+#include "timeUpdate.h"
+
+
+// Set the text of `label` if it's different. Returns true if it was
+// changed. Setting the same text again would still recalculate the
+// label's size and invalidate it, so skip that.
+static bool setIfChanged(lv_obj_t *label, const char *text) {
+  if (label == NULL) return false;
+  if (strcmp(lv_label_get_text(label), text) == 0) return false;
+
+  lv_label_set_text(label, text);
+  return true;
+}
+
+
+unsigned timeUpdateLabels(const TimeLabels *labels, const struct tm *tm) {
+  char buf[64];
+  unsigned changed = 0;
+  bool twelveHr = *labels->twelveHr;
+
+  strftime(buf, sizeof(buf), twelveHr ? "%I:%M" : "%H:%M", tm);
+  if (setIfChanged(labels->time, buf)) changed |= TIME_CHANGED_TIME;
+
+  strftime(buf, sizeof(buf), "%S", tm);
+  if (setIfChanged(labels->seconds, buf)) changed |= TIME_CHANGED_SECONDS;
+
+  if (twelveHr) {
+    strftime(buf, sizeof(buf), "%p", tm);
+  } else {
+    buf[0] = '\0';
+  }
+  if (setIfChanged(labels->ampm, buf)) changed |= TIME_CHANGED_AMPM;
+
+  strftime(buf, sizeof(buf), "%A %B %d, %Y", tm);
+  if (setIfChanged(labels->date, buf)) changed |= TIME_CHANGED_DATE;
+
+  return changed;
+}
+
+
+uint32_t timeUpdateMsToNextSecond(const struct timeval *tv) {
+  return 1000 - tv->tv_usec / 1000;
+}
+
+
+// Show the current time and schedule the next call for the start of
+// the next second. LVGL measures the period from when the callback
+// is started, so running late now doesn't delay the next update.
+static void timeUpdateCB(lv_timer_t *timerP) {
+  struct timeval tv;
+  struct tm tm;
+
+  gettimeofday(&tv, NULL);
+  localtime_r(&tv.tv_sec, &tm);
+  timeUpdateLabels(timerP->user_data, &tm);
+
+  lv_timer_set_period(timerP, timeUpdateMsToNextSecond(&tv));
+}
+
+
+lv_timer_t *timeUpdateStart(const TimeLabels *labels) {
+  lv_timer_t *timerP = lv_timer_create(timeUpdateCB, 1000, (void *) labels);
+  lv_timer_ready(timerP);
+  return timerP;
+}
@@ -0,0 +1,55 @@
+// Keep the clock UI's labels in step with the wall clock.
+//
+// The time is read from `gettimeofday()` once per tick instead of
+// being counted by the tick timer itself, so the display can't drift
+// when the LVGL handler runs late, and it jumps to the right time as
+// soon as SNTP sets the clock. Only labels whose text actually
+// changed are touched, so a seconds tick invalidates just the seconds
+// label, hh:mm changes once a minute and the date once a day.
+
+#ifndef TIMEUPDATE_H
+#define TIMEUPDATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "lvgl.h"
+
+
+// The labels to keep up to date. Any of them except `time` can be
+// NULL if it isn't shown. `twelveHr` points to the setting and is
+// read on every update, so changing it takes effect with the next
+// tick.
+typedef struct {
+  lv_obj_t *time;		/* hh:mm */
+  lv_obj_t *seconds;		/* ss */
+  lv_obj_t *ampm;		/* AM/PM in 12hr format, empty in 24hr */
+  lv_obj_t *date;		/* Day of week and date */
+  const uint8_t *twelveHr;	/* Nonzero for 12hr format (24hr otherwise) */
+} TimeLabels;
+
+
+// Bits returned by `timeUpdateLabels()` for each label it changed
+enum {
+  TIME_CHANGED_TIME = 1 << 0,
+  TIME_CHANGED_SECONDS = 1 << 1,
+  TIME_CHANGED_AMPM = 1 << 2,
+  TIME_CHANGED_DATE = 1 << 3,
+};
+
+
+// Format `tm` into the labels and set the text of only those whose
+// text is different from what they show now. Returns the
+// `TIME_CHANGED_*` bits of the labels that were changed.
+unsigned timeUpdateLabels(const TimeLabels *labels, const struct tm *tm);
+
+// Milliseconds from `tv` to the start of the next second (1..1000).
+uint32_t timeUpdateMsToNextSecond(const struct timeval *tv);
+
+// Show the current local time in `labels` now and then at the start
+// of every second. `labels` has to stay valid while the timer runs.
+lv_timer_t *timeUpdateStart(const TimeLabels *labels);
+
+#endif
@@ -0,0 +1,20 @@
+// Pause the touch read timer while it's not needed. See touchRead.h.
+
+#include "touchRead.h"
+
+
+bool touchReadIdle(lv_indev_t *indev) {
+  return indev->proc.state == LV_INDEV_STATE_RELEASED && lv_indev_get_scroll_obj(indev) == NULL;
+}
+
+
+void touchReadUpdate(lv_indev_t *indev, bool touched) {
+  lv_timer_t *timerP = indev->driver->read_timer;
+
+  if (touched) {
+    lv_timer_resume(timerP);
+    lv_timer_ready(timerP);
+  } else if (touchReadIdle(indev)) {
+    lv_timer_pause(timerP);
+  }
+}
@@ -0,0 +1,28 @@
+// Read the touch panel only while it's needed.
+//
+// LVGL reads an input device from a timer. The touch controller's
+// interrupt tells when a finger is on the panel, so the read timer
+// can be paused while nothing touches it. After the finger is
+// lifted LVGL still needs a few more reads: the scroll throw
+// (momentum scrolling and elastic scrolling back from an over-scroll)
+// is advanced from the read of the released state, so the timer is
+// kept running until the scrolling has stopped.
+
+#ifndef TOUCHREAD_H
+#define TOUCHREAD_H
+
+#include <stdbool.h>
+
+#include "lvgl.h"
+
+
+// True if `indev` has no work left: it's released and no scroll is
+// being thrown.
+bool touchReadIdle(lv_indev_t *indev);
+
+// Call before each `lv_timer_handler()`. With `touched` set (the
+// touch interrupt fired) the read timer is resumed and read right
+// away, otherwise it's paused once `indev` is idle.
+void touchReadUpdate(lv_indev_t *indev, bool touched);
+
+#endif
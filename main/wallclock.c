@@ -43,6 +43,9 @@
 
 #include "lvgl.h"
 
+#include "timeUpdate.h"
+#include "touchRead.h"
+
 #include "lwip/err.h"
 #include "lwip/sys.h"
 #include "lwip/ip_addr.h"
@@ -117,18 +120,12 @@ static const char *evToName[] = {
 #define HRESOLUTION 800
 #define VRESOLUTION 480
 
-#define LVGL_TICK_PERIOD_MS 10
-
 static lv_disp_draw_buf_t dispBuf;
 static lv_disp_drv_t dispDrv;
 static esp_lcd_panel_handle_t panelH;
 static esp_lcd_touch_handle_t touchH;
 static lv_indev_t *touchIndevP;
 
-static int hours = 0;
-static int minutes = 0;
-static int seconds = 0;
-
 // Our icons created with https://lvgl.io/tools/imageconverter
 extern const lv_img_dsc_t visible;
 extern const lv_img_dsc_t invisible;
@@ -147,9 +144,19 @@ static struct {
 
 static lv_disp_t *disp;
 static lv_obj_t *keyboard;
-extern lv_font_t LoraBold240;
 extern lv_font_t RobotoMedium40;
 
+// The TrueType font the time is rendered from at run time.
+extern const uint8_t loraTTFStart[] asm("_binary_Lora_VariableFont_wght_ttf_start");
+extern const uint8_t loraTTFEnd[] asm("_binary_Lora_VariableFont_wght_ttf_end");
+
+// Size and weight of the hh:mm digits and the bytes of PSRAM their
+// glyphs are rendered into.
+static const lv_coord_t timeFontSize = 240;
+static const uint16_t timeFontWeight = 700;
+static const size_t timeFontAtlasSize = 512 * 1024;
+static const lv_font_t *timeFont = &RobotoMedium40;
+
 
 // The display has one LVGL "screen" loaded at a time, and this is
 // used to set the UI mode for wallclock (`timeUI`), settings
@@ -239,52 +246,17 @@ static SemaphoreHandle_t semVsyncEnd;
 static SemaphoreHandle_t semGuiReady;
 
 
-static void lvglTickCB(void *) {
-  /* Tell LVGL how many milliseconds has elapsed */
-  lv_tick_inc(LVGL_TICK_PERIOD_MS);
-}
-
-
-// Timer callback for updating the displayed time and date every period.
-//
-// XXX Does this get called with lvgl_port_lock already held or do I
-// need to protect here or will that hang or what?
-//
-// https://components.espressif.com/components/espressif/esp_lvgl_port
-//
-// lvgl_port_lock(0);
-// ...
-// lvgl_port_unlock();
-static void secondsCB(lv_timer_t *timerP) {
+// The task running the LVGL loop, woken by the touch interrupt.
+static TaskHandle_t lvglTaskH;
 
-  if (++seconds > 59) {
-    seconds = 0;
 
-    if (++minutes > 59) {
-      minutes = 0;
+// The GT911 pulls INT (GPIO38) low when it has new touch data. Wake
+// the LVGL loop so it resumes polling the touch panel.
+static void touchInterruptCB(esp_lcd_touch_handle_t tp) {
+  BaseType_t highTaskAwoken = pdFALSE;
 
-      if (++hours > 23) hours = 0;
-    }
-  }
-
-#if 0
-  time_t now;
-  struct tm tm;
-  time(&now);
-  tzset();
-  localtime_r(&now, &tm);
-  
-  char buf[64];
-  int st;
-  char *timeFmtP = settings.twelveHr ? "%I:%M%p" : "%R";
-
-  st = strftime(buf, sizeof(buf)-1, timeFmtP, &tod);
-  lv_label_set_text(timeUI.time, buf);
-  lv_label_set_text_fmt(timeUI.seconds, "%02d", seconds);
-
-  int st = strftime(buf, sizeof(buf)-1, "%A %B %d, %Y");
-  lv_label_set_text(timeUI.date, date);
-#endif
+  if (lvglTaskH != NULL) vTaskNotifyGiveFromISR(lvglTaskH, &highTaskAwoken);
+  portYIELD_FROM_ISR(highTaskAwoken);
 }
 
 
@@ -302,17 +274,54 @@ static bool vsyncCB(esp_lcd_panel_handle_t panel,
 }
 
 
+// Grow `acc` to also cover `area`. An empty `acc` (x2 < x1) just
+// becomes a copy of `area`.
+static void joinArea(lv_area_t *acc, const lv_area_t *area) {
+
+  if (acc->x2 < acc->x1) {
+    *acc = *area;
+  } else {
+    _lv_area_join(acc, acc, area);
+  }
+}
+
+
+// In direct mode LVGL renders straight into the panel's two frame
+// buffers at absolute coordinates and calls us once per dirty area
+// with `colorMap` pointing at the start of the buffer it is drawing
+// into. Before rendering, LVGL copies the areas that changed in the
+// previous frame from the on-screen buffer into this one
+// (`refr_sync_areas()`), so both frame buffers stay coherent without
+// redrawing the whole screen every tick.
+//
+// Nothing may be shown until the last area of the frame is rendered,
+// so we only collect the dirty rectangles until then. On the last
+// area we wait for VSYNC and hand the panel the bounding box of this
+// frame's and the previous frame's areas. The panel driver sees that
+// `colorMap` is one of its own frame buffers, so instead of copying
+// it writes back the CPU cache for that box (which covers both the
+// freshly rendered and the sync-copied pixels) and switches to
+// scanning out this buffer.
 static void flushCB(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *colorMap) {
-  int ox1 = area->x1;
-  int ox2 = area->x2;
-  int oy1 = area->y1;
-  int oy2 = area->y2;
+  static lv_area_t thisFrame = {.x1 = 0, .y1 = 0, .x2 = -1, .y2 = -1};
+  static lv_area_t lastFrame = {.x1 = 0, .y1 = 0, .x2 = -1, .y2 = -1};
+
+  joinArea(&thisFrame, area);
+
+  if (lv_disp_flush_is_last(drv)) {
+    lv_area_t dirty = thisFrame;
+    if (lastFrame.x2 >= lastFrame.x1) joinArea(&dirty, &lastFrame);
+
+    xSemaphoreGive(semGuiReady);
+    xSemaphoreTake(semVsyncEnd, portMAX_DELAY);
+
+    esp_lcd_panel_draw_bitmap(panelH, dirty.x1, dirty.y1, dirty.x2 + 1, dirty.y2 + 1, colorMap);
 
-  xSemaphoreGive(semGuiReady);
-  xSemaphoreTake(semVsyncEnd, portMAX_DELAY);
+    lastFrame = thisFrame;
+    thisFrame.x1 = thisFrame.y1 = 0;
+    thisFrame.x2 = thisFrame.y2 = -1;
+  }
 
-  // pass the draw buffer to the driver
-  esp_lcd_panel_draw_bitmap(panelH, ox1, oy1, ox2 + 1, oy2 + 1, colorMap);
   lv_disp_flush_ready(drv);
 }
 
@@ -348,7 +357,7 @@ static void setupClockUI(void) {
   // The hours:minutes
   p = timeUI.time = lv_label_create(timeUI.screen);
   lv_label_set_text_static(p, "00:00");
-  lv_obj_set_style_text_font(p, &LoraBold240, LV_PART_MAIN);
+  lv_obj_set_style_text_font(p, timeFont, LV_PART_MAIN);
   lv_obj_set_pos(p, timeL, timeT);
 
   // The AM/PM indicator
@@ -408,7 +417,15 @@ static void setupClockUI(void) {
 	   (int) lv_obj_get_x(p), (int) lv_obj_get_y(p),
 	   (int) lv_obj_get_width(p), (int) lv_obj_get_height(p));
 
-  lv_timer_create(secondsCB, 1000, NULL);
+  // Show the wall clock time from now on. Each label is only touched
+  // when its text changes.
+  static TimeLabels timeLabels;
+  timeLabels.time = timeUI.time;
+  timeLabels.seconds = timeUI.seconds;
+  timeLabels.ampm = timeUI.ampm;
+  timeLabels.date = timeUI.date;
+  timeLabels.twelveHr = &settings.twelveHr;
+  timeUpdateStart(&timeLabels);
 }
 
 
@@ -566,7 +583,53 @@ static void setupSettingsUI(void) {
 }
 
 
+// Build glyph id lookup tables for the fonts used by the settings
+// screens so laying out their text doesn't search the character maps
+// for every letter.
+//
+// The time font is rendered from the TTF on demand instead of being
+// compiled in for one size and weight. Its glyphs are kept in an
+// atlas in PSRAM, so the digits are rendered only once.
+static void setupFonts(void) {
+  static const lv_font_t *fonts[] = {
+    &lv_font_montserrat_10,
+    &lv_font_montserrat_24,
+    &RobotoMedium40,
+  };
+
+  for (unsigned k = 0; k < sizeof(fonts) / sizeof(fonts[0]); ++k) {
+    if (!lv_font_fmt_txt_accel_create(fonts[k])) ESP_LOGW(TAG, "no glyph lookup table for font %u", k);
+  }
+
+  lv_font_t *f = lv_tiny_ttf_create_data_atlas(loraTTFStart, loraTTFEnd - loraTTFStart,
+                                               timeFontSize, timeFontWeight, timeFontAtlasSize);
+
+  if (f) {
+    timeFont = f;
+  } else {
+    ESP_LOGW(TAG, "can't create the %d px time font, using RobotoMedium40", timeFontSize);
+  }
+}
+
+
+// Keep the icons that are always on a screen opened in the image
+// cache so other images never push them out.
+static void setupImages(void) {
+  static const lv_img_dsc_t *icons[] = {
+    &cog,
+    &visible,
+    &invisible,
+  };
+
+  for (unsigned k = 0; k < sizeof(icons) / sizeof(icons[0]); ++k) {
+    if (lv_img_cache_pin(icons[k]) != LV_RES_OK) ESP_LOGW(TAG, "can't pin icon %u in the image cache", k);
+  }
+}
+
+
 static void setupUI(void) {
+  setupFonts();
+  setupImages();
   setupStyles();
   setupClockUI();
   setupKeyboard();
@@ -682,19 +745,18 @@ static void setupLCD(void) {
   dispDrv.draw_buf = &dispBuf;
   dispDrv.user_data = panelH;
 
-  // The full_refresh mode can maintain the synchronization between
-  // the two frame buffers.
-  dispDrv.full_refresh = true;
+  // Render only the invalidated areas directly into whichever of the
+  // two frame buffers is off screen. LVGL keeps the pair in sync by
+  // copying the previous frame's dirty areas across before drawing
+  // (see flushCB), so a seconds tick costs a few thousand pixels
+  // instead of all 800x480 like `full_refresh` does.
+  dispDrv.direct_mode = true;
 
   disp = lv_disp_drv_register(&dispDrv);
 
-  static const esp_timer_create_args_t timerArgs = {
-    .callback = &lvglTickCB,
-    .name = "lvglTickCB",
-  };
-  esp_timer_handle_t tickTimer = NULL;
-  ESP_ERROR_CHECK(esp_timer_create(&timerArgs, &tickTimer));
-  ESP_ERROR_CHECK(esp_timer_start_periodic(tickTimer, LVGL_TICK_PERIOD_MS * 1000));
+  // There's no tick timer to set up. LVGL reads its milliseconds
+  // from `esp_timer_get_time()` (`CONFIG_LV_TICK_CUSTOM`), so nothing
+  // has to wake up every few milliseconds just to count them.
 }
 
 
@@ -717,6 +779,7 @@ static void setupTouch(void) {
       .mirror_x = 0,
       .mirror_y = 0,
     },
+    .interrupt_callback = touchInterruptCB,
   };
 
   ESP_ERROR_CHECK(esp_lcd_new_panel_io_i2c((esp_lcd_i2c_bus_handle_t) I2C_NUM_1, &touchI2CConfig, &touchIOH));
@@ -894,8 +957,41 @@ static void setupSNTP(void) {
 }
 
 
+// Run LVGL without polling. `lv_timer_handler()` returns how long
+// until its next timer is due and we sleep exactly that long. LVGL
+// pauses the display refresh timer while nothing is invalidated and
+// any invalidation resumes it, animations stop their timer when there
+// are none, and we pause the touch read timer while nothing touches
+// the panel and no scroll is thrown (see touchRead.h). So an idle
+// clock only wakes up for the once a second time update or when the
+// GT911 interrupt notifies us.
+//
+// All LVGL calls are made from this task, so anything invalidated is
+// invalidated inside `lv_timer_handler()` and the delay it returns
+// already accounts for the refresh.
+static void lvglLoop(void) {
+  bool touched = false;
+
+  while (1) {
+    // Keep reading the touch panel until the finger is lifted and
+    // the scrolling it started has stopped.
+    touchReadUpdate(touchIndevP, touched);
+
+    uint32_t sleepMs = lv_timer_handler();
+
+    // Round up so a timer due in less than a tick isn't polled for
+    // with zero timeouts.
+    TickType_t sleepTicks = portMAX_DELAY;
+    if (sleepMs != LV_NO_TIMER_READY) sleepTicks = (sleepMs + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+
+    touched = ulTaskNotifyTake(pdTRUE, sleepTicks) > 0;
+  }
+}
+
+
 static void getSettings(void) {
   setenv("TZ", settings.tz, 1);
+  tzset();
 }
 
 
@@ -904,6 +1000,7 @@ static void enableClockUI(void) {
 
 
 void app_main(void) {
+  lvglTaskH = xTaskGetCurrentTaskHandle();
   printChipInfo();
 
   setupI2C();
@@ -924,10 +1021,5 @@ void app_main(void) {
   getSettings();
   enableClockUI();	  /* Finally, enable clock UI to be visible */
 
-  while (1) {
-    // raise the task priority of LVGL and/or reduce the handler period can improve the performance
-    vTaskDelay(pdMS_TO_TICKS(10));
-    // The task running lv_timer_handler should have lower priority than that running `lv_tick_inc`
-    lv_timer_handler();
-  }
+  lvglLoop();
 }